@@ -78,6 +78,8 @@ public:
     MeshBuilder& Vertex(uint32 vertexIndex, VertexAttr::Code attr, float32 x, float32 y, float32 z);
     /// write 4D vertex data
     MeshBuilder& Vertex(uint32 vertexIndex, VertexAttr::Code attr, float32 x, float32 y, float32 z, float32 w);
+    /// batch-write a vertex component from a tightly packed float stream
+    MeshBuilder& Vertices(VertexAttr::Code attr, uint32 startVertex, uint32 numVertices, const float32* src, int32 srcNumComps);
     /// write 16-bit vertex-index at index-buffer-index
     MeshBuilder& Index(uint32 index, uint16 vertexIndex);
     /// write 32-bit vertex-index at index-buffer-index
@@ -190,4 +192,14 @@ MeshBuilder::Vertex(uint32 vertexIndex, VertexAttr::Code attr, float x, float y,
     return *this;
 }
 
+//------------------------------------------------------------------------------
+inline MeshBuilder&
+MeshBuilder::Vertices(VertexAttr::Code attr, uint32 startVertex, uint32 numVertices, const float32* src, int32 srcNumComps) {
+    o_assert_dbg(this->inBegin);
+    o_assert_dbg((startVertex + numVertices) <= this->NumVertices);
+    uint8* ptr = this->vertexPointer + startVertex * this->Layout.ByteSize();
+    VertexWriter::WriteBatch(ptr, this->Layout, attr, src, srcNumComps, numVertices);
+    return *this;
+}
+
 } // namespace Oryol
@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+//  MeshLodSelector.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "MeshLodSelector.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+MeshLodSelector::MeshLodSelector() :
+numLods(0),
+radius(0.0f),
+projScale(1.0f),
+lodBias(1.0f) {
+    for (int32 i = 0; i < GfxConfig::MaxNumPrimGroups; i++) {
+        this->minScreenSizes[i] = 0.0f;
+        this->maxDistances[i] = 0.0f;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+MeshLodSelector::Setup(const MeshSetup& setup) {
+    this->numLods = setup.NumLods();
+    this->radius = setup.BoundingRadius;
+    for (int32 i = 0; i < this->numLods; i++) {
+        this->minScreenSizes[i] = setup.LodMinScreenSize(i);
+        // screen sizes must be descending (finest LOD first)
+        o_assert_dbg((0 == i) || (this->minScreenSizes[i] <= this->minScreenSizes[i-1]));
+    }
+    this->updateThresholds();
+}
+
+//------------------------------------------------------------------------------
+void
+MeshLodSelector::SetProjection(float32 projScale_, float32 lodBias_) {
+    o_assert_dbg(lodBias_ > 0.0f);
+    this->projScale = projScale_;
+    this->lodBias = lodBias_;
+    this->updateThresholds();
+}
+
+//------------------------------------------------------------------------------
+void
+MeshLodSelector::updateThresholds() {
+    // screenSize = radius * projScale * scale / distance >= minScreenSize / lodBias
+    // <=> distance <= radius * projScale * lodBias / minScreenSize * scale
+    const float32 k = this->radius * this->projScale * this->lodBias;
+    for (int32 i = 0; i < this->numLods; i++) {
+        const float32 minSize = this->minScreenSizes[i];
+        this->maxDistances[i] = (minSize > 0.0f) ? (k / minSize) : 1.0e30f;
+    }
+}
+
+//------------------------------------------------------------------------------
+float32
+MeshLodSelector::ScreenSize(float32 radius, float32 distance, float32 projScale) {
+    o_assert_dbg(distance > 0.0f);
+    return (radius * projScale) / distance;
+}
+
+} // namespace Oryol
@@ -0,0 +1,77 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::MeshLodSelector
+    @ingroup Assets
+    @brief select a mesh LOD level per instance by projected screen size
+
+    Setup the selector from the MeshSetup of a mesh with LOD levels
+    (for instance in the MeshLoader's loaded-callback), set the projection
+    scale whenever the projection matrix changes (this is proj[1][1],
+    or 1/tan(fovy/2)), and call Select() per instance with the
+    distance of the instance to the camera. The result is the primitive
+    group index to render. Meshes without LOD levels always return 
+    primitive group 0.
+    
+    The projected screen size of an instance is its bounding sphere
+    radius times the projection scale divided by the distance, as a 
+    fraction of the viewport height. LOD n is selected while the screen
+    size is at least the LOD's min screen size, the coarsest LOD is 
+    used for anything smaller. To avoid per-instance divisions, the 
+    screen size thresholds are converted to distance thresholds when 
+    the projection changes.
+
+    @see MeshSimplifier, OmshParser
+*/
+#include "Core/Types.h"
+#include "Gfx/Setup/MeshSetup.h"
+
+namespace Oryol {
+
+class MeshLodSelector {
+public:
+    /// constructor
+    MeshLodSelector();
+
+    /// setup LOD table from mesh setup object
+    void Setup(const MeshSetup& setup);
+    /// set projection scale (proj[1][1]) and LOD bias (>1.0 favours finer LODs)
+    void SetProjection(float32 projScale, float32 lodBias=1.0f);
+    /// select primitive group index by camera distance and instance scale
+    int32 Select(float32 distance, float32 scale=1.0f) const;
+    /// get number of LOD levels
+    int32 NumLods() const;
+    
+    /// compute projected screen size (fraction of viewport height)
+    static float32 ScreenSize(float32 radius, float32 distance, float32 projScale);
+    
+private:
+    /// update distance thresholds
+    void updateThresholds();
+
+    int32 numLods;
+    float32 radius;
+    float32 projScale;
+    float32 lodBias;
+    float32 minScreenSizes[GfxConfig::MaxNumPrimGroups];
+    float32 maxDistances[GfxConfig::MaxNumPrimGroups];
+};
+
+//------------------------------------------------------------------------------
+inline int32
+MeshLodSelector::Select(float32 distance, float32 scale) const {
+    // the LOD count is tiny, so a linear scan without early-out is cheapest
+    int32 lod = 0;
+    for (int32 i = 0; i < this->numLods - 1; i++) {
+        lod += (distance > (this->maxDistances[i] * scale)) ? 1 : 0;
+    }
+    return lod;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+MeshLodSelector::NumLods() const {
+    return this->numLods;
+}
+
+} // namespace Oryol
@@ -0,0 +1,317 @@
+//------------------------------------------------------------------------------
+//  MeshSimplifier.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "MeshSimplifier.h"
+#include "Core/Assertion.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+void
+MeshSimplifier::quadric::clear() {
+    a2 = ab = ac = ad = b2 = bc = bd = c2 = cd = d2 = 0.0;
+}
+
+//------------------------------------------------------------------------------
+void
+MeshSimplifier::quadric::fromPlane(float64 a, float64 b, float64 c, float64 d) {
+    a2 = a*a; ab = a*b; ac = a*c; ad = a*d;
+    b2 = b*b; bc = b*c; bd = b*d;
+    c2 = c*c; cd = c*d;
+    d2 = d*d;
+}
+
+//------------------------------------------------------------------------------
+void
+MeshSimplifier::quadric::add(const quadric& q) {
+    a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+    b2 += q.b2; bc += q.bc; bd += q.bd;
+    c2 += q.c2; cd += q.cd;
+    d2 += q.d2;
+}
+
+//------------------------------------------------------------------------------
+float64
+MeshSimplifier::quadric::error(const float32* p) const {
+    const float64 x = p[0], y = p[1], z = p[2];
+    return x*x*a2 + 2.0*x*y*ab + 2.0*x*z*ac + 2.0*x*ad
+         + y*y*b2 + 2.0*y*z*bc + 2.0*y*bd
+         + z*z*c2 + 2.0*z*cd
+         + d2;
+}
+
+//------------------------------------------------------------------------------
+inline const float32*
+MeshSimplifier::position(const float32* positions, int32 stride, uint32 vertexIndex) {
+    return (const float32*) (((const uint8*)positions) + vertexIndex * stride);
+}
+
+//------------------------------------------------------------------------------
+static void
+triNormal(const float32* p0, const float32* p1, const float32* p2, float32* outNormal) {
+    const float32 e0[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    const float32 e1[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    outNormal[0] = e0[1] * e1[2] - e0[2] * e1[1];
+    outNormal[1] = e0[2] * e1[0] - e0[0] * e1[2];
+    outNormal[2] = e0[0] * e1[1] - e0[1] * e1[0];
+}
+
+//------------------------------------------------------------------------------
+bool
+MeshSimplifier::flips(const float32* positions, int32 stride, const Array<uint32>& indices,
+                      const Array<int32>& adjOffsets, const Array<int32>& adjTris,
+                      uint32 from, uint32 to) {
+    const float32* toPos = position(positions, stride, to);
+    for (int32 i = adjOffsets[from]; i < adjOffsets[from + 1]; i++) {
+        const int32 triBase = adjTris[i] * 3;
+        const uint32 i0 = indices[triBase];
+        const uint32 i1 = indices[triBase + 1];
+        const uint32 i2 = indices[triBase + 2];
+        if ((i0 == to) || (i1 == to) || (i2 == to)) {
+            // this triangle will collapse
+            continue;
+        }
+        const float32* p0 = position(positions, stride, i0);
+        const float32* p1 = position(positions, stride, i1);
+        const float32* p2 = position(positions, stride, i2);
+        float32 before[3], after[3];
+        triNormal(p0, p1, p2, before);
+        triNormal((i0 == from) ? toPos : p0, (i1 == from) ? toPos : p1, (i2 == from) ? toPos : p2, after);
+        if ((before[0] * after[0] + before[1] * after[1] + before[2] * after[2]) <= 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+int32
+MeshSimplifier::Simplify(const float32* positions, int32 stride, int32 numVertices,
+                         const uint32* indices, int32 numIndices,
+                         int32 targetNumIndices, float32 maxError,
+                         Array<uint32>& outIndices) {
+    o_assert(positions && indices);
+    o_assert(stride >= int32(3 * sizeof(float32)));
+    o_assert((numIndices % 3) == 0);
+
+    outIndices.Clear();
+    outIndices.Reserve(numIndices);
+    for (int32 i = 0; i < numIndices; i++) {
+        o_assert_dbg(indices[i] < uint32(numVertices));
+        outIndices.Add(indices[i]);
+    }
+    if (numIndices <= targetNumIndices) {
+        return outIndices.Size();
+    }
+
+    // lock vertices which share their position with other vertices (seams)
+    Array<uint8> locked;
+    Array<uint32> sorted;
+    locked.Reserve(numVertices);
+    sorted.Reserve(numVertices);
+    for (int32 i = 0; i < numVertices; i++) {
+        locked.Add(0);
+        sorted.Add(uint32(i));
+    }
+    auto posLess = [positions, stride](uint32 a, uint32 b) {
+        const float32* pa = position(positions, stride, a);
+        const float32* pb = position(positions, stride, b);
+        if (pa[0] != pb[0]) return pa[0] < pb[0];
+        if (pa[1] != pb[1]) return pa[1] < pb[1];
+        return pa[2] < pb[2];
+    };
+    std::sort(sorted.begin(), sorted.end(), posLess);
+    for (int32 i = 1; i < numVertices; i++) {
+        if (!posLess(sorted[i-1], sorted[i])) {
+            locked[sorted[i-1]] = 1;
+            locked[sorted[i]] = 1;
+        }
+    }
+
+    // lock vertices on open borders (edges used by only one triangle)
+    Array<uint64> edges;
+    edges.Reserve(numIndices);
+    for (int32 i = 0; i < numIndices; i += 3) {
+        for (int32 e = 0; e < 3; e++) {
+            const uint32 a = indices[i + e];
+            const uint32 b = indices[i + (e + 1) % 3];
+            edges.Add((uint64(std::min(a, b)) << 32) | uint64(std::max(a, b)));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (int32 i = 0; i < edges.Size(); ) {
+        int32 end = i + 1;
+        while ((end < edges.Size()) && (edges[end] == edges[i])) {
+            end++;
+        }
+        if (1 == (end - i)) {
+            locked[uint32(edges[i] >> 32)] = 1;
+            locked[uint32(edges[i] & 0xFFFFFFFF)] = 1;
+        }
+        i = end;
+    }
+
+    // setup per-vertex error quadrics from triangle planes
+    Array<quadric> quadrics;
+    quadrics.Reserve(numVertices);
+    for (int32 i = 0; i < numVertices; i++) {
+        quadric q;
+        q.clear();
+        quadrics.Add(q);
+    }
+    for (int32 i = 0; i < numIndices; i += 3) {
+        const float32* p0 = position(positions, stride, indices[i]);
+        float32 n[3];
+        triNormal(p0, position(positions, stride, indices[i+1]), position(positions, stride, indices[i+2]), n);
+        const float64 len = std::sqrt(float64(n[0])*n[0] + float64(n[1])*n[1] + float64(n[2])*n[2]);
+        if (len > 0.0) {
+            const float64 a = n[0] / len, b = n[1] / len, c = n[2] / len;
+            quadric q;
+            q.fromPlane(a, b, c, -(a * p0[0] + b * p0[1] + c * p0[2]));
+            for (int32 k = 0; k < 3; k++) {
+                quadrics[indices[i + k]].add(q);
+            }
+        }
+    }
+
+    // collapse passes, each pass collapses a set of independent edges
+    // (no vertex of the triangle fan around a collapsed vertex is touched
+    // twice), so that the vertex-triangle adjacency stays valid for a pass
+    Array<int32> adjOffsets;
+    Array<int32> adjTris;
+    Array<uint32> remap;
+    Array<uint8> touched;
+    Array<collapse> candidates;
+    adjOffsets.Reserve(numVertices + 1);
+    remap.Reserve(numVertices);
+    touched.Reserve(numVertices);
+    for (int32 i = 0; i <= numVertices; i++) {
+        adjOffsets.Add(0);
+        if (i < numVertices) {
+            remap.Add(uint32(i));
+            touched.Add(0);
+        }
+    }
+    const int32 targetNumTris = targetNumIndices / 3;
+    while (outIndices.Size() > targetNumIndices) {
+        const int32 curNumIndices = outIndices.Size();
+
+        // build vertex-to-triangle adjacency
+        for (int32 i = 0; i <= numVertices; i++) {
+            adjOffsets[i] = 0;
+        }
+        for (int32 i = 0; i < curNumIndices; i++) {
+            adjOffsets[outIndices[i] + 1]++;
+        }
+        for (int32 i = 0; i < numVertices; i++) {
+            adjOffsets[i + 1] += adjOffsets[i];
+        }
+        adjTris.Clear();
+        adjTris.Reserve(curNumIndices);
+        for (int32 i = 0; i < curNumIndices; i++) {
+            adjTris.Add(0);
+        }
+        for (int32 i = 0; i < curNumIndices; i++) {
+            adjTris[adjOffsets[outIndices[i]]++] = i / 3;
+        }
+        for (int32 i = numVertices; i > 0; i--) {
+            adjOffsets[i] = adjOffsets[i - 1];
+        }
+        adjOffsets[0] = 0;
+
+        // gather collapse candidates
+        candidates.Clear();
+        for (int32 i = 0; i < curNumIndices; i += 3) {
+            for (int32 e = 0; e < 3; e++) {
+                const uint32 a = outIndices[i + e];
+                const uint32 b = outIndices[i + (e + 1) % 3];
+                if (locked[a] && locked[b]) {
+                    continue;
+                }
+                quadric q = quadrics[a];
+                q.add(quadrics[b]);
+                const float64 costAB = locked[a] ? 1.0e30 : q.error(position(positions, stride, b));
+                const float64 costBA = locked[b] ? 1.0e30 : q.error(position(positions, stride, a));
+                collapse c;
+                c.from = (costAB <= costBA) ? a : b;
+                c.to = (costAB <= costBA) ? b : a;
+                c.cost = float32(std::min(costAB, costBA));
+                candidates.Add(c);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const collapse& c0, const collapse& c1) {
+            return c0.cost < c1.cost;
+        });
+
+        // perform collapses, cheapest first
+        int32 numTris = curNumIndices / 3;
+        int32 numCollapses = 0;
+        for (const collapse& c : candidates) {
+            if ((numTris <= targetNumTris) || (c.cost > maxError)) {
+                break;
+            }
+            if (touched[c.from] || touched[c.to]) {
+                continue;
+            }
+            if (flips(positions, stride, outIndices, adjOffsets, adjTris, c.from, c.to)) {
+                continue;
+            }
+            for (int32 i = adjOffsets[c.from]; i < adjOffsets[c.from + 1]; i++) {
+                const int32 triBase = adjTris[i] * 3;
+                bool degenerate = false;
+                for (int32 k = 0; k < 3; k++) {
+                    const uint32 v = outIndices[triBase + k];
+                    touched[v] = 1;
+                    degenerate |= (v == c.to);
+                }
+                if (degenerate) {
+                    numTris--;
+                }
+            }
+            remap[c.from] = c.to;
+            quadrics[c.to].add(quadrics[c.from]);
+            numCollapses++;
+        }
+        if (0 == numCollapses) {
+            break;
+        }
+
+        // apply the collapses and remove degenerate triangles
+        int32 dst = 0;
+        for (int32 i = 0; i < curNumIndices; i += 3) {
+            const uint32 i0 = remap[outIndices[i]];
+            const uint32 i1 = remap[outIndices[i + 1]];
+            const uint32 i2 = remap[outIndices[i + 2]];
+            if ((i0 != i1) && (i1 != i2) && (i0 != i2)) {
+                outIndices[dst++] = i0;
+                outIndices[dst++] = i1;
+                outIndices[dst++] = i2;
+            }
+        }
+        while (outIndices.Size() > dst) {
+            outIndices.Erase(outIndices.Size() - 1);
+        }
+        for (int32 i = 0; i < numVertices; i++) {
+            remap[i] = uint32(i);
+            touched[i] = 0;
+        }
+    }
+    return outIndices.Size();
+}
+
+//------------------------------------------------------------------------------
+float32
+MeshSimplifier::BoundingRadius(const float32* positions, int32 stride, int32 numVertices) {
+    o_assert(positions);
+    float32 maxSq = 0.0f;
+    for (int32 i = 0; i < numVertices; i++) {
+        const float32* p = position(positions, stride, uint32(i));
+        maxSq = std::max(maxSq, p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    }
+    return std::sqrt(maxSq);
+}
+
+} // namespace Oryol
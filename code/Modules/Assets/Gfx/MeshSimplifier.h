@@ -0,0 +1,69 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::MeshSimplifier
+    @ingroup Assets
+    @brief generate mesh LOD levels by edge-collapse simplification
+
+    MeshSimplifier takes an indexed triangle list and reduces the number
+    of triangles by collapsing edges into one of their end-vertices
+    (half-edge collapse), ordered by quadric error. Since no new vertices
+    are created, all LOD levels of a mesh can share the original vertex
+    data, and each LOD level becomes a new primitive group into a
+    combined index buffer, which is what the 'OMSL' variant of the
+    OMSH file format stores (see OmshParser). This is meant to run
+    offline (e.g. in an asset exporter) or at load time, not per frame.
+
+    Vertices on open mesh borders and vertices which share their position
+    with other vertices (normal or texture coordinate seams) are never
+    removed, so that simplification doesn't open cracks in the mesh.
+    Collapses which would flip triangles are rejected.
+
+    The position stride is given in bytes, so positions can be read
+    directly from interleaved vertex data (the position must be 3 floats).
+
+    @see MeshLodSelector, OmshParser
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+
+namespace Oryol {
+
+class MeshSimplifier {
+public:
+    /// simplify triangle list to target index count, returns number of indices in result
+    static int32 Simplify(const float32* positions, int32 positionStride, int32 numVertices,
+                          const uint32* indices, int32 numIndices,
+                          int32 targetNumIndices, float32 maxError,
+                          Array<uint32>& outIndices);
+    /// compute bounding sphere radius around the origin
+    static float32 BoundingRadius(const float32* positions, int32 positionStride, int32 numVertices);
+
+private:
+    /// symmetric 4x4 error quadric
+    struct quadric {
+        float64 a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+        /// clear to zero
+        void clear();
+        /// setup from plane equation
+        void fromPlane(float64 a, float64 b, float64 c, float64 d);
+        /// add another quadric
+        void add(const quadric& q);
+        /// evaluate error at position
+        float64 error(const float32* p) const;
+    };
+    /// a collapse candidate
+    struct collapse {
+        uint32 from;
+        uint32 to;
+        float32 cost;
+    };
+    /// get position of vertex
+    static const float32* position(const float32* positions, int32 stride, uint32 vertexIndex);
+    /// test if collapsing a vertex would flip one of its triangles
+    static bool flips(const float32* positions, int32 stride, const Array<uint32>& indices,
+                      const Array<int32>& adjOffsets, const Array<int32>& adjTris,
+                      uint32 from, uint32 to);
+};
+
+} // namespace Oryol
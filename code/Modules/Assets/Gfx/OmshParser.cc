@@ -45,7 +45,7 @@ OmshParser::Parse(const void* ptr, uint32 size, MeshSetup& outSetup) {
 
     // start parsing static header
     const uint32 magic = *u32Ptr++;
-    if (magic != 'OMSH') {
+    if ((magic != 'OMSH') && (magic != 'OMSL')) {
         return false;
     }
     outSetup.NumVertices = *u32Ptr++;
@@ -98,6 +98,28 @@ OmshParser::Parse(const void* ptr, uint32 size, MeshSetup& outSetup) {
         outSetup.AddPrimitiveGroup(primGroup);
     }
 
+    // optional LOD table
+    if ('OMSL' == magic) {
+        u32CheckSize += 2;
+        if (u32CheckSize > u32Size) {
+            return false;
+        }
+        const uint32 numLods = *u32Ptr++;
+        if (numLods > numPrimGroups) {
+            return false;
+        }
+        const float32* f32Ptr = (const float32*) u32Ptr++;
+        outSetup.BoundingRadius = *f32Ptr++;
+        u32CheckSize += numLods;
+        if (u32CheckSize > u32Size) {
+            return false;
+        }
+        for (uint32 i = 0; i < numLods; i++) {
+            outSetup.AddLod(*f32Ptr++);
+        }
+        u32Ptr += numLods;
+    }
+
     // check if enough data for vertices
     const uint32 u32VertexDataSize = (outSetup.NumVertices * vertexSize) >> 2;
     u32CheckSize += u32VertexDataSize;
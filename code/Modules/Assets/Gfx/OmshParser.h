@@ -12,7 +12,7 @@
     OMSH file format (see oryol-tools project):
     
     struct {
-        uint32 magic = 'OMSH';
+        uint32 magic = 'OMSH' or 'OMSL';
         uint32 numVertices;
         uint32 vertexSize;      // size of one vertex in bytes (guaranteed multiple of 4)
         uint32 numIndices;
@@ -28,6 +28,10 @@
             uint32 baseElement;
             uint32 numElements;
         } primitiveGroups[numPrimitiveGroups];
+        - only if magic is 'OMSL' (mesh with LOD levels):
+        uint32 numLods;         // <= numPrimitiveGroups, LOD n uses primitive group n
+        float32 boundingRadius; // bounding sphere radius around origin
+        float32 lodMinScreenSize[numLods];  // fraction of viewport height, descending
         uint8 vertexData[numVertices * vertexSize];
         uint8 indexData[numIndices * indexSize];
         - optional: 2 zero-bytes of padding if odd number of 16-bit-indices
@@ -42,6 +46,11 @@
         TriangleStrip = 5,
         TriangleFan = 6,
     }
+
+    The LOD levels of an 'OMSL' file share the vertex data, each level
+    is a primitive group into the index data. They are generated offline
+    with the MeshSimplifier class, and selected at runtime with
+    MeshLodSelector.
 */
 #include "Gfx/Setup/MeshSetup.h"
 
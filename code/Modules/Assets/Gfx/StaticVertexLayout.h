@@ -0,0 +1,294 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::StaticVertexLayout
+    @ingroup Assets
+    @brief compile-time vertex layout with specialized vertex writers
+
+    A StaticVertexLayout describes a vertex layout as a list of
+    VertexComp<> template arguments. Component byte offsets, the
+    vertex stride and the packing code for each component are resolved
+    at compile time, so writing a vertex component doesn't need any
+    VertexLayout lookups or VertexFormat switches. Use this for hot
+    dynamic-geometry code where the vertex layout is known up front:
+
+    @code
+    typedef StaticVertexLayout<
+        VertexComp<VertexAttr::Position, VertexFormat::Float3>,
+        VertexComp<VertexAttr::Normal, VertexFormat::Byte4N>,
+        VertexComp<VertexAttr::TexCoord0, VertexFormat::Short2N>> MyLayout;
+
+    uint8* ptr = MyLayout::VertexPtr(vertexData, vertexIndex);
+    MyLayout::Write<VertexAttr::Position>(ptr, x, y, z);
+    MyLayout::Write<VertexAttr::Normal>(ptr, nx, ny, nz);
+    MyLayout::Write<VertexAttr::TexCoord0>(ptr, u, v);
+
+    meshSetup.Layout = MyLayout::Layout();
+    @endcode
+
+    The packed values are identical to the ones written by VertexWriter.
+
+    @see VertexWriter, VertexLayout
+*/
+#include "Core/Types.h"
+#include "Gfx/Core/Enums.h"
+#include "Gfx/Core/VertexLayout.h"
+#include <cstring>
+
+namespace Oryol {
+
+namespace _priv {
+
+//------------------------------------------------------------------------------
+inline float32
+vertexClamp(float32 v, float32 lo, float32 hi) {
+    // written so that compilers emit min/max instructions, not branches
+    v = v < lo ? lo : v;
+    return v > hi ? hi : v;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+vertexRound(float32 v) {
+    // round half away from zero, like glm::round()
+    return int32(v + (v < 0.0f ? -0.5f : 0.5f));
+}
+
+//------------------------------------------------------------------------------
+template<typename T, int NUM> inline void
+vertexStore(uint8* dst, const T (&vals)[NUM]) {
+    std::memcpy(dst, vals, sizeof(vals));
+}
+
+/// compile-time vertex format traits and packing functions
+template<VertexFormat::Code FORMAT> struct vertexFormat;
+
+template<> struct vertexFormat<VertexFormat::Float> {
+    static const int32 ByteSize = 4;
+    static const int32 MinComps = 1;
+    static const int32 MaxComps = 1;
+    static void Pack(uint8* dst, float32 x, float32 /*y*/, float32 /*z*/, float32 /*w*/) {
+        const float32 v[1] = { x };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Float2> {
+    static const int32 ByteSize = 8;
+    static const int32 MinComps = 2;
+    static const int32 MaxComps = 2;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 /*z*/, float32 /*w*/) {
+        const float32 v[2] = { x, y };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Float3> {
+    static const int32 ByteSize = 12;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 3;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 /*w*/) {
+        const float32 v[3] = { x, y, z };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Float4> {
+    static const int32 ByteSize = 16;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 4;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 w) {
+        const float32 v[4] = { x, y, z, w };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Byte4> {
+    static const int32 ByteSize = 4;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 4;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 w) {
+        const int8 v[4] = {
+            int8(vertexClamp(x, -128.0f, 127.0f)), int8(vertexClamp(y, -128.0f, 127.0f)),
+            int8(vertexClamp(z, -128.0f, 127.0f)), int8(vertexClamp(w, -128.0f, 127.0f))
+        };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Byte4N> {
+    static const int32 ByteSize = 4;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 4;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 w) {
+        const int8 v[4] = {
+            int8(vertexRound(vertexClamp(x, -1.0f, 1.0f) * 127.0f)), int8(vertexRound(vertexClamp(y, -1.0f, 1.0f) * 127.0f)),
+            int8(vertexRound(vertexClamp(z, -1.0f, 1.0f) * 127.0f)), int8(vertexRound(vertexClamp(w, -1.0f, 1.0f) * 127.0f))
+        };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::UByte4> {
+    static const int32 ByteSize = 4;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 4;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 w) {
+        const uint8 v[4] = {
+            uint8(vertexClamp(x, 0.0f, 255.0f)), uint8(vertexClamp(y, 0.0f, 255.0f)),
+            uint8(vertexClamp(z, 0.0f, 255.0f)), uint8(vertexClamp(w, 0.0f, 255.0f))
+        };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::UByte4N> {
+    static const int32 ByteSize = 4;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 4;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 w) {
+        const uint8 v[4] = {
+            uint8(vertexRound(vertexClamp(x, 0.0f, 1.0f) * 255.0f)), uint8(vertexRound(vertexClamp(y, 0.0f, 1.0f) * 255.0f)),
+            uint8(vertexRound(vertexClamp(z, 0.0f, 1.0f) * 255.0f)), uint8(vertexRound(vertexClamp(w, 0.0f, 1.0f) * 255.0f))
+        };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Short2> {
+    static const int32 ByteSize = 4;
+    static const int32 MinComps = 2;
+    static const int32 MaxComps = 2;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 /*z*/, float32 /*w*/) {
+        const int16 v[2] = { int16(vertexClamp(x, -32768.0f, 32767.0f)), int16(vertexClamp(y, -32768.0f, 32767.0f)) };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Short2N> {
+    static const int32 ByteSize = 4;
+    static const int32 MinComps = 2;
+    static const int32 MaxComps = 2;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 /*z*/, float32 /*w*/) {
+        const int16 v[2] = {
+            int16(vertexRound(vertexClamp(x, -1.0f, 1.0f) * 32767.0f)), int16(vertexRound(vertexClamp(y, -1.0f, 1.0f) * 32767.0f))
+        };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Short4> {
+    static const int32 ByteSize = 8;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 4;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 w) {
+        const int16 v[4] = {
+            int16(vertexClamp(x, -32768.0f, 32767.0f)), int16(vertexClamp(y, -32768.0f, 32767.0f)),
+            int16(vertexClamp(z, -32768.0f, 32767.0f)), int16(vertexClamp(w, -32768.0f, 32767.0f))
+        };
+        vertexStore(dst, v);
+    }
+};
+template<> struct vertexFormat<VertexFormat::Short4N> {
+    static const int32 ByteSize = 8;
+    static const int32 MinComps = 3;
+    static const int32 MaxComps = 4;
+    static void Pack(uint8* dst, float32 x, float32 y, float32 z, float32 w) {
+        const int16 v[4] = {
+            int16(vertexRound(vertexClamp(x, -1.0f, 1.0f) * 32767.0f)), int16(vertexRound(vertexClamp(y, -1.0f, 1.0f) * 32767.0f)),
+            int16(vertexRound(vertexClamp(z, -1.0f, 1.0f) * 32767.0f)), int16(vertexRound(vertexClamp(w, -1.0f, 1.0f) * 32767.0f))
+        };
+        vertexStore(dst, v);
+    }
+};
+
+} // namespace _priv
+
+//------------------------------------------------------------------------------
+/// a vertex component (attribute and pack format) in a StaticVertexLayout
+template<VertexAttr::Code ATTR, VertexFormat::Code FORMAT> struct VertexComp {
+    static const VertexAttr::Code Attr = ATTR;
+    static const VertexFormat::Code Format = FORMAT;
+    static const int32 ByteSize = _priv::vertexFormat<FORMAT>::ByteSize;
+};
+
+namespace _priv {
+
+/// recursively computes component byte offsets at compile time
+template<int32 OFFSET, typename... COMPS> struct staticVertexComps;
+
+template<int32 OFFSET> struct staticVertexComps<OFFSET> {
+    static const int32 ByteSize = OFFSET;
+    static void AddTo(VertexLayout& /*layout*/) { }
+    template<VertexAttr::Code ATTR> struct find {
+        static const bool Found = false;
+        static const int32 Offset = 0;
+        static const VertexFormat::Code Format = VertexFormat::InvalidVertexFormat;
+    };
+};
+
+template<int32 OFFSET, typename HEAD, typename... TAIL> struct staticVertexComps<OFFSET, HEAD, TAIL...> {
+    typedef staticVertexComps<OFFSET + HEAD::ByteSize, TAIL...> next;
+    static_assert(!next::template find<HEAD::Attr>::Found, "StaticVertexLayout: vertex attribute used more than once!");
+    static const int32 ByteSize = next::ByteSize;
+    static void AddTo(VertexLayout& layout) {
+        layout.Add(HEAD::Attr, HEAD::Format);
+        next::AddTo(layout);
+    }
+    template<VertexAttr::Code ATTR> struct find {
+        static const bool isHead = (ATTR == HEAD::Attr);
+        static const bool Found = isHead || next::template find<ATTR>::Found;
+        static const int32 Offset = isHead ? OFFSET : next::template find<ATTR>::Offset;
+        static const VertexFormat::Code Format = isHead ? HEAD::Format : next::template find<ATTR>::Format;
+    };
+};
+
+} // namespace _priv
+
+//------------------------------------------------------------------------------
+template<typename... COMPS> class StaticVertexLayout {
+    typedef _priv::staticVertexComps<0, COMPS...> comps;
+    template<VertexAttr::Code ATTR, int32 NUM> struct comp {
+        typedef typename comps::template find<ATTR> found;
+        static_assert(found::Found, "StaticVertexLayout: vertex attribute not in layout!");
+        typedef _priv::vertexFormat<found::Format> format;
+        static_assert((0 == NUM) || ((NUM >= format::MinComps) && (NUM <= format::MaxComps)),
+            "StaticVertexLayout: number of values doesn't match vertex format!");
+    };
+public:
+    /// byte size of one vertex (aka vertex stride)
+    static const int32 ByteSize = comps::ByteSize;
+    /// number of vertex components
+    static const int32 NumComponents = int32(sizeof...(COMPS));
+    static_assert(ByteSize < 128, "StaticVertexLayout: vertex too big!");
+    static_assert(NumComponents <= GfxConfig::MaxNumVertexLayoutComponents, "StaticVertexLayout: too many components!");
+
+    /// test if the layout contains a vertex attribute
+    template<VertexAttr::Code ATTR> struct Contains {
+        static const bool Value = comps::template find<ATTR>::Found;
+    };
+    /// byte offset of a vertex component
+    template<VertexAttr::Code ATTR> struct ComponentByteOffset {
+        static const int32 Value = comp<ATTR, 0>::found::Offset;
+    };
+
+    /// build the equivalent run-time VertexLayout (e.g. for MeshSetup)
+    static VertexLayout Layout() {
+        VertexLayout layout;
+        comps::AddTo(layout);
+        return layout;
+    }
+    /// get pointer to start of vertex in vertex data
+    static uint8* VertexPtr(uint8* vertexData, int32 vertexIndex) {
+        return vertexData + vertexIndex * ByteSize;
+    }
+
+    /// write 1D vertex component
+    template<VertexAttr::Code ATTR> static void Write(uint8* vertex, float32 x) {
+        comp<ATTR, 1>::format::Pack(vertex + comp<ATTR, 1>::found::Offset, x, 0.0f, 0.0f, 0.0f);
+    }
+    /// write 2D vertex component
+    template<VertexAttr::Code ATTR> static void Write(uint8* vertex, float32 x, float32 y) {
+        comp<ATTR, 2>::format::Pack(vertex + comp<ATTR, 2>::found::Offset, x, y, 0.0f, 0.0f);
+    }
+    /// write 3D vertex component (4D formats get w=0.0)
+    template<VertexAttr::Code ATTR> static void Write(uint8* vertex, float32 x, float32 y, float32 z) {
+        comp<ATTR, 3>::format::Pack(vertex + comp<ATTR, 3>::found::Offset, x, y, z, 0.0f);
+    }
+    /// write 4D vertex component
+    template<VertexAttr::Code ATTR> static void Write(uint8* vertex, float32 x, float32 y, float32 z, float32 w) {
+        comp<ATTR, 4>::format::Pack(vertex + comp<ATTR, 4>::found::Offset, x, y, z, w);
+    }
+};
+
+} // namespace Oryol
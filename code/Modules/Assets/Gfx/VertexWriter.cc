@@ -5,9 +5,159 @@
 #include "VertexWriter.h"
 #include "Core/Assertion.h"
 #include "glm/glm.hpp"
+#include <cstring>
+#if ORYOL_SIMD_SSE
+#include <emmintrin.h>
+#elif ORYOL_SIMD_NEON
+#include <arm_neon.h>
+#endif
 
 namespace Oryol {
 
+#if ORYOL_SIMD_SSE
+//------------------------------------------------------------------------------
+static inline __m128i
+sseRound(__m128 v) {
+    // round half away from zero, like glm::round()
+    const __m128 sign = _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x80000000)));
+    return _mm_cvttps_epi32(_mm_add_ps(v, _mm_or_ps(_mm_set1_ps(0.5f), sign)));
+}
+
+//------------------------------------------------------------------------------
+static inline __m128i
+ssePack(__m128 v, __m128 lo, __m128 hi, __m128 scale) {
+    return sseRound(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, lo), hi), scale));
+}
+
+//------------------------------------------------------------------------------
+static inline void
+sseScatter(uint8* dst, int32 stride, __m128i packed) {
+    uint32 words[4];
+    _mm_storeu_si128((__m128i*)words, packed);
+    for (int32 i = 0; i < 4; i++) {
+        std::memcpy(dst + i * stride, &words[i], sizeof(uint32));
+    }
+}
+
+//------------------------------------------------------------------------------
+static int32
+simdBatchByte4(uint8* dst, int32 stride, const float32* src, int32 srcNumComps, int32 num, bool isSigned) {
+    // with 3 source components the 4th loaded float is masked off, and the
+    // last vertex is left to the scalar code to not read past the source
+    int32 numSimd = (3 == srcNumComps) ? (num - 1) : num;
+    numSimd = (numSimd > 0) ? (numSimd & ~3) : 0;
+    const __m128 mask = _mm_castsi128_ps((3 == srcNumComps) ? _mm_set_epi32(0, -1, -1, -1) : _mm_set1_epi32(-1));
+    const __m128 lo = _mm_set1_ps(isSigned ? -1.0f : 0.0f);
+    const __m128 hi = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(isSigned ? 127.0f : 255.0f);
+    for (int32 i = 0; i < numSimd; i += 4) {
+        const __m128i v0 = ssePack(_mm_and_ps(_mm_loadu_ps(src), mask), lo, hi, scale); src += srcNumComps;
+        const __m128i v1 = ssePack(_mm_and_ps(_mm_loadu_ps(src), mask), lo, hi, scale); src += srcNumComps;
+        const __m128i v2 = ssePack(_mm_and_ps(_mm_loadu_ps(src), mask), lo, hi, scale); src += srcNumComps;
+        const __m128i v3 = ssePack(_mm_and_ps(_mm_loadu_ps(src), mask), lo, hi, scale); src += srcNumComps;
+        const __m128i s01 = _mm_packs_epi32(v0, v1);
+        const __m128i s23 = _mm_packs_epi32(v2, v3);
+        sseScatter(dst, stride, isSigned ? _mm_packs_epi16(s01, s23) : _mm_packus_epi16(s01, s23));
+        dst += 4 * stride;
+    }
+    return numSimd;
+}
+
+//------------------------------------------------------------------------------
+static int32
+simdBatchShort2N(uint8* dst, int32 stride, const float32* src, int32 num) {
+    const int32 numSimd = num & ~3;
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    const __m128 hi = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    for (int32 i = 0; i < numSimd; i += 4) {
+        const __m128i v01 = ssePack(_mm_loadu_ps(src), lo, hi, scale);
+        const __m128i v23 = ssePack(_mm_loadu_ps(src + 4), lo, hi, scale);
+        src += 8;
+        sseScatter(dst, stride, _mm_packs_epi32(v01, v23));
+        dst += 4 * stride;
+    }
+    return numSimd;
+}
+#elif ORYOL_SIMD_NEON
+//------------------------------------------------------------------------------
+static inline int32x4_t
+neonRound(float32x4_t v) {
+    // round half away from zero, like glm::round()
+    const uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000));
+    const float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(0.5f)), sign));
+    return vcvtq_s32_f32(vaddq_f32(v, half));
+}
+
+//------------------------------------------------------------------------------
+static inline int32x4_t
+neonPack(float32x4_t v, float32x4_t lo, float32x4_t hi, float32x4_t scale) {
+    return neonRound(vmulq_f32(vminq_f32(vmaxq_f32(v, lo), hi), scale));
+}
+
+//------------------------------------------------------------------------------
+static inline float32x4_t
+neonLoad(const float32* src, uint32x4_t mask) {
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vld1q_f32(src)), mask));
+}
+
+//------------------------------------------------------------------------------
+static inline void
+neonScatter(uint8* dst, int32 stride, uint32x4_t packed) {
+    uint32 words[4];
+    vst1q_u32(words, packed);
+    for (int32 i = 0; i < 4; i++) {
+        std::memcpy(dst + i * stride, &words[i], sizeof(uint32));
+    }
+}
+
+//------------------------------------------------------------------------------
+static int32
+simdBatchByte4(uint8* dst, int32 stride, const float32* src, int32 srcNumComps, int32 num, bool isSigned) {
+    // see SSE version for details
+    int32 numSimd = (3 == srcNumComps) ? (num - 1) : num;
+    numSimd = (numSimd > 0) ? (numSimd & ~3) : 0;
+    const uint32 maskBits[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, (3 == srcNumComps) ? 0u : 0xFFFFFFFF };
+    const uint32x4_t mask = vld1q_u32(maskBits);
+    const float32x4_t lo = vdupq_n_f32(isSigned ? -1.0f : 0.0f);
+    const float32x4_t hi = vdupq_n_f32(1.0f);
+    const float32x4_t scale = vdupq_n_f32(isSigned ? 127.0f : 255.0f);
+    for (int32 i = 0; i < numSimd; i += 4) {
+        const int32x4_t v0 = neonPack(neonLoad(src, mask), lo, hi, scale); src += srcNumComps;
+        const int32x4_t v1 = neonPack(neonLoad(src, mask), lo, hi, scale); src += srcNumComps;
+        const int32x4_t v2 = neonPack(neonLoad(src, mask), lo, hi, scale); src += srcNumComps;
+        const int32x4_t v3 = neonPack(neonLoad(src, mask), lo, hi, scale); src += srcNumComps;
+        const int16x8_t s01 = vcombine_s16(vqmovn_s32(v0), vqmovn_s32(v1));
+        const int16x8_t s23 = vcombine_s16(vqmovn_s32(v2), vqmovn_s32(v3));
+        if (isSigned) {
+            neonScatter(dst, stride, vreinterpretq_u32_s8(vcombine_s8(vqmovn_s16(s01), vqmovn_s16(s23))));
+        }
+        else {
+            neonScatter(dst, stride, vreinterpretq_u32_u8(vcombine_u8(vqmovun_s16(s01), vqmovun_s16(s23))));
+        }
+        dst += 4 * stride;
+    }
+    return numSimd;
+}
+
+//------------------------------------------------------------------------------
+static int32
+simdBatchShort2N(uint8* dst, int32 stride, const float32* src, int32 num) {
+    const int32 numSimd = num & ~3;
+    const float32x4_t lo = vdupq_n_f32(-1.0f);
+    const float32x4_t hi = vdupq_n_f32(1.0f);
+    const float32x4_t scale = vdupq_n_f32(32767.0f);
+    for (int32 i = 0; i < numSimd; i += 4) {
+        const int32x4_t v01 = neonPack(vld1q_f32(src), lo, hi, scale);
+        const int32x4_t v23 = neonPack(vld1q_f32(src + 4), lo, hi, scale);
+        src += 8;
+        neonScatter(dst, stride, vreinterpretq_u32_s16(vcombine_s16(vqmovn_s32(v01), vqmovn_s32(v23))));
+        dst += 4 * stride;
+    }
+    return numSimd;
+}
+#endif
+
 //------------------------------------------------------------------------------
 uint8*
 VertexWriter::Write(uint8* dst, VertexFormat::Code fmt, float32 x) {
@@ -127,5 +277,69 @@ VertexWriter::Write(uint8* dst, VertexFormat::Code fmt, float32 x, float32 y, fl
     }
 }
     
-} // namespace Oryol
+//------------------------------------------------------------------------------
+void
+VertexWriter::WriteBatchScalar(uint8* dst, int32 dstStride, VertexFormat::Code fmt, const float32* src, int32 srcNumComps, int32 numVertices) {
+    o_assert_dbg(dst && src);
+    o_assert_range_dbg(srcNumComps - 1, 4);
+    switch (srcNumComps) {
+        case 1:
+            for (int32 i = 0; i < numVertices; i++, dst += dstStride, src += 1) {
+                Write(dst, fmt, src[0]);
+            }
+            break;
+        case 2:
+            for (int32 i = 0; i < numVertices; i++, dst += dstStride, src += 2) {
+                Write(dst, fmt, src[0], src[1]);
+            }
+            break;
+        case 3:
+            for (int32 i = 0; i < numVertices; i++, dst += dstStride, src += 3) {
+                Write(dst, fmt, src[0], src[1], src[2]);
+            }
+            break;
+        default:
+            for (int32 i = 0; i < numVertices; i++, dst += dstStride, src += 4) {
+                Write(dst, fmt, src[0], src[1], src[2], src[3]);
+            }
+            break;
+    }
+}
 
+//------------------------------------------------------------------------------
+void
+VertexWriter::WriteBatch(uint8* dst, int32 dstStride, VertexFormat::Code fmt, const float32* src, int32 srcNumComps, int32 numVertices) {
+    o_assert_dbg(dst && src);
+    o_assert_dbg(dstStride >= VertexFormat::ByteSize(fmt));
+    int32 numDone = 0;
+    #if ORYOL_SIMD_SSE || ORYOL_SIMD_NEON
+    if ((VertexFormat::Byte4N == fmt) && (srcNumComps >= 3)) {
+        numDone = simdBatchByte4(dst, dstStride, src, srcNumComps, numVertices, true);
+    }
+    else if ((VertexFormat::UByte4N == fmt) && (srcNumComps >= 3)) {
+        numDone = simdBatchByte4(dst, dstStride, src, srcNumComps, numVertices, false);
+    }
+    else if ((VertexFormat::Short2N == fmt) && (2 == srcNumComps)) {
+        numDone = simdBatchShort2N(dst, dstStride, src, numVertices);
+    }
+    #endif
+    // scalar code path for the remaining vertices and non-vectorized formats
+    if (numDone < numVertices) {
+        WriteBatchScalar(dst + numDone * dstStride, dstStride, fmt,
+            src + numDone * srcNumComps, srcNumComps, numVertices - numDone);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+VertexWriter::WriteBatch(uint8* dst, const VertexLayout& layout, VertexAttr::Code attr, const float32* src, int32 srcNumComps, int32 numVertices) {
+    o_assert_dbg(dst && src);
+    const int32 compIndex = layout.ComponentIndexByVertexAttr(attr);
+    o_assert_dbg(InvalidIndex != compIndex);
+    WriteBatch(dst + layout.ComponentByteOffset(compIndex),
+        layout.ByteSize(),
+        layout.ComponentAt(compIndex).Format,
+        src, srcNumComps, numVertices);
+}
+
+} // namespace Oryol
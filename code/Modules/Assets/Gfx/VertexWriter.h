@@ -4,9 +4,18 @@
     @class Oryol::VertexWriter
     @ingroup Assets
     @brief efficiently write packed vertex components
+
+    The Write() methods pack a single vertex component at a time. For
+    dynamic geometry with many vertices use the WriteBatch() methods
+    instead, these take a whole float source stream (e.g. all positions
+    or all normals of a mesh, tightly packed) and write them into
+    interleaved vertex data, doing the pack-format selection only once
+    per call. The conversions to Byte4N, UByte4N and Short2N are
+    vectorized with SSE2 or NEON where available.
 */
 #include "Core/Types.h"
 #include "Gfx/Core/Enums.h"
+#include "Gfx/Core/VertexLayout.h"
 
 namespace Oryol {
     
@@ -20,6 +29,13 @@ public:
     static uint8* Write(uint8* dst, VertexFormat::Code fmt, float32 x, float32 y, float32 z);
     /// write 4D generic vertex component with run-time pack-format selection
     static uint8* Write(uint8* dst, VertexFormat::Code fmt, float32 x, float32 y, float32 z, float32 w);
+
+    /// batch-write a float stream into a vertex component of interleaved vertices
+    static void WriteBatch(uint8* dst, const VertexLayout& layout, VertexAttr::Code attr, const float32* src, int32 srcNumComps, int32 numVertices);
+    /// batch-write a float stream with explicit pack-format and vertex stride
+    static void WriteBatch(uint8* dst, int32 dstStride, VertexFormat::Code fmt, const float32* src, int32 srcNumComps, int32 numVertices);
+    /// batch-write a float stream without SIMD (reference implementation)
+    static void WriteBatchScalar(uint8* dst, int32 dstStride, VertexFormat::Code fmt, const float32* src, int32 srcNumComps, int32 numVertices);
 };
     
 } // namespace Oryol
\ No newline at end of file
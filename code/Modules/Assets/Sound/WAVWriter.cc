@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//  WAVWriter.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "WAVWriter.h"
+#include "Core/Assertion.h"
+#include "Core/Log.h"
+#include <cstdio>
+
+namespace Oryol {
+
+namespace {
+
+/// write a little-endian 32-bit value
+uint8*
+put32(uint8* ptr, uint32 val) {
+    ptr[0] = uint8(val);
+    ptr[1] = uint8(val >> 8);
+    ptr[2] = uint8(val >> 16);
+    ptr[3] = uint8(val >> 24);
+    return ptr + 4;
+}
+
+/// write a little-endian 16-bit value
+uint8*
+put16(uint8* ptr, uint32 val) {
+    ptr[0] = uint8(val);
+    ptr[1] = uint8(val >> 8);
+    return ptr + 2;
+}
+
+/// write a 4-character chunk id
+uint8*
+putId(uint8* ptr, const char* id) {
+    for (int32 i = 0; i < 4; i++) {
+        ptr[i] = uint8(id[i]);
+    }
+    return ptr + 4;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void
+WAVWriter::WriteHeader(uint8* dst, int32 numSamples, int32 sampleRate, int32 numChannels) {
+    o_assert_dbg(dst);
+    o_assert_dbg((numSamples >= 0) && (sampleRate > 0) && (numChannels > 0));
+    const uint32 blockAlign = numChannels * sizeof(int16);
+    const uint32 dataSize = numSamples * blockAlign;
+    uint8* ptr = dst;
+    ptr = putId(ptr, "RIFF");
+    ptr = put32(ptr, HeaderSize - 8 + dataSize);
+    ptr = putId(ptr, "WAVE");
+    ptr = putId(ptr, "fmt ");
+    ptr = put32(ptr, 16);                       // fmt chunk size
+    ptr = put16(ptr, 1);                        // PCM
+    ptr = put16(ptr, numChannels);
+    ptr = put32(ptr, sampleRate);
+    ptr = put32(ptr, sampleRate * blockAlign);  // bytes per second
+    ptr = put16(ptr, blockAlign);
+    ptr = put16(ptr, 16);                       // bits per sample
+    ptr = putId(ptr, "data");
+    ptr = put32(ptr, dataSize);
+    o_assert_dbg((ptr - dst) == HeaderSize);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The samples are written as they are in memory, all Oryol platforms
+ are little-endian like the WAV format.
+*/
+bool
+WAVWriter::WriteFile(const char* path, const int16* samples, int32 numSamples, int32 sampleRate, int32 numChannels) {
+    o_assert(path);
+    o_assert_dbg(samples || (0 == numSamples));
+    uint8 header[HeaderSize];
+    WriteHeader(header, numSamples, sampleRate, numChannels);
+    FILE* fp = std::fopen(path, "wb");
+    if (nullptr == fp) {
+        o_warn("WAVWriter::WriteFile: failed to open '%s'\n", path);
+        return false;
+    }
+    const size_t num = size_t(numSamples) * numChannels;
+    bool success = HeaderSize == std::fwrite(header, 1, HeaderSize, fp);
+    if (success && (num > 0)) {
+        success = num == std::fwrite(samples, sizeof(int16), num, fp);
+    }
+    std::fclose(fp);
+    return success;
+}
+
+} // namespace Oryol
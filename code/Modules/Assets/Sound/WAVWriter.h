@@ -0,0 +1,27 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::WAVWriter
+    @ingroup Assets
+    @brief write 16-bit PCM samples as WAV data
+
+    Used to save the output of Synth::RenderOffline() and
+    Sound::RenderOffline(), either into memory (WriteHeader() followed
+    by the samples), or directly into a file. Multi-channel samples
+    are interleaved.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class WAVWriter {
+public:
+    /// byte size of the WAV header
+    static const int32 HeaderSize = 44;
+    /// write the header for numSamples samples (per channel) to dst (HeaderSize bytes)
+    static void WriteHeader(uint8* dst, int32 numSamples, int32 sampleRate, int32 numChannels=1);
+    /// write a WAV file, return false on failure
+    static bool WriteFile(const char* path, const int16* samples, int32 numSamples, int32 sampleRate, int32 numChannels=1);
+};
+
+} // namespace Oryol
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+//  MeshLodTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Assets/Gfx/MeshSimplifier.h"
+#include "Assets/Gfx/MeshLodSelector.h"
+#include "Assets/Gfx/OmshParser.h"
+#include "Core/Containers/Array.h"
+#include <cmath>
+
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+TEST(MeshSimplifierTest) {
+
+    // a flat 16x16 quad grid, interior vertices can be removed without error
+    const int32 numQuads = 16;
+    const int32 numVerts = (numQuads + 1) * (numQuads + 1);
+    Array<float32> positions;
+    for (int32 z = 0; z <= numQuads; z++) {
+        for (int32 x = 0; x <= numQuads; x++) {
+            positions.Add(float32(x) - 8.0f);
+            positions.Add(0.0f);
+            positions.Add(float32(z) - 8.0f);
+        }
+    }
+    Array<uint32> indices;
+    for (int32 z = 0; z < numQuads; z++) {
+        for (int32 x = 0; x < numQuads; x++) {
+            const uint32 i0 = z * (numQuads + 1) + x;
+            const uint32 i1 = i0 + 1;
+            const uint32 i2 = i0 + (numQuads + 1);
+            const uint32 i3 = i2 + 1;
+            indices.Add(i0); indices.Add(i2); indices.Add(i1);
+            indices.Add(i1); indices.Add(i2); indices.Add(i3);
+        }
+    }
+    const int32 stride = 3 * sizeof(float32);
+    CHECK(MeshSimplifier::BoundingRadius(&positions[0], stride, numVerts) == std::sqrt(128.0f));
+
+    Array<uint32> lod;
+    const int32 numLodIndices = MeshSimplifier::Simplify(&positions[0], stride, numVerts,
+        &indices[0], indices.Size(), indices.Size() / 4, 1.0e-6f, lod);
+    CHECK(numLodIndices == lod.Size());
+    CHECK((numLodIndices % 3) == 0);
+    CHECK(numLodIndices <= indices.Size() / 4);
+    CHECK(numLodIndices > 0);
+    for (uint32 i : lod) {
+        CHECK(i < uint32(numVerts));
+    }
+    // the border must stay intact, and all triangles must still face up
+    for (int32 i = 0; i < lod.Size(); i += 3) {
+        const float32* p0 = &positions[lod[i] * 3];
+        const float32* p1 = &positions[lod[i + 1] * 3];
+        const float32* p2 = &positions[lod[i + 2] * 3];
+        const float32 ny = (p1[2] - p0[2]) * (p2[0] - p0[0]) - (p1[0] - p0[0]) * (p2[2] - p0[2]);
+        CHECK(ny > 0.0f);
+    }
+    for (uint32 corner : { 0, numQuads, numVerts - 1 - numQuads, numVerts - 1 }) {
+        CHECK(InvalidIndex != lod.FindIndexLinear(corner));
+    }
+
+    // with a tiny max error on a curved surface nothing may be collapsed
+    for (int32 i = 0; i < numVerts; i++) {
+        const float32 x = positions[i * 3];
+        const float32 z = positions[i * 3 + 2];
+        positions[i * 3 + 1] = (x * x + z * z) * 0.1f;
+    }
+    const int32 numCurvedIndices = MeshSimplifier::Simplify(&positions[0], stride, numVerts,
+        &indices[0], indices.Size(), indices.Size() / 4, 1.0e-6f, lod);
+    CHECK(numCurvedIndices == indices.Size());
+}
+
+//------------------------------------------------------------------------------
+TEST(MeshLodSelectorTest) {
+
+    // 'OMSL' file with 3 LODs (primitive groups) and no actual geometry
+    const uint32 data[] = {
+        'OMSL', 0, 4, 0, 2, 0, 3,
+        4, 0, 0,
+        4, 0, 0,
+        4, 0, 0,
+        3, 0x40000000 /*2.0f*/, 0x3F000000 /*0.5f*/, 0x3E800000 /*0.25f*/, 0x3D800000 /*0.0625f*/
+    };
+    MeshSetup setup = MeshSetup::FromData();
+    CHECK(OmshParser::Parse(data, sizeof(data), setup));
+    CHECK(setup.NumPrimitiveGroups() == 3);
+    CHECK(setup.NumLods() == 3);
+    CHECK(setup.BoundingRadius == 2.0f);
+    CHECK(setup.LodMinScreenSize(0) == 0.5f);
+    CHECK(setup.LodMinScreenSize(1) == 0.25f);
+    CHECK(setup.LodMinScreenSize(2) == 0.0625f);
+
+    // a truncated LOD table must fail
+    MeshSetup badSetup = MeshSetup::FromData();
+    CHECK(!OmshParser::Parse(data, sizeof(data) - 4, badSetup));
+
+    MeshLodSelector selector;
+    selector.Setup(setup);
+    selector.SetProjection(1.0f);
+    CHECK(selector.NumLods() == 3);
+    // screen size = 2.0 / distance
+    CHECK(selector.Select(1.0f) == 0);
+    CHECK(selector.Select(4.0f) == 0);
+    CHECK(selector.Select(4.1f) == 1);
+    CHECK(selector.Select(8.0f) == 1);
+    CHECK(selector.Select(8.1f) == 2);
+    CHECK(selector.Select(1000.0f) == 2);
+    // scaled instance
+    CHECK(selector.Select(8.0f, 2.0f) == 0);
+    // LOD bias
+    selector.SetProjection(1.0f, 2.0f);
+    CHECK(selector.Select(8.0f) == 0);
+    CHECK(MeshLodSelector::ScreenSize(2.0f, 4.0f, 1.0f) == 0.5f);
+
+    // a mesh without LODs always selects primitive group 0
+    MeshLodSelector noLods;
+    noLods.Setup(MeshSetup::FromData());
+    noLods.SetProjection(1.0f);
+    CHECK(noLods.Select(1000.0f) == 0);
+}
@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+//  StaticVertexLayoutTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Assets/Gfx/StaticVertexLayout.h"
+#include "Assets/Gfx/VertexWriter.h"
+#include "Core/Memory/Memory.h"
+#include <cstring>
+
+using namespace Oryol;
+
+typedef StaticVertexLayout<
+    VertexComp<VertexAttr::Position, VertexFormat::Float3>,
+    VertexComp<VertexAttr::Normal, VertexFormat::Byte4N>,
+    VertexComp<VertexAttr::TexCoord0, VertexFormat::Short2N>,
+    VertexComp<VertexAttr::Color0, VertexFormat::UByte4N>,
+    VertexComp<VertexAttr::Tangent, VertexFormat::Short4>> testLayout;
+
+//------------------------------------------------------------------------------
+TEST(StaticVertexLayoutTest) {
+
+    static_assert(testLayout::ByteSize == 32, "unexpected StaticVertexLayout::ByteSize");
+    static_assert(testLayout::NumComponents == 5, "unexpected StaticVertexLayout::NumComponents");
+    static_assert(testLayout::Contains<VertexAttr::Normal>::Value, "StaticVertexLayout::Contains failed");
+    static_assert(!testLayout::Contains<VertexAttr::TexCoord1>::Value, "StaticVertexLayout::Contains failed");
+
+    // the run-time layout must be identical
+    const VertexLayout layout = testLayout::Layout();
+    CHECK(layout.NumComponents() == 5);
+    CHECK(layout.ByteSize() == testLayout::ByteSize);
+    CHECK(layout.ComponentAt(0).Attr == VertexAttr::Position);
+    CHECK(layout.ComponentAt(0).Format == VertexFormat::Float3);
+    CHECK(layout.ComponentAt(4).Attr == VertexAttr::Tangent);
+    CHECK(layout.ComponentAt(4).Format == VertexFormat::Short4);
+    CHECK(layout.ComponentByteOffset(0) == testLayout::ComponentByteOffset<VertexAttr::Position>::Value);
+    CHECK(layout.ComponentByteOffset(1) == testLayout::ComponentByteOffset<VertexAttr::Normal>::Value);
+    CHECK(layout.ComponentByteOffset(2) == testLayout::ComponentByteOffset<VertexAttr::TexCoord0>::Value);
+    CHECK(layout.ComponentByteOffset(3) == testLayout::ComponentByteOffset<VertexAttr::Color0>::Value);
+    CHECK(layout.ComponentByteOffset(4) == testLayout::ComponentByteOffset<VertexAttr::Tangent>::Value);
+    CHECK(layout.Hash() == VertexLayout()
+        .Add(VertexAttr::Position, VertexFormat::Float3)
+        .Add(VertexAttr::Normal, VertexFormat::Byte4N)
+        .Add(VertexAttr::TexCoord0, VertexFormat::Short2N)
+        .Add(VertexAttr::Color0, VertexFormat::UByte4N)
+        .Add(VertexAttr::Tangent, VertexFormat::Short4).Hash());
+
+    // written vertices must be identical with VertexWriter output
+    uint8 staticData[4 * testLayout::ByteSize];
+    uint8 dynamicData[4 * testLayout::ByteSize];
+    Memory::Clear(staticData, sizeof(staticData));
+    Memory::Clear(dynamicData, sizeof(dynamicData));
+    for (int32 i = 0; i < 4; i++) {
+        const float32 f = float32(i) * 0.5f - 1.0f;
+        uint8* ptr = testLayout::VertexPtr(staticData, i);
+        testLayout::Write<VertexAttr::Position>(ptr, f, f * 2.0f, f * 3.0f);
+        testLayout::Write<VertexAttr::Normal>(ptr, f, -f, 0.5f);
+        testLayout::Write<VertexAttr::TexCoord0>(ptr, f * 2.0f, -0.25f);
+        testLayout::Write<VertexAttr::Color0>(ptr, f, 0.5f, 1.0f, -f);
+        testLayout::Write<VertexAttr::Tangent>(ptr, f * 40000.0f, 1.0f, -2.0f, 100.0f);
+
+        ptr = dynamicData + i * layout.ByteSize();
+        ptr = VertexWriter::Write(ptr, VertexFormat::Float3, f, f * 2.0f, f * 3.0f);
+        ptr = VertexWriter::Write(ptr, VertexFormat::Byte4N, f, -f, 0.5f);
+        ptr = VertexWriter::Write(ptr, VertexFormat::Short2N, f * 2.0f, -0.25f);
+        ptr = VertexWriter::Write(ptr, VertexFormat::UByte4N, f, 0.5f, 1.0f, -f);
+        VertexWriter::Write(ptr, VertexFormat::Short4, f * 40000.0f, 1.0f, -2.0f, 100.0f);
+    }
+    CHECK(0 == std::memcmp(staticData, dynamicData, sizeof(staticData)));
+}
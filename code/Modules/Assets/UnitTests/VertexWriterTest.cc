@@ -5,6 +5,10 @@
 #include "UnitTest++/src/UnitTest++.h"
 #include "Assets/Gfx/VertexWriter.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Log.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 
 using namespace Oryol;
 
@@ -128,4 +132,111 @@ TEST(VertexWriterTest) {
     CHECK(i16p[5] == 16384);
     CHECK(i16p[6] == 0);
     CHECK(i16p[7] == 0);
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------
+TEST(VertexWriterBatchTest) {
+
+    // vertex count not a multiple of 4 to also test the scalar tail
+    const int32 numVerts = 13;
+    VertexLayout layout;
+    layout.Add(VertexAttr::Position, VertexFormat::Float3)
+        .Add(VertexAttr::Normal, VertexFormat::Byte4N)
+        .Add(VertexAttr::TexCoord0, VertexFormat::Short2N)
+        .Add(VertexAttr::Color0, VertexFormat::UByte4N);
+    const int32 stride = layout.ByteSize();
+
+    float32 pos[numVerts * 3];
+    float32 norm[numVerts * 3];
+    float32 uv[numVerts * 2];
+    float32 color[numVerts * 4];
+    for (int32 i = 0; i < numVerts * 4; i++) {
+        const float32 f = float32((i % 9) - 4) * 0.25f;
+        if (i < numVerts * 3) {
+            pos[i] = f * 10.0f;
+            norm[i] = f;
+        }
+        if (i < numVerts * 2) {
+            uv[i] = f;
+        }
+        color[i] = f;
+    }
+
+    uint8 batch[numVerts * 32];
+    uint8 single[numVerts * 32];
+    Memory::Clear(batch, sizeof(batch));
+    Memory::Clear(single, sizeof(single));
+    VertexWriter::WriteBatch(batch, layout, VertexAttr::Position, pos, 3, numVerts);
+    VertexWriter::WriteBatch(batch, layout, VertexAttr::Normal, norm, 3, numVerts);
+    VertexWriter::WriteBatch(batch, layout, VertexAttr::TexCoord0, uv, 2, numVerts);
+    VertexWriter::WriteBatch(batch, layout, VertexAttr::Color0, color, 4, numVerts);
+    for (int32 i = 0; i < numVerts; i++) {
+        uint8* ptr = single + i * stride;
+        ptr = VertexWriter::Write(ptr, VertexFormat::Float3, pos[i*3], pos[i*3+1], pos[i*3+2]);
+        ptr = VertexWriter::Write(ptr, VertexFormat::Byte4N, norm[i*3], norm[i*3+1], norm[i*3+2]);
+        ptr = VertexWriter::Write(ptr, VertexFormat::Short2N, uv[i*2], uv[i*2+1]);
+        ptr = VertexWriter::Write(ptr, VertexFormat::UByte4N, color[i*4], color[i*4+1], color[i*4+2], color[i*4+3]);
+        CHECK(ptr == (single + (i + 1) * stride));
+    }
+    CHECK(0 == std::memcmp(batch, single, numVerts * stride));
+}
+
+//------------------------------------------------------------------------------
+TEST(VertexWriterBatchPerformance) {
+
+    const int32 numVerts = 100000;
+    VertexLayout layout;
+    layout.Add(VertexAttr::Position, VertexFormat::Float3)
+        .Add(VertexAttr::Normal, VertexFormat::Byte4N)
+        .Add(VertexAttr::TexCoord0, VertexFormat::Short2N);
+    const int32 stride = layout.ByteSize();
+    const int32 posOffset = layout.ComponentByteOffset(layout.ComponentIndexByVertexAttr(VertexAttr::Position));
+    const int32 normOffset = layout.ComponentByteOffset(layout.ComponentIndexByVertexAttr(VertexAttr::Normal));
+    const int32 uvOffset = layout.ComponentByteOffset(layout.ComponentIndexByVertexAttr(VertexAttr::TexCoord0));
+
+    float32* pos = (float32*) Memory::Alloc(numVerts * 3 * sizeof(float32));
+    float32* norm = (float32*) Memory::Alloc(numVerts * 3 * sizeof(float32));
+    float32* uv = (float32*) Memory::Alloc(numVerts * 2 * sizeof(float32));
+    uint8* dst = (uint8*) Memory::Alloc(numVerts * stride);
+    for (int32 i = 0; i < numVerts * 3; i++) {
+        pos[i] = float32(std::rand()) / float32(RAND_MAX) * 100.0f;
+        norm[i] = float32(std::rand()) / float32(RAND_MAX) * 2.0f - 1.0f;
+        if (i < numVerts * 2) {
+            uv[i] = float32(std::rand()) / float32(RAND_MAX);
+        }
+    }
+
+    for (int32 i = 0; i < 3; i++) {
+        std::chrono::time_point<std::chrono::system_clock> start, end;
+        start = std::chrono::system_clock::now();
+        for (int32 v = 0; v < numVerts; v++) {
+            VertexWriter::Write(dst + v * stride + posOffset, VertexFormat::Float3, pos[v*3], pos[v*3+1], pos[v*3+2]);
+            VertexWriter::Write(dst + v * stride + normOffset, VertexFormat::Byte4N, norm[v*3], norm[v*3+1], norm[v*3+2]);
+            VertexWriter::Write(dst + v * stride + uvOffset, VertexFormat::Short2N, uv[v*2], uv[v*2+1]);
+        }
+        end = std::chrono::system_clock::now();
+        std::chrono::duration<double> dur = end - start;
+        Log::Info("run %d: %d vertices packed per component: %f sec\n", i, numVerts, dur.count());
+
+        start = std::chrono::system_clock::now();
+        VertexWriter::WriteBatchScalar(dst + posOffset, stride, VertexFormat::Float3, pos, 3, numVerts);
+        VertexWriter::WriteBatchScalar(dst + normOffset, stride, VertexFormat::Byte4N, norm, 3, numVerts);
+        VertexWriter::WriteBatchScalar(dst + uvOffset, stride, VertexFormat::Short2N, uv, 2, numVerts);
+        end = std::chrono::system_clock::now();
+        dur = end - start;
+        Log::Info("run %d: %d vertices packed with WriteBatchScalar: %f sec\n", i, numVerts, dur.count());
+
+        start = std::chrono::system_clock::now();
+        VertexWriter::WriteBatch(dst, layout, VertexAttr::Position, pos, 3, numVerts);
+        VertexWriter::WriteBatch(dst, layout, VertexAttr::Normal, norm, 3, numVerts);
+        VertexWriter::WriteBatch(dst, layout, VertexAttr::TexCoord0, uv, 2, numVerts);
+        end = std::chrono::system_clock::now();
+        dur = end - start;
+        Log::Info("run %d: %d vertices packed with WriteBatch: %f sec\n", i, numVerts, dur.count());
+    }
+
+    Memory::Free(dst);
+    Memory::Free(uv);
+    Memory::Free(norm);
+    Memory::Free(pos);
+}
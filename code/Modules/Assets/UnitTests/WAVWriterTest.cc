@@ -0,0 +1,32 @@
+//------------------------------------------------------------------------------
+//  WAVWriterTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Assets/Sound/WAVWriter.h"
+#include <cstring>
+
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+TEST(WAVWriterTest) {
+    uint8 header[WAVWriter::HeaderSize];
+    WAVWriter::WriteHeader(header, 1000, 44100, 2);
+    CHECK(0 == std::memcmp(header, "RIFF", 4));
+    CHECK(0 == std::memcmp(header + 8, "WAVEfmt ", 8));
+    CHECK(0 == std::memcmp(header + 36, "data", 4));
+    // RIFF size: 36 + data size
+    const uint32 riffSize = header[4] | (header[5] << 8) | (header[6] << 16) | (header[7] << 24);
+    CHECK(riffSize == 36 + 4000);
+    // PCM, 2 channels, 44100Hz
+    CHECK((header[20] == 1) && (header[21] == 0));
+    CHECK((header[22] == 2) && (header[23] == 0));
+    const uint32 rate = header[24] | (header[25] << 8) | (header[26] << 16) | (header[27] << 24);
+    CHECK(rate == 44100);
+    const uint32 byteRate = header[28] | (header[29] << 8) | (header[30] << 16) | (header[31] << 24);
+    CHECK(byteRate == 44100 * 4);
+    // block align 4, 16 bits per sample
+    CHECK((header[32] == 4) && (header[34] == 16));
+    const uint32 dataSize = header[40] | (header[41] << 8) | (header[42] << 16) | (header[43] << 24);
+    CHECK(dataSize == 4000);
+}
@@ -39,6 +39,18 @@
 #define ORYOL_MAX_PLATFORM_ALIGN (16)
 #endif
 
+// SIMD instruction set availability (scalar code paths must always exist)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ORYOL_SIMD_SSE (1)
+#define ORYOL_SIMD_NEON (0)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ORYOL_SIMD_SSE (0)
+#define ORYOL_SIMD_NEON (1)
+#else
+#define ORYOL_SIMD_SSE (0)
+#define ORYOL_SIMD_NEON (0)
+#endif
+
 /// memory debug fill pattern (byte)
 #define ORYOL_MEMORY_DEBUG_BYTE (0xBB)
 /// memory debug fill pattern (short)
@@ -50,6 +62,8 @@
 #define ORYOL_CONTAINER_DEFAULT_MIN_GROW (16)
 /// maximum grow size for dynamic container classes (num elements)
 #define ORYOL_CONTAINER_DEFAULT_MAX_GROW (1<<16)
+/// alignment of the per-field streams in SoaArray (bytes)
+#define ORYOL_CONTAINER_STREAM_ALIGN (64)
 
 #ifndef __GNUC__
 #define __attribute__(x)
@@ -57,6 +57,10 @@ public:
     TYPE& Back();
     /// read-only access to first element
     const TYPE& Back() const;
+    /// read/write access to an element, 0 is the front
+    TYPE& operator[](int32 index);
+    /// read-only access to an element, 0 is the front
+    const TYPE& operator[](int32 index) const;
     
     /// copy-enqueue an element
     void Enqueue(const TYPE& elm);
@@ -69,6 +73,8 @@ public:
     TYPE Dequeue();
     /// dequeue into existing element
     void Dequeue(TYPE& outElm);
+    /// erase an element anywhere in the queue, 0 is the front
+    void Erase(int32 index);
     
 private:
     /// destroy contained resource
@@ -323,6 +329,24 @@ Queue<TYPE>::Dequeue(TYPE& outElm) {
     outElm = std::move(this->buffer.popFront());
 }
 
+//------------------------------------------------------------------------------
+template<class TYPE> void
+Queue<TYPE>::Erase(int32 index) {
+    this->buffer.erase(index);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE&
+Queue<TYPE>::operator[](int32 index) {
+    return this->buffer[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> const TYPE&
+Queue<TYPE>::operator[](int32 index) const {
+    return this->buffer[index];
+}
+
 //------------------------------------------------------------------------------
 template<class TYPE> TYPE&
 Queue<TYPE>::Front() {
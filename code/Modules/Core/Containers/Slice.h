@@ -0,0 +1,100 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Slice
+    @ingroup Core
+    @brief non-owning view of a contiguous range of elements
+
+    A Slice is a pointer and a number of elements. It doesn't own the
+    elements, and becomes invalid when the owner reallocates or
+    goes away. Use Slice<const TYPE> for read-only views.
+
+    @see SoaArray
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+
+template<class TYPE> class Slice {
+public:
+    /// default constructor, empty slice
+    Slice() = default;
+    /// construct from pointer and number of elements
+    Slice(TYPE* ptr, int32 size);
+    /// construct read-only slice from read/write slice
+    template<class OTHER> Slice(const Slice<OTHER>& rhs);
+
+    /// get number of elements
+    int32 Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// access single element
+    TYPE& operator[](int32 index) const;
+    /// get pointer to first element
+    TYPE* Data() const;
+
+    /// C++ conform begin
+    TYPE* begin() const;
+    /// C++ conform end
+    TYPE* end() const;
+
+private:
+    TYPE* ptr = nullptr;
+    int32 size = 0;
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+Slice<TYPE>::Slice(TYPE* ptr_, int32 size_) :
+ptr(ptr_),
+size(size_) {
+    o_assert_dbg((size >= 0) && (ptr || (0 == size)));
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> template<class OTHER>
+Slice<TYPE>::Slice(const Slice<OTHER>& rhs) :
+ptr(rhs.Data()),
+size(rhs.Size()) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int32
+Slice<TYPE>::Size() const {
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+Slice<TYPE>::Empty() const {
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE&
+Slice<TYPE>::operator[](int32 index) const {
+    o_assert_dbg((index >= 0) && (index < this->size));
+    return this->ptr[index];
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+Slice<TYPE>::Data() const {
+    return this->ptr;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+Slice<TYPE>::begin() const {
+    return this->ptr;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+Slice<TYPE>::end() const {
+    return this->ptr + this->size;
+}
+
+} // namespace Oryol
@@ -0,0 +1,399 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SoaArray
+    @ingroup Core
+    @brief dynamic structure-of-arrays container
+
+    A SoaArray<FIELDS...> stores each field of its elements in a separate
+    stream, so that a loop which only touches some fields of all elements
+    (e.g. updating particle positions from velocities) streams through
+    tightly packed memory and is easy to vectorize:
+
+    @code
+    SoaArray<glm::vec4, glm::vec4, float32> particles;
+    particles.Add(pos, vel, 1.0f);
+    Slice<glm::vec4> positions = particles.Stream<0>();
+    Slice<const glm::vec4> velocities = particles.Stream<1>();
+    for (int32 i = 0; i < particles.Size(); i++) {
+        positions[i] += velocities[i] * dt;
+    }
+    @endcode
+
+    All streams live in a single allocation, each stream starts at
+    an ORYOL_CONTAINER_STREAM_ALIGN byte boundary. The capacity
+    is always a multiple of CapacityGranularity, so SIMD loops can run
+    over whole blocks up to Capacity() without a scalar remainder loop
+    (the elements behind Size() have undefined values).
+
+    Fields must be trivially copyable, elements are moved with memcpy
+    and are never constructed or destroyed. New elements created with
+    Resize() are zero-initialized. Element order is not preserved when
+    erasing.
+
+    Operations which add elements may reallocate the streams, this
+    invalidates all Slices and references into the array.
+
+    @see Array, Slice
+*/
+#include "Core/Config.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Containers/Slice.h"
+#include <tuple>
+#include <type_traits>
+
+namespace Oryol {
+
+namespace _priv {
+/// true if all types in TYPES are trivially copyable
+template<class... TYPES> struct soaTriviallyCopyable : std::true_type { };
+template<class TYPE, class... REST> struct soaTriviallyCopyable<TYPE, REST...> :
+    std::integral_constant<bool, std::is_trivially_copyable<TYPE>::value && soaTriviallyCopyable<REST...>::value> { };
+} // namespace _priv
+
+template<class... FIELDS> class SoaArray {
+    static_assert(sizeof...(FIELDS) > 0, "SoaArray needs at least one field");
+    static_assert(_priv::soaTriviallyCopyable<FIELDS...>::value, "SoaArray fields must be trivially copyable");
+public:
+    /// number of fields (streams) per element
+    static const int32 NumFields = sizeof...(FIELDS);
+    /// capacity is always a multiple of this number of elements
+    static const int32 CapacityGranularity = 16;
+    /// type of field INDEX
+    template<int32 INDEX> using Field = typename std::tuple_element<INDEX, std::tuple<FIELDS...>>::type;
+
+    /// default constructor
+    SoaArray();
+    /// copy constructor (truncates capacity to size)
+    SoaArray(const SoaArray& rhs);
+    /// move constructor
+    SoaArray(SoaArray&& rhs);
+    /// destructor
+    ~SoaArray();
+
+    /// copy-assignment operator (truncates capacity to size)
+    void operator=(const SoaArray& rhs);
+    /// move-assignment operator
+    void operator=(SoaArray&& rhs);
+
+    /// set allocation strategy
+    void SetAllocStrategy(int32 minGrow_, int32 maxGrow_=ORYOL_CONTAINER_DEFAULT_MAX_GROW);
+    /// get number of elements
+    int32 Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// get capacity
+    int32 Capacity() const;
+
+    /// increase capacity to hold at least numElements more elements
+    void Reserve(int32 numElements);
+    /// grow or shrink number of elements, new elements are zero-initialized
+    void Resize(int32 newSize);
+    /// remove all elements (keeps capacity)
+    void Clear();
+    /// add an element to the back, return its index
+    int32 Add(const FIELDS&... values);
+    /// erase element at index, swap-in the last element (destroys element ordering)
+    void EraseSwap(int32 index);
+
+    /// read/write access to one field of an element
+    template<int32 INDEX> Field<INDEX>& Get(int32 index);
+    /// read-only access to one field of an element
+    template<int32 INDEX> const Field<INDEX>& Get(int32 index) const;
+    /// read/write access to the stream of one field
+    template<int32 INDEX> Slice<Field<INDEX>> Stream();
+    /// read-only access to the stream of one field
+    template<int32 INDEX> Slice<const Field<INDEX>> Stream() const;
+
+private:
+    /// get byte size of field
+    static int32 fieldSize(int32 fieldIndex);
+    /// get byte size of one stream with capacity elements
+    static int32 streamSize(int32 fieldIndex, int32 capacity);
+    /// reallocate with new capacity
+    void adjustCapacity(int32 newCapacity);
+    /// grow to make room for at least one more element
+    void grow();
+    /// free memory
+    void destroy();
+    /// copy from other array
+    void copy(const SoaArray& rhs);
+    /// move from other array
+    void move(SoaArray&& rhs);
+    /// write field values of the element at index (recursion end)
+    template<int32 INDEX> void setFields(int32 index);
+    /// write field values of the element at index
+    template<int32 INDEX, class TYPE, class... REST> void setFields(int32 index, const TYPE& value, const REST&... rest);
+
+    uint8* streams[NumFields];
+    int32 size = 0;
+    int32 capacity = 0;
+    int32 minGrow = ORYOL_CONTAINER_DEFAULT_MIN_GROW;
+    int32 maxGrow = ORYOL_CONTAINER_DEFAULT_MAX_GROW;
+};
+
+//------------------------------------------------------------------------------
+template<class... FIELDS>
+SoaArray<FIELDS...>::SoaArray() {
+    for (int32 i = 0; i < NumFields; i++) {
+        this->streams[i] = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS>
+SoaArray<FIELDS...>::SoaArray(const SoaArray& rhs) {
+    this->copy(rhs);
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS>
+SoaArray<FIELDS...>::SoaArray(SoaArray&& rhs) {
+    this->move(std::move(rhs));
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS>
+SoaArray<FIELDS...>::~SoaArray() {
+    this->destroy();
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::operator=(const SoaArray& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        this->copy(rhs);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::operator=(SoaArray&& rhs) {
+    if (&rhs != this) {
+        this->destroy();
+        this->move(std::move(rhs));
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::SetAllocStrategy(int32 minGrow_, int32 maxGrow_) {
+    this->minGrow = minGrow_;
+    this->maxGrow = maxGrow_;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> int32
+SoaArray<FIELDS...>::Size() const {
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> bool
+SoaArray<FIELDS...>::Empty() const {
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> int32
+SoaArray<FIELDS...>::Capacity() const {
+    return this->capacity;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::Reserve(int32 numElements) {
+    const int32 newCapacity = this->size + numElements;
+    if (newCapacity > this->capacity) {
+        this->adjustCapacity(newCapacity);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::Resize(int32 newSize) {
+    o_assert_dbg(newSize >= 0);
+    if (newSize > this->capacity) {
+        this->adjustCapacity(newSize);
+    }
+    if (newSize > this->size) {
+        for (int32 i = 0; i < NumFields; i++) {
+            const int32 elmSize = fieldSize(i);
+            Memory::Clear(this->streams[i] + this->size * elmSize, (newSize - this->size) * elmSize);
+        }
+    }
+    this->size = newSize;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::Clear() {
+    this->size = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> int32
+SoaArray<FIELDS...>::Add(const FIELDS&... values) {
+    if (this->size == this->capacity) {
+        this->grow();
+    }
+    this->setFields<0>(this->size, values...);
+    return this->size++;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::EraseSwap(int32 index) {
+    o_assert_dbg((index >= 0) && (index < this->size));
+    const int32 last = this->size - 1;
+    if (index != last) {
+        for (int32 i = 0; i < NumFields; i++) {
+            const int32 elmSize = fieldSize(i);
+            Memory::Copy(this->streams[i] + last * elmSize, this->streams[i] + index * elmSize, elmSize);
+        }
+    }
+    this->size = last;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> template<int32 INDEX> typename SoaArray<FIELDS...>::template Field<INDEX>&
+SoaArray<FIELDS...>::Get(int32 index) {
+    o_assert_dbg((index >= 0) && (index < this->size));
+    return ((Field<INDEX>*)this->streams[INDEX])[index];
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> template<int32 INDEX> const typename SoaArray<FIELDS...>::template Field<INDEX>&
+SoaArray<FIELDS...>::Get(int32 index) const {
+    o_assert_dbg((index >= 0) && (index < this->size));
+    return ((const Field<INDEX>*)this->streams[INDEX])[index];
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> template<int32 INDEX> Slice<typename SoaArray<FIELDS...>::template Field<INDEX>>
+SoaArray<FIELDS...>::Stream() {
+    return Slice<Field<INDEX>>((Field<INDEX>*)this->streams[INDEX], this->size);
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> template<int32 INDEX> Slice<const typename SoaArray<FIELDS...>::template Field<INDEX>>
+SoaArray<FIELDS...>::Stream() const {
+    return Slice<const Field<INDEX>>((const Field<INDEX>*)this->streams[INDEX], this->size);
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> int32
+SoaArray<FIELDS...>::fieldSize(int32 fieldIndex) {
+    static const int32 sizes[NumFields] = { int32(sizeof(FIELDS))... };
+    return sizes[fieldIndex];
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> int32
+SoaArray<FIELDS...>::streamSize(int32 fieldIndex, int32 capacity) {
+    return Memory::RoundUp(capacity * fieldSize(fieldIndex), ORYOL_CONTAINER_STREAM_ALIGN);
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::adjustCapacity(int32 newCapacity) {
+    o_assert_dbg(newCapacity >= this->size);
+    newCapacity = Memory::RoundUp(newCapacity, CapacityGranularity);
+    if (newCapacity == this->capacity) {
+        return;
+    }
+
+    // all streams go into one allocation (owned by the first stream),
+    // and each stream starts at an aligned address
+    int32 allocSize = 0;
+    for (int32 i = 0; i < NumFields; i++) {
+        allocSize += streamSize(i, newCapacity);
+    }
+    uint8* oldBuffer = this->streams[0];
+    uint8* ptr = (uint8*) Memory::AllocAligned(allocSize, ORYOL_CONTAINER_STREAM_ALIGN);
+    for (int32 i = 0; i < NumFields; i++) {
+        if (this->size > 0) {
+            Memory::Copy(this->streams[i], ptr, this->size * fieldSize(i));
+        }
+        this->streams[i] = ptr;
+        ptr += streamSize(i, newCapacity);
+    }
+    Memory::FreeAligned(oldBuffer);
+    this->capacity = newCapacity;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::grow() {
+    int32 growBy = this->capacity >> 1;
+    if (growBy < this->minGrow) {
+        growBy = this->minGrow;
+    }
+    else if (growBy > this->maxGrow) {
+        growBy = this->maxGrow;
+    }
+    o_assert_dbg(growBy > 0);
+    this->adjustCapacity(this->capacity + growBy);
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::destroy() {
+    Memory::FreeAligned(this->streams[0]);
+    for (int32 i = 0; i < NumFields; i++) {
+        this->streams[i] = nullptr;
+    }
+    this->size = 0;
+    this->capacity = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::copy(const SoaArray& rhs) {
+    for (int32 i = 0; i < NumFields; i++) {
+        this->streams[i] = nullptr;
+    }
+    this->size = 0;
+    this->capacity = 0;
+    this->minGrow = rhs.minGrow;
+    this->maxGrow = rhs.maxGrow;
+    if (rhs.size > 0) {
+        this->adjustCapacity(rhs.size);
+        for (int32 i = 0; i < NumFields; i++) {
+            Memory::Copy(rhs.streams[i], this->streams[i], rhs.size * fieldSize(i));
+        }
+        this->size = rhs.size;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> void
+SoaArray<FIELDS...>::move(SoaArray&& rhs) {
+    for (int32 i = 0; i < NumFields; i++) {
+        this->streams[i] = rhs.streams[i];
+        rhs.streams[i] = nullptr;
+    }
+    this->size = rhs.size;
+    this->capacity = rhs.capacity;
+    this->minGrow = rhs.minGrow;
+    this->maxGrow = rhs.maxGrow;
+    rhs.size = 0;
+    rhs.capacity = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> template<int32 INDEX> void
+SoaArray<FIELDS...>::setFields(int32 /*index*/) {
+    // empty, end of recursion
+}
+
+//------------------------------------------------------------------------------
+template<class... FIELDS> template<int32 INDEX, class TYPE, class... REST> void
+SoaArray<FIELDS...>::setFields(int32 index, const TYPE& value, const REST&... rest) {
+    ((TYPE*)this->streams[INDEX])[index] = value;
+    this->setFields<INDEX + 1>(index, rest...);
+}
+
+} // namespace Oryol
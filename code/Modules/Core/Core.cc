@@ -5,6 +5,7 @@
 #include "Core.h"
 #include "Core/RunLoop.h"
 #include "Core/Ptr.h"
+#include "Core/Threading/WorkerPool.h"
 
 namespace Oryol {
     
@@ -28,6 +29,9 @@ Core::Setup() {
     ptr = RunLoop::Create();
     ptr->addRef();
     threadPostRunLoop = ptr.get();
+
+    // setup the worker pool for parallel runloop phases
+    WorkerPool::Setup();
 }
 
 //------------------------------------------------------------------------------
@@ -37,6 +41,7 @@ Core::Discard() {
     o_assert(threadPreRunLoop);
     o_assert(threadPostRunLoop);
     
+    WorkerPool::Discard();
     threadPreRunLoop->release();
     threadPreRunLoop = nullptr;
     threadPostRunLoop->release();
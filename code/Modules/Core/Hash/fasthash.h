@@ -32,6 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #include "Core/Types.h"
+#include <cstring>
 
 namespace Oryol {
 namespace _priv {
@@ -59,7 +60,8 @@ fasthash64(const void *buf, size_t len, uint64 seed)
     uint64 v;
 
     while (pos != end) {
-        v = *pos++;
+        // buf may be unaligned, memcpy compiles to a plain load
+        std::memcpy(&v, pos++, sizeof(v));
         h ^= fasthash_mix(v);
         h *= m;
     }
@@ -6,6 +6,7 @@
 #include "Core/Log.h"
 #include "Core/Assertion.h"
 #include "Core/Logger.h"
+#include "Core/logQueue.h"
 #include "Core/Threading/RWLock.h"
 #include "Core/Containers/Array.h"
 #if ORYOL_WINDOWS
@@ -109,9 +110,71 @@ Log::Error(const char* msg, ...) {
     }
 }
 
+//------------------------------------------------------------------------------
+void
+Log::StartAsync(AsyncPolicy policy, int32 bufferSize) {
+    logQueue::Start(policy, bufferSize, &Log::write);
+}
+
+//------------------------------------------------------------------------------
+void
+Log::StopAsync() {
+    logQueue::Stop();
+}
+
+//------------------------------------------------------------------------------
+bool
+Log::IsAsync() {
+    return logQueue::IsRunning();
+}
+
+//------------------------------------------------------------------------------
+void
+Log::Flush() {
+    logQueue::Flush();
+}
+
+//------------------------------------------------------------------------------
+Log::AsyncStats
+Log::GetAsyncStats() {
+    return logQueue::Stats();
+}
+
 //------------------------------------------------------------------------------
 void
 Log::vprint(Level lvl, const char* msg, va_list args) {
+    if (logQueue::IsRunning()) {
+        if (Level::Error != lvl) {
+            if (logQueue::Put(lvl, msg, args)) {
+                return;
+            }
+        }
+        else {
+            // errors are usually followed by a trap, so write them right away
+            logQueue::Flush();
+        }
+    }
+    Log::vwrite(lvl, msg, args);
+}
+
+//------------------------------------------------------------------------------
+static void
+writeFormatted(Log::Level lvl, void (*vwriteFunc)(Log::Level, const char*, va_list), const char* msg, ...) {
+    va_list args;
+    va_start(args, msg);
+    vwriteFunc(lvl, msg, args);
+    va_end(args);
+}
+
+//------------------------------------------------------------------------------
+void
+Log::write(Level lvl, const char* str) {
+    writeFormatted(lvl, &Log::vwrite, "%s", str);
+}
+
+//------------------------------------------------------------------------------
+void
+Log::vwrite(Level lvl, const char* msg, va_list args) {
     lock.LockRead();
     if (loggers.Empty()) {
         #if ORYOL_ANDROID
@@ -168,6 +231,7 @@ Log::vprint(Level lvl, const char* msg, va_list args) {
 //------------------------------------------------------------------------------
 void
 Log::AssertMsg(const char* cond, const char* msg, const char* file, int32 line, const char* func) {
+    logQueue::Flush();
     lock.LockRead();
     if (loggers.Empty()) {
         #if ORYOL_ANDROID
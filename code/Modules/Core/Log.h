@@ -9,6 +9,16 @@
     output is logged to stdout and stderr, but custom Logger objects
     can be attached to handle log output differently.
 
+    By default, messages are formatted and written on the calling thread.
+    After Log::StartAsync(), the calling thread only records the format
+    string and the raw arguments into a per-thread buffer. A background
+    thread formats them and writes them to the loggers. Errors and assert
+    messages are always written synchronously, after all pending messages
+    have been flushed. Since only the pointer to the format string is
+    recorded, the format string of Dbg(), Info() and Warn() must live in
+    static storage (e.g. a string literal), pass dynamic text as a "%s"
+    argument instead, string arguments are copied.
+
     @see Logger
 */
 #include <cstdarg>
@@ -34,6 +44,23 @@ public:
         InvalidLevel
     };
 
+    /// what to do when a thread's async log buffer is full
+    enum class AsyncPolicy {
+        Drop,       ///< drop the message
+        Block,      ///< wait until the log thread has made room
+    };
+    /// async logging statistics
+    struct AsyncStats {
+        /// number of messages written by the log thread
+        int64 NumRecords = 0;
+        /// number of messages dropped because a buffer was full
+        int64 NumDropped = 0;
+        /// number of times a thread had to wait for buffer space
+        int64 NumBlocked = 0;
+        /// number of messages with arguments cut off
+        int64 NumTruncated = 0;
+    };
+
     /// add a logger object
     static void AddLogger(const Ptr<Logger>& p);
     /// get number of loggers
@@ -45,20 +72,35 @@ public:
     static void SetLogLevel(Level l);
     /// get current log level
     static Level GetLogLevel();
-    /// print a debug message
+    /// print a debug message (msg must be static, e.g. a string literal)
     static void Dbg(const char* msg, ...) __attribute__((format(printf, 1, 2)));
-    /// print an info message
+    /// print an info message (msg must be static, e.g. a string literal)
     static void Info(const char* msg, ...) __attribute__((format(printf, 1, 2)));
-    /// print a warning
+    /// print a warning (msg must be static, e.g. a string literal)
     static void Warn(const char* msg, ...) __attribute__((format(printf, 1, 2)));
     /// print an error (use o_error() macro to also abort the program)
     static void Error(const char* msg, ...) __attribute__((format(printf, 1, 2)));
     /// print an assert message
     static void AssertMsg(const char* cond, const char* msg, const char* file, int32 line, const char* func);
 
+    /// start async logging (bufferSize is per thread, must be a power of 2)
+    static void StartAsync(AsyncPolicy policy = AsyncPolicy::Drop, int32 bufferSize = 64 * 1024);
+    /// stop async logging, pending messages are written first
+    static void StopAsync();
+    /// test if async logging is active
+    static bool IsAsync();
+    /// block until all messages logged so far have been written
+    static void Flush();
+    /// get async logging statistics
+    static AsyncStats GetAsyncStats();
+
 private:
     /// generic vprint-style method
     static void vprint(Level l, const char* msg, va_list args) __attribute__((format(printf, 2, 0)));
+    /// synchronously write to loggers or default output
+    static void vwrite(Level l, const char* msg, va_list args) __attribute__((format(printf, 2, 0)));
+    /// write a formatted message, called from the async log thread
+    static void write(Level l, const char* str);
 };
 
 /// shortcut for Log::Dbg()
@@ -0,0 +1,240 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::HandlePool
+    @ingroup Core
+    @brief thread-safe object pool with generational handles
+
+    A HandlePool constructs objects in place and hands out 32-bit
+    handles instead of pointers. A handle is the slot index in the
+    lower 16 bits and the slot's generation in the upper 16 bits.
+    The generation of a slot is bumped on Create() and on Destroy(),
+    live slots always have an odd generation, so a handle to a
+    destroyed object fails the lookup instead of finding the object
+    which reused its slot.
+
+    There is no reference counting, objects live until Destroy() is
+    called, so handles can be copied around and passed between threads
+    without touching the object's cache line. Create(), Destroy() and
+    Lookup() are O(1), lock-free and can be called from any thread,
+    but it is an error to use a looked up object while another thread
+    destroys it.
+
+    Like poolAllocator, the pool grows by "puddles" of 256 slots which
+    never move, so Lookup() doesn't need to synchronize with Create().
+    One pool can hold up to 65280 objects.
+*/
+#include <atomic>
+#include <utility>
+#include <type_traits>
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+template<class TYPE> class HandlePool {
+public:
+    /// a handle, [16bit generation] | [8bit puddle index] | [8bit elm index]
+    typedef uint32 Handle;
+    /// the invalid handle (even generations are never alive)
+    static const Handle InvalidHandle = 0;
+
+    /// constructor
+    HandlePool();
+    /// destructor, destroys objects which are still alive
+    ~HandlePool();
+
+    /// construct a new object, return its handle
+    template<typename... ARGS> Handle Create(ARGS&&... args);
+    /// destroy the object, the handle becomes invalid
+    void Destroy(Handle handle);
+    /// test if the handle refers to a live object
+    bool IsValid(Handle handle) const;
+    /// get pointer to object, or nullptr if the handle is no longer valid
+    TYPE* Lookup(Handle handle) const;
+    /// get number of live objects
+    int32 Size() const;
+
+private:
+    /// the slot header in front of each object, padded to 16 bytes
+    struct slot {
+        std::atomic<uint32> generation;
+        std::atomic<uint32> next;   // free-list link (slot index)
+        uint8 padding[8];
+    };
+
+    /// pop a slot index from the free-list, return invalidIndex if empty
+    uint32 pop();
+    /// push a slot index onto the free-list
+    void push(uint32 index);
+    /// allocate a new puddle and add its slots to the free-list
+    void allocPuddle();
+    /// get slot address from slot index
+    slot* slotAt(uint32 index) const;
+
+    static const uint32 MaxNumPuddles = 255;
+    static const uint32 NumPuddleElements = 256;
+    static const uint32 invalidIndex = 0xFFFF;
+
+    int32 elmSize;                      // offset to next slot in bytes
+    std::atomic<uint32> head;           // [16bit unique count] | [16bit slot index]
+    std::atomic<uint32> numPuddles;
+    std::atomic<int32> size;
+    std::atomic<uint8*> puddles[MaxNumPuddles];
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+HandlePool<TYPE>::HandlePool() :
+elmSize(int32(Memory::RoundUp(sizeof(slot) + sizeof(TYPE), sizeof(slot)))),
+head(invalidIndex),
+numPuddles(0),
+size(0) {
+    static_assert(sizeof(slot) == 16, "HandlePool::slot should be 16 bytes!");
+    static_assert(std::alignment_of<TYPE>::value <= sizeof(slot), "HandlePool: TYPE alignment too big!");
+    for (uint32 i = 0; i < MaxNumPuddles; i++) {
+        this->puddles[i] = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+HandlePool<TYPE>::~HandlePool() {
+    const uint32 num = this->numPuddles;
+    for (uint32 puddleIndex = 0; puddleIndex < num; puddleIndex++) {
+        for (uint32 elmIndex = 0; elmIndex < NumPuddleElements; elmIndex++) {
+            slot* s = this->slotAt((puddleIndex << 8) | elmIndex);
+            if (s->generation & 1) {
+                ((TYPE*)(s + 1))->~TYPE();
+            }
+        }
+        Memory::Free(this->puddles[puddleIndex]);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+typename HandlePool<TYPE>::slot*
+HandlePool<TYPE>::slotAt(uint32 index) const {
+    uint8* puddle = this->puddles[index >> 8].load(std::memory_order_acquire);
+    o_assert_dbg(nullptr != puddle);
+    return (slot*) (puddle + (index & 0xFF) * this->elmSize);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+HandlePool<TYPE>::allocPuddle() {
+    // reserve the puddle index first, Create() may be called from
+    // several threads which all found the free-list empty
+    const uint32 puddleIndex = this->numPuddles.fetch_add(1, std::memory_order_relaxed);
+    o_assert2(puddleIndex < MaxNumPuddles, "HandlePool: too many objects!\n");
+
+    const int32 puddleByteSize = NumPuddleElements * this->elmSize;
+    uint8* puddle = (uint8*) Memory::Alloc(puddleByteSize);
+    Memory::Clear(puddle, puddleByteSize);
+    this->puddles[puddleIndex].store(puddle, std::memory_order_release);
+    for (int32 elmIndex = NumPuddleElements - 1; elmIndex >= 0; elmIndex--) {
+        this->push((puddleIndex << 8) | elmIndex);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+HandlePool<TYPE>::push(uint32 index) {
+    // see poolAllocator, the unique count in the head tag protects
+    // against the ABA problem
+    slot* s = this->slotAt(index);
+    uint32 oldHead = this->head.load(std::memory_order_relaxed);
+    uint32 newHead;
+    do {
+        s->next.store(oldHead & 0xFFFF, std::memory_order_relaxed);
+        newHead = ((oldHead + 0x10000) & 0xFFFF0000) | index;
+    }
+    while (!this->head.compare_exchange_weak(oldHead, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> uint32
+HandlePool<TYPE>::pop() {
+    uint32 oldHead = this->head.load(std::memory_order_acquire);
+    uint32 newHead;
+    do {
+        const uint32 index = oldHead & 0xFFFF;
+        if (invalidIndex == index) {
+            return invalidIndex;
+        }
+        const uint32 next = this->slotAt(index)->next.load(std::memory_order_relaxed);
+        newHead = ((oldHead + 0x10000) & 0xFFFF0000) | next;
+    }
+    while (!this->head.compare_exchange_weak(oldHead, newHead, std::memory_order_acquire, std::memory_order_acquire));
+    return oldHead & 0xFFFF;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+template<typename... ARGS>
+typename HandlePool<TYPE>::Handle
+HandlePool<TYPE>::Create(ARGS&&... args) {
+    uint32 index = this->pop();
+    while (invalidIndex == index) {
+        this->allocPuddle();
+        index = this->pop();
+    }
+    slot* s = this->slotAt(index);
+    new((void*)(s + 1)) TYPE(std::forward<ARGS>(args)...);
+
+    // bump to the next (odd) generation, wraps around after 32768 reuses
+    const uint32 generation = (s->generation.load(std::memory_order_relaxed) + 1) & 0xFFFF;
+    o_assert_dbg(generation & 1);
+    s->generation.store(generation, std::memory_order_release);
+    this->size.fetch_add(1, std::memory_order_relaxed);
+    return (generation << 16) | index;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+HandlePool<TYPE>::Destroy(Handle handle) {
+    TYPE* obj = this->Lookup(handle);
+    o_assert2(nullptr != obj, "HandlePool::Destroy(): invalid handle!\n");
+    obj->~TYPE();
+    const uint32 index = handle & 0xFFFF;
+    slot* s = this->slotAt(index);
+    s->generation.store(((handle >> 16) + 1) & 0xFFFF, std::memory_order_release);
+    this->size.fetch_sub(1, std::memory_order_relaxed);
+    this->push(index);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+HandlePool<TYPE>::Lookup(Handle handle) const {
+    const uint32 index = handle & 0xFFFF;
+    const uint32 puddleIndex = index >> 8;
+    if ((0 == ((handle >> 16) & 1)) || (puddleIndex >= this->numPuddles.load(std::memory_order_relaxed))) {
+        // not a live generation (this includes InvalidHandle), or out of range
+        return nullptr;
+    }
+    if (nullptr == this->puddles[puddleIndex].load(std::memory_order_acquire)) {
+        // puddle is still being allocated by another thread
+        return nullptr;
+    }
+    slot* s = this->slotAt(index);
+    if (s->generation.load(std::memory_order_acquire) != (handle >> 16)) {
+        return nullptr;
+    }
+    return (TYPE*)(s + 1);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+HandlePool<TYPE>::IsValid(Handle handle) const {
+    return nullptr != this->Lookup(handle);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int32
+HandlePool<TYPE>::Size() const {
+    return this->size.load(std::memory_order_relaxed);
+}
+
+} // namespace Oryol
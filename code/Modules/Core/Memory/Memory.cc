@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <cstring>
 #include "Memory.h"
+#include "Core/Assertion.h"
 #if ORYOL_USE_VLD
 #include "vld.h"
 #endif
@@ -40,6 +41,31 @@ Memory::Free(void* p) {
     std::free(p);
 }
 
+//------------------------------------------------------------------------------
+/**
+ Over-allocates through Memory::Alloc() and stores the original pointer
+ right in front of the aligned chunk, so this works with any alignment
+ (also beyond ORYOL_MAX_PLATFORM_ALIGN) on all platforms.
+*/
+void*
+Memory::AllocAligned(int32 numBytes, int32 align) {
+    o_assert_dbg((align > 0) && (0 == (align & (align - 1))));
+    uint8* raw = (uint8*) Memory::Alloc(numBytes + align + int32(sizeof(void*)));
+    intptr ptri = (intptr)(raw + sizeof(void*));
+    ptri = (ptri + (align - 1)) & ~intptr(align - 1);
+    void* ptr = (void*) ptri;
+    ((void**)ptr)[-1] = raw;
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::FreeAligned(void* ptr) {
+    if (ptr) {
+        Memory::Free(((void**)ptr)[-1]);
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 Memory::Copy(const void* from, void* to, int32 numBytes) {
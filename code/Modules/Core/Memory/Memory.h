@@ -27,6 +27,10 @@ public:
     static void* ReAlloc(void* ptr, int32 numBytes);
     /// free a raw chunk of memory
     static void Free(void* ptr);
+    /// allocate a raw chunk of memory aligned to a power-of-2 (free with FreeAligned)
+    static void* AllocAligned(int32 numBytes, int32 align);
+    /// free memory allocated with AllocAligned
+    static void FreeAligned(void* ptr);
     /// fill range of memory with a byte value
     static void Fill(void* ptr, int32 numBytes, uint8 value);
     /// copy a raw chunk of non-overlapping memory
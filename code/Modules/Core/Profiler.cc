@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+//  Profiler.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Profiler.h"
+#include "Core/Assertion.h"
+#include "Core/Log.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Threading/Mutex.h"
+#include <chrono>
+#include <cstdio>
+#include <new>
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && !ORYOL_EMSCRIPTEN && !ORYOL_PNACL
+#define ORYOL_PROFILER_RDTSC (1)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define ORYOL_PROFILER_RDTSC (0)
+#endif
+
+namespace Oryol {
+
+namespace _priv {
+
+/// a recorded event
+struct profilerEvent {
+    uint64 ticks;
+    const char* name;
+    int64 value;
+    int32 type;
+};
+
+/// an event in the ring buffer, its fields are atomic because the
+/// owning thread may overwrite it while a dump copies it
+struct profilerSlot {
+    std::atomic<uint64> ticks{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64> value{0};
+    std::atomic<int32> type{0};
+};
+
+/// per-thread event ring buffer, only written by the owning thread
+struct profilerThread {
+    profilerThread* next = nullptr;
+    int32 threadIndex = 0;
+    char name[32] = { 0 };
+    /// total number of events written (monotonic, wraps the ring)
+    std::atomic<uint64> writeIndex{0};
+    /// events before this index have been discarded by Profiler::Reset()
+    std::atomic<uint64> clearIndex{0};
+    profilerSlot events[Profiler::MaxEventsPerThread];
+};
+
+} // namespace _priv
+
+using namespace _priv;
+
+std::atomic<bool> Profiler::enabled{false};
+std::atomic<profilerThread*> Profiler::threads{nullptr};
+std::atomic<int32> Profiler::numThreads{0};
+ORYOL_THREADLOCAL_PTR(profilerThread) Profiler::curThread = nullptr;
+
+// timestamp/clock pair for calibrating raw ticks to microseconds,
+// taken once under calibLock by the first SetEnabled(true) or dump
+static Mutex calibLock;
+static uint64 calibTicks = 0;
+static std::chrono::high_resolution_clock::time_point calibTime;
+
+//------------------------------------------------------------------------------
+static void
+calibrate(uint64& outTicks, std::chrono::high_resolution_clock::time_point& outTime) {
+    ScopedLock lock(calibLock);
+    if (0 == calibTicks) {
+        calibTime = std::chrono::high_resolution_clock::now();
+        calibTicks = Profiler::Ticks();
+    }
+    outTicks = calibTicks;
+    outTime = calibTime;
+}
+
+//------------------------------------------------------------------------------
+uint64
+Profiler::Ticks() {
+    #if ORYOL_PROFILER_RDTSC
+    return __rdtsc();
+    #else
+    return (uint64) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+Profiler::SetEnabled(bool b) {
+    if (b) {
+        uint64 ticks;
+        std::chrono::high_resolution_clock::time_point time;
+        calibrate(ticks, time);
+    }
+    enabled.store(b, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void
+Profiler::Reset() {
+    for (profilerThread* t = threads.load(std::memory_order_acquire); t; t = t->next) {
+        t->clearIndex.store(t->writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+//------------------------------------------------------------------------------
+profilerThread*
+Profiler::thread() {
+    profilerThread* t = curThread;
+    if (nullptr == t) {
+        void* mem = Memory::Alloc(sizeof(profilerThread));
+        t = new(mem) profilerThread();
+        t->threadIndex = ++numThreads;
+        std::snprintf(t->name, sizeof(t->name), "Thread %d", t->threadIndex);
+
+        // push onto the global thread list without locking
+        profilerThread* head = threads.load(std::memory_order_relaxed);
+        do {
+            t->next = head;
+        }
+        while (!threads.compare_exchange_weak(head, t, std::memory_order_release, std::memory_order_relaxed));
+        curThread = t;
+    }
+    return t;
+}
+
+//------------------------------------------------------------------------------
+void
+Profiler::SetThreadName(const char* name) {
+    o_assert_dbg(name);
+    profilerThread* t = thread();
+    std::snprintf(t->name, sizeof(t->name), "%s", name);
+}
+
+//------------------------------------------------------------------------------
+void
+Profiler::record(EventType type, const char* name, int64 value) {
+    profilerThread* t = thread();
+    const uint64 index = t->writeIndex.load(std::memory_order_relaxed);
+    profilerSlot& e = t->events[index & (MaxEventsPerThread - 1)];
+    // a dump which sees any of the new fields also sees writeIndex == index,
+    // and so knows that the old event in this slot may be torn
+    std::atomic_thread_fence(std::memory_order_release);
+    e.ticks.store(Ticks(), std::memory_order_relaxed);
+    e.name.store(name, std::memory_order_relaxed);
+    e.value.store(value, std::memory_order_relaxed);
+    e.type.store(type, std::memory_order_relaxed);
+    t->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+static void
+appendJsonString(StringBuilder& json, const char* str) {
+    json.Append('"');
+    for (const char* p = str; *p; p++) {
+        if (('"' == *p) || ('\\' == *p)) {
+            json.Append('\\');
+        }
+        if (uint8(*p) >= 0x20) {
+            json.Append(*p);
+        }
+    }
+    json.Append('"');
+}
+
+//------------------------------------------------------------------------------
+void
+Profiler::dumpThread(profilerThread* t, float64 ticksPerMicroSec, uint64 baseTicks, StringBuilder& json, bool& first) {
+
+    // thread name meta-data event
+    json.Append(first ? "\n" : ",\n");
+    first = false;
+    json.AppendFormat(128, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", t->threadIndex);
+    appendJsonString(json, t->name);
+    json.Append("}}");
+
+    // the owning thread may keep writing while we read, the events are
+    // copied like a seqlock: copy, then re-check the write index and drop
+    // every event whose slot may have been (partially) overwritten
+    const uint64 endIndex = t->writeIndex.load(std::memory_order_acquire);
+    uint64 startIndex = t->clearIndex.load(std::memory_order_acquire);
+    if ((endIndex - startIndex) > uint64(MaxEventsPerThread)) {
+        startIndex = endIndex - MaxEventsPerThread;
+    }
+    const int32 num = int32(endIndex - startIndex);
+    if (0 == num) {
+        return;
+    }
+    profilerEvent* copy = (profilerEvent*) Memory::Alloc(num * sizeof(profilerEvent));
+    for (int32 i = 0; i < num; i++) {
+        const profilerSlot& slot = t->events[(startIndex + i) & (MaxEventsPerThread - 1)];
+        copy[i].ticks = slot.ticks.load(std::memory_order_relaxed);
+        copy[i].name = slot.name.load(std::memory_order_relaxed);
+        copy[i].value = slot.value.load(std::memory_order_relaxed);
+        copy[i].type = slot.type.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // the event at checkIndex may be in the middle of being written,
+    // so its slot counts as overwritten too
+    const uint64 checkIndex = t->writeIndex.load(std::memory_order_relaxed);
+    int32 firstValid = 0;
+    if ((checkIndex + 1 - startIndex) > uint64(MaxEventsPerThread)) {
+        firstValid = int32(checkIndex + 1 - startIndex - MaxEventsPerThread);
+        if (firstValid > num) {
+            firstValid = num;
+        }
+    }
+
+    int32 depth = 0;
+    for (int32 i = firstValid; i < num; i++) {
+        const profilerEvent& e = copy[i];
+        if (EndEvent == e.type) {
+            // skip end events whose begin has been overwritten
+            if (0 == depth) {
+                continue;
+            }
+            depth--;
+        }
+        else if (BeginEvent == e.type) {
+            depth++;
+        }
+        const float64 ts = (e.ticks > baseTicks) ? (float64(e.ticks - baseTicks) / ticksPerMicroSec) : 0.0;
+        json.Append(",\n{");
+        if (EndEvent != e.type) {
+            json.Append("\"name\":");
+            appendJsonString(json, e.name);
+            json.Append(',');
+        }
+        switch (e.type) {
+            case BeginEvent:    json.Append("\"ph\":\"B\""); break;
+            case EndEvent:      json.Append("\"ph\":\"E\""); break;
+            case CounterEvent:  json.Append("\"ph\":\"C\""); break;
+            default:            json.Append("\"ph\":\"i\",\"s\":\"g\""); break;
+        }
+        json.AppendFormat(128, ",\"ts\":%.3f,\"pid\":1,\"tid\":%d", ts, t->threadIndex);
+        if (CounterEvent == e.type) {
+            json.AppendFormat(64, ",\"args\":{\"value\":%lld}", (long long) e.value);
+        }
+        json.Append('}');
+    }
+    Memory::Free(copy);
+}
+
+//------------------------------------------------------------------------------
+/**
+ NOTE: the rdtsc frequency is measured against the system clock over
+ the time since recording was first enabled. If that is very short,
+ this method will block until 10 milliseconds have passed.
+*/
+void
+Profiler::DumpChromeTrace(StringBuilder& json) {
+    using namespace std::chrono;
+    uint64 calibTicks;
+    high_resolution_clock::time_point calibTime;
+    calibrate(calibTicks, calibTime);
+    float64 elapsedMicroSecs = 0.0;
+    uint64 ticks = 0;
+    do {
+        ticks = Ticks();
+        elapsedMicroSecs = float64(duration_cast<nanoseconds>(high_resolution_clock::now() - calibTime).count()) / 1000.0;
+    }
+    while (elapsedMicroSecs < 10000.0);
+    const float64 ticksPerMicroSec = float64(ticks - calibTicks) / elapsedMicroSecs;
+
+    // find the earliest recorded timestamp, so that the trace starts at 0
+    uint64 baseTicks = ticks;
+    for (profilerThread* t = threads.load(std::memory_order_acquire); t; t = t->next) {
+        const uint64 endIndex = t->writeIndex.load(std::memory_order_acquire);
+        uint64 startIndex = t->clearIndex.load(std::memory_order_acquire);
+        if ((endIndex - startIndex) > uint64(MaxEventsPerThread)) {
+            startIndex = endIndex - MaxEventsPerThread;
+        }
+        if (endIndex > startIndex) {
+            const uint64 t0 = t->events[startIndex & (MaxEventsPerThread - 1)].ticks.load(std::memory_order_relaxed);
+            if (t0 < baseTicks) {
+                baseTicks = t0;
+            }
+        }
+    }
+
+    json.Append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    for (profilerThread* t = threads.load(std::memory_order_acquire); t; t = t->next) {
+        dumpThread(t, ticksPerMicroSec, baseTicks, json, first);
+    }
+    json.Append("\n]}\n");
+}
+
+//------------------------------------------------------------------------------
+bool
+Profiler::WriteChromeTrace(const char* path) {
+    o_assert(path);
+    StringBuilder json;
+    DumpChromeTrace(json);
+    FILE* fp = std::fopen(path, "wb");
+    if (nullptr == fp) {
+        o_warn("Profiler::WriteChromeTrace: failed to open '%s'\n", path);
+        return false;
+    }
+    const size_t len = size_t(json.Length());
+    const bool success = len == std::fwrite(json.AsCStr(), 1, len, fp);
+    std::fclose(fp);
+    return success;
+}
+
+} // namespace Oryol
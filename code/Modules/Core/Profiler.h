@@ -0,0 +1,160 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Profiler
+    @ingroup Core
+    @brief built-in per-thread event profiler with Chrome trace export
+
+    The Profiler records begin/end, counter and frame events into
+    per-thread ring buffers and can dump them as Chrome trace-event JSON
+    (load the result in chrome://tracing or any compatible viewer).
+    Unlike the Remotery and emscripten hooks in Trace.h, the Profiler
+    doesn't need a live viewer connection and isn't tied to
+    ORYOL_PROFILING, so traces can be captured on headless machines.
+
+    Recording is off by default and is switched on with
+    Profiler::SetEnabled(true). The o_trace_* macros in Trace.h feed
+    the Profiler, so the engine's own instrumentation (App, RunLoop,
+    ThreadedQueue, ioLane, Gfx) shows up without extra work.
+
+    Each thread gets its own fixed-size ring buffer on its first
+    recorded event. Only the owning thread writes into a buffer, so
+    recording doesn't lock or allocate. When a buffer is full, the
+    oldest events are overwritten. A dump may run while other threads
+    keep recording, events overwritten during the dump are left out. Timestamps come from rdtsc on x86
+    (calibrated against the system clock at dump time), or from
+    std::chrono::high_resolution_clock on other platforms.
+
+    Event and counter names are stored as pointers. They must point to
+    static strings (e.g. string literals), since they are only
+    resolved when the trace is dumped.
+
+    Thread buffers are never freed. This way, events from threads which
+    have already exited remain available for the next dump.
+
+    @see Trace
+*/
+#include "Core/Types.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+#include "Core/String/StringBuilder.h"
+#include <atomic>
+
+namespace Oryol {
+
+namespace _priv {
+struct profilerThread;
+}
+class ProfilerScope;
+
+class Profiler {
+public:
+    /// max number of events per thread before old events are overwritten
+    static const int32 MaxEventsPerThread = (1<<14);
+
+    /// enable or disable recording (disabled by default)
+    static void SetEnabled(bool b);
+    /// test if recording is enabled
+    static bool IsEnabled();
+    /// discard all recorded events
+    static void Reset();
+    /// set the name of the calling thread (shown in trace viewers)
+    static void SetThreadName(const char* name);
+
+    /// begin a named event on the calling thread
+    static void Begin(const char* name);
+    /// end the last begun event on the calling thread
+    static void End();
+    /// record a counter value
+    static void Counter(const char* name, int64 value);
+    /// record a frame marker
+    static void Frame();
+
+    /// dump all recorded events as Chrome trace-event JSON
+    static void DumpChromeTrace(StringBuilder& outJson);
+    /// dump all recorded events as Chrome trace-event JSON to a file
+    static bool WriteChromeTrace(const char* path);
+
+    /// get the current raw timestamp
+    static uint64 Ticks();
+
+    /// event types
+    enum EventType {
+        BeginEvent,
+        EndEvent,
+        CounterEvent,
+        FrameEvent,
+    };
+
+private:
+    friend class ProfilerScope;
+    /// record an event into the calling thread's ring buffer
+    static void record(EventType type, const char* name, int64 value);
+    /// get or create the calling thread's ring buffer
+    static _priv::profilerThread* thread();
+    /// dump events of one thread
+    static void dumpThread(_priv::profilerThread* t, float64 ticksPerMicroSec, uint64 baseTicks, StringBuilder& json, bool& first);
+
+    static std::atomic<bool> enabled;
+    static std::atomic<_priv::profilerThread*> threads;
+    static std::atomic<int32> numThreads;
+    static ORYOL_THREADLOCAL_PTR(_priv::profilerThread) curThread;
+};
+
+/// scoped begin/end helper, used by the o_trace_scoped() macro
+class ProfilerScope {
+public:
+    /// constructor, begins an event if recording is enabled
+    ProfilerScope(const char* name) : begun(Profiler::IsEnabled()) {
+        if (this->begun) {
+            Profiler::record(Profiler::BeginEvent, name, 0);
+        }
+    };
+    /// destructor, ends the event if the constructor has begun it
+    ~ProfilerScope() {
+        if (this->begun) {
+            Profiler::record(Profiler::EndEvent, nullptr, 0);
+        }
+    };
+private:
+    bool begun;     // recording was enabled when the scope was entered
+};
+
+//------------------------------------------------------------------------------
+inline bool
+Profiler::IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+inline void
+Profiler::Begin(const char* name) {
+    if (IsEnabled()) {
+        record(BeginEvent, name, 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+Profiler::End() {
+    if (IsEnabled()) {
+        record(EndEvent, nullptr, 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+Profiler::Counter(const char* name, int64 value) {
+    if (IsEnabled()) {
+        record(CounterEvent, name, value);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+Profiler::Frame() {
+    if (IsEnabled()) {
+        record(FrameEvent, "Frame", 0);
+    }
+}
+
+} // namespace Oryol
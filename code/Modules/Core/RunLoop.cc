@@ -3,6 +3,8 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "RunLoop.h"
+#include "Core/Trace.h"
+#include "Core/Threading/WorkerPool.h"
 
 namespace Oryol {
 
@@ -23,11 +25,26 @@ RunLoop::~RunLoop() {
 //------------------------------------------------------------------------------
 void
 RunLoop::Run() {
+    o_trace_scoped(RunLoop_Run);
     this->remCallbacks();
     this->addCallbacks();
+    if (this->scheduleDirty) {
+        this->buildSchedule();
+    }
+    // callbacks run in Id order, the phase graph runs as one block
+    // at the position of the first phase callback
+    bool phasesDone = this->jobs.Empty();
     for (const auto& entry : this->callbacks) {
-        if (entry.Value().valid) {
-            entry.Value().func();
+        const item& cb = entry.Value();
+        if (!cb.valid) {
+            continue;
+        }
+        if (InvalidIndex == cb.phaseIndex) {
+            cb.func();
+        }
+        else if (!phasesDone) {
+            this->runPhases();
+            phasesDone = true;
         }
     }
     this->remCallbacks();
@@ -48,10 +65,48 @@ RunLoop::HasCallback(Id id) const {
 RunLoop::Id
 RunLoop::Add(Func func) {
     Id newId = ++this->curId;
-    this->toAdd.Add(newId, item{func, false});
+    item newItem;
+    newItem.func = func;
+    this->toAdd.Add(newId, newItem);
+    return newId;
+}
+
+//------------------------------------------------------------------------------
+/**
+ NOTE: the callback function will not be added immediately, but at the
+ start or end of the Run function. If the phase hasn't been declared
+ with AddPhase() it will be declared without dependencies.
+*/
+RunLoop::Id
+RunLoop::Add(const StringAtom& phase, Func func, Affinity affinity) {
+    o_assert_dbg(phase.IsValid());
+    Id newId = ++this->curId;
+    item newItem;
+    newItem.func = func;
+    newItem.phaseName = phase;
+    newItem.affinity = affinity;
+    this->toAdd.Add(newId, newItem);
     return newId;
 }
 
+//------------------------------------------------------------------------------
+/**
+ NOTE: like callbacks, phases are only declared at the start or end
+ of the Run function. Declaring an existing phase again adds
+ the new dependencies to it.
+*/
+void
+RunLoop::AddPhase(const StringAtom& name, std::initializer_list<StringAtom> after) {
+    o_assert_dbg(name.IsValid());
+    phase newPhase;
+    newPhase.name = name;
+    for (const StringAtom& dep : after) {
+        o_assert_dbg(dep != name);
+        newPhase.after.Add(dep);
+    }
+    this->phasesToAdd.Add(newPhase);
+}
+
 //------------------------------------------------------------------------------
 /**
  NOTE: the callback function not be removed immediately, but at the 
@@ -67,10 +122,37 @@ RunLoop::Remove(Id id) {
 //------------------------------------------------------------------------------
 void
 RunLoop::addCallbacks() {
+    for (const phase& newPhase : this->phasesToAdd) {
+        int32 phaseIndex = this->findPhase(newPhase.name);
+        if (InvalidIndex == phaseIndex) {
+            phaseIndex = this->phases.Size();
+            this->phases.Add(newPhase);
+        }
+        else {
+            phase& p = this->phases[phaseIndex];
+            for (const StringAtom& dep : newPhase.after) {
+                if (InvalidIndex == p.after.FindIndexLinear(dep)) {
+                    p.after.Add(dep);
+                }
+            }
+        }
+        this->scheduleDirty = true;
+    }
+    this->phasesToAdd.Clear();
     for (auto& entry : this->toAdd) {
         item& item = entry.Value();
         item.valid = true;
+        if (item.phaseName.IsValid()) {
+            item.phaseIndex = this->findPhase(item.phaseName);
+            if (InvalidIndex == item.phaseIndex) {
+                item.phaseIndex = this->phases.Size();
+                phase newPhase;
+                newPhase.name = item.phaseName;
+                this->phases.Add(newPhase);
+            }
+        }
         this->callbacks.Add(entry.Key(), item);
+        this->scheduleDirty = true;
     }
     this->toAdd.Clear();
 }
@@ -81,6 +163,7 @@ RunLoop::remCallbacks() {
     for (Id id : this->toRemove) {
         if (this->callbacks.Contains(id)) {
             this->callbacks.Erase(id);
+            this->scheduleDirty = true;
         }
         else if (this->toAdd.Contains(id)) {
             this->toAdd.Erase(id);
@@ -89,4 +172,171 @@ RunLoop::remCallbacks() {
     this->toRemove.Clear();
 }
 
-} // namespace Oryol
\ No newline at end of file
+//------------------------------------------------------------------------------
+int32
+RunLoop::findPhase(const StringAtom& name) const {
+    for (int32 i = 0; i < this->phases.Size(); i++) {
+        if (this->phases[i].name == name) {
+            return i;
+        }
+    }
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Resolves the phase dependencies into successor lists, checks that
+ the graph has no cycles, and builds the job list. Job and item
+ pointers stay valid until the callbacks map changes, which always
+ marks the schedule as dirty.
+*/
+void
+RunLoop::buildSchedule() {
+    this->scheduleDirty = false;
+    for (phase& p : this->phases) {
+        p.successors.Clear();
+        p.jobIndices.Clear();
+        p.numDeps = 0;
+    }
+    for (int32 i = 0; i < this->phases.Size(); i++) {
+        for (const StringAtom& dep : this->phases[i].after) {
+            const int32 depIndex = this->findPhase(dep);
+            if (InvalidIndex != depIndex) {
+                this->phases[depIndex].successors.Add(i);
+                this->phases[i].numDeps++;
+            }
+        }
+    }
+
+    // check for cycles (Kahn's algorithm must visit each phase once)
+    #if ORYOL_DEBUG
+    {
+        Array<int32> depsLeft;
+        Array<int32> ready;
+        for (int32 i = 0; i < this->phases.Size(); i++) {
+            depsLeft.Add(this->phases[i].numDeps);
+            if (0 == this->phases[i].numDeps) {
+                ready.Add(i);
+            }
+        }
+        int32 numVisited = 0;
+        while (!ready.Empty()) {
+            const int32 cur = ready.Back();
+            ready.Erase(ready.Size() - 1);
+            numVisited++;
+            for (int32 succ : this->phases[cur].successors) {
+                if (0 == --depsLeft[succ]) {
+                    ready.Add(succ);
+                }
+            }
+        }
+        o_assert2(numVisited == this->phases.Size(), "RunLoop: cycle in phase dependencies!\n");
+    }
+    #endif
+
+    this->jobs.Clear();
+    for (const auto& entry : this->callbacks) {
+        const item& cb = entry.Value();
+        if (InvalidIndex != cb.phaseIndex) {
+            this->phases[cb.phaseIndex].jobIndices.Add(this->jobs.Size());
+            job newJob;
+            newJob.runLoop = this;
+            newJob.callback = &cb;
+            this->jobs.Add(newJob);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+RunLoop::runPhases() {
+    this->useWorkers = WorkerPool::IsValid() && (WorkerPool::NumWorkers() > 0);
+    {
+        ScopedLock lock(this->schedLock);
+        this->numPhasesLeft = this->phases.Size();
+        for (phase& p : this->phases) {
+            p.depsLeft = p.numDeps;
+            p.jobsLeft = p.jobIndices.Size();
+        }
+        for (int32 i = 0; i < this->phases.Size(); i++) {
+            if (0 == this->phases[i].numDeps) {
+                this->startPhase(i);
+            }
+        }
+    }
+    // run main-thread callbacks until all phases are done, help out
+    // with our own queued worker jobs while there's nothing to do for us
+    for (;;) {
+        const job* mainJob = nullptr;
+        {
+            ScopedLock lock(this->schedLock);
+            if (0 == this->numPhasesLeft) {
+                break;
+            }
+            if (!this->mainJobs.Empty()) {
+                mainJob = this->mainJobs.Dequeue();
+            }
+        }
+        if (mainJob) {
+            runJob((void*)mainJob);
+        }
+        else if (!(this->useWorkers && WorkerPool::RunOwn(this))) {
+            this->wakeup.Wait();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+RunLoop::startPhase(int32 phaseIndex) {
+    const phase& p = this->phases[phaseIndex];
+    if (0 == p.jobsLeft) {
+        this->finishPhase(phaseIndex);
+        return;
+    }
+    bool mainJobsAdded = false;
+    for (int32 jobIndex : p.jobIndices) {
+        const job* j = &this->jobs[jobIndex];
+        if (this->useWorkers && (Affinity::AnyThread == j->callback->affinity)) {
+            WorkerPool::Push(runJob, (void*)j, this);
+        }
+        else {
+            this->mainJobs.Enqueue(j);
+            mainJobsAdded = true;
+        }
+    }
+    if (mainJobsAdded) {
+        this->wakeup.Signal();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+RunLoop::finishPhase(int32 phaseIndex) {
+    if (0 == --this->numPhasesLeft) {
+        this->wakeup.Signal();
+    }
+    for (int32 succ : this->phases[phaseIndex].successors) {
+        if (0 == --this->phases[succ].depsLeft) {
+            this->startPhase(succ);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+RunLoop::runJob(void* userData) {
+    const job* j = (const job*) userData;
+    RunLoop* self = j->runLoop;
+    const int32 phaseIndex = j->callback->phaseIndex;
+    {
+        ProfilerScope scope(self->phases[phaseIndex].name.AsCStr());
+        j->callback->func();
+    }
+    ScopedLock lock(self->schedLock);
+    if (0 == --self->phases[phaseIndex].jobsLeft) {
+        self->finishPhase(phaseIndex);
+    }
+}
+
+} // namespace Oryol
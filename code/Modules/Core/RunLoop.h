@@ -22,11 +22,37 @@
 
         MyClass myObj;<br>
         Callback("name", pri, std::function<void()>(&MyClass::MyMethod, &myObj));
+
+    Callbacks can also be added to named frame phases. A phase can
+    declare other phases it must run after, phases without a path
+    between them in this dependency graph may run concurrently, and
+    the callbacks inside one phase may run concurrently too.
+    Callbacks with Affinity::AnyThread are handed to the WorkerPool,
+    callbacks with Affinity::MainThread always run on the thread which
+    called Run() (which helps out with this RunLoop's AnyThread
+    callbacks while it waits, but never with unrelated WorkerPool
+    jobs).
+    Dependencies on phases which have not been declared are ignored,
+    so modules can refer to each other's phases without having to
+    know whether the other module has been setup.
+
+        runLoop->AddPhase("IOQueue", { "IO" });
+        runLoop->Add("IO", [] { ... });
+        runLoop->Add("IOQueue", [] { ... });
+
+    Callbacks without a phase run in the order they were added, the
+    phase graph runs as one block at the position of the first
+    callback which was added to a phase.
 */
 #include <functional>
+#include <initializer_list>
 #include "Core/RefCounted.h"
 #include "Core/String/StringAtom.h"
+#include "Core/Containers/Array.h"
 #include "Core/Containers/Map.h"
+#include "Core/Containers/Queue.h"
+#include "Core/Threading/Mutex.h"
+#include "Core/Threading/Event.h"
 
 namespace Oryol {
 
@@ -39,6 +65,11 @@ public:
     static const Id InvalidId = 0;
     /// runloop function typedef
     typedef std::function<void()> Func;
+    /// which threads a phase callback may run on
+    enum class Affinity {
+        MainThread,
+        AnyThread,
+    };
 
     /// constructor
     RunLoop();
@@ -50,6 +81,10 @@ public:
     
     /// add a callback to the run loop, higher priorities run earlier, slow!
     Id Add(Func func);
+    /// add a callback to a frame phase, slow!
+    Id Add(const StringAtom& phase, Func func, Affinity affinity = Affinity::MainThread);
+    /// declare a frame phase which runs after other phases, slow!
+    void AddPhase(const StringAtom& phase, std::initializer_list<StringAtom> after = {});
     /// remove a callback, slow!
     void Remove(Id);
     /// test if a callback has been attached, slow!
@@ -60,16 +95,54 @@ private:
     void addCallbacks();
     /// remove callbacks that have been removed (called at end of Run())
     void remCallbacks();
+    /// find a phase index by name, InvalidIndex if not declared
+    int32 findPhase(const StringAtom& name) const;
+    /// rebuild the phase dependency graph and job list
+    void buildSchedule();
+    /// run the phase graph
+    void runPhases();
+    /// start a phase whose dependencies are finished (schedLock must be held)
+    void startPhase(int32 phaseIndex);
+    /// mark a phase as finished (schedLock must be held)
+    void finishPhase(int32 phaseIndex);
     
     struct item {
         Func func;
-        bool valid;
+        bool valid = false;
+        StringAtom phaseName;
+        int32 phaseIndex = InvalidIndex;
+        Affinity affinity = Affinity::MainThread;
     };
+    struct job {
+        RunLoop* runLoop = nullptr;
+        const item* callback = nullptr;
+    };
+    struct phase {
+        StringAtom name;
+        Array<StringAtom> after;
+        Array<int32> successors;
+        Array<int32> jobIndices;
+        int32 numDeps = 0;
+        int32 depsLeft = 0;
+        int32 jobsLeft = 0;
+    };
+    /// run a phase callback and update its phase, called on any thread
+    static void runJob(void* job);
     
     Id curId;
     Map<Id, item> callbacks;
     Map<Id, item> toAdd;
     Set<Id> toRemove;
+
+    Array<phase> phases;
+    Array<phase> phasesToAdd;
+    Array<job> jobs;
+    bool scheduleDirty = false;
+    bool useWorkers = false;
+    Mutex schedLock;
+    Queue<const job*> mainJobs;
+    int32 numPhasesLeft = 0;
+    Event wakeup;
 };
     
 } // namespace Oryol
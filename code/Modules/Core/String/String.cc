@@ -5,11 +5,10 @@
 #include <cstring>
 #include "String.h"
 #include "StringAtom.h"
+#include "StringArena.h"
 
 namespace Oryol {
 
-const char* String::emptyString = "";
-
 //------------------------------------------------------------------------------
 String::String(const StringAtom& str) {
     const char* cstr = str.AsCStr();
@@ -22,16 +21,13 @@ String::String(const char* str) {
         this->create(str, int32(std::strlen(str)));
     }
     else {
-        this->data = nullptr;
-        this->strPtr = nullptr;
+        this->setEmpty();
     }
 }
 
 //------------------------------------------------------------------------------
-String::String() :
-data(nullptr),
-strPtr(nullptr) {
-    // empty
+String::String() {
+    this->setEmpty();
 }
 
 //------------------------------------------------------------------------------
@@ -63,6 +59,21 @@ String::String(const char* ptr, int32 startIndex, int32 endIndex) {
     this->create(ptr + startIndex, endIndex - startIndex);
 }
 
+//------------------------------------------------------------------------------
+/**
+ Like the raw data constructor, but a string which doesn't fit
+ into the String object is copied into the arena instead of
+ a refcounted heap block.
+*/
+String::String(StringArena& arena, const char* ptr, int32 startIndex, int32 endIndex) {
+    o_assert(nullptr != ptr);
+    if (EndOfString == endIndex) {
+        endIndex = int32(std::strlen(ptr));
+    }
+    o_assert(startIndex < endIndex);
+    this->create(ptr + startIndex, endIndex - startIndex, &arena);
+}
+
 //------------------------------------------------------------------------------
 void
 String::Assign(const char* ptr, int32 startIndex, int32 endIndex) {
@@ -75,6 +86,18 @@ String::Assign(const char* ptr, int32 startIndex, int32 endIndex) {
     this->create(ptr + startIndex, endIndex - startIndex);
 }
 
+//------------------------------------------------------------------------------
+void
+String::Assign(StringArena& arena, const char* ptr, int32 startIndex, int32 endIndex) {
+    o_assert(nullptr != ptr);
+    this->release();
+    if (EndOfString == endIndex) {
+        endIndex = int32(std::strlen(ptr));
+    }
+    o_assert(startIndex < endIndex);
+    this->create(ptr + startIndex, endIndex - startIndex, &arena);
+}
+
 //------------------------------------------------------------------------------
 void
 String::operator=(const StringAtom& str) {
@@ -89,70 +112,120 @@ String::AsStringAtom() const {
     return StringAtom(this->AsCStr());;
 }
 
+//------------------------------------------------------------------------------
+void
+String::setEmpty() {
+    this->local[0] = 0;
+    this->local[TagIndex] = char(MaxLocalLength);
+}
+
+//------------------------------------------------------------------------------
+bool
+String::isLocal() const {
+    return uint8(this->local[TagIndex]) <= MaxLocalLength;
+}
+
+//------------------------------------------------------------------------------
+bool
+String::isShared() const {
+    return SharedTag == uint8(this->local[TagIndex]);
+}
+
 //------------------------------------------------------------------------------
 void
 String::destroy() {
-    o_assert(0 != this->data);
-    o_assert(0 == this->data->refCount);
-    this->data->~StringData();
-    Memory::Free(this->data);
-    this->data = nullptr;
-    this->strPtr = nullptr;
+    o_assert(this->isShared());
+    o_assert(0 == this->ext.data->refCount);
+    this->ext.data->~StringData();
+    Memory::Free(this->ext.data);
+    this->setEmpty();
 }
 
 //------------------------------------------------------------------------------
 void
 String::alloc(int32 len) {
     o_assert(len > 0);
-    this->data = (StringData*) Memory::Alloc(sizeof(StringData) + len + 1);
-    new(this->data) StringData();
+    this->ext.data = (StringData*) Memory::Alloc(sizeof(StringData) + len + 1);
+    new(this->ext.data) StringData();
+    this->local[TagIndex] = char(SharedTag);
     this->addRef();
-    this->data->length = len;
-    this->strPtr = (const char*) &(this->data[1]);
+    this->ext.length = len;
+    this->ext.strPtr = (const char*) &(this->ext.data[1]);
 }
 
 //------------------------------------------------------------------------------
 void
-String::create(const char* ptr, int32 len) {
+String::create(const char* ptr, int32 len, StringArena* arena) {
     o_assert(0 != ptr);
     if ((ptr[0] != 0) && (len > 0)) {
-        this->alloc(len);
-        Memory::Copy(ptr, (void*)this->strPtr, len);
-        ((char*)this->strPtr)[len] = 0;
+        char* dst;
+        if (len <= MaxLocalLength) {
+            // short string, store in place, the tag byte is the remaining
+            // capacity, which becomes the terminating 0 of a full local string
+            dst = this->local;
+            this->local[TagIndex] = char(MaxLocalLength - len);
+        }
+        else if (arena) {
+            dst = arena->Alloc(len);
+            this->ext.data = nullptr;
+            this->ext.strPtr = dst;
+            this->ext.length = len;
+            this->local[TagIndex] = char(ArenaTag);
+        }
+        else {
+            this->alloc(len);
+            dst = (char*) this->ext.strPtr;
+        }
+        Memory::Copy(ptr, dst, len);
+        dst[len] = 0;
     }
     else {
         // empty string, don't bother to allocate storage for this
-        this->data = nullptr;
-        this->strPtr = nullptr;
+        this->setEmpty();
     }
 }
 
 //------------------------------------------------------------------------------
 void
 String::addRef() {
-    o_assert(nullptr != this->data);
+    o_assert(this->isShared());
     #if ORYOL_HAS_ATOMIC
-    this->data->refCount.fetch_add(1, std::memory_order_relaxed);
+    this->ext.data->refCount.fetch_add(1, std::memory_order_relaxed);
     #else
-    this->data->refCount++;
+    this->ext.data->refCount++;
     #endif
 }
 
 //------------------------------------------------------------------------------
 void
 String::release() {
-    if (nullptr != this->data) {
+    if (this->isShared()) {
         #if ORYOL_HAS_ATOMIC
-        if (1 == this->data->refCount.fetch_sub(1, std::memory_order_relaxed)) {
+        if (1 == this->ext.data->refCount.fetch_sub(1, std::memory_order_relaxed)) {
         #else
-        if (1 == this->data->refCount--) {
+        if (1 == this->ext.data->refCount--) {
         #endif
             // no more owners, destroy the shared string data
             this->destroy();
         }
-        this->data = nullptr;
-        this->strPtr = nullptr;
     }
+    this->setEmpty();
+}
+
+//------------------------------------------------------------------------------
+void
+String::copy(const String& rhs) {
+    Memory::Copy(&rhs.local, &this->local, sizeof(this->local));
+    if (this->isShared()) {
+        this->addRef();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+String::move(String& rhs) {
+    Memory::Copy(&rhs.local, &this->local, sizeof(this->local));
+    rhs.setEmpty();
 }
 
 //------------------------------------------------------------------------------
@@ -173,19 +246,12 @@ String::Assign(const String& rhs, int32 startIndex, int32 endIndex) {
     
 //------------------------------------------------------------------------------
 String::String(const String& rhs) {
-    this->data = rhs.data;
-    this->strPtr = rhs.strPtr;
-    if (nullptr != this->data) {
-        this->addRef();
-    }
+    this->copy(rhs);
 }
 
 //------------------------------------------------------------------------------
 String::String(String&& rhs) {
-    this->data = rhs.data;
-    this->strPtr = rhs.strPtr;
-    rhs.data = 0;
-    rhs.strPtr = 0;
+    this->move(rhs);
 }
 
 //------------------------------------------------------------------------------
@@ -207,11 +273,7 @@ void
 String::operator=(const String& rhs) {
     if (this != &rhs) {
         this->release();
-        this->data = rhs.data;
-        this->strPtr = rhs.strPtr;
-        if (nullptr != this->data) {
-            this->addRef();
-        }
+        this->copy(rhs);
     }
 }
 
@@ -220,22 +282,16 @@ void
 String::operator=(String&& rhs) {
     if (this != &rhs) {
         this->release();
-        this->data = rhs.data;
-        this->strPtr = rhs.strPtr;
-        rhs.data = 0;
-        rhs.strPtr = 0;
+        this->move(rhs);
     }
 }
 
 //------------------------------------------------------------------------------
 bool
 String::operator==(const String& rhs) const {
-    if (this->data == rhs.data) {
+    if (!this->isLocal() && !rhs.isLocal() && (this->ext.strPtr == rhs.ext.strPtr)) {
         return true;
     }
-    else if ((nullptr == this->data) || (nullptr == rhs.data)) {
-        return false;
-    }
     else {
         return std::strcmp(this->AsCStr(), rhs.AsCStr()) == 0;
     }
@@ -250,66 +306,46 @@ String::operator!=(const String& rhs) const {
 //------------------------------------------------------------------------------
 bool
 String::operator<(const String& rhs) const {
-    if (this->data == rhs.data) {
-        return false;
-    }
-    else {
-        return std::strcmp(this->AsCStr(), rhs.AsCStr()) < 0;
-    }
+    return std::strcmp(this->AsCStr(), rhs.AsCStr()) < 0;
 }
 
 //------------------------------------------------------------------------------
 bool
 String::operator>(const String& rhs) const {
-    if (this->data == rhs.data) {
-        return false;
-    }
-    else {
-        return std::strcmp(this->AsCStr(), rhs.AsCStr()) > 0;
-    }
+    return std::strcmp(this->AsCStr(), rhs.AsCStr()) > 0;
 }
 
 //------------------------------------------------------------------------------
 bool
 String::operator<=(const String& rhs) const {
-    if (this->data == rhs.data) {
-        return true;
-    }
-    else {
-        return std::strcmp(this->AsCStr(), rhs.AsCStr()) <= 0;
-    }
+    return std::strcmp(this->AsCStr(), rhs.AsCStr()) <= 0;
 }
 
 //------------------------------------------------------------------------------
 bool
 String::operator>=(const String& rhs) const {
-    if (this->data == rhs.data) {
-        return true;
-    }
-    else {
-        return std::strcmp(this->AsCStr(), rhs.AsCStr()) >= 0;
-    }
+    return std::strcmp(this->AsCStr(), rhs.AsCStr()) >= 0;
 }
 
 //------------------------------------------------------------------------------
 int32
 String::Length() const {
-    if (nullptr == this->data) {
-        return 0;
+    if (this->isLocal()) {
+        return MaxLocalLength - this->local[TagIndex];
     }
     else {
-        return this->data->length;
+        return this->ext.length;
     }
 }
 
 //------------------------------------------------------------------------------
 const char*
 String::AsCStr() const {
-    if (nullptr == this->strPtr) {
-        return emptyString;
+    if (this->isLocal()) {
+        return this->local;
     }
     else {
-        return this->strPtr;
+        return this->ext.strPtr;
     }
 }
 
@@ -334,19 +370,24 @@ String::Clear() {
 //------------------------------------------------------------------------------
 int32
 String::RefCount() const {
-    if (nullptr == this->data) {
-        return 0;
+    if (this->isShared()) {
+        return this->ext.data->refCount;
+    }
+    else if (this->isLocal()) {
+        return this->Empty() ? 0 : 1;
     }
     else {
-        return this->data->refCount;
+        // arena strings are not refcounted
+        return 0;
     }
 }
 
 //------------------------------------------------------------------------------
 char
 String::Back() const {
-    if (this->strPtr) {
-        return this->strPtr[this->data->length - 1];
+    const int32 len = this->Length();
+    if (len > 0) {
+        return this->AsCStr()[len - 1];
     }
     else {
         return 0;
@@ -356,12 +397,7 @@ String::Back() const {
 //------------------------------------------------------------------------------
 char
 String::Front() const {
-    if (this->strPtr) {
-        return this->strPtr[0];
-    }
-    else {
-        return 0;
-    }
+    return this->AsCStr()[0];
 }
 
 //------------------------------------------------------------------------------
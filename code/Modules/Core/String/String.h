@@ -5,12 +5,18 @@
     @ingroup Core
     @brief immutable, reference counted, shared strings
     
-    An immutable, shared UTF-8 String class. Memory is only allocated
+    An immutable, shared UTF-8 String class. Strings of up to 23 bytes
+    are stored inside the String object itself and never allocate.
+    For longer strings, memory is only allocated
     when creating or assigning from non-String objects (const char*,
     StringAtoms). When assigning from another string,
     only a pointer to the original string data is copied, and a 
     refcount is maintained. The last String pointing to the string
     data frees the string data.
+
+    Long strings can also be created in a StringArena. Such strings are
+    not refcounted, copies share the arena memory, and the arena
+    must outlive all strings (and copies) created from it.
     
     To manipulate string data, use the StringUtil class.
     
@@ -31,6 +37,7 @@
 namespace Oryol {
 
 class StringAtom;
+class StringArena;
 
 class String {
 public:
@@ -44,6 +51,8 @@ public:
     String(const String& rhs, int32 startIndex, int32 endIndex);
     /// construct from StringAtom (allocates!)
     String(const StringAtom& str);
+    /// construct from raw byte sequence, long strings are stored in an arena
+    String(StringArena& arena, const char* ptr, int32 startIndex, int32 endIndex);
     
     /// copy constructor (does not allocate)
     String(const String& rhs);
@@ -79,6 +88,8 @@ public:
     void Assign(const char* ptr, int32 startIndex, int32 endIndex);
     /// assign from other string, with start index and endIndex, endIndex can be EndOfString
     void Assign(const String& rhs, int32 startIndex, int32 endIndex);
+    /// assign from raw byte sequence, long strings are stored in an arena
+    void Assign(StringArena& arena, const char* ptr, int32 startIndex, int32 endIndex);
     /// get as C-String, will always return a valid ptr, even if String is empty
     const char* AsCStr() const;
     /// get as StringAtom (slow)
@@ -96,8 +107,11 @@ public:
     bool Empty() const;
     /// clear content
     void Clear();
-    /// get the refcount of this string
+    /// get the refcount of this string (1 for local strings, 0 for arena strings)
     int32 RefCount() const;
+
+    /// max length of strings which are stored locally
+    static const int32 MaxLocalLength = 23;
     
 private:
     /// shared string data header, this is followed by the actual string
@@ -107,11 +121,10 @@ private:
         #else
         int32 refCount{0};
         #endif
-        int32 length;
     };
     
     /// create new string data block, numBytes does not include the terminating 0
-    void create(const char* ptr, int32 len);
+    void create(const char* ptr, int32 len, StringArena* arena = nullptr);
     /// private alloc function for len
     void alloc(int32 len);
     /// destroy shared string data block
@@ -120,10 +133,31 @@ private:
     void addRef();
     /// decrement refcount, call destroy if 0
     void release();
-    
-    StringData* data;
-    const char* strPtr;     // direct pointer to string data, necessary to see something in the debugger
-    static const char* emptyString;
+    /// set to empty local string
+    void setEmpty();
+    /// copy from other string, and increment refcount of shared string data
+    void copy(const String& rhs);
+    /// take over other string, and leave it empty
+    void move(String& rhs);
+    /// test if string data is stored locally
+    bool isLocal() const;
+    /// test if string data is shared with refcount
+    bool isShared() const;
+
+    /// the last local byte: remaining local capacity, or a storage tag
+    static const int32 TagIndex = MaxLocalLength;
+    static const uint8 SharedTag = 0x80;
+    static const uint8 ArenaTag = 0x81;
+    static_assert(MaxLocalLength < SharedTag, "local length collides with storage tags");
+    union {
+        struct {
+            StringData* data;       // nullptr for arena strings
+            const char* strPtr;     // direct pointer to string data, necessary to see something in the debugger
+            int32 length;
+        } ext;
+        /// local string data, the last byte doubles as terminating 0 of a full local string
+        char local[MaxLocalLength + 1];
+    };
 };
 
 //------------------------------------------------------------------------------
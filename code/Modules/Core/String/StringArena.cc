@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+//  StringArena.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "StringArena.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+StringArena::StringArena(int32 chunkSize_) :
+chunkSize(chunkSize_) {
+    o_assert(chunkSize_ > 0);
+}
+
+//------------------------------------------------------------------------------
+StringArena::~StringArena() {
+    this->Reset();
+}
+
+//------------------------------------------------------------------------------
+char*
+StringArena::Alloc(int32 len) {
+    o_assert(len >= 0);
+    const int32 size = len + 1;
+    if ((nullptr == this->head) || ((this->head->size - this->head->used) < size)) {
+        chunk* c = this->newChunk(size);
+        if ((nullptr != this->head) && (c->size == size) && ((this->head->size - this->head->used) > 0)) {
+            // a dedicated chunk for an oversized string, keep
+            // filling the current chunk with later strings
+            c->next = this->head->next;
+            this->head->next = c;
+        }
+        else {
+            c->next = this->head;
+            this->head = c;
+        }
+        c->used = size;
+        this->numBytes += size;
+        return (char*) &(c[1]);
+    }
+    char* ptr = ((char*) &(this->head[1])) + this->head->used;
+    this->head->used += size;
+    this->numBytes += size;
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+StringArena::chunk*
+StringArena::newChunk(int32 size) {
+    const int32 capacity = size > this->chunkSize ? size : this->chunkSize;
+    chunk* c = (chunk*) Memory::Alloc(sizeof(chunk) + capacity);
+    c->next = nullptr;
+    c->size = capacity;
+    c->used = 0;
+    this->numChunks++;
+    return c;
+}
+
+//------------------------------------------------------------------------------
+void
+StringArena::Reset() {
+    while (this->head) {
+        chunk* next = this->head->next;
+        Memory::Free(this->head);
+        this->head = next;
+    }
+    this->numChunks = 0;
+    this->numBytes = 0;
+}
+
+//------------------------------------------------------------------------------
+int32
+StringArena::NumChunks() const {
+    return this->numChunks;
+}
+
+//------------------------------------------------------------------------------
+int32
+StringArena::NumBytes() const {
+    return this->numBytes;
+}
+
+} // namespace Oryol
@@ -0,0 +1,62 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::StringArena
+    @ingroup Core
+    @brief bump-allocator for the storage of long-lived String objects
+
+    A StringArena hands out string storage from large chunks, so that
+    many long strings with the same lifetime (for instance the strings
+    of a parsed file or a batch of IO requests) cost a handful of
+    allocations instead of one per string. Memory is only given back
+    when the arena is reset or destroyed, the arena must outlive
+    all String objects created from it. Short strings never touch the
+    arena, they are stored in the String object itself.
+
+    A StringArena is not thread-safe.
+
+    @see String
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class StringArena {
+public:
+    /// default chunk size in bytes
+    static const int32 DefaultChunkSize = 4096;
+
+    /// constructor
+    StringArena(int32 chunkSize = DefaultChunkSize);
+    /// destructor, frees all chunks
+    ~StringArena();
+    /// copying is not allowed
+    StringArena(const StringArena&) = delete;
+    /// copy-assignment is not allowed
+    void operator=(const StringArena&) = delete;
+
+    /// allocate storage for len bytes plus a terminating 0
+    char* Alloc(int32 len);
+    /// free all chunks, all strings created from the arena become invalid
+    void Reset();
+    /// get number of allocated chunks
+    int32 NumChunks() const;
+    /// get number of bytes handed out since the last reset
+    int32 NumBytes() const;
+
+private:
+    struct chunk {
+        chunk* next;
+        int32 size;
+        int32 used;
+    };
+    /// allocate a new chunk with at least numBytes capacity
+    chunk* newChunk(int32 numBytes);
+
+    int32 chunkSize;
+    int32 numChunks = 0;
+    int32 numBytes = 0;
+    chunk* head = nullptr;
+};
+
+} // namespace Oryol
@@ -311,12 +311,15 @@ StringBuilder::PopBack() {
 
 //------------------------------------------------------------------------------
 void
-StringBuilder::substituteCommon(char* occur, int32 matchLen, int32 substLen, const char* subst) {
+StringBuilder::substituteCommon(int32 index, int32 matchLen, int32 substLen, const char* subst) {
     const int32 diff = substLen - matchLen;
     if (diff > 0) {
         this->ensureRoom(diff);
     }
     
+    // NOTE: ensureRoom() may have moved the buffer
+    char* occur = this->buffer + index;
+
     // move tail in or out
     const char* moveFrom = occur + matchLen;
     char* moveTo = occur + substLen;
@@ -347,8 +350,7 @@ StringBuilder::SubstituteRange(int32 startIndex, int32 endIndex, const char* sub
     o_assert(endIndex <= this->size);
     const int32 matchLen = endIndex - startIndex;
     const int32 substLen = int32(std::strlen(subst));
-    char* occur = this->buffer + startIndex;
-    this->substituteCommon(occur, matchLen, substLen, subst);
+    this->substituteCommon(startIndex, matchLen, substLen, subst);
 }
 
 //------------------------------------------------------------------------------
@@ -359,11 +361,15 @@ StringBuilder::SubstituteAll(const char* match, const char* subst) {
 
     int32 numSubst = 0;
     if (nullptr != this->buffer) {
-        char* ptr = this->buffer;
         const int32 matchLen = int32(std::strlen(match));
         const int32 substLen = int32(std::strlen(subst));
-        while (nullptr != (ptr = std::strstr(ptr, match))) {
-            this->substituteCommon(ptr, matchLen, substLen, subst);
+        int32 index = 0;
+        const char* occur;
+        while (nullptr != (occur = std::strstr(this->buffer + index, match))) {
+            // continue searching behind the substitute
+            index = int32(occur - this->buffer);
+            this->substituteCommon(index, matchLen, substLen, subst);
+            index += substLen;
             numSubst++;
         }
     }
@@ -383,11 +389,11 @@ StringBuilder::SubstituteFirst(const char* match, const char* subst) {
     o_assert(match[0] != 0);
     
     if (nullptr != this->buffer) {
-        char* occur = std::strstr(this->buffer, match);
+        const char* occur = std::strstr(this->buffer, match);
         if (nullptr != occur) {
             const int32 matchLen = int32(std::strlen(match));
             const int32 substLen = int32(std::strlen(subst));
-            this->substituteCommon(occur, matchLen, substLen, subst);
+            this->substituteCommon(int32(occur - this->buffer), matchLen, substLen, subst);
             return true;
         }
         else {
@@ -478,9 +484,9 @@ int32
 StringBuilder::FindFirstNotOf(const char* str, int32 startIndex, int32 endIndex, const char* delims) {
     o_assert(0 != delims);
     o_assert(str);
-    o_assert((EndOfString != endIndex) || (endIndex >= startIndex));
+    o_assert((EndOfString == endIndex) || (endIndex >= startIndex));
     const int32 strLen = int32(std::strlen(str));
-    return findFirstOf(str, strLen, startIndex, endIndex, delims);
+    return findFirstNotOf(str, strLen, startIndex, endIndex, delims);
 }
 
 //------------------------------------------------------------------------------
@@ -137,7 +137,7 @@ private:
     /// make sure that at least numBytes are available at end of string buffer 
     void ensureRoom(int32 numBytes);
     /// helper function for Substitute methods
-    void substituteCommon(char* occur, int32 matchLen, int32 substLen, const char* subst);
+    void substituteCommon(int32 index, int32 matchLen, int32 substLen, const char* subst);
     /// helper function for FindFirstOf functions
     static int32 findFirstOf(const char* str, int32 strLen, int32 startIndex, int32 endIndex, const char* delims);
     /// helper function for FindFirstNotOf functions
@@ -4,6 +4,7 @@
 #include "Pre.h"
 #include "Core/Assertion.h"
 #include "StringConverter.h"
+#include "Core/String/stringOps.h"
 #include "Ext/ConvertUTF/ConvertUTF.h"
 #include <cstdlib>
 #include <cstring>
@@ -22,40 +23,41 @@ DumpWarning(ConversionResult convRes) {
 }
 
 //------------------------------------------------------------------------------
+/**
+ Runs of ASCII characters are widened 16 at a time, only multi-byte
+ sequences are decoded one by one.
+*/
 int32
 StringConverter::UTF8ToWide(const unsigned char* src, int32 srcNumBytes, wchar_t* dst, int32 dstMaxBytes) {
     o_assert((0 != src) && (0 != dst));
-    int32 result = 0;
-    const UTF8* srcPtr = src;
 
     // need to keep 1 wchar_t for the terminating 0
-    ConversionResult convRes = conversionOK;
-    wchar_t* dstEndPtr = dst + ((dstMaxBytes / sizeof(wchar_t)) - 1);
-    o_assert(dstEndPtr > dst);
+    const int32 dstMaxChars = int32(dstMaxBytes / sizeof(wchar_t)) - 1;
+    o_assert(dstMaxChars > 0);
+    int32 res;
     if (sizeof(wchar_t) == 4) {
-        UTF32* dstPtr = (UTF32*)dst;
-        convRes = ConvertUTF8toUTF32(&srcPtr, src + srcNumBytes, &dstPtr, (UTF32*) dstEndPtr, strictConversion);
-        o_assert(dstPtr < (UTF32*) (dst + (dstMaxBytes / sizeof(wchar_t))));
-        *dstPtr = 0;
-        if (conversionOK == convRes) {
-            result = int32(dstPtr - (UTF32*)dst) + 1;
-        }
-    } 
+        res = _priv::stringOps::UTF8ToUTF32(src, srcNumBytes, (uint32*)dst, dstMaxChars);
+    }
     else {
         o_assert(2 == sizeof(wchar_t));
-        UTF16* dstPtr = (UTF16*) dst;
-        convRes = ConvertUTF8toUTF16(&srcPtr, src + srcNumBytes, &dstPtr, (UTF16*) dstEndPtr, strictConversion);
-        o_assert(dstPtr < (UTF16*) (dst + (dstMaxBytes / sizeof(wchar_t))));
-        *dstPtr = 0;
-        if (conversionOK == convRes) {
-            result = int32(dstPtr - (UTF16*)dst) + 1;
-        }
+        res = _priv::stringOps::UTF8ToUTF16(src, srcNumBytes, (uint16*)dst, dstMaxChars);
     }
-    if (conversionOK != convRes) {
-        DumpWarning(convRes);
+    if (res < 0) {
+        dst[0] = 0;
+        if (_priv::stringOps::SourceExhausted == res) DumpWarning(sourceExhausted);
+        else if (_priv::stringOps::TargetExhausted == res) DumpWarning(targetExhausted);
+        else DumpWarning(sourceIllegal);
         return 0;
     }
-    return result;
+    dst[res] = 0;
+    return res + 1;
+}
+
+//------------------------------------------------------------------------------
+bool
+StringConverter::IsValidUTF8(const unsigned char* src, int32 srcNumBytes) {
+    o_assert(0 != src);
+    return _priv::stringOps::ValidateUTF8(src, srcNumBytes);
 }
 
 //------------------------------------------------------------------------------
@@ -39,6 +39,8 @@ public:
     static WideString UTF8ToWide(const unsigned char* src);
     /// convert UTF8 string object to wide string object
     static WideString UTF8ToWide(const String& src);
+    /// check if a raw UTF8 string range is valid UTF-8
+    static bool IsValidUTF8(const unsigned char* src, int32 srcNumBytes);
 
 private:
     static const int32 MaxInternalBufferWChars = 128;
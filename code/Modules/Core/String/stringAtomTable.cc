@@ -4,6 +4,7 @@
 #include "Pre.h"
 #include <cstring>
 #include "stringAtomTable.h"
+#include "Core/String/stringOps.h"
 #if ORYOL_USE_VLD
 #include "vld.h"
 #endif
@@ -75,21 +76,9 @@ stringAtomTable::Add(int32 hash, const char* str) {
 //------------------------------------------------------------------------------
 int32
 stringAtomTable::HashForString(const char* str) {
-
-    // see here: http://eternallyconfuzzled.com/tuts/algorithms/jsw_tut_hashing.aspx
-    const char* p = str;
-    int32 h = 0;
-    char c;
-    while (0 != (c = *p++))
-    {
-        h += c;
-        h += (h << 10);
-        h ^= (h >> 6);
-    }
-    h += (h << 3);
-    h ^= (h >> 11);
-    h += (h << 15);
-    return h;
+    // strlen() is vectorized by the C runtime, the hash itself
+    // consumes 8 bytes per step
+    return _priv::stringOps::Hash(str, int32(std::strlen(str)));
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,426 @@
+//------------------------------------------------------------------------------
+//  stringOps.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "stringOps.h"
+#include "Core/Assertion.h"
+#include "Core/Hash/fasthash.h"
+#include <cstring>
+#if ORYOL_SIMD_SSE
+#include <emmintrin.h>
+#elif ORYOL_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#if ORYOL_WINDOWS
+#include <intrin.h>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+// a minimal 16-byte vector abstraction, vmask() returns a bit mask
+// with MaskBitsPerByte bits per byte lane (SSE2 has a movemask
+// instruction, on NEON the mask is narrowed to 4 bits per lane)
+namespace {
+#if ORYOL_SIMD_SSE
+typedef __m128i vec;
+const int32 MaskBitsPerByte = 1;
+inline vec vsplat(uchar c) { return _mm_set1_epi8(char(c)); }
+inline vec vload(const void* p) { return _mm_loadu_si128((const __m128i*)p); }
+inline vec veq(vec a, vec b) { return _mm_cmpeq_epi8(a, b); }
+inline vec vor(vec a, vec b) { return _mm_or_si128(a, b); }
+inline vec vand(vec a, vec b) { return _mm_and_si128(a, b); }
+inline vec vnot(vec a) { return _mm_xor_si128(a, _mm_set1_epi8(char(0xFF))); }
+inline vec vhighbit(vec a) { return _mm_cmplt_epi8(a, _mm_setzero_si128()); }
+inline uint64 vmask(vec a) { return uint32(_mm_movemask_epi8(a)); }
+#define ORYOL_STRINGOPS_SIMD (1)
+#elif ORYOL_SIMD_NEON
+typedef uint8x16_t vec;
+const int32 MaskBitsPerByte = 4;
+inline vec vsplat(uchar c) { return vdupq_n_u8(c); }
+inline vec vload(const void* p) { return vld1q_u8((const uint8_t*)p); }
+inline vec veq(vec a, vec b) { return vceqq_u8(a, b); }
+inline vec vor(vec a, vec b) { return vorrq_u8(a, b); }
+inline vec vand(vec a, vec b) { return vandq_u8(a, b); }
+inline vec vnot(vec a) { return vmvnq_u8(a); }
+inline vec vhighbit(vec a) { return vcgeq_u8(a, vdupq_n_u8(0x80)); }
+inline uint64 vmask(vec a) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(a), 4)), 0);
+}
+#define ORYOL_STRINGOPS_SIMD (1)
+#else
+#define ORYOL_STRINGOPS_SIMD (0)
+#endif
+
+#if ORYOL_STRINGOPS_SIMD
+const uint64 LaneMask = (uint64(1) << MaskBitsPerByte) - 1;
+
+/// byte index of the first lane set in a vmask() result (mask must not be 0)
+inline int32
+firstLane(uint64 mask) {
+    #if ORYOL_WINDOWS
+    unsigned long index;
+    #if defined(_M_X64) || defined(_M_ARM64)
+    _BitScanForward64(&index, mask);
+    #else
+    if (!_BitScanForward(&index, uint32(mask))) {
+        _BitScanForward(&index, uint32(mask >> 32));
+        index += 32;
+    }
+    #endif
+    return int32(index) / MaskBitsPerByte;
+    #else
+    return __builtin_ctzll(mask) / MaskBitsPerByte;
+    #endif
+}
+#endif
+
+/// max number of delimiter characters handled in SIMD registers
+const int32 MaxSIMDDelims = 8;
+
+/// 256-bit membership table for the scalar delimiter scans
+struct charSet {
+    uint32 bits[8];
+    charSet(const char* chars) {
+        std::memset(this->bits, 0, sizeof(this->bits));
+        for (const uchar* p = (const uchar*) chars; *p; p++) {
+            this->bits[*p >> 5] |= 1u << (*p & 31);
+        }
+    };
+    bool Contains(uchar c) const {
+        return 0 != (this->bits[c >> 5] & (1u << (c & 31)));
+    };
+};
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int32
+stringOps::FindSubString(const char* str, int32 len, const char* sub, int32 subLen) {
+    o_assert_dbg(str && sub && (len >= 0) && (subLen > 0));
+    if (subLen > len) {
+        return InvalidIndex;
+    }
+    int32 i = 0;
+    #if ORYOL_STRINGOPS_SIMD
+    // compare the first and last char of sub at 16 positions at
+    // once, only candidates which match both are compared fully
+    // (see http://0x80.pl/articles/simd-strfind.html)
+    const vec first = vsplat(uchar(sub[0]));
+    const vec last = vsplat(uchar(sub[subLen - 1]));
+    for (; (i + subLen - 1 + 16) <= len; i += 16) {
+        // test 32 bytes at once while there are no candidates
+        if ((i + subLen - 1 + 32) <= len) {
+            const vec m0 = vand(veq(first, vload(str + i)), veq(last, vload(str + i + subLen - 1)));
+            const vec m1 = vand(veq(first, vload(str + i + 16)), veq(last, vload(str + i + 16 + subLen - 1)));
+            if (0 == vmask(vor(m0, m1))) {
+                i += 16;
+                continue;
+            }
+        }
+        const vec blockFirst = vload(str + i);
+        const vec blockLast = vload(str + i + subLen - 1);
+        uint64 mask = vmask(vand(veq(first, blockFirst), veq(last, blockLast)));
+        while (0 != mask) {
+            const int32 lane = firstLane(mask);
+            if ((subLen <= 2) || (0 == std::memcmp(str + i + lane + 1, sub + 1, subLen - 2))) {
+                return i + lane;
+            }
+            mask &= ~(LaneMask << (lane * MaskBitsPerByte));
+        }
+    }
+    #endif
+    for (; (i + subLen) <= len; i++) {
+        if ((str[i] == sub[0]) && (0 == std::memcmp(str + i + 1, sub + 1, subLen - 1))) {
+            return i;
+        }
+    }
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+int32
+stringOps::FindFirstOf(const char* str, int32 len, const char* delims) {
+    o_assert_dbg(str && delims && (len >= 0));
+    int32 i = 0;
+    #if ORYOL_STRINGOPS_SIMD
+    const int32 numDelims = int32(std::strlen(delims));
+    if ((numDelims > 0) && (numDelims <= MaxSIMDDelims)) {
+        vec d[MaxSIMDDelims];
+        for (int32 j = 0; j < numDelims; j++) {
+            d[j] = vsplat(uchar(delims[j]));
+        }
+        for (; (i + 16) <= len; i += 16) {
+            const vec block = vload(str + i);
+            vec match = veq(block, d[0]);
+            for (int32 j = 1; j < numDelims; j++) {
+                match = vor(match, veq(block, d[j]));
+            }
+            const uint64 mask = vmask(match);
+            if (0 != mask) {
+                return i + firstLane(mask);
+            }
+        }
+    }
+    #endif
+    if (i < len) {
+        // only build the table if there's a scalar tail left
+        const charSet set(delims);
+        for (; i < len; i++) {
+            if (set.Contains(uchar(str[i]))) {
+                return i;
+            }
+        }
+    }
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+int32
+stringOps::FindFirstNotOf(const char* str, int32 len, const char* delims) {
+    o_assert_dbg(str && delims && (len >= 0));
+    int32 i = 0;
+    #if ORYOL_STRINGOPS_SIMD
+    const int32 numDelims = int32(std::strlen(delims));
+    if ((numDelims > 0) && (numDelims <= MaxSIMDDelims)) {
+        vec d[MaxSIMDDelims];
+        for (int32 j = 0; j < numDelims; j++) {
+            d[j] = vsplat(uchar(delims[j]));
+        }
+        for (; (i + 16) <= len; i += 16) {
+            const vec block = vload(str + i);
+            vec match = veq(block, d[0]);
+            for (int32 j = 1; j < numDelims; j++) {
+                match = vor(match, veq(block, d[j]));
+            }
+            const uint64 mask = vmask(vnot(match));
+            if (0 != mask) {
+                return i + firstLane(mask);
+            }
+        }
+    }
+    #endif
+    if (i < len) {
+        // only build the table if there's a scalar tail left
+        const charSet set(delims);
+        for (; i < len; i++) {
+            if (!set.Contains(uchar(str[i]))) {
+                return i;
+            }
+        }
+    }
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+/**
+ The hash consumes 8 bytes per step (fasthash), 0 is reserved as
+ 'no hash' by the StringAtom table.
+*/
+int32
+stringOps::Hash(const char* str, int32 len) {
+    o_assert_dbg(str && (len >= 0));
+    const uint32 h = fasthash32(str, size_t(len), 0x5bd1e995);
+    return (0 != h) ? int32(h) : 1;
+}
+
+//------------------------------------------------------------------------------
+int32
+stringOps::ASCIIPrefix(const uchar* str, int32 len) {
+    o_assert_dbg(str && (len >= 0));
+    int32 i = 0;
+    #if ORYOL_STRINGOPS_SIMD
+    for (; (i + 16) <= len; i += 16) {
+        const uint64 mask = vmask(vhighbit(vload(str + i)));
+        if (0 != mask) {
+            return i + firstLane(mask);
+        }
+    }
+    #endif
+    while ((i < len) && (str[i] < 0x80)) {
+        i++;
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Decodes a sequence starting with a non-ASCII byte, following the
+ same rules as ConvertUTF's strict mode: overlong encodings, surrogate
+ code points and code points above U+10FFFF are illegal.
+*/
+int32
+stringOps::decodeSequence(const uchar* src, int32 srcLen, uint32& outCodePoint) {
+    const uchar c0 = src[0];
+    int32 num = 0;
+    uchar min1 = 0x80;
+    uchar max1 = 0xBF;
+    if (c0 < 0xC2) {
+        // continuation byte or overlong 2-byte sequence
+        return SourceIllegal;
+    }
+    else if (c0 < 0xE0) {
+        num = 2;
+        outCodePoint = c0 & 0x1F;
+    }
+    else if (c0 < 0xF0) {
+        num = 3;
+        outCodePoint = c0 & 0x0F;
+        if (0xE0 == c0) min1 = 0xA0;        // overlong
+        else if (0xED == c0) max1 = 0x9F;   // surrogates
+    }
+    else if (c0 < 0xF5) {
+        num = 4;
+        outCodePoint = c0 & 0x07;
+        if (0xF0 == c0) min1 = 0x90;        // overlong
+        else if (0xF4 == c0) max1 = 0x8F;   // > U+10FFFF
+    }
+    else {
+        return SourceIllegal;
+    }
+    if (srcLen < num) {
+        return SourceExhausted;
+    }
+    if ((src[1] < min1) || (src[1] > max1)) {
+        return SourceIllegal;
+    }
+    for (int32 i = 1; i < num; i++) {
+        if ((src[i] & 0xC0) != 0x80) {
+            return SourceIllegal;
+        }
+        outCodePoint = (outCodePoint << 6) | (src[i] & 0x3F);
+    }
+    return num;
+}
+
+//------------------------------------------------------------------------------
+bool
+stringOps::ValidateUTF8(const uchar* str, int32 len) {
+    o_assert_dbg(str && (len >= 0));
+    int32 i = 0;
+    while (i < len) {
+        i += ASCIIPrefix(str + i, len - i);
+        if (i < len) {
+            uint32 cp;
+            const int32 num = decodeSequence(str + i, len - i, cp);
+            if (num < 0) {
+                return false;
+            }
+            i += num;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int32
+stringOps::UTF8ToUTF32(const uchar* src, int32 srcLen, uint32* dst, int32 dstMaxChars) {
+    o_assert_dbg(src && dst && (srcLen >= 0) && (dstMaxChars >= 0));
+    int32 si = 0;
+    int32 di = 0;
+    while (si < srcLen) {
+        // widen runs of ASCII characters 16 at a time
+        #if ORYOL_STRINGOPS_SIMD
+        for (; ((si + 16) <= srcLen) && ((di + 16) <= dstMaxChars); si += 16, di += 16) {
+            const vec block = vload(src + si);
+            if (0 != vmask(vhighbit(block))) {
+                break;
+            }
+            #if ORYOL_SIMD_SSE
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i lo = _mm_unpacklo_epi8(block, zero);
+            const __m128i hi = _mm_unpackhi_epi8(block, zero);
+            _mm_storeu_si128((__m128i*)(dst + di), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(dst + di + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(dst + di + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i*)(dst + di + 12), _mm_unpackhi_epi16(hi, zero));
+            #else
+            const uint16x8_t lo = vmovl_u8(vget_low_u8(block));
+            const uint16x8_t hi = vmovl_u8(vget_high_u8(block));
+            vst1q_u32(dst + di, vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(dst + di + 4, vmovl_u16(vget_high_u16(lo)));
+            vst1q_u32(dst + di + 8, vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(dst + di + 12, vmovl_u16(vget_high_u16(hi)));
+            #endif
+        }
+        if (si >= srcLen) {
+            break;
+        }
+        #endif
+        if (di >= dstMaxChars) {
+            return TargetExhausted;
+        }
+        if (src[si] < 0x80) {
+            dst[di++] = src[si++];
+        }
+        else {
+            uint32 cp;
+            const int32 num = decodeSequence(src + si, srcLen - si, cp);
+            if (num < 0) {
+                return num;
+            }
+            dst[di++] = cp;
+            si += num;
+        }
+    }
+    return di;
+}
+
+//------------------------------------------------------------------------------
+int32
+stringOps::UTF8ToUTF16(const uchar* src, int32 srcLen, uint16* dst, int32 dstMaxChars) {
+    o_assert_dbg(src && dst && (srcLen >= 0) && (dstMaxChars >= 0));
+    int32 si = 0;
+    int32 di = 0;
+    while (si < srcLen) {
+        // widen runs of ASCII characters 16 at a time
+        #if ORYOL_STRINGOPS_SIMD
+        for (; ((si + 16) <= srcLen) && ((di + 16) <= dstMaxChars); si += 16, di += 16) {
+            const vec block = vload(src + si);
+            if (0 != vmask(vhighbit(block))) {
+                break;
+            }
+            #if ORYOL_SIMD_SSE
+            const __m128i zero = _mm_setzero_si128();
+            _mm_storeu_si128((__m128i*)(dst + di), _mm_unpacklo_epi8(block, zero));
+            _mm_storeu_si128((__m128i*)(dst + di + 8), _mm_unpackhi_epi8(block, zero));
+            #else
+            vst1q_u16(dst + di, vmovl_u8(vget_low_u8(block)));
+            vst1q_u16(dst + di + 8, vmovl_u8(vget_high_u8(block)));
+            #endif
+        }
+        if (si >= srcLen) {
+            break;
+        }
+        #endif
+        if (di >= dstMaxChars) {
+            return TargetExhausted;
+        }
+        if (src[si] < 0x80) {
+            dst[di++] = src[si++];
+        }
+        else {
+            uint32 cp;
+            const int32 num = decodeSequence(src + si, srcLen - si, cp);
+            if (num < 0) {
+                return num;
+            }
+            if (cp > 0xFFFF) {
+                // surrogate pair
+                if ((di + 1) >= dstMaxChars) {
+                    return TargetExhausted;
+                }
+                cp -= 0x10000;
+                dst[di++] = uint16(0xD800 + (cp >> 10));
+                dst[di++] = uint16(0xDC00 + (cp & 0x3FF));
+            }
+            else {
+                dst[di++] = uint16(cp);
+            }
+            si += num;
+        }
+    }
+    return di;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,54 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::stringOps
+    @ingroup _priv
+    @brief vectorized low-level string scanning, hashing and UTF-8 decoding
+
+    The building blocks behind StringAtom hashing and
+    StringConverter::UTF8ToWide(), plus search functions for strings
+    which aren't null-terminated. All functions work on strings with
+    a known length. StringBuilder keeps using strstr/strcspn/strspn,
+    the C runtime versions are faster than the SSE2 searches here. The SSE2 and NEON code paths scan 16 bytes per
+    step and never read past the end of the string. The scalar code paths
+    produce exactly the same results.
+*/
+#include "Core/Config.h"
+#include "Core/Types.h"
+
+namespace Oryol {
+namespace _priv {
+
+class stringOps {
+public:
+    /// UTF-8 decoding error: illegal byte sequence
+    static const int32 SourceIllegal = -1;
+    /// UTF-8 decoding error: destination buffer too small
+    static const int32 TargetExhausted = -2;
+    /// UTF-8 decoding error: byte sequence cut off at end of source
+    static const int32 SourceExhausted = -3;
+
+    /// find first occurrence of sub in str, return InvalidIndex if not found
+    static int32 FindSubString(const char* str, int32 len, const char* sub, int32 subLen);
+    /// find first character in str which is in delims, return InvalidIndex if not found
+    static int32 FindFirstOf(const char* str, int32 len, const char* delims);
+    /// find first character in str which is not in delims, return InvalidIndex if not found
+    static int32 FindFirstNotOf(const char* str, int32 len, const char* delims);
+    /// compute a (never 0) 32-bit hash of a string
+    static int32 Hash(const char* str, int32 len);
+    /// get number of leading 7-bit ASCII bytes
+    static int32 ASCIIPrefix(const uchar* str, int32 len);
+    /// check if str is a valid UTF-8 sequence
+    static bool ValidateUTF8(const uchar* str, int32 len);
+    /// decode UTF-8 to UTF-32, return number of written chars or error code
+    static int32 UTF8ToUTF32(const uchar* src, int32 srcLen, uint32* dst, int32 dstMaxChars);
+    /// decode UTF-8 to UTF-16, return number of written chars or error code
+    static int32 UTF8ToUTF16(const uchar* src, int32 srcLen, uint16* dst, int32 dstMaxChars);
+
+private:
+    /// decode one multi-byte UTF-8 sequence, return number of bytes or error code
+    static int32 decodeSequence(const uchar* src, int32 srcLen, uint32& outCodePoint);
+};
+
+} // namespace _priv
+} // namespace Oryol
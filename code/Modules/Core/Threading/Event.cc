@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+//  Event.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Event.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+using namespace _priv;
+
+/// number of spin iterations before a waiting thread goes to sleep
+static const int32 MaxSpins = 1000;
+
+//------------------------------------------------------------------------------
+Event::Event(bool manualReset_) :
+manualReset(manualReset_) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+Event::~Event() {
+    this->EnableStats(false);
+}
+
+//------------------------------------------------------------------------------
+void
+Event::Signal() {
+    this->signaled.store(1, std::memory_order_seq_cst);
+    if (this->numSleepers.load(std::memory_order_seq_cst) > 0) {
+        if (this->manualReset) {
+            futex::WakeAll(&this->signaled);
+        }
+        else {
+            futex::WakeOne(&this->signaled);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Event::Reset() {
+    this->signaled.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool
+Event::waitSlow(int32 timeoutMs) {
+    const int64 startTime = lockStatsCounter::now();
+    int32 spins = 0;
+    int32 waits = 0;
+    bool acquired = false;
+    for (;;) {
+        if (this->tryConsume()) {
+            acquired = true;
+            break;
+        }
+        if (spins < MaxSpins) {
+            spins++;
+            futex::CpuRelax();
+            continue;
+        }
+        int32 remainingMs = futex::Infinite;
+        if (futex::Infinite != timeoutMs) {
+            remainingMs = timeoutMs - int32((lockStatsCounter::now() - startTime) / 1000);
+            if (remainingMs <= 0) {
+                break;
+            }
+        }
+        // register as sleeper before re-checking, Signal() sets
+        // the flag before checking for sleepers
+        this->numSleepers.fetch_add(1, std::memory_order_seq_cst);
+        if (0 == this->signaled.load(std::memory_order_seq_cst)) {
+            waits++;
+            futex::Wait(&this->signaled, 0, remainingMs);
+        }
+        this->numSleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (this->stats) {
+        if (acquired) {
+            this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+        }
+        this->stats->contended(spins, waits, startTime);
+    }
+    return acquired;
+}
+
+//------------------------------------------------------------------------------
+void
+Event::EnableStats(bool b) {
+    if (b && !this->stats) {
+        this->stats = Memory::New<lockStatsCounter>();
+    }
+    else if (!b && this->stats) {
+        Memory::Delete(this->stats);
+        this->stats = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+LockStats
+Event::Stats() const {
+    return this->stats ? this->stats->get() : LockStats();
+}
+
+//------------------------------------------------------------------------------
+void
+Event::ResetStats() {
+    if (this->stats) {
+        this->stats->reset();
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,99 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Event
+    @ingroup Core
+    @brief a signal which threads can wait on
+
+    An auto-reset Event (the default) releases exactly one waiting
+    thread per Signal() and is reset when that thread wakes up. A
+    manual-reset Event releases all waiting threads and stays signaled
+    until Reset() is called. A waiting thread spins briefly and then
+    sleeps in the kernel (see _priv::futex). Signal() only makes a
+    syscall if a thread is actually sleeping.
+
+    @see Semaphore, Mutex, LockStats
+*/
+#include "Core/Types.h"
+#include "Core/Threading/LockStats.h"
+#include "Core/Threading/futex.h"
+#include <atomic>
+
+namespace Oryol {
+
+class Event {
+public:
+    /// constructor
+    Event(bool manualReset = false);
+    /// destructor
+    ~Event();
+    /// copying is not allowed
+    Event(const Event&) = delete;
+    /// copy-assignment is not allowed
+    void operator=(const Event&) = delete;
+
+    /// set the event to signaled, wakes up waiting threads
+    void Signal();
+    /// set the event to non-signaled
+    void Reset();
+    /// test if the event is signaled
+    bool IsSignaled() const;
+    /// wait until the event is signaled
+    void Wait();
+    /// like Wait(), but give up after a timeout, returns false on timeout
+    bool TimedWait(int32 timeoutMs);
+
+    /// enable or disable contention statistics
+    void EnableStats(bool b);
+    /// get contention statistics
+    LockStats Stats() const;
+    /// reset contention statistics
+    void ResetStats();
+
+private:
+    /// check for and consume (if auto-reset) the signal
+    bool tryConsume();
+    /// contended wait path
+    bool waitSlow(int32 timeoutMs);
+
+    std::atomic<int32> signaled{0};
+    std::atomic<int32> numSleepers{0};
+    bool manualReset;
+    _priv::lockStatsCounter* stats = nullptr;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+Event::tryConsume() {
+    if (this->manualReset) {
+        return 0 != this->signaled.load(std::memory_order_acquire);
+    }
+    int32 expected = 1;
+    return this->signaled.compare_exchange_strong(expected, 0, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+inline void
+Event::Wait() {
+    this->TimedWait(_priv::futex::Infinite);
+}
+
+//------------------------------------------------------------------------------
+inline bool
+Event::TimedWait(int32 timeoutMs) {
+    if (this->tryConsume()) {
+        if (this->stats) {
+            this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return this->waitSlow(timeoutMs);
+}
+
+//------------------------------------------------------------------------------
+inline bool
+Event::IsSignaled() const {
+    return 0 != this->signaled.load(std::memory_order_acquire);
+}
+
+} // namespace Oryol
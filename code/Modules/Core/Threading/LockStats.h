@@ -0,0 +1,77 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::LockStats
+    @ingroup Core
+    @brief contention statistics of a Mutex, RWLock, Semaphore or Event
+
+    Statistics are off by default. They are switched on per instance with
+    EnableStats(true), which must happen before the object is used by
+    several threads. Only the uncontended acquire path pays for
+    NumAcquired (one relaxed atomic increment). All other counters are
+    only updated when a thread actually has to spin or wait.
+*/
+#include "Core/Types.h"
+#include <atomic>
+#include <chrono>
+
+namespace Oryol {
+
+struct LockStats {
+    /// number of successful acquires
+    int64 NumAcquired = 0;
+    /// number of acquires which couldn't take the fast path
+    int64 NumContended = 0;
+    /// number of spin iterations in contended acquires
+    int64 NumSpins = 0;
+    /// number of times a thread went to sleep in the kernel
+    int64 NumWaits = 0;
+    /// total time spent in contended acquires in microseconds
+    int64 WaitMicroSecs = 0;
+};
+
+namespace _priv {
+
+/// atomic counters behind LockStats
+class lockStatsCounter {
+public:
+    std::atomic<int64> numAcquired{0};
+    std::atomic<int64> numContended{0};
+    std::atomic<int64> numSpins{0};
+    std::atomic<int64> numWaits{0};
+    std::atomic<int64> waitMicroSecs{0};
+
+    /// get current timestamp in microseconds
+    static int64 now() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+    /// record a contended acquire
+    void contended(int32 spins, int32 waits, int64 startMicroSecs) {
+        this->numContended.fetch_add(1, std::memory_order_relaxed);
+        this->numSpins.fetch_add(spins, std::memory_order_relaxed);
+        this->numWaits.fetch_add(waits, std::memory_order_relaxed);
+        this->waitMicroSecs.fetch_add(now() - startMicroSecs, std::memory_order_relaxed);
+    };
+    /// get a snapshot of the counters
+    LockStats get() const {
+        LockStats s;
+        s.NumAcquired = this->numAcquired.load(std::memory_order_relaxed);
+        s.NumContended = this->numContended.load(std::memory_order_relaxed);
+        s.NumSpins = this->numSpins.load(std::memory_order_relaxed);
+        s.NumWaits = this->numWaits.load(std::memory_order_relaxed);
+        s.WaitMicroSecs = this->waitMicroSecs.load(std::memory_order_relaxed);
+        return s;
+    };
+    /// reset all counters
+    void reset() {
+        this->numAcquired = 0;
+        this->numContended = 0;
+        this->numSpins = 0;
+        this->numWaits = 0;
+        this->waitMicroSecs = 0;
+    };
+};
+
+} // namespace _priv
+} // namespace Oryol
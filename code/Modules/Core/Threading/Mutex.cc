@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+//  Mutex.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Mutex.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include <algorithm>
+
+namespace Oryol {
+
+using namespace _priv;
+
+/// lower and upper bound for the adaptive spin count
+static const int32 MinSpins = 16;
+static const int32 MaxSpins = 2000;
+
+//------------------------------------------------------------------------------
+Mutex::~Mutex() {
+    o_assert_dbg(0 == this->state);
+    this->EnableStats(false);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The spin phase only tries to grab the lock when it looks free, so that
+ spinning threads don't keep stealing the cache line from the owner. The
+ spin estimate moves towards the number of spins that were needed when
+ spinning succeeded, and shrinks when spinning failed, so that a mutex
+ which is usually held for a long time quickly goes to sleep instead.
+*/
+void
+Mutex::lockSlow() {
+    const int64 startTime = this->stats ? lockStatsCounter::now() : 0;
+    const int32 estimate = this->spinEstimate.load(std::memory_order_relaxed);
+    const int32 maxSpins = std::min(MaxSpins, std::max(MinSpins, estimate * 2));
+    int32 spins = 0;
+    int32 waits = 0;
+    bool acquired = false;
+    for (; spins < maxSpins; spins++) {
+        if (0 == this->state.load(std::memory_order_relaxed)) {
+            int32 expected = 0;
+            if (this->state.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                acquired = true;
+                break;
+            }
+        }
+        futex::CpuRelax();
+    }
+    if (acquired) {
+        this->spinEstimate.store(estimate + (spins - estimate) / 8, std::memory_order_relaxed);
+    }
+    else {
+        this->spinEstimate.store(std::max(0, estimate - (estimate / 8) - 1), std::memory_order_relaxed);
+
+        // mark the mutex as having sleepers and go to sleep, the owner
+        // will wake up one thread when unlocking
+        int32 cur = this->state.exchange(2, std::memory_order_acquire);
+        while (0 != cur) {
+            waits++;
+            futex::Wait(&this->state, 2);
+            cur = this->state.exchange(2, std::memory_order_acquire);
+        }
+    }
+    if (this->stats) {
+        this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+        this->stats->contended(spins, waits, startTime);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Mutex::EnableStats(bool b) {
+    if (b && !this->stats) {
+        this->stats = Memory::New<lockStatsCounter>();
+    }
+    else if (!b && this->stats) {
+        Memory::Delete(this->stats);
+        this->stats = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+LockStats
+Mutex::Stats() const {
+    return this->stats ? this->stats->get() : LockStats();
+}
+
+//------------------------------------------------------------------------------
+void
+Mutex::ResetStats() {
+    if (this->stats) {
+        this->stats->reset();
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,111 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Mutex
+    @ingroup Core
+    @brief adaptive spin-then-sleep mutex
+
+    An uncontended Lock()/Unlock() pair is one compare-exchange and one
+    exchange. When the mutex is taken, a thread spins for a bounded
+    number of iterations and then sleeps in the kernel (see _priv::futex)
+    until the owner unlocks. The spin limit adapts per mutex to how
+    long it usually takes to get the lock by spinning. Short critical
+    sections are acquired without a syscall. Long or oversubscribed
+    ones don't burn CPU.
+
+    The mutex is not recursive.
+
+    @see ScopedLock, RWLock, LockStats
+*/
+#include "Core/Types.h"
+#include "Core/Threading/LockStats.h"
+#include "Core/Threading/futex.h"
+#include <atomic>
+
+namespace Oryol {
+
+class Mutex {
+public:
+    /// constructor
+    Mutex() = default;
+    /// destructor
+    ~Mutex();
+    /// copying is not allowed
+    Mutex(const Mutex&) = delete;
+    /// copy-assignment is not allowed
+    void operator=(const Mutex&) = delete;
+
+    /// acquire the lock
+    void Lock();
+    /// try to acquire the lock without waiting
+    bool TryLock();
+    /// release the lock
+    void Unlock();
+
+    /// enable or disable contention statistics
+    void EnableStats(bool b);
+    /// get contention statistics
+    LockStats Stats() const;
+    /// reset contention statistics
+    void ResetStats();
+
+private:
+    /// contended lock path
+    void lockSlow();
+
+    /// 0: unlocked, 1: locked, 2: locked with (possible) sleepers
+    std::atomic<int32> state{0};
+    /// running average of spins needed to get the lock
+    std::atomic<int32> spinEstimate{0};
+    _priv::lockStatsCounter* stats = nullptr;
+};
+
+/// lock a Mutex for the current scope
+class ScopedLock {
+public:
+    /// constructor, locks the mutex
+    ScopedLock(Mutex& m) : mutex(m) {
+        this->mutex.Lock();
+    };
+    /// destructor, unlocks the mutex
+    ~ScopedLock() {
+        this->mutex.Unlock();
+    };
+private:
+    Mutex& mutex;
+};
+
+//------------------------------------------------------------------------------
+inline void
+Mutex::Lock() {
+    int32 expected = 0;
+    if (!this->state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        this->lockSlow();
+    }
+    else if (this->stats) {
+        this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline bool
+Mutex::TryLock() {
+    int32 expected = 0;
+    if (this->state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        if (this->stats) {
+            this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+inline void
+Mutex::Unlock() {
+    if (2 == this->state.exchange(0, std::memory_order_release)) {
+        _priv::futex::WakeOne(&this->state);
+    }
+}
+
+} // namespace Oryol
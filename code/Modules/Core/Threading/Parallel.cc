@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//  Parallel.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Parallel.h"
+#include "Core/Threading/WorkerPool.h"
+#include <atomic>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
+
+namespace Oryol {
+
+namespace {
+
+/// the state of one run() call, shared by the calling thread and the helper jobs
+struct task {
+    int32 num = 0;
+    int32 numChunks = 0;
+    int32 chunkSize = 0;
+    void (*func)(int32 chunkIndex, int32 begin, int32 end, void* userData) = nullptr;
+    void* userData = nullptr;
+    std::atomic<int32> nextChunk{0};
+    std::atomic<int32> numHelpersDone{0};
+
+    /// run chunks until all chunks have been handed out
+    void runChunks() {
+        int32 chunkIndex;
+        while ((chunkIndex = this->nextChunk.fetch_add(1, std::memory_order_relaxed)) < this->numChunks) {
+            const int32 begin = chunkIndex * this->chunkSize;
+            const int32 end = (begin + this->chunkSize) < this->num ? (begin + this->chunkSize) : this->num;
+            this->func(chunkIndex, begin, end, this->userData);
+        }
+    }
+};
+
+/// the WorkerPool job function of the helpers
+void
+helperJob(void* userData) {
+    task* t = (task*) userData;
+    t->runChunks();
+    t->numHelpersDone.fetch_add(1, std::memory_order_release);
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void
+Parallel::chunkRange(int32 num, int32 numChunks, int32 chunkIndex, int32& outBegin, int32& outEnd) {
+    const int32 chunkSize = (num + numChunks - 1) / numChunks;
+    outBegin = chunkIndex * chunkSize;
+    outEnd = outBegin + chunkSize;
+    if (outEnd > num) {
+        outEnd = num;
+    }
+}
+
+//------------------------------------------------------------------------------
+int32
+Parallel::numChunks(int32 num, int32 grainSize, int32 maxChunks) {
+    o_assert_dbg((grainSize > 0) && (maxChunks > 0));
+    if (num <= 0) {
+        return 0;
+    }
+    int32 n = (num + grainSize - 1) / grainSize;
+    if (n > maxChunks) {
+        n = maxChunks;
+    }
+    // rounding up the chunk size may leave the last chunks empty, drop those
+    const int32 chunkSize = (num + n - 1) / n;
+    return (num + chunkSize - 1) / chunkSize;
+}
+
+//------------------------------------------------------------------------------
+int32
+Parallel::numSortChunks(int32 num, int32 grainSize) {
+    // a few chunks per thread is enough to balance the load, more
+    // chunks only add merge passes and histograms
+    int32 numThreads = 1;
+    if (WorkerPool::IsValid()) {
+        numThreads += WorkerPool::NumWorkers();
+    }
+    const int32 maxChunks = 2 * numThreads;
+    return numChunks(num, grainSize, maxChunks < MaxChunks ? maxChunks : MaxChunks);
+}
+
+//------------------------------------------------------------------------------
+/**
+ Runs the chunks on the calling thread and up to NumWorkers() helper
+ jobs. Chunks are handed out through an atomic counter. The task lives
+ on the stack of the calling thread, so run() doesn't return before
+ all helper jobs have left it. Helper jobs which are still queued
+ when the last chunk is done are taken back with RunOwn() (they
+ find no chunks left and return right away).
+*/
+void
+Parallel::run(int32 num, int32 numChunks, chunkFunc func, void* userData) {
+    int32 numHelpers = 0;
+    if (WorkerPool::IsValid()) {
+        numHelpers = WorkerPool::NumWorkers();
+        if (numHelpers > (numChunks - 1)) {
+            numHelpers = numChunks - 1;
+        }
+    }
+    if (numHelpers <= 0) {
+        int32 begin, end;
+        for (int32 i = 0; i < numChunks; i++) {
+            chunkRange(num, numChunks, i, begin, end);
+            func(i, begin, end, userData);
+        }
+        return;
+    }
+
+    task t;
+    t.num = num;
+    t.numChunks = numChunks;
+    t.chunkSize = (num + numChunks - 1) / numChunks;
+    t.func = func;
+    t.userData = userData;
+    for (int32 i = 0; i < numHelpers; i++) {
+        WorkerPool::Push(helperJob, &t, &t);
+    }
+    t.runChunks();
+    while (t.numHelpersDone.load(std::memory_order_acquire) < numHelpers) {
+        if (!WorkerPool::RunOwn(&t)) {
+            #if ORYOL_HAS_THREADS
+            std::this_thread::yield();
+            #endif
+        }
+    }
+}
+
+} // namespace Oryol
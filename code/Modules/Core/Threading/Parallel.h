@@ -0,0 +1,384 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Parallel
+    @ingroup Core
+    @brief data-parallel algorithms running on the WorkerPool
+
+    Parallel::For(), Reduce(), Scan(), Sort() and RadixSort() split their
+    input into chunks of at least grainSize items. The chunks are
+    picked up by the WorkerPool threads and the calling thread, and the
+    functions return when all chunks are done. Once the chunks have
+    been handed out, the calling thread takes back its own helper jobs
+    which no worker has started yet and only waits for the running
+    ones. It never runs unrelated WorkerPool jobs, so the algorithms
+    can be called from within jobs and from threads with deadlines
+    (like an audio thread).
+
+    Pick the grain size so that one chunk does a few microseconds of
+    work. Inputs smaller than the grain size run on the calling thread.
+    Without a WorkerPool (or without worker threads) everything runs
+    on the calling thread.
+
+    The chunk layout of For(), Reduce() and Scan() only depends on the
+    number of items and the grain size, not on the number of
+    workers. Floating point results are reproducible across machines.
+    Sort() is a stable merge sort, RadixSort() a stable LSD radix sort
+    on unsigned integer keys.
+
+    @code
+    Parallel::For(0, particles.Size(), 4096, [&](int32 i) {
+        particles[i].pos += particles[i].vec * dt;
+    });
+    float32 sum = Parallel::Reduce(0, values.Size(), 4096, 0.0f,
+        [&](int32 i) { return values[i]; },
+        [](float32 a, float32 b) { return a + b; });
+    Parallel::RadixSort(drawCalls, 4096, [](const DrawCall& dc) { return dc.SortKey; });
+    @endcode
+
+    @see WorkerPool, Slice
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Slice.h"
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace Oryol {
+
+class Parallel {
+public:
+    /// max number of chunks an input is split into
+    static const int32 MaxChunks = 256;
+
+    /// call func(int32 index) for each index in [begin, end)
+    template<class FUNC> static void For(int32 begin, int32 end, int32 grainSize, const FUNC& func);
+    /// combine map(int32 index) for each index in [begin, end) into init
+    template<class TYPE, class MAP, class COMBINE> static TYPE Reduce(int32 begin, int32 end, int32 grainSize, TYPE init, const MAP& map, const COMBINE& combine);
+    /// exclusive prefix scan from src into dst (may be identical), returns the total
+    template<class TYPE, class OP> static TYPE Scan(Slice<const TYPE> src, Slice<TYPE> dst, int32 grainSize, TYPE init, const OP& op);
+    /// stable merge sort with less(a, b)
+    template<class TYPE, class LESS> static void Sort(Slice<TYPE> items, int32 grainSize, const LESS& less);
+    /// stable merge sort of an array with less(a, b)
+    template<class TYPE, class LESS> static void Sort(Array<TYPE>& items, int32 grainSize, const LESS& less);
+    /// stable radix sort by an unsigned integer key(item)
+    template<class TYPE, class KEY> static void RadixSort(Slice<TYPE> items, int32 grainSize, const KEY& key);
+    /// stable radix sort of an array by an unsigned integer key(item)
+    template<class TYPE, class KEY> static void RadixSort(Array<TYPE>& items, int32 grainSize, const KEY& key);
+
+private:
+    /// a chunk function, called with the chunk index and the item range of the chunk
+    typedef void (*chunkFunc)(int32 chunkIndex, int32 begin, int32 end, void* userData);
+    /// number of chunks for num items, capped at maxChunks, never produces empty chunks
+    static int32 numChunks(int32 num, int32 grainSize, int32 maxChunks);
+    /// number of chunks for the sort functions, derived from the number of workers
+    static int32 numSortChunks(int32 num, int32 grainSize);
+    /// run func for all chunks of [0, num), return when all are done
+    static void run(int32 num, int32 numChunks, chunkFunc func, void* userData);
+    /// get item range of a chunk
+    static void chunkRange(int32 num, int32 numChunks, int32 chunkIndex, int32& outBegin, int32& outEnd);
+    /// find split point of a stable merge of a and b at output position d
+    template<class TYPE, class LESS> static int32 coRank(const TYPE* a, int32 numA, const TYPE* b, int32 numB, int32 d, const LESS& less);
+    /// merge two sorted runs into dst in parallel
+    template<class TYPE, class LESS> static void merge(TYPE* a, int32 numA, TYPE* b, int32 numB, TYPE* dst, int32 grainSize, const LESS& less);
+};
+
+//------------------------------------------------------------------------------
+template<class FUNC> void
+Parallel::For(int32 begin, int32 end, int32 grainSize, const FUNC& func) {
+    o_assert_dbg((end >= begin) && (grainSize > 0));
+    struct context {
+        const FUNC* func;
+        int32 offset;
+    } ctx = { &func, begin };
+    run(end - begin, numChunks(end - begin, grainSize, MaxChunks), [](int32, int32 first, int32 last, void* userData) {
+        const context* ctx = (const context*) userData;
+        for (int32 i = first; i < last; i++) {
+            (*ctx->func)(i + ctx->offset);
+        }
+    }, &ctx);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class MAP, class COMBINE> TYPE
+Parallel::Reduce(int32 begin, int32 end, int32 grainSize, TYPE init, const MAP& map, const COMBINE& combine) {
+    o_assert_dbg((end >= begin) && (grainSize > 0));
+    const int32 num = end - begin;
+    if (0 == num) {
+        return init;
+    }
+    struct context {
+        const MAP* map;
+        const COMBINE* combine;
+        int32 offset;
+        Array<TYPE> partials;
+    } ctx;
+    ctx.map = &map;
+    ctx.combine = &combine;
+    ctx.offset = begin;
+    const int32 chunks = numChunks(num, grainSize, MaxChunks);
+    ctx.partials.Reserve(chunks);
+    for (int32 i = 0; i < chunks; i++) {
+        ctx.partials.Add(init);
+    }
+    run(num, chunks, [](int32 chunkIndex, int32 first, int32 last, void* userData) {
+        context* ctx = (context*) userData;
+        TYPE acc = (*ctx->map)(first + ctx->offset);
+        for (int32 i = first + 1; i < last; i++) {
+            acc = (*ctx->combine)(acc, (*ctx->map)(i + ctx->offset));
+        }
+        ctx->partials[chunkIndex] = acc;
+    }, &ctx);
+
+    // combine the per-chunk results in chunk order
+    TYPE result = init;
+    for (const TYPE& partial : ctx.partials) {
+        result = combine(result, partial);
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class OP> TYPE
+Parallel::Scan(Slice<const TYPE> src, Slice<TYPE> dst, int32 grainSize, TYPE init, const OP& op) {
+    o_assert_dbg((src.Size() == dst.Size()) && (grainSize > 0));
+    const int32 num = src.Size();
+    if (0 == num) {
+        return init;
+    }
+    struct context {
+        const TYPE* src;
+        TYPE* dst;
+        const OP* op;
+        Array<TYPE> partials;
+    } ctx;
+    ctx.src = src.Data();
+    ctx.dst = dst.Data();
+    ctx.op = &op;
+    const int32 chunks = numChunks(num, grainSize, MaxChunks);
+    ctx.partials.Reserve(chunks);
+    for (int32 i = 0; i < chunks; i++) {
+        ctx.partials.Add(init);
+    }
+
+    // first pass: reduce each chunk
+    run(num, chunks, [](int32 chunkIndex, int32 first, int32 last, void* userData) {
+        context* ctx = (context*) userData;
+        TYPE acc = ctx->src[first];
+        for (int32 i = first + 1; i < last; i++) {
+            acc = (*ctx->op)(acc, ctx->src[i]);
+        }
+        ctx->partials[chunkIndex] = acc;
+    }, &ctx);
+
+    // scan the chunk results into per-chunk start values
+    TYPE total = init;
+    for (TYPE& partial : ctx.partials) {
+        TYPE next = op(total, partial);
+        partial = total;
+        total = next;
+    }
+
+    // second pass: scan each chunk from its start value (reads src[i]
+    // before writing dst[i], so src and dst may be identical)
+    run(num, chunks, [](int32 chunkIndex, int32 first, int32 last, void* userData) {
+        context* ctx = (context*) userData;
+        TYPE acc = ctx->partials[chunkIndex];
+        for (int32 i = first; i < last; i++) {
+            TYPE next = (*ctx->op)(acc, ctx->src[i]);
+            ctx->dst[i] = acc;
+            acc = next;
+        }
+    }, &ctx);
+    return total;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class LESS> int32
+Parallel::coRank(const TYPE* a, int32 numA, const TYPE* b, int32 numB, int32 d, const LESS& less) {
+    // find the number of items taken from a in the first d items of
+    // the merged output, items from a go first if equal
+    int32 lo = d > numB ? d - numB : 0;
+    int32 hi = d < numA ? d : numA;
+    while (lo < hi) {
+        const int32 i = (lo + hi) >> 1;
+        const int32 j = d - i;
+        if ((j > 0) && !less(b[j - 1], a[i])) {
+            lo = i + 1;
+        }
+        else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class LESS> void
+Parallel::merge(TYPE* a, int32 numA, TYPE* b, int32 numB, TYPE* dst, int32 grainSize, const LESS& less) {
+    struct context {
+        TYPE* a;
+        int32 numA;
+        TYPE* b;
+        int32 numB;
+        TYPE* dst;
+        const LESS* less;
+    } ctx = { a, numA, b, numB, dst, &less };
+    const int32 num = numA + numB;
+    run(num, numSortChunks(num, grainSize), [](int32, int32 first, int32 last, void* userData) {
+        const context* ctx = (const context*) userData;
+        const int32 i0 = coRank(ctx->a, ctx->numA, ctx->b, ctx->numB, first, *ctx->less);
+        const int32 i1 = coRank(ctx->a, ctx->numA, ctx->b, ctx->numB, last, *ctx->less);
+        std::merge(std::make_move_iterator(ctx->a + i0), std::make_move_iterator(ctx->a + i1),
+                   std::make_move_iterator(ctx->b + (first - i0)), std::make_move_iterator(ctx->b + (last - i1)),
+                   ctx->dst + first, *ctx->less);
+    }, &ctx);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class LESS> void
+Parallel::Sort(Slice<TYPE> items, int32 grainSize, const LESS& less) {
+    o_assert_dbg(grainSize > 0);
+    const int32 num = items.Size();
+    const int32 chunks = numSortChunks(num, grainSize);
+    if (chunks <= 1) {
+        std::stable_sort(items.begin(), items.end(), less);
+        return;
+    }
+
+    // sort the chunks
+    struct context {
+        TYPE* items;
+        int32 num;
+        int32 chunks;
+        const LESS* less;
+    } ctx = { items.Data(), num, chunks, &less };
+    run(num, chunks, [](int32, int32 first, int32 last, void* userData) {
+        const context* ctx = (const context*) userData;
+        std::stable_sort(ctx->items + first, ctx->items + last, *ctx->less);
+    }, &ctx);
+
+    // merge runs of chunks pairwise, ping-ponging between items and a temp buffer
+    Array<TYPE> tmp;
+    tmp.Reserve(num);
+    for (int32 i = 0; i < num; i++) {
+        tmp.Add(items[i]);
+    }
+    TYPE* src = items.Data();
+    TYPE* dst = tmp.begin();
+    for (int32 width = 1; width < chunks; width *= 2) {
+        for (int32 chunk = 0; chunk < chunks; chunk += 2 * width) {
+            int32 begin, mid, end, dummy;
+            chunkRange(num, chunks, chunk, begin, dummy);
+            if ((chunk + width) < chunks) {
+                chunkRange(num, chunks, chunk + width, mid, dummy);
+                chunkRange(num, chunks, std::min(chunk + 2 * width, chunks) - 1, dummy, end);
+                merge(src + begin, mid - begin, src + mid, end - mid, dst + begin, grainSize, less);
+            }
+            else {
+                // odd run out, just move it over
+                chunkRange(num, chunks, chunks - 1, dummy, end);
+                std::move(src + begin, src + end, dst + begin);
+            }
+        }
+        std::swap(src, dst);
+    }
+    if (src != items.Data()) {
+        std::move(src, src + num, items.Data());
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class LESS> void
+Parallel::Sort(Array<TYPE>& items, int32 grainSize, const LESS& less) {
+    Sort(Slice<TYPE>(items.begin(), items.Size()), grainSize, less);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class KEY> void
+Parallel::RadixSort(Slice<TYPE> items, int32 grainSize, const KEY& key) {
+    typedef typename std::decay<decltype(key(*items.Data()))>::type keyType;
+    static_assert(std::is_integral<keyType>::value && std::is_unsigned<keyType>::value, "RadixSort keys must be unsigned integers");
+    o_assert_dbg(grainSize > 0);
+    const int32 num = items.Size();
+    if (num < 2) {
+        return;
+    }
+    const int32 chunks = numSortChunks(num, grainSize);
+    Array<TYPE> tmp;
+    tmp.Reserve(num);
+    for (int32 i = 0; i < num; i++) {
+        tmp.Add(items[i]);
+    }
+    struct context {
+        TYPE* src;
+        TYPE* dst;
+        const KEY* key;
+        int32 shift;
+        Array<int32> counts;    // chunks x 256 digit counts, then scatter offsets
+    } ctx;
+    ctx.src = items.Data();
+    ctx.dst = tmp.begin();
+    ctx.key = &key;
+    ctx.counts.Reserve(chunks * 256);
+    for (int32 i = 0; i < chunks * 256; i++) {
+        ctx.counts.Add(0);
+    }
+
+    // one pass per byte, least significant byte first
+    for (int32 shift = 0; shift < int32(sizeof(keyType) * 8); shift += 8) {
+        ctx.shift = shift;
+        run(num, chunks, [](int32 chunkIndex, int32 first, int32 last, void* userData) {
+            context* ctx = (context*) userData;
+            int32* counts = &ctx->counts[chunkIndex * 256];
+            std::fill(counts, counts + 256, 0);
+            for (int32 i = first; i < last; i++) {
+                counts[((*ctx->key)(ctx->src[i]) >> ctx->shift) & 0xFF]++;
+            }
+        }, &ctx);
+
+        // turn counts into scatter offsets (digit-major, then chunk order),
+        // skip the pass if all keys have the same digit
+        int32 offset = 0;
+        bool skip = false;
+        for (int32 digit = 0; digit < 256; digit++) {
+            int32 digitCount = 0;
+            for (int32 chunk = 0; chunk < chunks; chunk++) {
+                int32& count = ctx.counts[chunk * 256 + digit];
+                digitCount += count;
+                const int32 c = count;
+                count = offset;
+                offset += c;
+            }
+            if (digitCount == num) {
+                skip = true;
+                break;
+            }
+        }
+        if (skip) {
+            continue;
+        }
+        run(num, chunks, [](int32 chunkIndex, int32 first, int32 last, void* userData) {
+            context* ctx = (context*) userData;
+            int32* offsets = &ctx->counts[chunkIndex * 256];
+            for (int32 i = first; i < last; i++) {
+                const int32 digit = ((*ctx->key)(ctx->src[i]) >> ctx->shift) & 0xFF;
+                ctx->dst[offsets[digit]++] = std::move(ctx->src[i]);
+            }
+        }, &ctx);
+        std::swap(ctx.src, ctx.dst);
+    }
+    if (ctx.src != items.Data()) {
+        std::move(ctx.src, ctx.src + num, items.Data());
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, class KEY> void
+Parallel::RadixSort(Array<TYPE>& items, int32 grainSize, const KEY& key) {
+    RadixSort(Slice<TYPE>(items.begin(), items.Size()), grainSize, key);
+}
+
+} // namespace Oryol
@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+//  RWLock.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "RWLock.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+using namespace _priv;
+
+/// number of spin iterations before a waiting thread goes to sleep
+static const int32 MaxSpins = 1000;
+
+//------------------------------------------------------------------------------
+RWLock::~RWLock() {
+    this->EnableStats(false);
+}
+
+//------------------------------------------------------------------------------
+void
+RWLock::waitTurn(uint16 ticket, int32 shift) {
+    const int64 startTime = this->stats ? lockStatsCounter::now() : 0;
+    int32 spins = 0;
+    int32 waits = 0;
+    for (;;) {
+        if (isServed(this->serving.load(std::memory_order_acquire), ticket, shift)) {
+            break;
+        }
+        if (spins < MaxSpins) {
+            spins++;
+            futex::CpuRelax();
+            continue;
+        }
+        // register as sleeper before re-checking, the unlocking thread
+        // changes serving before checking for sleepers
+        this->numSleepers.fetch_add(1, std::memory_order_seq_cst);
+        const int32 cur = this->serving.load(std::memory_order_seq_cst);
+        if (!isServed(cur, ticket, shift)) {
+            waits++;
+            futex::Wait(&this->serving, cur);
+        }
+        this->numSleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (this->stats) {
+        this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+        this->stats->contended(spins, waits, startTime);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+RWLock::EnableStats(bool b) {
+    if (b && !this->stats) {
+        this->stats = Memory::New<lockStatsCounter>();
+    }
+    else if (!b && this->stats) {
+        Memory::Delete(this->stats);
+        this->stats = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+LockStats
+RWLock::Stats() const {
+    return this->stats ? this->stats->get() : LockStats();
+}
+
+//------------------------------------------------------------------------------
+void
+RWLock::ResetStats() {
+    if (this->stats) {
+        this->stats->reset();
+    }
+}
+
+} // namespace Oryol
@@ -3,18 +3,41 @@
 /**
     @class Oryol::RWLock
     @ingroup Core
-    @brief single-write / multiple-reader lock
+    @brief fair single-writer / multiple-reader lock
+
+    A ticket-based reader/writer lock. Every LockRead() and LockWrite()
+    draws a ticket, and lock requests are granted in ticket order.
+    Consecutive readers share the lock. A waiting writer blocks readers
+    that arrive after it, and a writer waits for readers that arrived
+    before it. This way, neither readers nor writers can starve.
+
+    Waiting threads spin for a short while and then sleep in the kernel
+    (see _priv::futex). They don't burn a whole core when the lock is
+    held for a long time.
+
+    At most 65535 threads may wait on the same lock at the same time.
+
+    @see ScopedReadLock, ScopedWriteLock, Mutex, LockStats
 */
 #include "Core/Config.h"
 #include "Core/Types.h"
-#if ORYOL_HAS_ATOMIC
+#include "Core/Threading/LockStats.h"
+#include "Core/Threading/futex.h"
 #include <atomic>
-#endif
 
 namespace Oryol {
 
 class RWLock {
 public:
+    /// constructor
+    RWLock() = default;
+    /// destructor
+    ~RWLock();
+    /// copying is not allowed
+    RWLock(const RWLock&) = delete;
+    /// copy-assignment is not allowed
+    void operator=(const RWLock&) = delete;
+
     /// lock for writing
     void LockWrite();
     /// unlock from writing
@@ -23,56 +46,98 @@ public:
     void LockRead();
     /// unlock from reading
     void UnlockRead();
-    
+
+    /// enable or disable contention statistics
+    void EnableStats(bool b);
+    /// get contention statistics
+    LockStats Stats() const;
+    /// reset contention statistics
+    void ResetStats();
+
 private:
-#if ORYOL_HAS_ATOMIC
-    std::atomic<bool> writeLock{false};
-    std::atomic<int32> readCount{0};
-#endif
+    /// wait until the read (shift=0) or write (shift=16) ticket is served
+    void waitTurn(uint16 ticket, int32 shift);
+    /// wake up sleeping threads after serving has changed
+    void wakeSleepers();
+    /// test if a ticket is served
+    static bool isServed(int32 serving, uint16 ticket, int32 shift);
+
+    /// next ticket to draw (only the lower 16 bits are used)
+    std::atomic<int32> next{0};
+    /// lower 16 bits: next read ticket allowed in, upper 16 bits: next write ticket
+    std::atomic<int32> serving{0};
+    /// number of threads sleeping on serving
+    std::atomic<int32> numSleepers{0};
+    _priv::lockStatsCounter* stats = nullptr;
 };
 
+//------------------------------------------------------------------------------
+inline bool
+RWLock::isServed(int32 serving, uint16 ticket, int32 shift) {
+    return uint16(uint32(serving) >> shift) == ticket;
+}
+
+//------------------------------------------------------------------------------
+inline void
+RWLock::wakeSleepers() {
+    if (this->numSleepers.load(std::memory_order_seq_cst) > 0) {
+        _priv::futex::WakeAll(&this->serving);
+    }
+}
+
 //------------------------------------------------------------------------------
 inline void
 RWLock::LockWrite() {
-#if ORYOL_HAS_ATOMIC
-    /// acquire the write-lock
-    while (std::atomic_exchange_explicit(&this->writeLock, true, std::memory_order_acquire)) {
-        // spinning...
+    const uint16 ticket = uint16(this->next.fetch_add(1, std::memory_order_relaxed));
+    if (!isServed(this->serving.load(std::memory_order_acquire), ticket, 16)) {
+        this->waitTurn(ticket, 16);
     }
-    /// spin until no-one's reading anymore
-    while (this->readCount > 0) {
-        // spinning...
+    else if (this->stats) {
+        this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
     }
-#endif
 }
 
 //------------------------------------------------------------------------------
 inline void
 RWLock::UnlockWrite() {
-#if ORYOL_HAS_ATOMIC
-    std::atomic_store_explicit(&this->writeLock, false, std::memory_order_release);
-#endif
+    // serve the next read and write ticket
+    int32 cur = this->serving.load(std::memory_order_relaxed);
+    int32 upd;
+    do {
+        const uint32 u = uint32(cur);
+        upd = int32((((u >> 16) + 1) << 16) | ((u + 1) & 0xFFFF));
+    }
+    while (!this->serving.compare_exchange_weak(cur, upd, std::memory_order_seq_cst, std::memory_order_relaxed));
+    this->wakeSleepers();
 }
 
 //------------------------------------------------------------------------------
 inline void
 RWLock::LockRead() {
-#if ORYOL_HAS_ATOMIC
-    /// spin until no one is writing anymore
-    while (this->writeLock) {
-        // spinning...
+    const uint16 ticket = uint16(this->next.fetch_add(1, std::memory_order_relaxed));
+    if (!isServed(this->serving.load(std::memory_order_acquire), ticket, 0)) {
+        this->waitTurn(ticket, 0);
+    }
+    else if (this->stats) {
+        this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+    }
+    // let the next reader in (write half may change concurrently from unlocking readers)
+    int32 cur = this->serving.load(std::memory_order_relaxed);
+    int32 upd;
+    do {
+        const uint32 u = uint32(cur);
+        upd = int32((u & 0xFFFF0000) | ((u + 1) & 0xFFFF));
     }
-    /// increment the read-count
-    ++this->readCount;
-#endif
+    while (!this->serving.compare_exchange_weak(cur, upd, std::memory_order_seq_cst, std::memory_order_relaxed));
+    this->wakeSleepers();
 }
 
 //------------------------------------------------------------------------------
 inline void
 RWLock::UnlockRead() {
-#if ORYOL_HAS_ATOMIC
-    --this->readCount;
-#endif
+    // serve the next write ticket
+    this->serving.fetch_add(0x10000, std::memory_order_seq_cst);
+    this->wakeSleepers();
 }
 
 class ScopedReadLock {
@@ -0,0 +1,110 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SPSCQueue
+    @ingroup Core
+    @brief lock-free single-producer/single-consumer ring buffer
+
+    A fixed-capacity FIFO queue for handing items from exactly one
+    producer thread to exactly one consumer thread without locking.
+    Push() fails when the queue is full, and Pop() fails when the
+    queue is empty, neither ever blocks. The read and write positions
+    live on separate cache lines, the producer and consumer only
+    share a cache line when they touch the same item.
+
+    CAPACITY must be a power of 2.
+
+    @see Queue, WorkerPool
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include <atomic>
+#include <utility>
+
+namespace Oryol {
+
+template<class TYPE, int32 CAPACITY> class SPSCQueue {
+public:
+    /// constructor
+    SPSCQueue() = default;
+    /// copying is not allowed
+    SPSCQueue(const SPSCQueue&) = delete;
+    /// copy-assignment is not allowed
+    void operator=(const SPSCQueue&) = delete;
+
+    /// push an item (producer thread only), return false if full
+    bool Push(const TYPE& item);
+    /// push an item by move (producer thread only), return false if full
+    bool Push(TYPE&& item);
+    /// pop an item (consumer thread only), return false if empty
+    bool Pop(TYPE& outItem);
+    /// get number of items (only exact on the producer or consumer thread)
+    int32 Size() const;
+    /// return true if empty (only exact on the consumer thread)
+    bool Empty() const;
+    /// get the capacity
+    static int32 Capacity();
+
+private:
+    static_assert((CAPACITY > 0) && (0 == (CAPACITY & (CAPACITY - 1))), "SPSCQueue: CAPACITY must be a power of 2!");
+    static const int32 CacheLineSize = 64;
+
+    // padded instead of alignas(), the queue is usually heap-allocated
+    // through Memory::New() which doesn't respect over-alignment
+    std::atomic<uint32> writePos{0};    // written by producer
+    uint8 pad0[CacheLineSize - sizeof(std::atomic<uint32>)];
+    std::atomic<uint32> readPos{0};     // written by consumer
+    uint8 pad1[CacheLineSize - sizeof(std::atomic<uint32>)];
+    TYPE items[CAPACITY];
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE, int32 CAPACITY> bool
+SPSCQueue<TYPE, CAPACITY>::Push(const TYPE& item) {
+    TYPE copy(item);
+    return this->Push(std::move(copy));
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int32 CAPACITY> bool
+SPSCQueue<TYPE, CAPACITY>::Push(TYPE&& item) {
+    const uint32 pos = this->writePos.load(std::memory_order_relaxed);
+    if ((pos - this->readPos.load(std::memory_order_acquire)) >= uint32(CAPACITY)) {
+        return false;
+    }
+    this->items[pos & (CAPACITY - 1)] = std::move(item);
+    this->writePos.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int32 CAPACITY> bool
+SPSCQueue<TYPE, CAPACITY>::Pop(TYPE& outItem) {
+    const uint32 pos = this->readPos.load(std::memory_order_relaxed);
+    if (pos == this->writePos.load(std::memory_order_acquire)) {
+        return false;
+    }
+    outItem = std::move(this->items[pos & (CAPACITY - 1)]);
+    this->readPos.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int32 CAPACITY> int32
+SPSCQueue<TYPE, CAPACITY>::Size() const {
+    return int32(this->writePos.load(std::memory_order_acquire) - this->readPos.load(std::memory_order_acquire));
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int32 CAPACITY> bool
+SPSCQueue<TYPE, CAPACITY>::Empty() const {
+    return 0 == this->Size();
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE, int32 CAPACITY> int32
+SPSCQueue<TYPE, CAPACITY>::Capacity() {
+    return CAPACITY;
+}
+
+} // namespace Oryol
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//  Semaphore.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Semaphore.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+using namespace _priv;
+
+/// number of spin iterations before a waiting thread goes to sleep
+static const int32 MaxSpins = 1000;
+
+//------------------------------------------------------------------------------
+Semaphore::Semaphore(int32 initialCount) :
+count(initialCount) {
+    o_assert(initialCount >= 0);
+}
+
+//------------------------------------------------------------------------------
+Semaphore::~Semaphore() {
+    this->EnableStats(false);
+}
+
+//------------------------------------------------------------------------------
+void
+Semaphore::Post(int32 n) {
+    o_assert_dbg(n > 0);
+    this->count.fetch_add(n, std::memory_order_seq_cst);
+    if (this->numSleepers.load(std::memory_order_seq_cst) > 0) {
+        if (1 == n) {
+            futex::WakeOne(&this->count);
+        }
+        else {
+            futex::WakeAll(&this->count);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+Semaphore::waitSlow(int32 timeoutMs) {
+    const int64 startTime = lockStatsCounter::now();
+    int32 spins = 0;
+    int32 waits = 0;
+    bool acquired = false;
+    for (;;) {
+        if (this->tryDecrement()) {
+            acquired = true;
+            break;
+        }
+        if (spins < MaxSpins) {
+            spins++;
+            futex::CpuRelax();
+            continue;
+        }
+        int32 remainingMs = futex::Infinite;
+        if (futex::Infinite != timeoutMs) {
+            remainingMs = timeoutMs - int32((lockStatsCounter::now() - startTime) / 1000);
+            if (remainingMs <= 0) {
+                break;
+            }
+        }
+        // register as sleeper before re-checking, Post() changes
+        // the count before checking for sleepers
+        this->numSleepers.fetch_add(1, std::memory_order_seq_cst);
+        const int32 cur = this->count.load(std::memory_order_seq_cst);
+        if (cur <= 0) {
+            waits++;
+            futex::Wait(&this->count, cur, remainingMs);
+        }
+        this->numSleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (this->stats) {
+        if (acquired) {
+            this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+        }
+        this->stats->contended(spins, waits, startTime);
+    }
+    return acquired;
+}
+
+//------------------------------------------------------------------------------
+void
+Semaphore::EnableStats(bool b) {
+    if (b && !this->stats) {
+        this->stats = Memory::New<lockStatsCounter>();
+    }
+    else if (!b && this->stats) {
+        Memory::Delete(this->stats);
+        this->stats = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+LockStats
+Semaphore::Stats() const {
+    return this->stats ? this->stats->get() : LockStats();
+}
+
+//------------------------------------------------------------------------------
+void
+Semaphore::ResetStats() {
+    if (this->stats) {
+        this->stats->reset();
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,106 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Semaphore
+    @ingroup Core
+    @brief counting semaphore
+
+    Post() increments the count. Wait() waits until the count is greater
+    than zero and then decrements it. A waiting thread spins briefly and
+    then sleeps in the kernel (see _priv::futex). Post() only makes a
+    syscall if a thread is actually sleeping.
+
+    @see Event, Mutex, LockStats
+*/
+#include "Core/Types.h"
+#include "Core/Threading/LockStats.h"
+#include "Core/Threading/futex.h"
+#include <atomic>
+
+namespace Oryol {
+
+class Semaphore {
+public:
+    /// constructor
+    Semaphore(int32 initialCount = 0);
+    /// destructor
+    ~Semaphore();
+    /// copying is not allowed
+    Semaphore(const Semaphore&) = delete;
+    /// copy-assignment is not allowed
+    void operator=(const Semaphore&) = delete;
+
+    /// increment the count, wakes up waiting threads
+    void Post(int32 n = 1);
+    /// wait until the count is > 0, and decrement it
+    void Wait();
+    /// like Wait(), but give up after a timeout, returns false on timeout
+    bool TimedWait(int32 timeoutMs);
+    /// decrement the count if it is > 0, never waits
+    bool TryWait();
+    /// get the current count
+    int32 Count() const;
+
+    /// enable or disable contention statistics
+    void EnableStats(bool b);
+    /// get contention statistics
+    LockStats Stats() const;
+    /// reset contention statistics
+    void ResetStats();
+
+private:
+    /// try to decrement the count without waiting
+    bool tryDecrement();
+    /// contended wait path
+    bool waitSlow(int32 timeoutMs);
+
+    std::atomic<int32> count;
+    std::atomic<int32> numSleepers{0};
+    _priv::lockStatsCounter* stats = nullptr;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+Semaphore::tryDecrement() {
+    int32 cur = this->count.load(std::memory_order_relaxed);
+    while (cur > 0) {
+        if (this->count.compare_exchange_weak(cur, cur - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+Semaphore::TryWait() {
+    if (this->tryDecrement()) {
+        if (this->stats) {
+            this->stats->numAcquired.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+inline void
+Semaphore::Wait() {
+    if (!this->TryWait()) {
+        this->waitSlow(_priv::futex::Infinite);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline bool
+Semaphore::TimedWait(int32 timeoutMs) {
+    return this->TryWait() || this->waitSlow(timeoutMs);
+}
+
+//------------------------------------------------------------------------------
+inline int32
+Semaphore::Count() const {
+    return this->count.load(std::memory_order_relaxed);
+}
+
+} // namespace Oryol
@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+//  WorkerPool.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "WorkerPool.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Profiler.h"
+
+namespace Oryol {
+
+WorkerPool::_state* WorkerPool::state = nullptr;
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::Setup(int32 numWorkers) {
+    o_assert(!IsValid());
+    state = Memory::New<_state>();
+    state->highJobs.Reserve(64);
+    state->lowJobs.Reserve(64);
+    #if ORYOL_HAS_THREADS
+    if (DefaultNumWorkers == numWorkers) {
+        numWorkers = int32(std::thread::hardware_concurrency()) - 1;
+    }
+    numWorkers = numWorkers < 0 ? 0 : (numWorkers > MaxWorkers ? MaxWorkers : numWorkers);
+    state->numWorkers = numWorkers;
+    for (int32 i = 0; i < numWorkers; i++) {
+        state->threads[i] = std::thread(workerLoop);
+    }
+    #else
+    (void)numWorkers;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::Discard() {
+    o_assert(IsValid());
+    #if ORYOL_HAS_THREADS
+    // one extra token per worker, a worker which finds the job
+    // queues empty after the stop request leaves its loop
+    state->stopRequested = true;
+    if (state->numWorkers > 0) {
+        state->pending.Post(state->numWorkers);
+    }
+    for (int32 i = 0; i < state->numWorkers; i++) {
+        state->threads[i].join();
+    }
+    #endif
+    // run jobs which were pushed while no worker was around
+    job j;
+    while (pop(j)) {
+        j.func(j.userData);
+    }
+    Memory::Delete(state);
+    state = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+WorkerPool::IsValid() {
+    return nullptr != state;
+}
+
+//------------------------------------------------------------------------------
+int32
+WorkerPool::NumWorkers() {
+    o_assert_dbg(IsValid());
+    return state->numWorkers;
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::Push(JobFunc func, void* userData, Priority prio) {
+    Push(func, userData, nullptr, prio);
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::Push(JobFunc func, void* userData, const void* owner, Priority prio) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(func);
+    job j;
+    j.func = func;
+    j.userData = userData;
+    j.owner = owner;
+    {
+        ScopedLock lock(state->lock);
+        if (Priority::High == prio) {
+            state->highJobs.Enqueue(j);
+        }
+        else {
+            state->lowJobs.Enqueue(j);
+        }
+    }
+    // one token per job, jobs taken with RunOne() or RunOwn() leave
+    // a token behind, a worker which takes it finds nothing to do
+    state->pending.Post();
+}
+
+//------------------------------------------------------------------------------
+bool
+WorkerPool::RunOne() {
+    o_assert_dbg(IsValid());
+    job j;
+    {
+        ScopedLock lock(state->lock);
+        if (state->highJobs.Empty()) {
+            return false;
+        }
+        j = state->highJobs.Dequeue();
+    }
+    j.func(j.userData);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+ The job queues are searched front to back, the few jobs which are
+ pending at any time make this cheaper than keeping per-owner queues.
+*/
+bool
+WorkerPool::RunOwn(const void* owner) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(owner);
+    job j;
+    {
+        ScopedLock lock(state->lock);
+        Queue<job>* queues[2] = { &state->highJobs, &state->lowJobs };
+        for (Queue<job>* q : queues) {
+            const int32 num = q->Size();
+            for (int32 i = 0; i < num; i++) {
+                if ((*q)[i].owner == owner) {
+                    j = (*q)[i];
+                    q->Erase(i);
+                    break;
+                }
+            }
+            if (j.func) {
+                break;
+            }
+        }
+    }
+    if (j.func) {
+        j.func(j.userData);
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::workerLoop() {
+    Profiler::SetThreadName("WorkerPool");
+    for (;;) {
+        state->pending.Wait();
+        job j;
+        if (pop(j)) {
+            j.func(j.userData);
+        }
+        else if (state->stopRequested) {
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+WorkerPool::pop(job& outJob) {
+    ScopedLock lock(state->lock);
+    if (!state->highJobs.Empty()) {
+        outJob = state->highJobs.Dequeue();
+        return true;
+    }
+    else if (!state->lowJobs.Empty()) {
+        outJob = state->lowJobs.Dequeue();
+        return true;
+    }
+    return false;
+}
+
+} // namespace Oryol
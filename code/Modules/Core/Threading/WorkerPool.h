@@ -0,0 +1,102 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::WorkerPool
+    @ingroup Core
+    @brief a small pool of worker threads for short, independent jobs
+
+    The worker pool is set up by Core::Setup() with one thread per
+    hardware thread minus one. A job is a plain function pointer and a
+    user data pointer, pushing a job doesn't allocate once the job
+    queues have grown to their working size.
+
+    Jobs have a priority: workers always take pending High jobs
+    (frame-critical work like RunLoop phases and Parallel helpers)
+    before Low jobs (long background work like generating sound
+    effects), so background work only delays frame-critical work by
+    the job which is already running on a worker. Long Low jobs
+    should therefore be split into short ones.
+
+    A job can be pushed with an owner pointer. A thread which waits
+    for its own jobs helps out with RunOwn(), which only takes jobs
+    of the given owner, so a waiting thread never ends up running
+    unrelated (and maybe long) jobs of other systems. RunOne() takes
+    any pending High job.
+
+    Jobs must not block on other jobs, the pool doesn't grow to
+    resolve such dependencies. Jobs pushed on a platform without
+    threads (or when the pool has no workers) are only executed
+    through RunOne() or RunOwn(), or by Discard().
+
+    @see RunLoop
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Queue.h"
+#include "Core/Containers/StaticArray.h"
+#include "Core/Threading/Mutex.h"
+#include "Core/Threading/Semaphore.h"
+#include <atomic>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
+
+namespace Oryol {
+
+class WorkerPool {
+public:
+    /// a job function
+    typedef void (*JobFunc)(void* userData);
+    /// max number of worker threads
+    static const int32 MaxWorkers = 32;
+    /// pick number of workers from the hardware concurrency
+    static const int32 DefaultNumWorkers = -1;
+    /// job priorities
+    enum class Priority {
+        High,
+        Low,
+    };
+
+    /// setup the worker pool, start worker threads
+    static void Setup(int32 numWorkers = DefaultNumWorkers);
+    /// discard the worker pool, runs remaining jobs and joins worker threads
+    static void Discard();
+    /// check if the worker pool has been setup
+    static bool IsValid();
+    /// get number of worker threads (can be 0)
+    static int32 NumWorkers();
+
+    /// push a job, will be picked up by the next idle worker
+    static void Push(JobFunc func, void* userData, Priority prio = Priority::High);
+    /// push a job of an owner, the owner can run it itself with RunOwn()
+    static void Push(JobFunc func, void* userData, const void* owner, Priority prio = Priority::High);
+    /// run one pending High job on the calling thread, return false if no job was pending
+    static bool RunOne();
+    /// run one pending job of an owner on the calling thread, return false if none was pending
+    static bool RunOwn(const void* owner);
+
+private:
+    /// the worker thread function
+    static void workerLoop();
+
+    struct job {
+        JobFunc func = nullptr;
+        void* userData = nullptr;
+        const void* owner = nullptr;
+    };
+    /// pop the next job, High before Low, return false if both queues are empty
+    static bool pop(job& outJob);
+    struct _state {
+        Mutex lock;
+        Queue<job> highJobs;
+        Queue<job> lowJobs;
+        Semaphore pending;
+        std::atomic<bool> stopRequested{false};
+        int32 numWorkers = 0;
+        #if ORYOL_HAS_THREADS
+        StaticArray<std::thread, MaxWorkers> threads;
+        #endif
+    };
+    static _state* state;
+};
+
+} // namespace Oryol
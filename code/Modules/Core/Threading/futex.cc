@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+//  futex.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "futex.h"
+#include "Core/Assertion.h"
+#if ORYOL_HAS_THREADS
+#if ORYOL_LINUX || ORYOL_ANDROID
+#define ORYOL_FUTEX_LINUX (1)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <ctime>
+#include <climits>
+#elif ORYOL_WINDOWS
+#define ORYOL_FUTEX_WINDOWS (1)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#define ORYOL_FUTEX_PARKING (1)
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#endif
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+static_assert(sizeof(std::atomic<int32>) == sizeof(int32), "std::atomic<int32> must be lock-free and have the size of int32");
+
+#if ORYOL_FUTEX_PARKING
+// a fixed table of parking buckets, several addresses can share a
+// bucket, so wakeups always wake all waiters of a bucket
+namespace {
+struct parkingBucket {
+    std::mutex mutex;
+    std::condition_variable cond;
+};
+const int32 NumBuckets = 64;
+parkingBucket buckets[NumBuckets];
+
+parkingBucket&
+bucketForAddr(const void* addr) {
+    const uintptr_t h = uintptr_t(addr) >> 2;
+    return buckets[(h ^ (h >> 6)) & (NumBuckets - 1)];
+}
+} // anonymous namespace
+#endif
+
+//------------------------------------------------------------------------------
+bool
+futex::Wait(std::atomic<int32>* addr, int32 expected, int32 timeoutMs) {
+    o_assert_dbg(addr);
+    #if ORYOL_FUTEX_LINUX
+        struct timespec ts;
+        struct timespec* tsPtr = nullptr;
+        if (Infinite != timeoutMs) {
+            ts.tv_sec = timeoutMs / 1000;
+            ts.tv_nsec = (timeoutMs % 1000) * 1000000;
+            tsPtr = &ts;
+        }
+        const long res = syscall(SYS_futex, (int*)addr, FUTEX_WAIT_PRIVATE, expected, tsPtr, nullptr, 0);
+        return !((-1 == res) && (ETIMEDOUT == errno));
+    #elif ORYOL_FUTEX_WINDOWS
+        const DWORD ms = (Infinite == timeoutMs) ? INFINITE : DWORD(timeoutMs);
+        if (!WaitOnAddress((volatile VOID*)addr, &expected, sizeof(int32), ms)) {
+            return ERROR_TIMEOUT != GetLastError();
+        }
+        return true;
+    #elif ORYOL_FUTEX_PARKING
+        parkingBucket& bucket = bucketForAddr(addr);
+        std::unique_lock<std::mutex> lock(bucket.mutex);
+        // the waker changes the value before locking the bucket,
+        // so checking under the bucket lock can't miss a wakeup
+        if (addr->load(std::memory_order_relaxed) != expected) {
+            return true;
+        }
+        if (Infinite == timeoutMs) {
+            bucket.cond.wait(lock);
+            return true;
+        }
+        return std::cv_status::no_timeout == bucket.cond.wait_for(lock, std::chrono::milliseconds(timeoutMs));
+    #else
+        // without threads nobody could ever change the value
+        (void)expected;
+        (void)timeoutMs;
+        return false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+futex::WakeOne(std::atomic<int32>* addr) {
+    o_assert_dbg(addr);
+    #if ORYOL_FUTEX_LINUX
+        syscall(SYS_futex, (int*)addr, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    #elif ORYOL_FUTEX_WINDOWS
+        WakeByAddressSingle((PVOID)addr);
+    #elif ORYOL_FUTEX_PARKING
+        WakeAll(addr);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+futex::WakeAll(std::atomic<int32>* addr) {
+    o_assert_dbg(addr);
+    #if ORYOL_FUTEX_LINUX
+        syscall(SYS_futex, (int*)addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    #elif ORYOL_FUTEX_WINDOWS
+        WakeByAddressAll((PVOID)addr);
+    #elif ORYOL_FUTEX_PARKING
+        parkingBucket& bucket = bucketForAddr(addr);
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        bucket.cond.notify_all();
+    #endif
+}
+
+} // namespace _priv
+} // namespace Oryol
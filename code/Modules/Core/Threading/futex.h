@@ -0,0 +1,54 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::futex
+    @ingroup _priv
+    @brief wait on / wake up threads waiting on a 32-bit atomic value
+
+    This is the parking primitive for Mutex, RWLock, Semaphore and Event.
+    Wait() puts the calling thread to sleep if the value at an address
+    still equals an expected value. Wake() wakes threads sleeping on that
+    address. On Linux and Android this maps directly to the futex syscall.
+    On Windows it maps to WaitOnAddress(). On other platforms it uses a
+    small hashed table of mutex/condition-variable pairs.
+
+    Spurious wakeups are possible, so callers must always re-check
+    their condition after Wait() returns.
+*/
+#include "Core/Config.h"
+#include "Core/Types.h"
+#include <atomic>
+#if ORYOL_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+class futex {
+public:
+    /// wait without timeout
+    static const int32 Infinite = -1;
+
+    /// sleep while *addr == expected, returns false on timeout
+    static bool Wait(std::atomic<int32>* addr, int32 expected, int32 timeoutMs = Infinite);
+    /// wake up one thread waiting on addr
+    static void WakeOne(std::atomic<int32>* addr);
+    /// wake up all threads waiting on addr
+    static void WakeAll(std::atomic<int32>* addr);
+    /// hint to the CPU that we're in a spin-wait loop
+    static void CpuRelax();
+};
+
+//------------------------------------------------------------------------------
+inline void
+futex::CpuRelax() {
+    #if ORYOL_SIMD_SSE
+    _mm_pause();
+    #elif (defined(__arm__) || defined(__aarch64__)) && (defined(__GNUC__) || defined(__clang__))
+    __asm__ __volatile__("yield");
+    #endif
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -1,14 +1,20 @@
 #pragma once
-#if ORYOL_PROFILING
 //------------------------------------------------------------------------------
 /**
     @class Oryol::Trace
-    @brief tracing support when ORYOL_PROFILING is enabled
+    @brief tracing support
 
     This file implements various macros that hook Oryol into
-    profiling/tracing tools.
+    profiling/tracing tools. The o_trace_* macros always feed the
+    built-in Profiler (which only records when enabled at runtime).
+    When ORYOL_PROFILING is enabled they additionally feed Remotery
+    or emscripten tracing.
+
+    @see Profiler
  */
 #include "Core/Types.h"
+#include "Core/Profiler.h"
+#if ORYOL_PROFILING
 #if ORYOL_LINUX || ORYOL_MACOS || ORYOL_WINDOWS
 #define ORYOL_USE_REMOTERY (1)
 #endif
@@ -38,43 +44,50 @@ private:
     #endif
 };
 
-#if ORYOL_USE_EMSCTRACE
-struct emscScopedTrace {
-    emscScopedTrace(const char* name) {
-        emscripten_trace_enter_context(name);
-    };
-    ~emscScopedTrace() {
-        emscripten_trace_exit_context();
-    };
-};
+} // namespace Oryol
 #endif
-    
-// trace macros
+
+// external tracing tool hooks
 #if ORYOL_USE_REMOTERY
-#define o_trace_begin_frame() ((void)0)
-#define o_trace_end_frame() ((void)0)
-#define o_trace_begin(name) rmt_BeginCPUSample(name)
-#define o_trace_end() rmt_EndCPUSample()
-#define o_trace_scoped(name) rmt_ScopedCPUSample(name)
+#define _o_ext_trace_begin_frame() ((void)0)
+#define _o_ext_trace_end_frame() ((void)0)
+#define _o_ext_trace_begin(name) rmt_BeginCPUSample(name)
+#define _o_ext_trace_end() rmt_EndCPUSample()
 #elif ORYOL_USE_EMSCTRACE
-#define o_trace_begin_frame() emscripten_trace_record_frame_start()
-#define o_trace_end_frame() emscripten_trace_record_frame_end()
-#define o_trace_begin(name) emscripten_trace_enter_context(#name)
-#define o_trace_end(name) emscripten_trace_exit_context()
-#define o_trace_scoped(name) emscScopedTrace emscScopedTrace##name(#name)
+#define _o_ext_trace_begin_frame() emscripten_trace_record_frame_start()
+#define _o_ext_trace_end_frame() emscripten_trace_record_frame_end()
+#define _o_ext_trace_begin(name) emscripten_trace_enter_context(#name)
+#define _o_ext_trace_end() emscripten_trace_exit_context()
 #else
-#define o_trace_begin_frame() ((void)0)
-#define o_trace_end_frame() ((void)0)
-#define o_trace_begin(name) ((void)0)
-#define o_trace_end() ((void)0)
-#define o_trace_scoped(name) ((void)0)
+#define _o_ext_trace_begin_frame() ((void)0)
+#define _o_ext_trace_end_frame() ((void)0)
+#define _o_ext_trace_begin(name) ((void)0)
+#define _o_ext_trace_end() ((void)0)
 #endif
 
+namespace Oryol {
+namespace _priv {
+/// scope object behind o_trace_scoped(), feeds the external tool and the Profiler
+class traceScope {
+public:
+    /// constructor, begins the Profiler event and calls the external begin hook
+    template<class BEGINEXT> traceScope(const char* name, BEGINEXT beginExt) : profilerScope(name) {
+        beginExt();
+    };
+    /// destructor, ends the external sample (the Profiler event ends with profilerScope)
+    ~traceScope() {
+        _o_ext_trace_end();
+    };
+private:
+    ProfilerScope profilerScope;
+};
+} // namespace _priv
 } // namespace Oryol
-#else
-#define o_trace_begin_frame() ((void)0)
-#define o_trace_end_frame() ((void)0)
-#define o_trace_begin(name) ((void)0)
-#define o_trace_end() ((void)0)
-#define o_trace_scoped(name) ((void)0)
-#endif
+
+// trace macros
+#define o_trace_begin_frame() do { _o_ext_trace_begin_frame(); Oryol::Profiler::Frame(); } while(0)
+#define o_trace_end_frame() do { _o_ext_trace_end_frame(); } while(0)
+#define o_trace_begin(name) do { _o_ext_trace_begin(name); Oryol::Profiler::Begin(#name); } while(0)
+#define o_trace_end() do { Oryol::Profiler::End(); _o_ext_trace_end(); } while(0)
+#define o_trace_scoped(name) Oryol::_priv::traceScope _o_traceScope##name(#name, []{ _o_ext_trace_begin(name); })
+#define o_trace_counter(name, value) Oryol::Profiler::Counter(#name, value)
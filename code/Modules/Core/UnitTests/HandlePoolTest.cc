@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+//  HandlePoolTest.cc
+//  Test HandlePool functionality.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Memory/HandlePool.h"
+#include "Core/String/String.h"
+#include "Core/Containers/Array.h"
+#include <atomic>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
+
+using namespace Oryol;
+
+namespace {
+struct obj {
+    obj(int32 val_, const char* str_) : val(val_), str(str_) { numAlive++; };
+    ~obj() { numAlive--; };
+    int32 val;
+    String str;
+    static std::atomic<int32> numAlive;
+};
+std::atomic<int32> obj::numAlive{0};
+}
+
+//------------------------------------------------------------------------------
+TEST(HandlePoolTest) {
+    {
+        HandlePool<obj> pool;
+        CHECK(pool.Size() == 0);
+        CHECK(!pool.IsValid(HandlePool<obj>::InvalidHandle));
+        CHECK(nullptr == pool.Lookup(HandlePool<obj>::InvalidHandle));
+
+        HandlePool<obj>::Handle h0 = pool.Create(1, "one");
+        HandlePool<obj>::Handle h1 = pool.Create(2, "two");
+        CHECK(h0 != HandlePool<obj>::InvalidHandle);
+        CHECK(h0 != h1);
+        CHECK(pool.Size() == 2);
+        CHECK(obj::numAlive == 2);
+        CHECK(pool.IsValid(h0) && pool.IsValid(h1));
+        CHECK(pool.Lookup(h0)->val == 1);
+        CHECK(pool.Lookup(h0)->str == "one");
+        CHECK(pool.Lookup(h1)->val == 2);
+
+        // a destroyed handle must not find the object which reuses its slot
+        obj* ptr0 = pool.Lookup(h0);
+        pool.Destroy(h0);
+        CHECK(obj::numAlive == 1);
+        CHECK(!pool.IsValid(h0));
+        CHECK(nullptr == pool.Lookup(h0));
+        HandlePool<obj>::Handle h2 = pool.Create(3, "three");
+        CHECK(pool.Lookup(h2) == ptr0);
+        CHECK(h2 != h0);
+        CHECK((h2 & 0xFFFF) == (h0 & 0xFFFF));
+        CHECK(nullptr == pool.Lookup(h0));
+        CHECK(pool.Lookup(h2)->val == 3);
+        // a handle with the dead generation of the slot is never valid
+        CHECK(nullptr == pool.Lookup(h0 + 0x10000));
+
+        // grow beyond one puddle, the objects must not move
+        Array<HandlePool<obj>::Handle> handles;
+        for (int32 i = 0; i < 1000; i++) {
+            handles.Add(pool.Create(i, "bla"));
+        }
+        CHECK(pool.Size() == 1002);
+        CHECK(pool.Lookup(h2) == ptr0);
+        for (int32 i = 0; i < 1000; i++) {
+            CHECK(pool.Lookup(handles[i])->val == i);
+        }
+        for (int32 i = 0; i < 1000; i += 2) {
+            pool.Destroy(handles[i]);
+        }
+        CHECK(pool.Size() == 502);
+        for (int32 i = 0; i < 1000; i++) {
+            CHECK(pool.IsValid(handles[i]) == ((i & 1) != 0));
+        }
+        // the remaining objects are destroyed with the pool
+    }
+    CHECK(obj::numAlive == 0);
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_HAS_THREADS
+TEST(HandlePoolThreadTest) {
+    HandlePool<obj> pool;
+    const int32 numThreads = 4;
+    const int32 numIter = 20000;
+    std::thread threads[numThreads];
+    bool ok[numThreads] = { };
+    for (int32 t = 0; t < numThreads; t++) {
+        threads[t] = std::thread([&pool, &ok, t] {
+            HandlePool<obj>::Handle handles[16];
+            bool good = true;
+            for (int32 i = 0; i < numIter; i++) {
+                const int32 slot = i & 15;
+                if (i >= 16) {
+                    obj* o = pool.Lookup(handles[slot]);
+                    good &= (nullptr != o) && (o->val == (t << 20) + i - 16);
+                    pool.Destroy(handles[slot]);
+                    good &= !pool.IsValid(handles[slot]);
+                }
+                handles[slot] = pool.Create((t << 20) + i, "thread");
+            }
+            for (int32 i = 0; i < 16; i++) {
+                pool.Destroy(handles[i]);
+            }
+            ok[t] = good;
+        });
+    }
+    for (int32 t = 0; t < numThreads; t++) {
+        threads[t].join();
+        CHECK(ok[t]);
+    }
+    CHECK(pool.Size() == 0);
+    CHECK(obj::numAlive == 0);
+}
+#endif
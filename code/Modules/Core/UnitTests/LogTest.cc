@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+//  LogTest.cc
+//  Test async logging.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Log.h"
+#include "Core/Logger.h"
+#include "Core/logQueue.h"
+#include "Core/Containers/Array.h"
+#include "Core/String/String.h"
+#include <cstdio>
+#include <cstring>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <mutex>
+#include <atomic>
+#endif
+
+using namespace Oryol;
+using namespace Oryol::_priv;
+
+// encode and decode, and compare against vsnprintf
+static bool
+roundTrip(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    uint8 rec[logQueue::MaxRecordSize];
+    bool truncated = false;
+    const int32 size = logQueue::encode(fmt, args, rec, sizeof(rec), truncated);
+    va_end(args);
+    char decoded[logQueue::MaxMessageLength];
+    logQueue::decode(fmt, rec, size, decoded, sizeof(decoded));
+
+    char expected[logQueue::MaxMessageLength];
+    va_start(args, fmt);
+    std::vsnprintf(expected, sizeof(expected), fmt, args);
+    va_end(args);
+    return !truncated && (0 == std::strcmp(decoded, expected));
+}
+
+TEST(LogRecordEncodeTest) {
+    CHECK(roundTrip("plain text\n"));
+    CHECK(roundTrip("100%% done\n"));
+    CHECK(roundTrip("%d %i %5d %-5d| %05d\n", -1, 2, 3, 4, 5));
+    CHECK(roundTrip("%u %x %X %o %#x\n", 1u, 0xABu, 0xCDu, 8u, 255u));
+    CHECK(roundTrip("%ld %lld %llu %zu\n", -123456789L, -1234567890123LL, 12345678901234ULL, size_t(77)));
+    CHECK(roundTrip("%hhd %hd\n", 12, 1234));
+    CHECK(roundTrip("%f %.2f %10.3e %g %c\n", 1.5, 3.14159, 12345.678, 0.0001, 'x'));
+    CHECK(roundTrip("%*d|%-*.*f|\n", 6, 42, 10, 2, 2.5));
+    CHECK(roundTrip("'%s' '%10s' '%.3s' '%s'\n", "str", "right", "truncate", ""));
+    CHECK(roundTrip("%p\n", (void*)0x1234));
+
+    // a string which doesn't fit into a record is cut off
+    char longStr[2 * logQueue::MaxRecordSize];
+    std::memset(longStr, 'a', sizeof(longStr) - 1);
+    longStr[sizeof(longStr) - 1] = 0;
+    uint8 rec[logQueue::MaxRecordSize];
+    bool truncated = false;
+    const char* fmt = "%s %d\n";
+    struct helper {
+        static int32 encode(const char* fmt, uint8* rec, bool& truncated, ...) {
+            va_list args;
+            va_start(args, truncated);
+            int32 size = logQueue::encode(fmt, args, rec, logQueue::MaxRecordSize, truncated);
+            va_end(args);
+            return size;
+        }
+    };
+    const int32 size = helper::encode(fmt, rec, truncated, longStr, 123);
+    CHECK(truncated);
+    CHECK(size <= logQueue::MaxRecordSize);
+    char decoded[logQueue::MaxMessageLength];
+    const int32 len = logQueue::decode(fmt, rec, size, decoded, sizeof(decoded));
+    CHECK(len == int32(std::strlen(decoded)));
+    CHECK(0 == std::strcmp(decoded + len - 5, "[...]"));
+}
+
+#if ORYOL_HAS_THREADS
+class captureLogger : public Logger {
+    OryolClassDecl(captureLogger);
+public:
+    virtual void VPrint(Log::Level l, const char* msg, va_list args) override {
+        char buf[1024];
+        std::vsnprintf(buf, sizeof(buf), msg, args);
+        std::lock_guard<std::mutex> guard(this->mutex);
+        if (this->capture) {
+            this->lines.Add(String(buf));
+        }
+        else {
+            std::printf("%s", buf);
+        }
+    };
+    std::mutex mutex;
+    bool capture = false;
+    Array<String> lines;
+};
+OryolClassImpl(captureLogger);
+
+TEST(LogAsyncTest) {
+    Ptr<captureLogger> logger = captureLogger::Create();
+    Log::AddLogger(logger);
+    logger->capture = true;
+
+    const int32 num = 1000;
+    Log::StartAsync(Log::AsyncPolicy::Block, 4096);
+    CHECK(Log::IsAsync());
+    std::thread worker([] {
+        for (int32 i = 0; i < num; i++) {
+            Log::Info("worker %d\n", i);
+        }
+    });
+    for (int32 i = 0; i < num; i++) {
+        Log::Info("main %d '%s'\n", i, "text");
+    }
+    worker.join();
+    Log::Flush();
+
+    // messages of one thread must arrive in order
+    {
+        std::lock_guard<std::mutex> guard(logger->mutex);
+        CHECK(logger->lines.Size() == 2 * num);
+        int32 nextMain = 0;
+        int32 nextWorker = 0;
+        char expected[64];
+        for (const String& line : logger->lines) {
+            if (line.AsCStr()[0] == 'm') {
+                std::snprintf(expected, sizeof(expected), "main %d 'text'\n", nextMain++);
+            }
+            else {
+                std::snprintf(expected, sizeof(expected), "worker %d\n", nextWorker++);
+            }
+            CHECK(line == expected);
+        }
+        CHECK((nextMain == num) && (nextWorker == num));
+        logger->lines.Clear();
+    }
+    Log::StopAsync();
+    CHECK(!Log::IsAsync());
+    Log::AsyncStats stats = Log::GetAsyncStats();
+    CHECK(0 == stats.NumDropped);
+
+    // with the drop policy, every message is either written or counted as dropped
+    Log::StartAsync(Log::AsyncPolicy::Drop, 1024);
+    for (int32 i = 0; i < num; i++) {
+        Log::Info("drop %d\n", i);
+    }
+    Log::StopAsync();
+    Log::AsyncStats dropStats = Log::GetAsyncStats();
+    CHECK((dropStats.NumRecords - stats.NumRecords) + (dropStats.NumDropped - stats.NumDropped) == num);
+    {
+        std::lock_guard<std::mutex> guard(logger->mutex);
+        CHECK(logger->lines.Size() == int32(dropStats.NumRecords - stats.NumRecords));
+        logger->lines.Clear();
+    }
+
+    // stopping while another thread logs must not lose messages, the
+    // messages after the stop are written directly
+    Log::StartAsync(Log::AsyncPolicy::Block, 4096);
+    std::atomic<int32> numLogged{0};
+    std::thread stopWorker([&numLogged] {
+        for (int32 i = 0; i < num; i++) {
+            Log::Info("stop %d\n", i);
+            numLogged++;
+        }
+    });
+    while (numLogged < num / 2) {
+        std::this_thread::yield();
+    }
+    Log::StopAsync();
+    stopWorker.join();
+    {
+        std::lock_guard<std::mutex> guard(logger->mutex);
+        CHECK(logger->lines.Size() == num);
+        logger->capture = false;
+    }
+}
+#endif
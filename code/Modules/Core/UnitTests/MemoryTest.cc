@@ -73,6 +73,16 @@ TEST(Memory) {
     ptr = (void*) 0x1234567;
     ptr = Memory::Align(ptr, ORYOL_MAX_PLATFORM_ALIGN);
     CHECK((intptr(ptr) & (ORYOL_MAX_PLATFORM_ALIGN - 1)) == 0);
+    
+    // aligned allocation
+    for (int32 align = 1; align <= 256; align *= 2) {
+        uint8* p2 = (uint8*) Memory::AllocAligned(byteSize, align);
+        CHECK(nullptr != p2);
+        CHECK((intptr(p2) & (align - 1)) == 0);
+        Memory::Clear(p2, byteSize);
+        Memory::FreeAligned(p2);
+    }
+    Memory::FreeAligned(nullptr);
 }
 
 
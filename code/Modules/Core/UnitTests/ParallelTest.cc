@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//  ParallelTest.cc
+//  Test the parallel algorithms against their serial counterparts.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Threading/Parallel.h"
+#include "Core/Threading/WorkerPool.h"
+#include "Core/Log.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+using namespace Oryol;
+
+namespace {
+
+struct item {
+    uint32 key;
+    int32 order;
+};
+
+uint32
+rnd(uint32& seed) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+} // anonymous namespace
+
+TEST(ParallelTest) {
+    // run the test with and without worker threads
+    for (int32 numWorkers = 0; numWorkers < 4; numWorkers += 3) {
+        WorkerPool::Setup(numWorkers);
+        for (int32 num : { 0, 1, 7, 1000, 100000 }) {
+            const int32 grainSize = 64;
+
+            // For() visits each index exactly once
+            Array<int32> visits;
+            for (int32 i = 0; i < num; i++) {
+                visits.Add(0);
+            }
+            Parallel::For(0, num, grainSize, [&visits](int32 i) {
+                visits[i]++;
+            });
+            CHECK(std::all_of(visits.begin(), visits.end(), [](int32 v) { return v == 1; }));
+            std::atomic<int32> numVisits{0};
+            Parallel::For(10, 10 + num, grainSize, [&numVisits, num](int32 i) {
+                if ((i >= 10) && (i < 10 + num)) {
+                    numVisits++;
+                }
+            });
+            CHECK(numVisits == num);
+
+            // Reduce() matches the serial sum
+            int64 sum = Parallel::Reduce(0, num, grainSize, int64(5),
+                [](int32 i) { return int64(i); },
+                [](int64 a, int64 b) { return a + b; });
+            CHECK(sum == 5 + (int64(num) * (num - 1)) / 2);
+
+            // Scan() matches the serial exclusive scan, also in place
+            Array<int32> values;
+            Array<int32> scanned;
+            uint32 seed = 1;
+            for (int32 i = 0; i < num; i++) {
+                values.Add(int32(rnd(seed) & 0xFF));
+                scanned.Add(0);
+            }
+            int32 total = Parallel::Scan(Slice<const int32>(values.begin(), num), Slice<int32>(scanned.begin(), num), grainSize, 0,
+                [](int32 a, int32 b) { return a + b; });
+            int32 acc = 0;
+            bool scanOk = true;
+            for (int32 i = 0; i < num; i++) {
+                scanOk &= (scanned[i] == acc);
+                acc += values[i];
+            }
+            CHECK(scanOk);
+            CHECK(total == acc);
+            Parallel::Scan(Slice<const int32>(values.begin(), num), Slice<int32>(values.begin(), num), grainSize, 0,
+                [](int32 a, int32 b) { return a + b; });
+            CHECK(std::equal(values.begin(), values.end(), scanned.begin()));
+
+            // Sort() and RadixSort() are stable and match std::stable_sort
+            Array<item> items;
+            for (int32 i = 0; i < num; i++) {
+                items.Add(item{ rnd(seed) & 0xFFFF, i });
+            }
+            Array<item> expected(items);
+            auto less = [](const item& a, const item& b) { return a.key < b.key; };
+            std::stable_sort(expected.begin(), expected.end(), less);
+            auto same = [](const item& a, const item& b) { return (a.key == b.key) && (a.order == b.order); };
+            Array<item> sorted(items);
+            Parallel::Sort(sorted, grainSize, less);
+            CHECK(std::equal(sorted.begin(), sorted.end(), expected.begin(), same));
+            sorted = items;
+            Parallel::RadixSort(sorted, grainSize, [](const item& i) { return i.key; });
+            CHECK(std::equal(sorted.begin(), sorted.end(), expected.begin(), same));
+            sorted = items;
+            Parallel::RadixSort(sorted, grainSize, [](const item& i) { return uint64(i.key) << 32; });
+            CHECK(std::equal(sorted.begin(), sorted.end(), expected.begin(), same));
+        }
+
+        // nested parallel calls from within chunks
+        std::atomic<int32> numInner{0};
+        Parallel::For(0, 8, 1, [&numInner](int32) {
+            Parallel::For(0, 1000, 10, [&numInner](int32) {
+                numInner++;
+            });
+        });
+        CHECK(numInner == 8000);
+        WorkerPool::Discard();
+    }
+}
+
+TEST(ParallelForeignJobTest) {
+    // the caller of For() never runs unrelated WorkerPool jobs, even
+    // if the only worker is blocked by one and a helper job is queued
+    WorkerPool::Setup(1);
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    std::atomic<int32> numForeign{0};
+    struct foreign {
+        std::atomic<bool>* started;
+        std::atomic<bool>* release;
+        std::atomic<int32>* num;
+    } blocker{ &started, &release, &numForeign };
+    auto blockFunc = [](void* userData) {
+        foreign* f = (foreign*) userData;
+        *f->started = true;
+        while (!f->release->load()) {
+            // wait until the test is done
+        }
+        (*f->num)++;
+    };
+    auto countFunc = [](void* userData) {
+        (*((foreign*)userData)->num)++;
+    };
+    WorkerPool::Push(blockFunc, &blocker);
+    while (!started) {
+        // wait until the worker is blocked
+    }
+    WorkerPool::Push(countFunc, &blocker);
+    WorkerPool::Push(countFunc, &blocker, WorkerPool::Priority::Low);
+    std::atomic<int32> numVisited{0};
+    Parallel::For(0, 1000, 10, [&numVisited](int32) {
+        numVisited++;
+    });
+    CHECK(numVisited == 1000);
+    CHECK(numForeign == 0);
+    // RunOne() takes High jobs only, RunOwn() only jobs of its owner
+    CHECK(!WorkerPool::RunOwn(&numVisited));
+    CHECK(WorkerPool::RunOne());
+    CHECK(!WorkerPool::RunOne());
+    CHECK(numForeign == 1);
+    release = true;
+    WorkerPool::Discard();
+    CHECK(numForeign == 3);
+}
+
+TEST(ParallelBenchmark) {
+    WorkerPool::Setup();
+    const int32 num = 1000000;
+    Array<uint32> keys;
+    uint32 seed = 1234;
+    for (int32 i = 0; i < num; i++) {
+        keys.Add(rnd(seed));
+    }
+    Array<uint32> sorted(keys);
+    auto t = std::chrono::high_resolution_clock::now();
+    std::sort(sorted.begin(), sorted.end());
+    const double stdSort = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t).count();
+    sorted = keys;
+    t = std::chrono::high_resolution_clock::now();
+    Parallel::Sort(sorted, 4096, [](uint32 a, uint32 b) { return a < b; });
+    const double mergeSort = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t).count();
+    CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+    sorted = keys;
+    t = std::chrono::high_resolution_clock::now();
+    Parallel::RadixSort(sorted, 4096, [](uint32 k) { return k; });
+    const double radixSort = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t).count();
+    CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+    Log::Info("Parallel (%d workers, %d keys): std::sort %.2fms, Sort %.2fms, RadixSort %.2fms\n",
+        WorkerPool::NumWorkers(), num, stdSort, mergeSort, radixSort);
+    WorkerPool::Discard();
+}
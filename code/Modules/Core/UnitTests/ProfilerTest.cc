@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//  ProfilerTest.cc
+//  Test the built-in Profiler and its Chrome trace export.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Trace.h"
+#include "Core/Config.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <atomic>
+#endif
+
+using namespace Oryol;
+
+static int32
+countSubStrings(const StringBuilder& sb, const char* subStr) {
+    int32 count = 0;
+    int32 index = 0;
+    while ((index = sb.FindSubString(index, EndOfString, subStr)) != InvalidIndex) {
+        count++;
+        index++;
+    }
+    return count;
+}
+
+TEST(ProfilerTest) {
+    Profiler::Reset();
+
+    // nothing is recorded while disabled
+    CHECK(!Profiler::IsEnabled());
+    {
+        o_trace_scoped(ProfilerTest_Disabled);
+    }
+    Profiler::SetEnabled(true);
+    CHECK(Profiler::IsEnabled());
+    Profiler::SetThreadName("ProfilerTestMain");
+
+    o_trace_begin_frame();
+    o_trace_begin(ProfilerTest_Outer);
+    {
+        o_trace_scoped(ProfilerTest_Inner);
+        o_trace_counter(ProfilerTest_Counter, 42);
+    }
+    o_trace_end();
+    o_trace_end_frame();
+
+    #if ORYOL_HAS_THREADS
+    std::thread worker([] {
+        Profiler::SetThreadName("ProfilerTestWorker");
+        o_trace_scoped(ProfilerTest_Worker);
+    });
+    worker.join();
+    #endif
+    Profiler::SetEnabled(false);
+
+    StringBuilder json;
+    Profiler::DumpChromeTrace(json);
+    CHECK(json.Contains("\"traceEvents\":["));
+    CHECK(json.Contains("ProfilerTestMain"));
+    CHECK(!json.Contains("ProfilerTest_Disabled"));
+    CHECK(1 == countSubStrings(json, "\"name\":\"ProfilerTest_Outer\",\"ph\":\"B\""));
+    CHECK(1 == countSubStrings(json, "\"name\":\"ProfilerTest_Inner\",\"ph\":\"B\""));
+    CHECK(1 == countSubStrings(json, "\"name\":\"ProfilerTest_Counter\",\"ph\":\"C\""));
+    CHECK(json.Contains("\"args\":{\"value\":42}"));
+    CHECK(1 == countSubStrings(json, "\"name\":\"Frame\",\"ph\":\"i\""));
+    #if ORYOL_HAS_THREADS
+    CHECK(json.Contains("ProfilerTestWorker"));
+    CHECK(3 == countSubStrings(json, "\"ph\":\"B\""));
+    CHECK(3 == countSubStrings(json, "\"ph\":\"E\""));
+    #else
+    CHECK(2 == countSubStrings(json, "\"ph\":\"B\""));
+    CHECK(2 == countSubStrings(json, "\"ph\":\"E\""));
+    #endif
+
+    // reset discards recorded events
+    Profiler::Reset();
+    json.Clear();
+    Profiler::DumpChromeTrace(json);
+    CHECK(!json.Contains("ProfilerTest_Outer"));
+}
+
+TEST(ProfilerRingBufferTest) {
+    Profiler::Reset();
+    Profiler::SetEnabled(true);
+
+    // overflow the ring buffer, the oldest events are dropped, and
+    // no end event without a matching begin event is dumped
+    o_trace_begin(ProfilerTest_Lost);
+    for (int32 i = 0; i < Profiler::MaxEventsPerThread; i++) {
+        o_trace_scoped(ProfilerTest_Ring);
+    }
+    o_trace_end();
+    Profiler::SetEnabled(false);
+
+    StringBuilder json;
+    Profiler::DumpChromeTrace(json);
+    CHECK(!json.Contains("ProfilerTest_Lost"));
+    const int32 numBegin = countSubStrings(json, "\"ph\":\"B\"");
+    const int32 numEnd = countSubStrings(json, "\"ph\":\"E\"");
+    CHECK(numBegin == numEnd);
+    CHECK(numBegin == (Profiler::MaxEventsPerThread / 2) - 1);
+    Profiler::Reset();
+}
+
+TEST(ProfilerScopeToggleTest) {
+    Profiler::Reset();
+
+    // toggling recording inside a scope doesn't leave unmatched events
+    {
+        o_trace_scoped(ProfilerTest_EnabledInside);
+        Profiler::SetEnabled(true);
+    }
+    {
+        o_trace_scoped(ProfilerTest_DisabledInside);
+        Profiler::SetEnabled(false);
+    }
+    // o_trace_scoped() is a single declaration, so an unbraced if
+    // doesn't leak the scope object into the enclosing block
+    Profiler::SetEnabled(true);
+    bool skip = true;
+    if (!skip) o_trace_scoped(ProfilerTest_Skipped);
+    Profiler::SetEnabled(false);
+
+    StringBuilder json;
+    Profiler::DumpChromeTrace(json);
+    CHECK(!json.Contains("ProfilerTest_EnabledInside"));
+    CHECK(!json.Contains("ProfilerTest_Skipped"));
+    CHECK(1 == countSubStrings(json, "\"name\":\"ProfilerTest_DisabledInside\",\"ph\":\"B\""));
+    CHECK(1 == countSubStrings(json, "\"ph\":\"B\""));
+    CHECK(1 == countSubStrings(json, "\"ph\":\"E\""));
+    Profiler::Reset();
+}
+
+#if ORYOL_HAS_THREADS
+TEST(ProfilerConcurrentDumpTest) {
+    Profiler::Reset();
+    Profiler::SetEnabled(true);
+
+    // dump while another thread keeps overwriting its ring buffer, the
+    // dump only contains whole events, and never an unmatched end event
+    std::atomic<bool> stop{false};
+    std::thread worker([&stop] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            o_trace_scoped(ProfilerTest_Busy);
+            o_trace_counter(ProfilerTest_BusyCounter, 7);
+        }
+    });
+    for (int32 i = 0; i < 8; i++) {
+        StringBuilder json;
+        Profiler::DumpChromeTrace(json);
+        const int32 numBegin = countSubStrings(json, "\"name\":\"ProfilerTest_Busy\",\"ph\":\"B\"");
+        const int32 numEnd = countSubStrings(json, "\"ph\":\"E\"");
+        const int32 numCounter = countSubStrings(json, "\"name\":\"ProfilerTest_BusyCounter\",\"ph\":\"C\"");
+        CHECK(numEnd <= numBegin);
+        CHECK(numCounter == countSubStrings(json, "\"args\":{\"value\":7}"));
+        CHECK(numBegin + numEnd + numCounter == countSubStrings(json, "\"tid\":") - countSubStrings(json, "\"thread_name\""));
+    }
+    stop = true;
+    worker.join();
+    Profiler::SetEnabled(false);
+    Profiler::Reset();
+}
+#endif
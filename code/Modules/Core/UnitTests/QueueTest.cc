@@ -78,5 +78,23 @@ TEST(QueueTest) {
     CHECK(queue0.SpareDequeue() == 0);
     CHECK(queue0.Size() == 1);
     CHECK(queue0.Dequeue() == "Bla");
+
+    // indexed access and erasing from the middle
+    Queue<int32> queue3;
+    for (int32 i = 0; i < 6; i++) {
+        queue3.Enqueue(i);
+    }
+    CHECK(queue3[0] == 0);
+    CHECK(queue3[5] == 5);
+    queue3.Erase(2);
+    CHECK(queue3.Size() == 5);
+    CHECK(queue3[2] == 3);
+    queue3.Erase(0);
+    queue3.Erase(queue3.Size() - 1);
+    CHECK(queue3.Size() == 3);
+    CHECK(queue3.Dequeue() == 1);
+    CHECK(queue3.Dequeue() == 3);
+    CHECK(queue3.Dequeue() == 4);
+    CHECK(queue3.Empty());
 }
     
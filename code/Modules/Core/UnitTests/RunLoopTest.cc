@@ -5,6 +5,9 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/RunLoop.h"
+#include "Core/Threading/WorkerPool.h"
+#include "Core/Threading/Mutex.h"
+#include <atomic>
 
 using namespace Oryol;
 
@@ -30,3 +33,73 @@ TEST(RunLoopTest) {
     CHECK(y == 4);
     runLoop = 0;
 }
+
+TEST(RunLoopPhaseTest) {
+    // run the test with and without worker threads
+    for (int32 numWorkers = 0; numWorkers < 4; numWorkers += 3) {
+        WorkerPool::Setup(numWorkers);
+        Ptr<RunLoop> runLoop = RunLoop::Create();
+
+        // a diamond: A -> (B, C) -> D, plus an independent phase E
+        runLoop->AddPhase("A");
+        runLoop->AddPhase("B", { "A" });
+        runLoop->AddPhase("C", { "A", "Unknown" });
+        runLoop->AddPhase("D", { "B", "C" });
+        Mutex lock;
+        Array<char> order;
+        auto record = [&lock, &order](char name) {
+            ScopedLock l(lock);
+            order.Add(name);
+        };
+        std::atomic<int32> numC{0};
+        int32 legacy = 0;
+        int32 legacyAfter = 0;
+        runLoop->Add([&] { CHECK(order.Empty()); legacy++; });
+        runLoop->Add("D", [&] { record('D'); }, RunLoop::Affinity::AnyThread);
+        for (int32 i = 0; i < 8; i++) {
+            runLoop->Add("C", [&] { numC++; record('C'); }, RunLoop::Affinity::AnyThread);
+        }
+        runLoop->Add("B", [&] { record('B'); });
+        runLoop->Add("A", [&] { record('A'); }, RunLoop::Affinity::AnyThread);
+        runLoop->Add("E", [&] { record('E'); }, RunLoop::Affinity::AnyThread);
+        runLoop->Add([&] { CHECK(order.Size() >= 12); legacyAfter++; });
+        runLoop->Run();
+        CHECK(1 == legacy);
+        CHECK(1 == legacyAfter);
+        CHECK(8 == numC);
+        CHECK(12 == order.Size());
+        const int32 a = order.FindIndexLinear('A');
+        const int32 b = order.FindIndexLinear('B');
+        const int32 d = order.FindIndexLinear('D');
+        CHECK(0 == a);
+        CHECK(11 == d || (10 == d && order[11] == 'E'));
+        CHECK(b > a && b < d);
+        for (int32 i = 0; i < order.Size(); i++) {
+            if (order[i] == 'C') {
+                CHECK(i > a && i < d);
+            }
+        }
+
+        // removing callbacks and adding a phase dependency from a main-thread callback
+        order.Clear();
+        RunLoop::Id idE = runLoop->Add("E", [&] { record('e'); });
+        runLoop->Add("A", [&] {
+            if (runLoop->HasCallback(idE)) {
+                runLoop->Remove(idE);
+                runLoop->AddPhase("E", { "D" });
+            }
+        });
+        runLoop->Run();
+        CHECK(13 == order.Size());
+        order.Clear();
+        runLoop->Run();
+        CHECK(12 == order.Size());
+        CHECK(order[11] == 'E');
+        CHECK(InvalidIndex == order.FindIndexLinear('e'));
+        CHECK(3 == legacy);
+        CHECK(3 == legacyAfter);
+
+        runLoop = 0;
+        WorkerPool::Discard();
+    }
+}
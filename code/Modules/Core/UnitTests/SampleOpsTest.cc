@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+//  SampleOpsTest.cc
+//  Test the vectorized sample mixer against a scalar reference.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/sampleOps.h"
+#include <cstdlib>
+
+using namespace Oryol;
+using namespace Oryol::_priv;
+
+// the plain scalar mixing loop
+static void
+refMix(int16* dst, const int16* src, int32 srcStride, const int16* volumes, int32 numSources, int32 numSamples) {
+    for (int32 i = 0; i < numSamples; i++) {
+        int32 sum = 0;
+        for (int32 srcIndex = 0; srcIndex < numSources; srcIndex++) {
+            sum += (int32(src[srcIndex * srcStride + i]) * volumes[srcIndex]) >> 14;
+        }
+        if (sum < -0x8000) sum = -0x8000;
+        else if (sum > 0x7FFF) sum = 0x7FFF;
+        dst[i] = int16(sum);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(SampleOpsVolumeTest) {
+    CHECK(0 == sampleOps::ToVolume(0.0f));
+    CHECK(0 == sampleOps::ToVolume(-1.0f));
+    CHECK(sampleOps::VolumeOne == sampleOps::ToVolume(1.0f));
+    CHECK(sampleOps::VolumeOne / 2 == sampleOps::ToVolume(0.5f));
+    CHECK(0x7FFF == sampleOps::ToVolume(2.0f));
+    CHECK(0x7FFF == sampleOps::ToVolume(100.0f));
+}
+
+//------------------------------------------------------------------------------
+TEST(SampleOpsMixTest) {
+    const int32 maxNumSources = 8;
+    const int32 stride = 77;
+    int16 src[maxNumSources * stride];
+    int16 volumes[maxNumSources];
+    int16 dst[stride];
+    int16 ref[stride];
+
+    std::srand(1);
+    for (int32 round = 0; round < 64; round++) {
+        // full-scale samples and volumes up to the max, so that the
+        // sums clamp at both ends
+        for (int32 i = 0; i < maxNumSources * stride; i++) {
+            src[i] = int16((std::rand() & 0xFFFF) - 0x8000);
+        }
+        for (int32 i = 0; i < maxNumSources; i++) {
+            volumes[i] = int16(std::rand() & 0x7FFF);
+        }
+        const int32 numSources = round % (maxNumSources + 1);
+        const int32 numSamples = stride - (round % 16);
+        sampleOps::Mix(dst, src, stride, volumes, numSources, numSamples);
+        refMix(ref, src, stride, volumes, numSources, numSamples);
+        bool equal = true;
+        for (int32 i = 0; i < numSamples; i++) {
+            equal &= dst[i] == ref[i];
+        }
+        CHECK(equal);
+    }
+
+    // a single source at volume 1.0 is copied unchanged
+    for (int32 i = 0; i < stride; i++) {
+        src[i] = int16(i * 431 - 0x4000);
+    }
+    volumes[0] = sampleOps::VolumeOne;
+    sampleOps::Mix(dst, src, stride, volumes, 1, stride);
+    bool equal = true;
+    for (int32 i = 0; i < stride; i++) {
+        equal &= dst[i] == src[i];
+    }
+    CHECK(equal);
+}
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+//  SoaArrayTest.cc
+//  Test SoaArray and Slice.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/SoaArray.h"
+
+using namespace Oryol;
+
+struct vec3 {
+    float32 x, y, z;
+};
+
+TEST(SliceTest) {
+    int32 values[] = { 1, 2, 3, 4 };
+    Slice<int32> slice(values, 4);
+    CHECK(slice.Size() == 4);
+    CHECK(!slice.Empty());
+    CHECK(slice.Data() == values);
+    slice[1] = 5;
+    CHECK(values[1] == 5);
+    int32 sum = 0;
+    for (int32 v : slice) {
+        sum += v;
+    }
+    CHECK(sum == 13);
+    Slice<const int32> constSlice(slice);
+    CHECK(constSlice.Size() == 4);
+    CHECK(constSlice[1] == 5);
+    Slice<int32> empty;
+    CHECK(empty.Empty());
+    CHECK(empty.begin() == empty.end());
+}
+
+TEST(SoaArrayTest) {
+    SoaArray<vec3, float32, uint8> array0;
+    CHECK(array0.NumFields == 3);
+    CHECK(array0.Empty());
+    CHECK(array0.Size() == 0);
+    CHECK(array0.Capacity() == 0);
+    CHECK(array0.Stream<0>().Empty());
+
+    // add elements and check stream alignment
+    for (int32 i = 0; i < 100; i++) {
+        CHECK(i == array0.Add(vec3{ float32(i), 0.0f, 1.0f }, float32(i) * 2.0f, uint8(i)));
+    }
+    CHECK(array0.Size() == 100);
+    CHECK(array0.Capacity() >= 100);
+    CHECK((array0.Capacity() % SoaArray<vec3, float32, uint8>::CapacityGranularity) == 0);
+    CHECK((intptr(array0.Stream<0>().Data()) & (ORYOL_CONTAINER_STREAM_ALIGN - 1)) == 0);
+    CHECK((intptr(array0.Stream<1>().Data()) & (ORYOL_CONTAINER_STREAM_ALIGN - 1)) == 0);
+    CHECK((intptr(array0.Stream<2>().Data()) & (ORYOL_CONTAINER_STREAM_ALIGN - 1)) == 0);
+    for (int32 i = 0; i < 100; i++) {
+        CHECK(array0.Get<0>(i).x == float32(i));
+        CHECK(array0.Get<1>(i) == float32(i) * 2.0f);
+        CHECK(array0.Get<2>(i) == uint8(i));
+    }
+
+    // update loop over a typed stream
+    Slice<float32> stream1 = array0.Stream<1>();
+    CHECK(stream1.Size() == 100);
+    for (float32& f : stream1) {
+        f += 1.0f;
+    }
+    CHECK(array0.Get<1>(10) == 21.0f);
+
+    // swap-erase
+    array0.EraseSwap(10);
+    CHECK(array0.Size() == 99);
+    CHECK(array0.Get<0>(10).x == 99.0f);
+    CHECK(array0.Get<1>(10) == 199.0f);
+    CHECK(array0.Get<2>(10) == 99);
+    array0.EraseSwap(98);
+    CHECK(array0.Size() == 98);
+    CHECK(array0.Get<2>(97) == 97);
+
+    // copy and move
+    SoaArray<vec3, float32, uint8> array1(array0);
+    CHECK(array1.Size() == 98);
+    CHECK(array1.Capacity() < array0.Capacity());
+    CHECK(array1.Get<1>(10) == 199.0f);
+    CHECK(array1.Stream<0>().Data() != array0.Stream<0>().Data());
+    SoaArray<vec3, float32, uint8> array2(std::move(array1));
+    CHECK(array1.Empty());
+    CHECK(array1.Capacity() == 0);
+    CHECK(array2.Size() == 98);
+    CHECK(array2.Get<0>(97).x == 97.0f);
+    array1 = array2;
+    CHECK(array1.Size() == 98);
+    array2 = std::move(array0);
+    CHECK(array0.Empty());
+    CHECK(array2.Size() == 98);
+
+    // resize zero-initializes new elements
+    const SoaArray<vec3, float32, uint8>& constArray = array2;
+    array2.Resize(200);
+    CHECK(array2.Size() == 200);
+    CHECK(constArray.Get<1>(150) == 0.0f);
+    CHECK(constArray.Get<0>(199).z == 0.0f);
+    CHECK(constArray.Stream<2>().Size() == 200);
+    array2.Resize(10);
+    CHECK(array2.Size() == 10);
+    array2.Clear();
+    CHECK(array2.Empty());
+    CHECK(array2.Capacity() >= 200);
+
+    // reserve
+    SoaArray<float32> array3;
+    array3.Reserve(1000);
+    CHECK(array3.Capacity() >= 1000);
+    const float32* ptr = array3.Stream<0>().Data();
+    for (int32 i = 0; i < 1000; i++) {
+        array3.Add(float32(i));
+    }
+    CHECK(array3.Stream<0>().Data() == ptr);
+}
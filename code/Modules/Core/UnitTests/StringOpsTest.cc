@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+//  StringOpsTest.cc
+//  Test the vectorized string primitives against the C runtime and
+//  ConvertUTF, and compare their performance.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/String/stringOps.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/String/StringConverter.h"
+#include "Core/Log.h"
+#include "Ext/ConvertUTF/ConvertUTF.h"
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+
+using namespace Oryol;
+using namespace Oryol::_priv;
+
+// the C runtime searches (still used by StringBuilder), and the hash
+// and UTF-8 conversion which were replaced by stringOps
+static int32
+oldFindSubString(const char* str, const char* sub) {
+    const char* occur = std::strstr(str, sub);
+    return occur ? int32(occur - str) : InvalidIndex;
+}
+
+static int32
+oldFindFirstOf(const char* str, int32 len, const char* delims) {
+    const int32 index = int32(std::strcspn(str, delims));
+    return index < len ? index : InvalidIndex;
+}
+
+static int32
+oldFindFirstNotOf(const char* str, int32 len, const char* delims) {
+    const int32 index = int32(std::strspn(str, delims));
+    return index < len ? index : InvalidIndex;
+}
+
+static int32
+oldHash(const char* str) {
+    const char* p = str;
+    int32 h = 0;
+    char c;
+    while (0 != (c = *p++)) {
+        h += c;
+        h += (h << 10);
+        h ^= (h >> 6);
+    }
+    h += (h << 3);
+    h ^= (h >> 11);
+    h += (h << 15);
+    return h;
+}
+
+static int32
+oldUTF8ToUTF32(const uchar* src, int32 srcLen, uint32* dst, int32 dstMaxChars) {
+    const UTF8* srcPtr = src;
+    UTF32* dstPtr = (UTF32*) dst;
+    ConversionResult res = ConvertUTF8toUTF32(&srcPtr, src + srcLen, &dstPtr, (UTF32*)dst + dstMaxChars, strictConversion);
+    return conversionOK == res ? int32(dstPtr - (UTF32*)dst) : -1;
+}
+
+// a pseudo-random text with a few rare characters
+static void
+makeText(char* buf, int32 len, uint32 seed) {
+    for (int32 i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = "abcdefghijklmnopqrstuvwxyz ABCDEFG/"[(seed >> 16) % 35];
+    }
+    buf[len] = 0;
+}
+
+//------------------------------------------------------------------------------
+TEST(StringOpsSearchTest) {
+    char text[300];
+    const char* subs[] = { "a", "ab", "abc", "x/y", "z z", "qrstuvwxyzabcdefghijklmn", "ABCDEFG/ABC" };
+    const char* delims[] = { "/", ":/", " \t\n", "ABCDEFG", "abcdefghijklmn", "" };
+    for (uint32 seed = 1; seed < 200; seed++) {
+        const int32 len = int32(seed % 290);
+        makeText(text, len, seed);
+        for (const char* sub : subs) {
+            const int32 subLen = int32(std::strlen(sub));
+            CHECK(oldFindSubString(text, sub) == stringOps::FindSubString(text, len, sub, subLen));
+        }
+        for (const char* d : delims) {
+            CHECK(oldFindFirstOf(text, len, d) == stringOps::FindFirstOf(text, len, d));
+            CHECK(oldFindFirstNotOf(text, len, d) == stringOps::FindFirstNotOf(text, len, d));
+        }
+    }
+    // match at the very end, beyond the last full 16-byte block
+    std::memset(text, 'a', 40);
+    std::memcpy(text + 37, "xyz", 4);
+    CHECK(37 == stringOps::FindSubString(text, 40, "xyz", 3));
+    CHECK(39 == stringOps::FindFirstOf(text, 40, "z"));
+    CHECK(37 == stringOps::FindFirstNotOf(text, 40, "a"));
+    CHECK(InvalidIndex == stringOps::FindSubString(text, 39, "xyz", 3));
+
+    // the StringBuilder wrappers
+    StringBuilder builder("one two three one two three");
+    CHECK(14 == builder.FindSubString(1, EndOfString, "one"));
+    CHECK(InvalidIndex == builder.FindSubString(1, 14, "one"));
+    CHECK(14 == builder.FindSubString(1, 15, "one"));
+    CHECK(3 == builder.FindFirstOf(0, EndOfString, " "));
+    CHECK(InvalidIndex == builder.FindFirstOf(0, 3, " "));
+    CHECK(1 == builder.FindFirstNotOf(0, EndOfString, "o"));
+    CHECK(2 == StringBuilder::FindFirstNotOf("oops", 0, EndOfString, "o"));
+    CHECK(2 == builder.SubstituteAll("one", "one one"));
+    CHECK(builder.GetString() == "one one two three one one two three");
+}
+
+//------------------------------------------------------------------------------
+TEST(StringOpsHashTest) {
+    CHECK(stringOps::Hash("", 0) != 0);
+    CHECK(stringOps::Hash("abc", 3) == stringOps::Hash("abcd", 3));
+    CHECK(stringOps::Hash("abc", 3) != stringOps::Hash("abd", 3));
+    CHECK(stringOps::Hash("0123456789abcdef", 16) != stringOps::Hash("0123456789abcdeg", 16));
+}
+
+//------------------------------------------------------------------------------
+TEST(StringOpsUTF8Test) {
+    // valid: ASCII, 2-, 3- and 4-byte sequences, mixed with long ASCII runs
+    const char* valid = "Hello World, this is a long ASCII run \xC3\xA4\xC3\xB6\xC3\xBC "
+        "\xE2\x82\xAC and \xF0\x9F\x98\x80 followed by another long run of ASCII text";
+    const int32 validLen = int32(std::strlen(valid));
+    uint32 oldBuf[256];
+    uint32 newBuf[256];
+    const int32 oldNum = oldUTF8ToUTF32((const uchar*)valid, validLen, oldBuf, 256);
+    const int32 newNum = stringOps::UTF8ToUTF32((const uchar*)valid, validLen, newBuf, 256);
+    CHECK(oldNum > 0);
+    CHECK(oldNum == newNum);
+    CHECK(0 == std::memcmp(oldBuf, newBuf, newNum * sizeof(uint32)));
+    CHECK(stringOps::ValidateUTF8((const uchar*)valid, validLen));
+    CHECK(38 == stringOps::ASCIIPrefix((const uchar*)valid, validLen));
+
+    uint16 buf16[256];
+    const int32 num16 = stringOps::UTF8ToUTF16((const uchar*)valid, validLen, buf16, 256);
+    CHECK(num16 == newNum + 1);
+    int32 emoji = 0;
+    while ((emoji < oldNum) && (oldBuf[emoji] != 0x1F600)) {
+        emoji++;
+    }
+    CHECK(emoji < oldNum);
+    CHECK((buf16[emoji] == 0xD83D) && (buf16[emoji + 1] == 0xDE00));
+
+    // illegal: stray continuation, overlong, surrogate, > U+10FFFF, cut off
+    const char* illegal[] = { "abc\x80", "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80" };
+    for (const char* str : illegal) {
+        const int32 len = int32(std::strlen(str));
+        CHECK(!stringOps::ValidateUTF8((const uchar*)str, len));
+        CHECK(stringOps::SourceIllegal == stringOps::UTF8ToUTF32((const uchar*)str, len, newBuf, 256));
+        CHECK(-1 == oldUTF8ToUTF32((const uchar*)str, len, oldBuf, 256));
+    }
+    CHECK(stringOps::SourceExhausted == stringOps::UTF8ToUTF32((const uchar*)"ab\xE2\x82", 4, newBuf, 256));
+    CHECK(stringOps::TargetExhausted == stringOps::UTF8ToUTF32((const uchar*)valid, validLen, newBuf, 20));
+
+    // the StringConverter wrapper
+    WideString wide = StringConverter::UTF8ToWide((const uchar*)valid);
+    CHECK(StringConverter::WideToUTF8(wide) == valid);
+    CHECK(StringConverter::IsValidUTF8((const uchar*)valid, validLen));
+    CHECK(!StringConverter::IsValidUTF8((const uchar*)"\xC0\xAF", 2));
+}
+
+//------------------------------------------------------------------------------
+static double
+elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+TEST(StringOpsBenchmark) {
+    const int32 len = 4096;
+    const int32 numIter = 2000;
+    static char text[len + 1];
+    makeText(text, len, 1234);
+    // the searches don't find anything and run to the end, the start
+    // offset varies so the compiler can't hoist the calls out of the loops
+    const char* sub = "zyx/wvu";
+    const char* delims = "\t\n";
+    uint32 sum = 0;
+
+    auto t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += oldFindSubString(text + (i & 7), sub);
+    const double oldSub = elapsedMs(t);
+    t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += stringOps::FindSubString(text + (i & 7), len - (i & 7), sub, 7);
+    const double newSub = elapsedMs(t);
+
+    t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += oldFindFirstOf(text + (i & 7), len - (i & 7), delims);
+    const double oldDelim = elapsedMs(t);
+    t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += stringOps::FindFirstOf(text + (i & 7), len - (i & 7), delims);
+    const double newDelim = elapsedMs(t);
+
+    t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += oldHash(text + (i & 7));
+    const double oldHashMs = elapsedMs(t);
+    t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += stringOps::Hash(text + (i & 7), len - (i & 7));
+    const double newHashMs = elapsedMs(t);
+
+    static uint32 wide[len];
+    t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += oldUTF8ToUTF32((const uchar*)text + (i & 7), len - (i & 7), wide, len);
+    const double oldUTF8 = elapsedMs(t);
+    t = std::chrono::high_resolution_clock::now();
+    for (int32 i = 0; i < numIter; i++) sum += stringOps::UTF8ToUTF32((const uchar*)text + (i & 7), len - (i & 7), wide, len);
+    const double newUTF8 = elapsedMs(t);
+
+    Log::Info("stringOps (%d x %d bytes, old/new ms): substring %.2f/%.2f, first-of %.2f/%.2f, hash %.2f/%.2f, utf8 %.2f/%.2f (%d)\n",
+        numIter, len, oldSub, newSub, oldDelim, newDelim, oldHashMs, newHashMs, oldUTF8, newUTF8, sum & 1);
+}
@@ -6,6 +6,7 @@
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/String/String.h"
 #include "Core/String/StringAtom.h"
+#include "Core/String/StringArena.h"
 
 #include <cstring>
 
@@ -64,15 +65,30 @@ TEST(StringTest) {
     CHECK(str4 == blob);
     CHECK(str4 == "Blob");
     
-    // copy-assignment
+    // copy-assignment of a short, local string
     str0 = str2;
     CHECK(str0 == "Bla");
     CHECK(str0 == str2);
+    CHECK(str0.RefCount() == 1);
+    CHECK(str2.RefCount() == 1);
+    CHECK(str0.AsCStr() != str2.AsCStr());
+    str2.Clear();
+    CHECK(str0 == "Bla");
+    CHECK(str2.Empty());
+    str0.Clear();
+    CHECK(str0.Empty());
+
+    // copy-assignment of a long, shared string
+    const char* longBla = "Bla Bla Bla Bla Bla Bla Bla";
+    str2 = longBla;
+    str0 = str2;
+    CHECK(str0 == longBla);
+    CHECK(str0 == str2);
     CHECK(str0.RefCount() == 2);
     CHECK(str2.RefCount() == 2);
     CHECK(str0.AsCStr() == str2.AsCStr());  // tests for identical pointers!
     str2.Clear();
-    CHECK(str0 == "Bla");
+    CHECK(str0 == longBla);
     CHECK(str2.Empty());
     CHECK(str0.RefCount() == 1);
     CHECK(str2.RefCount() == 0);
@@ -151,3 +167,106 @@ TEST(StringTest) {
     CHECK(nullString.AsCStr() != nullptr);
     CHECK(nullString.AsCStr()[0] == 0);    
 }
+
+
+TEST(StringLocalStorageTest) {
+    // strings up to MaxLocalLength are stored inside the String object
+    const char* max = "0123456789abcdefghijklm";
+    CHECK(std::strlen(max) == String::MaxLocalLength);
+    String str0(max);
+    CHECK(str0.Length() == String::MaxLocalLength);
+    CHECK(str0 == max);
+    CHECK(str0.AsCStr()[String::MaxLocalLength] == 0);
+    CHECK((str0.AsCStr() >= (const char*)&str0) && (str0.AsCStr() < (const char*)(&str0 + 1)));
+    String str1(str0);
+    CHECK(str1 == str0);
+    CHECK(str1.AsCStr() != str0.AsCStr());
+    CHECK(str1.RefCount() == 1);
+
+    // one byte more goes to the heap and is shared
+    String str2("0123456789abcdefghijklmn");
+    CHECK(str2.Length() == String::MaxLocalLength + 1);
+    String str3(str2);
+    CHECK(str3.AsCStr() == str2.AsCStr());
+    CHECK(str2.RefCount() == 2);
+
+    // move leaves the source empty
+    String str4(std::move(str0));
+    CHECK(str4 == max);
+    CHECK(str0.Empty());
+    CHECK(!str0.IsValid());
+    str4 = std::move(str2);
+    CHECK(str4 == "0123456789abcdefghijklmn");
+    CHECK(str2.Empty());
+    CHECK(str4.RefCount() == 2);
+
+    // embedded 0 bytes in local strings
+    const char bytes[] = { 'a', 0, 'b', 0, 'c' };
+    String str5(bytes, 0, 5);
+    CHECK(str5.Length() == 5);
+    CHECK(0 == std::memcmp(str5.AsCStr(), bytes, 5));
+    CHECK(str5.AsCStr()[5] == 0);
+
+    // comparison between local and heap strings
+    CHECK(String("abc") < String("abcdefghijklmnopqrstuvwxyz"));
+    CHECK(String("abcdefghijklmnopqrstuvwxyz") != String("abc"));
+    CHECK(String("abcdefghijklmnopqrstuvwxyz") == String("abcdefghijklmnopqrstuvwxyz"));
+}
+
+TEST(StringArenaTest) {
+    StringArena arena(256);
+    CHECK(arena.NumChunks() == 0);
+    const char* longStr = "a long string which doesn't fit into a String object";
+    const int32 longLen = int32(std::strlen(longStr));
+
+    // short strings don't touch the arena
+    String str0(arena, "short", 0, EndOfString);
+    CHECK(str0 == "short");
+    CHECK(arena.NumBytes() == 0);
+
+    // long strings are allocated from the arena and not refcounted
+    String str1(arena, longStr, 0, EndOfString);
+    CHECK(str1 == longStr);
+    CHECK(str1.Length() == longLen);
+    CHECK(str1.RefCount() == 0);
+    CHECK(arena.NumChunks() == 1);
+    CHECK(arena.NumBytes() >= longLen + 1);
+    String str2(str1);
+    CHECK(str2.AsCStr() == str1.AsCStr());
+    CHECK(str2 == longStr);
+    String str3;
+    str3.Assign(arena, longStr, 2, 40);
+    CHECK(str3.Length() == 38);
+    CHECK(0 == std::strncmp(str3.AsCStr(), longStr + 2, 38));
+    CHECK(arena.NumChunks() == 1);
+
+    // a substring of an arena string is a regular string
+    String str4(str1, 0, 30);
+    CHECK(str4.RefCount() == 1);
+    CHECK(str4.AsCStr() != str1.AsCStr());
+
+    // oversized strings get their own chunk
+    char big[1000];
+    std::memset(big, 'x', sizeof(big));
+    String str5(arena, big, 0, sizeof(big));
+    CHECK(str5.Length() == sizeof(big));
+    CHECK(arena.NumChunks() == 2);
+
+    // fill the first chunk until a new one is needed
+    for (int32 i = 0; i < 10; i++) {
+        String str(arena, longStr, 0, EndOfString);
+        CHECK(str == longStr);
+    }
+    CHECK(arena.NumChunks() > 2);
+    CHECK(str1 == longStr);
+
+    str1.Clear();
+    str2.Clear();
+    str3.Clear();
+    str5.Clear();
+    arena.Reset();
+    CHECK(arena.NumChunks() == 0);
+    CHECK(arena.NumBytes() == 0);
+    CHECK(str0 == "short");
+    CHECK(str4 == String(longStr, 0, 30));
+}
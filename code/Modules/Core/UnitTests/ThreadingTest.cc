@@ -0,0 +1,277 @@
+//------------------------------------------------------------------------------
+//  ThreadingTest.cc
+//  Test Mutex, RWLock, Semaphore, Event and SPSCQueue.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Config.h"
+#include "Core/Threading/Mutex.h"
+#include "Core/Threading/RWLock.h"
+#include "Core/Threading/Semaphore.h"
+#include "Core/Threading/Event.h"
+#include "Core/Threading/SPSCQueue.h"
+#include "Core/Log.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <chrono>
+#endif
+
+using namespace Oryol;
+
+TEST(MutexTest) {
+    Mutex mutex;
+    mutex.EnableStats(true);
+    CHECK(mutex.TryLock());
+    CHECK(!mutex.TryLock());
+    mutex.Unlock();
+    {
+        ScopedLock lock(mutex);
+        CHECK(!mutex.TryLock());
+    }
+    CHECK(mutex.TryLock());
+    mutex.Unlock();
+    CHECK(mutex.Stats().NumAcquired == 3);
+    CHECK(mutex.Stats().NumContended == 0);
+
+    #if ORYOL_HAS_THREADS
+    const int32 numThreads = 4;
+    const int32 numIter = 100000;
+    int32 counter = 0;
+    std::thread threads[numThreads];
+    for (int32 i = 0; i < numThreads; i++) {
+        threads[i] = std::thread([&mutex, &counter] {
+            for (int32 j = 0; j < numIter; j++) {
+                ScopedLock lock(mutex);
+                counter++;
+            }
+        });
+    }
+    for (int32 i = 0; i < numThreads; i++) {
+        threads[i].join();
+    }
+    CHECK(counter == numThreads * numIter);
+    const LockStats stats = mutex.Stats();
+    CHECK(stats.NumAcquired == 3 + numThreads * numIter);
+    Log::Info("Mutex: acquired=%d contended=%d spins=%d waits=%d waitTime=%dus\n",
+        int(stats.NumAcquired), int(stats.NumContended), int(stats.NumSpins), int(stats.NumWaits), int(stats.WaitMicroSecs));
+    mutex.ResetStats();
+    CHECK(mutex.Stats().NumAcquired == 0);
+    #endif
+}
+
+TEST(RWLockTest) {
+    RWLock lock;
+    lock.EnableStats(true);
+
+    // readers share the lock
+    lock.LockRead();
+    lock.LockRead();
+    lock.UnlockRead();
+    lock.UnlockRead();
+    lock.LockWrite();
+    lock.UnlockWrite();
+    {
+        ScopedReadLock r(lock);
+    }
+    {
+        ScopedWriteLock w(lock);
+    }
+    CHECK(lock.Stats().NumAcquired == 5);
+    CHECK(lock.Stats().NumContended == 0);
+
+    #if ORYOL_HAS_THREADS
+    // writers keep two values in sync, readers must never see them differ
+    const int32 numIter = 20000;
+    int32 a = 0;
+    int32 b = 0;
+    std::atomic<int32> numTorn{0};
+    std::thread threads[4];
+    for (int32 i = 0; i < 2; i++) {
+        threads[i] = std::thread([&] {
+            for (int32 j = 0; j < numIter; j++) {
+                ScopedWriteLock w(lock);
+                a++;
+                b++;
+            }
+        });
+    }
+    for (int32 i = 2; i < 4; i++) {
+        threads[i] = std::thread([&] {
+            for (int32 j = 0; j < numIter; j++) {
+                ScopedReadLock r(lock);
+                if (a != b) {
+                    numTorn++;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    CHECK(0 == numTorn);
+    CHECK((a == 2 * numIter) && (b == 2 * numIter));
+    CHECK(lock.Stats().NumAcquired == 5 + 4 * numIter);
+
+    // a waiting writer blocks readers which arrive after it
+    lock.LockRead();
+    std::atomic<int32> order{0};
+    int32 writerOrder = 0;
+    int32 readerOrder = 0;
+    std::thread writer([&] {
+        lock.LockWrite();
+        writerOrder = ++order;
+        lock.UnlockWrite();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread reader([&] {
+        lock.LockRead();
+        readerOrder = ++order;
+        lock.UnlockRead();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(0 == order);
+    lock.UnlockRead();
+    writer.join();
+    reader.join();
+    CHECK((1 == writerOrder) && (2 == readerOrder));
+    #endif
+}
+
+TEST(SemaphoreTest) {
+    Semaphore sem(2);
+    CHECK(sem.Count() == 2);
+    CHECK(sem.TryWait());
+    sem.Wait();
+    CHECK(!sem.TryWait());
+    CHECK(!sem.TimedWait(5));
+    sem.Post(3);
+    CHECK(sem.Count() == 3);
+    CHECK(sem.TimedWait(5));
+    CHECK(sem.Count() == 2);
+
+    #if ORYOL_HAS_THREADS
+    // producer/consumer
+    Semaphore items;
+    items.EnableStats(true);
+    const int32 num = 10000;
+    std::atomic<int32> consumed{0};
+    std::thread consumers[2];
+    for (auto& c : consumers) {
+        c = std::thread([&] {
+            for (int32 i = 0; i < num / 2; i++) {
+                items.Wait();
+                consumed++;
+            }
+        });
+    }
+    for (int32 i = 0; i < num; i++) {
+        items.Post();
+    }
+    for (auto& c : consumers) {
+        c.join();
+    }
+    CHECK(consumed == num);
+    CHECK(items.Count() == 0);
+    CHECK(items.Stats().NumAcquired == num);
+    #endif
+}
+
+TEST(EventTest) {
+    Event autoEvent;
+    CHECK(!autoEvent.IsSignaled());
+    CHECK(!autoEvent.TimedWait(5));
+    autoEvent.Signal();
+    CHECK(autoEvent.IsSignaled());
+    autoEvent.Wait();
+    CHECK(!autoEvent.IsSignaled());
+
+    Event manualEvent(true);
+    manualEvent.Signal();
+    manualEvent.Wait();
+    CHECK(manualEvent.TimedWait(5));
+    CHECK(manualEvent.IsSignaled());
+    manualEvent.Reset();
+    CHECK(!manualEvent.TimedWait(5));
+
+    #if ORYOL_HAS_THREADS
+    // a manual-reset event releases all waiting threads
+    std::atomic<int32> released{0};
+    std::thread waiters[3];
+    for (auto& w : waiters) {
+        w = std::thread([&] {
+            manualEvent.Wait();
+            released++;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(0 == released);
+    manualEvent.Signal();
+    for (auto& w : waiters) {
+        w.join();
+    }
+    CHECK(3 == released);
+
+    // an auto-reset event releases one thread per signal
+    std::atomic<int32> pingPong{0};
+    Event ping;
+    Event pong;
+    std::thread t([&] {
+        for (int32 i = 0; i < 1000; i++) {
+            ping.Wait();
+            pingPong++;
+            pong.Signal();
+        }
+    });
+    for (int32 i = 0; i < 1000; i++) {
+        ping.Signal();
+        pong.Wait();
+    }
+    t.join();
+    CHECK(1000 == pingPong);
+    #endif
+}
+
+TEST(SPSCQueueTest) {
+    SPSCQueue<int32, 4> queue;
+    CHECK(queue.Empty());
+    CHECK(4 == queue.Capacity());
+    int32 val = 0;
+    CHECK(!queue.Pop(val));
+    for (int32 i = 0; i < 4; i++) {
+        CHECK(queue.Push(i));
+    }
+    CHECK(!queue.Push(4));
+    CHECK(4 == queue.Size());
+    CHECK(queue.Pop(val) && (0 == val));
+    CHECK(queue.Push(4));
+    for (int32 i = 1; i < 5; i++) {
+        CHECK(queue.Pop(val) && (i == val));
+    }
+    CHECK(queue.Empty());
+
+    #if ORYOL_HAS_THREADS
+    // items must arrive complete and in order
+    static SPSCQueue<int64, 64> threadQueue;
+    const int32 num = 100000;
+    std::thread producer([&] {
+        for (int32 i = 0; i < num; i++) {
+            while (!threadQueue.Push((int64(i) << 32) | i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int32 numOk = 0;
+    for (int32 i = 0; i < num; i++) {
+        int64 item;
+        while (!threadQueue.Pop(item)) {
+            std::this_thread::yield();
+        }
+        if (item == ((int64(i) << 32) | i)) {
+            numOk++;
+        }
+    }
+    producer.join();
+    CHECK(num == numOk);
+    CHECK(threadQueue.Empty());
+    #endif
+}
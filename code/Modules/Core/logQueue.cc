@@ -0,0 +1,683 @@
+//------------------------------------------------------------------------------
+//  logQueue.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "logQueue.h"
+#include "Core/Config.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+#include "Core/Threading/Event.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+/// a per-thread ring buffer, written by the owning thread, read by the log thread
+struct logBuffer {
+    logBuffer* next = nullptr;
+    int32 size = 0;
+    uint8* data = nullptr;
+    std::atomic<uint64> head{0};
+    std::atomic<uint64> tail{0};
+};
+
+namespace {
+
+/// header in front of each record in a ring buffer
+struct recordHeader {
+    /// record size including header, multiple of 8
+    uint32 size;
+    /// Log::Level, or SkipRecord for padding at the end of the ring
+    uint32 level;
+    /// the format string
+    const char* fmt;
+};
+const uint32 SkipRecord = 0xFFFFFFFF;
+const int32 HeaderSize = int32(sizeof(recordHeader));
+
+/// printf length modifiers
+enum lengthMod {
+    LenNone,
+    LenHH,
+    LenH,
+    LenL,
+    LenLL,
+    LenJ,
+    LenZ,
+    LenT,
+    LenBigL,
+};
+
+/// a parsed printf conversion specification
+struct fmtSpec {
+    const char* flags = nullptr;
+    int32 flagsLen = 0;
+    bool widthStar = false;
+    const char* width = nullptr;
+    int32 widthLen = 0;
+    bool hasPrec = false;
+    bool precStar = false;
+    const char* prec = nullptr;
+    int32 precLen = 0;
+    lengthMod len = LenNone;
+    char conv = 0;
+};
+
+/// global async log state
+struct logState {
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopRequested{false};
+    /// number of threads inside Put(), Stop() waits for them
+    std::atomic<int32> numPutting{0};
+    /// set by the log thread before it goes to sleep
+    std::atomic<bool> idle{false};
+    Log::AsyncPolicy policy = Log::AsyncPolicy::Drop;
+    int32 bufferSize = 0;
+    logQueue::WriteFunc writeFunc = nullptr;
+    std::atomic<logBuffer*> buffers{nullptr};
+    std::atomic<int64> numRecords{0};
+    std::atomic<int64> numDropped{0};
+    std::atomic<int64> numBlocked{0};
+    std::atomic<int64> numTruncated{0};
+    #if ORYOL_HAS_THREADS
+    std::thread thread;
+    Event wakeup;
+    #endif
+};
+logState state;
+ORYOL_THREADLOCAL_PTR(logBuffer) curBuffer = nullptr;
+// only set on the log thread
+ORYOL_THREADLOCAL_PTR(logState) logThreadState = nullptr;
+
+//------------------------------------------------------------------------------
+bool
+isLogThread() {
+    return nullptr != logThreadState;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Parse a conversion specification, p points to the character after
+ the '%'. Returns pointer to the character after the specification.
+*/
+const char*
+parseSpec(const char* p, fmtSpec& spec) {
+    spec.flags = p;
+    while (*p && std::strchr("-+ #0", *p)) {
+        p++;
+    }
+    spec.flagsLen = int32(p - spec.flags);
+    if ('*' == *p) {
+        spec.widthStar = true;
+        p++;
+    }
+    else {
+        spec.width = p;
+        while ((*p >= '0') && (*p <= '9')) {
+            p++;
+        }
+        spec.widthLen = int32(p - spec.width);
+    }
+    if ('.' == *p) {
+        spec.hasPrec = true;
+        p++;
+        if ('*' == *p) {
+            spec.precStar = true;
+            p++;
+        }
+        else {
+            spec.prec = p;
+            while ((*p >= '0') && (*p <= '9')) {
+                p++;
+            }
+            spec.precLen = int32(p - spec.prec);
+        }
+    }
+    switch (*p) {
+        case 'h': if ('h' == p[1]) { spec.len = LenHH; p += 2; } else { spec.len = LenH; p++; } break;
+        case 'l': if ('l' == p[1]) { spec.len = LenLL; p += 2; } else { spec.len = LenL; p++; } break;
+        case 'j': spec.len = LenJ; p++; break;
+        case 'z': spec.len = LenZ; p++; break;
+        case 't': spec.len = LenT; p++; break;
+        case 'L': spec.len = LenBigL; p++; break;
+        default: break;
+    }
+    spec.conv = *p;
+    if (*p) {
+        p++;
+    }
+    return p;
+}
+
+/// sequential writer for encoded arguments
+struct argWriter {
+    uint8* dst;
+    int32 size;
+    int32 pos;
+    template<class T> bool put(T val) {
+        if ((this->pos + int32(sizeof(T))) > this->size) {
+            return false;
+        }
+        std::memcpy(this->dst + this->pos, &val, sizeof(T));
+        this->pos += int32(sizeof(T));
+        return true;
+    };
+};
+
+/// sequential reader for encoded arguments
+struct argReader {
+    const uint8* src;
+    int32 size;
+    int32 pos;
+    template<class T> bool get(T& val) {
+        if ((this->pos + int32(sizeof(T))) > this->size) {
+            return false;
+        }
+        std::memcpy(&val, this->src + this->pos, sizeof(T));
+        this->pos += int32(sizeof(T));
+        return true;
+    };
+};
+
+//------------------------------------------------------------------------------
+/**
+ Build a printf conversion specification for a decoded argument, with
+ '*' width and precision replaced by the recorded values and the
+ length modifier replaced by one that matches the stored value.
+*/
+void
+buildSpec(const fmtSpec& spec, int64 width, int64 prec, const char* len, char* buf, int32 bufSize) {
+    // bufSize must be big enough for the clamped pieces
+    o_assert_dbg(bufSize >= 64);
+    const int32 maxLen = 12;
+    int32 pos = 0;
+    pos += std::snprintf(buf + pos, bufSize - pos, "%%%.*s", std::min(spec.flagsLen, maxLen), spec.flags);
+    if (spec.widthStar) {
+        pos += std::snprintf(buf + pos, bufSize - pos, "%d", int(width));
+    }
+    else {
+        pos += std::snprintf(buf + pos, bufSize - pos, "%.*s", std::min(spec.widthLen, maxLen), spec.width);
+    }
+    if (spec.hasPrec) {
+        if (spec.precStar) {
+            pos += std::snprintf(buf + pos, bufSize - pos, ".%d", int(prec));
+        }
+        else {
+            pos += std::snprintf(buf + pos, bufSize - pos, ".%.*s", std::min(spec.precLen, maxLen), spec.prec);
+        }
+    }
+    std::snprintf(buf + pos, bufSize - pos, "%s%c", len, spec.conv);
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int32
+logQueue::encode(const char* fmt, va_list args, uint8* dst, int32 dstSize, bool& outTruncated) {
+    o_assert_dbg(fmt && dst);
+    outTruncated = false;
+    argWriter w{ dst, dstSize, 0 };
+    va_list ap;
+    va_copy(ap, args);
+    const char* p = fmt;
+    bool ok = true;
+    while (ok && *p) {
+        if ('%' != *p++) {
+            continue;
+        }
+        if ('%' == *p) {
+            p++;
+            continue;
+        }
+        fmtSpec spec;
+        p = parseSpec(p, spec);
+        if (spec.widthStar) {
+            ok = w.put<int64>(va_arg(ap, int));
+        }
+        if (ok && spec.precStar) {
+            ok = w.put<int64>(va_arg(ap, int));
+        }
+        if (!ok) {
+            break;
+        }
+        switch (spec.conv) {
+            case 'd':
+            case 'i':
+                switch (spec.len) {
+                    case LenL:  ok = w.put<int64>(va_arg(ap, long)); break;
+                    case LenLL: ok = w.put<int64>(va_arg(ap, long long)); break;
+                    case LenJ:  ok = w.put<int64>(va_arg(ap, intmax_t)); break;
+                    case LenZ:  ok = w.put<int64>(va_arg(ap, size_t)); break;
+                    case LenT:  ok = w.put<int64>(va_arg(ap, ptrdiff_t)); break;
+                    default:    ok = w.put<int64>(va_arg(ap, int)); break;
+                }
+                break;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                switch (spec.len) {
+                    case LenL:  ok = w.put<uint64>(va_arg(ap, unsigned long)); break;
+                    case LenLL: ok = w.put<uint64>(va_arg(ap, unsigned long long)); break;
+                    case LenJ:  ok = w.put<uint64>(va_arg(ap, uintmax_t)); break;
+                    case LenZ:  ok = w.put<uint64>(va_arg(ap, size_t)); break;
+                    case LenT:  ok = w.put<uint64>(va_arg(ap, ptrdiff_t)); break;
+                    default:    ok = w.put<uint64>(va_arg(ap, unsigned int)); break;
+                }
+                break;
+            case 'c':
+                ok = w.put<int64>(va_arg(ap, int));
+                break;
+            case 'f': case 'F':
+            case 'e': case 'E':
+            case 'g': case 'G':
+            case 'a': case 'A':
+                if (LenBigL == spec.len) {
+                    ok = w.put<float64>(float64(va_arg(ap, long double)));
+                }
+                else {
+                    ok = w.put<float64>(va_arg(ap, double));
+                }
+                break;
+            case 's':
+                {
+                    // wide strings are not supported, and are recorded as empty string
+                    const char* str = nullptr;
+                    if (LenL == spec.len) {
+                        (void) va_arg(ap, const wchar_t*);
+                        str = "";
+                    }
+                    else {
+                        str = va_arg(ap, const char*);
+                        if (nullptr == str) {
+                            str = "(null)";
+                        }
+                    }
+                    const int32 strLen = int32(std::strlen(str));
+                    const int32 maxLen = w.size - w.pos - int32(sizeof(uint16));
+                    if (maxLen < 0) {
+                        ok = false;
+                        break;
+                    }
+                    const uint16 len = uint16(strLen < maxLen ? strLen : maxLen);
+                    if (!w.put<uint16>(len)) {
+                        ok = false;
+                        break;
+                    }
+                    std::memcpy(w.dst + w.pos, str, len);
+                    w.pos += len;
+                    ok = (len == strLen);
+                }
+                break;
+            case 'p':
+                ok = w.put<uint64>(uint64(uintptr_t(va_arg(ap, void*))));
+                break;
+            case 'n':
+                (void) va_arg(ap, void*);
+                break;
+            default:
+                // unknown conversion, can't know the argument type
+                ok = false;
+                break;
+        }
+    }
+    va_end(ap);
+    outTruncated = !ok;
+    return w.pos;
+}
+
+//------------------------------------------------------------------------------
+int32
+logQueue::decode(const char* fmt, const uint8* src, int32 srcSize, char* dst, int32 dstSize) {
+    o_assert_dbg(fmt && dst && (dstSize > 0));
+    argReader r{ src, srcSize, 0 };
+    const int32 maxPos = dstSize - 1;
+    int32 pos = 0;
+    char specBuf[64];
+    char strBuf[MaxRecordSize];
+    const char* p = fmt;
+    bool ok = true;
+    while (*p && (pos < maxPos)) {
+        if ('%' != *p) {
+            dst[pos++] = *p++;
+            continue;
+        }
+        p++;
+        if ('%' == *p) {
+            dst[pos++] = '%';
+            p++;
+            continue;
+        }
+        fmtSpec spec;
+        p = parseSpec(p, spec);
+        int64 width = 0;
+        int64 prec = 0;
+        if ((spec.widthStar && !r.get(width)) || (spec.precStar && !r.get(prec))) {
+            ok = false;
+            break;
+        }
+        int32 n = 0;
+        switch (spec.conv) {
+            case 'd':
+            case 'i':
+                {
+                    int64 val;
+                    if (!(ok = r.get(val))) break;
+                    buildSpec(spec, width, prec, "ll", specBuf, sizeof(specBuf));
+                    n = std::snprintf(dst + pos, dstSize - pos, specBuf, (long long) val);
+                }
+                break;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                {
+                    uint64 val;
+                    if (!(ok = r.get(val))) break;
+                    buildSpec(spec, width, prec, "ll", specBuf, sizeof(specBuf));
+                    n = std::snprintf(dst + pos, dstSize - pos, specBuf, (unsigned long long) val);
+                }
+                break;
+            case 'c':
+                {
+                    int64 val;
+                    if (!(ok = r.get(val))) break;
+                    buildSpec(spec, width, prec, "", specBuf, sizeof(specBuf));
+                    n = std::snprintf(dst + pos, dstSize - pos, specBuf, int(val));
+                }
+                break;
+            case 'f': case 'F':
+            case 'e': case 'E':
+            case 'g': case 'G':
+            case 'a': case 'A':
+                {
+                    float64 val;
+                    if (!(ok = r.get(val))) break;
+                    buildSpec(spec, width, prec, "", specBuf, sizeof(specBuf));
+                    n = std::snprintf(dst + pos, dstSize - pos, specBuf, val);
+                }
+                break;
+            case 's':
+                {
+                    uint16 len;
+                    if (!(ok = r.get(len))) break;
+                    if (!(ok = ((r.pos + len) <= r.size))) break;
+                    std::memcpy(strBuf, r.src + r.pos, len);
+                    strBuf[len] = 0;
+                    r.pos += len;
+                    buildSpec(spec, width, prec, "", specBuf, sizeof(specBuf));
+                    n = std::snprintf(dst + pos, dstSize - pos, specBuf, strBuf);
+                }
+                break;
+            case 'p':
+                {
+                    uint64 val;
+                    if (!(ok = r.get(val))) break;
+                    buildSpec(spec, width, prec, "", specBuf, sizeof(specBuf));
+                    n = std::snprintf(dst + pos, dstSize - pos, specBuf, (void*)uintptr_t(val));
+                }
+                break;
+            case 'n':
+                break;
+            default:
+                ok = false;
+                break;
+        }
+        if (!ok) {
+            break;
+        }
+        if (n > 0) {
+            pos += n;
+            if (pos > maxPos) {
+                pos = maxPos;
+            }
+        }
+    }
+    if (!ok) {
+        pos += std::snprintf(dst + pos, dstSize - pos, "[...]");
+        if (pos > maxPos) {
+            pos = maxPos;
+        }
+    }
+    dst[pos] = 0;
+    return pos;
+}
+
+//------------------------------------------------------------------------------
+void
+logQueue::Start(Log::AsyncPolicy policy, int32 bufferSize, WriteFunc writeFunc) {
+    o_assert(!IsRunning());
+    o_assert(writeFunc);
+    o_assert2((bufferSize >= 2 * MaxRecordSize) && (0 == (bufferSize & (bufferSize - 1))),
+        "async log buffer size must be a power of 2 and at least 2 * MaxRecordSize\n");
+    #if ORYOL_HAS_THREADS
+    state.policy = policy;
+    state.bufferSize = bufferSize;
+    state.writeFunc = writeFunc;
+    state.stopRequested = false;
+    state.thread = std::thread(threadFunc);
+    state.running = true;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+logQueue::Stop() {
+    o_assert(IsRunning());
+    #if ORYOL_HAS_THREADS
+    // new Put() calls fail from here on and the callers write their
+    // messages directly, wait for the Put() calls which are already
+    // past the check so that their records make it into the final drain
+    state.running = false;
+    while (state.numPutting.load() > 0) {
+        state.wakeup.Signal();
+        std::this_thread::yield();
+    }
+    state.stopRequested = true;
+    state.wakeup.Signal();
+    state.thread.join();
+    drain();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
+logQueue::IsRunning() {
+    return state.running.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+logBuffer*
+logQueue::threadBuffer() {
+    logBuffer* buf = curBuffer;
+    if (nullptr == buf) {
+        buf = new(Memory::Alloc(sizeof(logBuffer))) logBuffer();
+        buf->size = state.bufferSize;
+        buf->data = (uint8*) Memory::Alloc(buf->size);
+
+        // push onto the global buffer list without locking
+        logBuffer* head = state.buffers.load(std::memory_order_relaxed);
+        do {
+            buf->next = head;
+        }
+        while (!state.buffers.compare_exchange_weak(head, buf, std::memory_order_release, std::memory_order_relaxed));
+        curBuffer = buf;
+    }
+    return buf;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Returns false without touching args if the log thread isn't running
+ (or is being stopped), the caller must then write the message itself.
+*/
+bool
+logQueue::Put(Log::Level lvl, const char* fmt, va_list args) {
+    // register before checking running, Stop() clears running before
+    // it checks numPutting, so one of them sees the other
+    state.numPutting.fetch_add(1);
+    if (!state.running.load()) {
+        state.numPutting.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+    putRecord(lvl, fmt, args);
+    state.numPutting.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+logQueue::putRecord(Log::Level lvl, const char* fmt, va_list args) {
+    uint64 rec[MaxRecordSize / sizeof(uint64)];
+    uint8* recPtr = (uint8*) rec;
+    bool truncated = false;
+    const int32 payloadSize = encode(fmt, args, recPtr + HeaderSize, MaxRecordSize - HeaderSize, truncated);
+    if (truncated) {
+        state.numTruncated++;
+    }
+    recordHeader hdr;
+    hdr.size = uint32(Memory::RoundUp(HeaderSize + payloadSize, 8));
+    hdr.level = uint32(lvl);
+    hdr.fmt = fmt;
+    std::memcpy(recPtr, &hdr, HeaderSize);
+
+    // find room in the ring buffer, a record must not wrap around
+    // the end of the ring, instead the rest of the ring is skipped
+    logBuffer* buf = threadBuffer();
+    const uint64 capacity = uint64(buf->size);
+    uint64 head = buf->head.load(std::memory_order_relaxed);
+    const uint64 remaining = capacity - (head & (capacity - 1));
+    const uint64 needed = (remaining < hdr.size) ? (remaining + hdr.size) : hdr.size;
+    if ((capacity - (head - buf->tail.load(std::memory_order_acquire))) < needed) {
+        // the log thread can't wait for itself
+        if ((Log::AsyncPolicy::Drop == state.policy) || isLogThread()) {
+            state.numDropped++;
+            return;
+        }
+        state.numBlocked++;
+        #if ORYOL_HAS_THREADS
+        // the log thread keeps running until all Put() calls have
+        // returned, even if Stop() has been called in the meantime
+        while ((capacity - (head - buf->tail.load(std::memory_order_acquire))) < needed) {
+            state.wakeup.Signal();
+            std::this_thread::yield();
+        }
+        #endif
+    }
+    if (remaining < hdr.size) {
+        if (remaining >= uint64(HeaderSize)) {
+            recordHeader skip;
+            skip.size = uint32(remaining);
+            skip.level = SkipRecord;
+            skip.fmt = nullptr;
+            std::memcpy(buf->data + (head & (capacity - 1)), &skip, HeaderSize);
+        }
+        head += remaining;
+    }
+    std::memcpy(buf->data + (head & (capacity - 1)), recPtr, hdr.size);
+    buf->head.store(head + hdr.size, std::memory_order_release);
+
+    // only wake up the log thread if it has gone to sleep, pairs
+    // with the fence in threadFunc()
+    #if ORYOL_HAS_THREADS
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state.idle.load(std::memory_order_relaxed) && state.idle.exchange(false)) {
+        state.wakeup.Signal();
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
+logQueue::drain() {
+    bool anyWritten = false;
+    char msg[MaxMessageLength];
+    for (logBuffer* buf = state.buffers.load(std::memory_order_acquire); buf; buf = buf->next) {
+        const uint64 capacity = uint64(buf->size);
+        const uint64 head = buf->head.load(std::memory_order_acquire);
+        uint64 tail = buf->tail.load(std::memory_order_relaxed);
+        while (tail != head) {
+            const uint64 offset = tail & (capacity - 1);
+            const uint64 remaining = capacity - offset;
+            if (remaining < uint64(HeaderSize)) {
+                tail += remaining;
+            }
+            else {
+                recordHeader hdr;
+                std::memcpy(&hdr, buf->data + offset, HeaderSize);
+                if (SkipRecord != hdr.level) {
+                    decode(hdr.fmt, buf->data + offset + HeaderSize, hdr.size - HeaderSize, msg, sizeof(msg));
+                    state.writeFunc((Log::Level)hdr.level, msg);
+                    state.numRecords++;
+                    anyWritten = true;
+                }
+                tail += hdr.size;
+            }
+            // free the space right away, a writer may be waiting for it
+            buf->tail.store(tail, std::memory_order_release);
+        }
+    }
+    return anyWritten;
+}
+
+//------------------------------------------------------------------------------
+void
+logQueue::Flush() {
+    if (!IsRunning() || isLogThread()) {
+        return;
+    }
+    #if ORYOL_HAS_THREADS
+    for (logBuffer* buf = state.buffers.load(std::memory_order_acquire); buf; buf = buf->next) {
+        const uint64 head = buf->head.load(std::memory_order_acquire);
+        while (IsRunning() && (buf->tail.load(std::memory_order_acquire) < head)) {
+            state.wakeup.Signal();
+            std::this_thread::yield();
+        }
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+Log::AsyncStats
+logQueue::Stats() {
+    Log::AsyncStats stats;
+    stats.NumRecords = state.numRecords;
+    stats.NumDropped = state.numDropped;
+    stats.NumBlocked = state.numBlocked;
+    stats.NumTruncated = state.numTruncated;
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+void
+logQueue::threadFunc() {
+    #if ORYOL_HAS_THREADS
+    logThreadState = &state;
+    while (!state.stopRequested) {
+        if (!drain()) {
+            // announce going to sleep and look once more, a producer
+            // either sees the idle flag and signals, or has published
+            // its record before the second drain()
+            state.idle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!drain() && !state.stopRequested) {
+                state.wakeup.Wait();
+            }
+            state.idle.store(false, std::memory_order_relaxed);
+        }
+    }
+    drain();
+    #endif
+}
+
+} // namespace _priv
+} // namespace Oryol
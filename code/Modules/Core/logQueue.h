@@ -0,0 +1,83 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::logQueue
+    @ingroup _priv
+    @brief asynchronous log record queue
+
+    Backend for Log::StartAsync(). A thread calling Log::Info() and the
+    other log functions doesn't format the message. Instead, it encodes a
+    compact binary record into its own ring buffer. The record holds the
+    format string pointer and the raw argument values. A background
+    thread drains all ring buffers, formats the messages and hands them
+    to the loggers.
+
+    Each ring buffer has exactly one writer (the owning thread) and one
+    reader (the log thread), so no locks are needed. Ring buffers are
+    allocated on the first async log call of a thread and are never
+    freed. After that, logging doesn't allocate.
+
+    Since the record is formatted later, string arguments (%s) are copied
+    into the record. The format string itself is not, it must live in
+    static storage (see Log::Info()). Records are at most MaxRecordSize bytes. Arguments
+    that don't fit are dropped, and the formatted message ends with
+    "[...]". Long double arguments are stored as double, and %n is
+    ignored.
+
+    Log::StopAsync() waits for the threads which are in the middle of
+    putting a record and writes their records. Messages logged after
+    StopAsync() has begun are written directly.
+
+    Messages from one thread are written in order. Messages from
+    different threads may be interleaved differently than they were
+    logged.
+*/
+#include "Core/Log.h"
+#include "Core/Types.h"
+#include <cstdarg>
+
+namespace Oryol {
+namespace _priv {
+
+struct logBuffer;
+
+class logQueue {
+public:
+    /// max size of an encoded record in bytes
+    static const int32 MaxRecordSize = 512;
+    /// max length of a formatted message
+    static const int32 MaxMessageLength = 1024;
+    /// function which writes a formatted message to the loggers
+    typedef void (*WriteFunc)(Log::Level lvl, const char* str);
+
+    /// start the log thread
+    static void Start(Log::AsyncPolicy policy, int32 bufferSize, WriteFunc writeFunc);
+    /// stop the log thread, pending records are written before
+    static void Stop();
+    /// test if the log thread is running
+    static bool IsRunning();
+    /// put a log record into the calling thread's ring buffer, return false if not running
+    static bool Put(Log::Level lvl, const char* fmt, va_list args);
+    /// block until all records which have been put so far have been written
+    static void Flush();
+    /// get statistics counters
+    static Log::AsyncStats Stats();
+
+    /// encode printf-style arguments, returns number of bytes written to dst
+    static int32 encode(const char* fmt, va_list args, uint8* dst, int32 dstSize, bool& outTruncated);
+    /// format an encoded record, returns length of formatted string
+    static int32 decode(const char* fmt, const uint8* src, int32 srcSize, char* dst, int32 dstSize);
+
+private:
+    /// get or create the calling thread's ring buffer
+    static logBuffer* threadBuffer();
+    /// encode a record into the calling thread's ring buffer
+    static void putRecord(Log::Level lvl, const char* fmt, va_list args);
+    /// write all pending records of all buffers, return true if any were written
+    static bool drain();
+    /// the log thread function
+    static void threadFunc();
+};
+
+} // namespace _priv
+} // namespace Oryol
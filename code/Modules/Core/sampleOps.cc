@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+//  sampleOps.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "sampleOps.h"
+#include "Core/Assertion.h"
+#if ORYOL_SIMD_SSE
+#include <emmintrin.h>
+#elif ORYOL_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+int16
+sampleOps::ToVolume(float32 vol) {
+    int32 v = int32(vol * float32(VolumeOne));
+    if (v < 0) {
+        v = 0;
+    }
+    else if (v > 0x7FFF) {
+        v = 0x7FFF;
+    }
+    return int16(v);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The sample loop is the outer loop, so the running sums of a block
+ of samples stay in registers while all sources are added. A source
+ sample times its volume always fits into 32 bits.
+*/
+void
+sampleOps::Mix(int16* dst, const int16* src, int32 srcStride, const int16* volumes, int32 numSources, int32 numSamples) {
+    o_assert_dbg(dst && src && volumes);
+    o_assert_dbg(srcStride >= numSamples);
+
+    int32 i = 0;
+    #if ORYOL_SIMD_SSE
+    for (; (i + 8) <= numSamples; i += 8) {
+        __m128i sum0 = _mm_setzero_si128();
+        __m128i sum1 = _mm_setzero_si128();
+        const int16* s = src + i;
+        for (int32 srcIndex = 0; srcIndex < numSources; srcIndex++, s += srcStride) {
+            // 16x16 => 32 bit products from the low and high halves
+            const __m128i vol = _mm_set1_epi16(volumes[srcIndex]);
+            const __m128i x = _mm_loadu_si128((const __m128i*)s);
+            const __m128i lo = _mm_mullo_epi16(x, vol);
+            const __m128i hi = _mm_mulhi_epi16(x, vol);
+            sum0 = _mm_add_epi32(sum0, _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 14));
+            sum1 = _mm_add_epi32(sum1, _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 14));
+        }
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(sum0, sum1));
+    }
+    #elif ORYOL_SIMD_NEON
+    for (; (i + 8) <= numSamples; i += 8) {
+        int32x4_t sum0 = vdupq_n_s32(0);
+        int32x4_t sum1 = vdupq_n_s32(0);
+        const int16* s = src + i;
+        for (int32 srcIndex = 0; srcIndex < numSources; srcIndex++, s += srcStride) {
+            const int16x4_t vol = vdup_n_s16(volumes[srcIndex]);
+            const int16x8_t x = vld1q_s16(s);
+            sum0 = vaddq_s32(sum0, vshrq_n_s32(vmull_s16(vget_low_s16(x), vol), 14));
+            sum1 = vaddq_s32(sum1, vshrq_n_s32(vmull_s16(vget_high_s16(x), vol), 14));
+        }
+        vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(sum0), vqmovn_s32(sum1)));
+    }
+    #endif
+    for (; i < numSamples; i++) {
+        int32 sum = 0;
+        const int16* s = src + i;
+        for (int32 srcIndex = 0; srcIndex < numSources; srcIndex++, s += srcStride) {
+            sum += (int32(*s) * volumes[srcIndex]) >> 14;
+        }
+        if (sum < -0x8000) sum = -0x8000;
+        else if (sum > 0x7FFF) sum = 0x7FFF;
+        dst[i] = int16(sum);
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
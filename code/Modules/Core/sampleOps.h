@@ -0,0 +1,33 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::sampleOps
+    @ingroup _priv
+    @brief vectorized 16-bit audio sample mixing
+
+    The mixing kernel shared by the Synth and Sound modules. Each
+    source buffer has a fixed-point volume (1<<14 is 1.0, the max is
+    just below 2.0). The scaled samples are summed in 32 bits, and
+    clamped to 16 bits once all sources have been added, so loud
+    sources don't clip quiet ones before the final sum. The SSE2 and
+    NEON code paths mix 8 samples per step, the scalar code path
+    produces exactly the same results.
+*/
+#include "Core/Config.h"
+#include "Core/Types.h"
+
+namespace Oryol {
+namespace _priv {
+
+class sampleOps {
+public:
+    /// the volume value for 1.0
+    static const int32 VolumeOne = 1<<14;
+    /// convert a float volume (0.0f .. 2.0f) to a mixer volume
+    static int16 ToVolume(float32 vol);
+    /// mix numSources source buffers (srcStride samples apart) into dst
+    static void Mix(int16* dst, const int16* src, int32 srcStride, const int16* volumes, int32 numSources, int32 numSamples);
+};
+
+} // namespace _priv
+} // namespace Oryol
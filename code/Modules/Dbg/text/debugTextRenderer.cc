@@ -5,7 +5,13 @@
 #include "debugTextRenderer.h"
 #include "Gfx/Gfx.h"
 #include "IO/Stream/MemoryStream.h"
+#include "Core/Core.h"
 #include "DebugShaders.h"
+#if ORYOL_SIMD_SSE
+#include <emmintrin.h>
+#elif ORYOL_SIMD_NEON
+#include <arm_neon.h>
+#endif
 
 namespace Oryol {
 namespace _priv {
@@ -15,7 +21,10 @@ extern const char *kc85_4_Font;
 //------------------------------------------------------------------------------
 debugTextRenderer::debugTextRenderer() :
 textScale(1.0f, 1.0f),
-valid(false) {
+valid(false),
+runLoopId(RunLoop::InvalidId),
+curRetainedMesh(0),
+numDrawsInFrame(0) {
     // NOTE: text rendering will be setup lazily when the text rendering
     // method is called first
     this->stringBuilder.Reserve(MaxNumChars * 2);
@@ -49,6 +58,12 @@ debugTextRenderer::setup() {
     this->setupTextMesh();
     this->setupTextDrawState();
     Gfx::PopResourceLabel();
+
+    // the first draw of a frame goes into the next retained mesh
+    this->runLoopId = Core::PostRunLoop()->Add("Dbg", [this]() {
+        this->curRetainedMesh = (this->curRetainedMesh + 1) % NumRetainedMeshes;
+        this->numDrawsInFrame = 0;
+    });
     this->valid = true;
 }
 
@@ -57,6 +72,11 @@ void
 debugTextRenderer::discard() {
     o_assert(this->valid);
     this->valid = false;
+    Core::PostRunLoop()->Remove(this->runLoopId);
+    this->runLoopId = RunLoop::InvalidId;
+    for (auto& rm : this->retainedMeshes) {
+        rm.numGlyphs = 0;
+    }
     Gfx::DestroyResources(this->resourceLabel);
 }
 
@@ -121,11 +141,11 @@ debugTextRenderer::drawTextBuffer() {
     this->stringBuilder.Clear();
     this->rwLock.UnlockWrite();
     
-    // convert string into vertices
-    int32 numVertices = this->convertStringToVertices(str);
+    // convert string into glyphs
+    const int32 numGlyphs = this->convertStringToGlyphs(str);
 
-    // draw the vertices
-    if (numVertices > 0) {
+    // draw the glyphs
+    if (numGlyphs > 0) {
         // compute the size factor for one 8x8 glyph on screen
         // FIXME: this would be wrong if rendering to a render target which
         // isn't the same size as the back buffer, there's no method yet
@@ -136,13 +156,56 @@ debugTextRenderer::drawTextBuffer() {
         const float h = 8.0f / Gfx::RenderTargetAttrs().FramebufferHeight;  // glyph is 8 pixel tall
         vsParams.GlyphSize = glm::vec2(w * 2.0f, h * 2.0f) * this->textScale;
         fsParams.Texture = this->fontTexture;
-    
-        Gfx::UpdateVertices(this->textMesh, this->vertexData, numVertices * this->vertexLayout.ByteSize());
-        Gfx::ApplyDrawState(this->textDrawState);
-        Gfx::ApplyUniformBlock(vsParams);
-        Gfx::ApplyUniformBlock(fsParams);
-        Gfx::Draw(PrimitiveGroup(PrimitiveType::Triangles, 0, numVertices));
+        const int32 numVertices = numGlyphs * 6;
+
+        if (0 == this->numDrawsInFrame++) {
+            // only update the changed glyphs in the retained mesh
+            this->updateRetainedMesh(numGlyphs);
+            Gfx::ApplyDrawState(this->retainedMeshes[this->curRetainedMesh].drawState);
+            Gfx::ApplyUniformBlock(vsParams);
+            Gfx::ApplyUniformBlock(fsParams);
+            Gfx::Draw(PrimitiveGroup(PrimitiveType::Triangles, 0, numVertices));
+        }
+        else {
+            // text drawn more than once per frame, append to the streaming mesh
+            this->writeGlyphVertices(0, numGlyphs);
+            const int32 baseVertex = Gfx::AppendVertices(this->textMesh, this->vertexData, numVertices * this->vertexLayout.ByteSize());
+            if (InvalidIndex != baseVertex) {
+                Gfx::ApplyDrawState(this->textDrawState);
+                Gfx::ApplyUniformBlock(vsParams);
+                Gfx::ApplyUniformBlock(fsParams);
+                Gfx::Draw(PrimitiveGroup(PrimitiveType::Triangles, 0, numVertices), baseVertex);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+debugTextRenderer::updateRetainedMesh(int32 numGlyphs) {
+    retainedMesh& rm = this->retainedMeshes[this->curRetainedMesh];
+    const int32 vertexSize = this->vertexLayout.ByteSize();
+    int32 i = 0;
+    while (i < numGlyphs) {
+        if ((i < rm.numGlyphs) && (this->glyphs[i] == rm.glyphs[i])) {
+            i++;
+            continue;
+        }
+        // found a changed glyph, extend the range over short unchanged gaps
+        const int32 first = i;
+        int32 last = i;
+        for (i++; (i < numGlyphs) && ((i - last) <= MaxGlyphGap); i++) {
+            if ((i >= rm.numGlyphs) || (this->glyphs[i] != rm.glyphs[i])) {
+                last = i;
+            }
+        }
+        const int32 num = last - first + 1;
+        Memory::Copy(&this->glyphs[first], &rm.glyphs[first], num * sizeof(uint64));
+        this->writeGlyphVertices(first, num);
+        Gfx::UpdateVertices(rm.mesh, first * 6 * vertexSize, &this->vertexData[first * 6], num * 6 * vertexSize);
+        i = last + 1;
     }
+    rm.numGlyphs = numGlyphs;
 }
 
 //------------------------------------------------------------------------------
@@ -209,6 +272,15 @@ debugTextRenderer::setupTextMesh() {
     this->textMesh = Gfx::CreateResource(setup);
     o_assert(this->textMesh.IsValid());
     o_assert(Gfx::QueryResourceInfo(this->textMesh).State == ResourceState::Valid);
+
+    // the retained meshes are only updated where glyphs have changed
+    MeshSetup retainedSetup = MeshSetup::Empty(maxNumVerts, Usage::Dynamic);
+    retainedSetup.Layout = this->vertexLayout;
+    for (auto& rm : this->retainedMeshes) {
+        rm.mesh = Gfx::CreateResource(retainedSetup);
+        rm.numGlyphs = 0;
+        o_assert(rm.mesh.IsValid());
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -220,7 +292,8 @@ debugTextRenderer::setupTextDrawState() {
     // shader
     Id shd = Gfx::CreateResource(Shaders::TextShader::CreateSetup());
     
-    // finally create draw state
+    // finally create draw states, one for the streaming mesh, and
+    // one for each retained mesh
     auto dss = DrawStateSetup::FromMeshAndShader(this->textMesh, shd);
     dss.DepthStencilState.DepthWriteEnabled = false;
     dss.DepthStencilState.DepthCmpFunc = CompareFunc::Always;
@@ -234,32 +307,88 @@ debugTextRenderer::setupTextDrawState() {
     dss.BlendState.DepthFormat = Gfx::RenderTargetAttrs().DepthPixelFormat;
     dss.RasterizerState.SampleCount = Gfx::RenderTargetAttrs().SampleCount;
     this->textDrawState = Gfx::CreateResource(dss);
+    for (auto& rm : this->retainedMeshes) {
+        dss.Meshes[0] = rm.mesh;
+        rm.drawState = Gfx::CreateResource(dss);
+    }
 }
 
 //------------------------------------------------------------------------------
-int32
-debugTextRenderer::writeVertex(int32 index, uint8 x, uint8 y, uint8 u, uint8 v, uint32 rgba) {
-    this->vertexData[index].x = (float) x;
-    this->vertexData[index].y = (float) y;
-    this->vertexData[index].u = (float) u;
-    this->vertexData[index].v = (float) v;
-    this->vertexData[index].color = rgba;
-/*
-    this->vertexData[index][0] = (v << 24) | (u << 16) | (y << 8) | x;
-    this->vertexData[index][1] = rgba;
-*/
-    return index + 1;
+void
+debugTextRenderer::writeGlyphVertices(int32 firstGlyph, int32 numGlyphs) {
+    o_assert_dbg((firstGlyph >= 0) && ((firstGlyph + numGlyphs) <= MaxNumChars));
+
+    // the 6 corners of a glyph quad, added to (x, y, u, v)
+    static const float corners[6][4] = {
+        { 0.0f, 0.0f, 0.0f, 0.0f },
+        { 1.0f, 0.0f, 1.0f, 0.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 0.0f, 0.0f, 0.0f, 0.0f },
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 0.0f, 1.0f, 0.0f, 1.0f },
+    };
+    const uint64* glyphPtr = &this->glyphs[firstGlyph];
+    Vertex* vtx = &this->vertexData[firstGlyph * 6];
+    #if ORYOL_SIMD_SSE
+    const __m128i zero = _mm_setzero_si128();
+    __m128 c[6];
+    for (int32 i = 0; i < 6; i++) {
+        c[i] = _mm_loadu_ps(corners[i]);
+    }
+    for (int32 i = 0; i < numGlyphs; i++, vtx += 6) {
+        // unpack the x, y, char bytes into (x, y, u, 0)
+        const uint64 glyph = glyphPtr[i];
+        __m128i b = _mm_cvtsi32_si128(int(uint32(glyph)));
+        b = _mm_unpacklo_epi16(_mm_unpacklo_epi8(b, zero), zero);
+        const __m128 base = _mm_cvtepi32_ps(b);
+        const uint32 rgba = uint32(glyph >> 32);
+        for (int32 k = 0; k < 6; k++) {
+            _mm_storeu_ps(&vtx[k].x, _mm_add_ps(base, c[k]));
+            vtx[k].color = rgba;
+        }
+    }
+    #elif ORYOL_SIMD_NEON
+    float32x4_t c[6];
+    for (int32 i = 0; i < 6; i++) {
+        c[i] = vld1q_f32(corners[i]);
+    }
+    for (int32 i = 0; i < numGlyphs; i++, vtx += 6) {
+        const uint64 glyph = glyphPtr[i];
+        const uint16x4_t b = vget_low_u16(vmovl_u8(vcreate_u8(glyph & 0xFFFFFFFF)));
+        const float32x4_t base = vcvtq_f32_u32(vmovl_u16(b));
+        const uint32 rgba = uint32(glyph >> 32);
+        for (int32 k = 0; k < 6; k++) {
+            vst1q_f32(&vtx[k].x, vaddq_f32(base, c[k]));
+            vtx[k].color = rgba;
+        }
+    }
+    #else
+    for (int32 i = 0; i < numGlyphs; i++, vtx += 6) {
+        const uint64 glyph = glyphPtr[i];
+        const float x = float(glyph & 0xFF);
+        const float y = float((glyph >> 8) & 0xFF);
+        const float u = float((glyph >> 16) & 0xFF);
+        const uint32 rgba = uint32(glyph >> 32);
+        for (int32 k = 0; k < 6; k++) {
+            vtx[k].x = x + corners[k][0];
+            vtx[k].y = y + corners[k][1];
+            vtx[k].u = u + corners[k][2];
+            vtx[k].v = corners[k][3];
+            vtx[k].color = rgba;
+        }
+    }
+    #endif
 }
 
 //------------------------------------------------------------------------------
 int32
-debugTextRenderer::convertStringToVertices(const String& str) {
+debugTextRenderer::convertStringToGlyphs(const String& str) {
 
     int32 cursorX = 0;
     int32 cursorY = 0;
     const int32 cursorMaxX = MaxNumColumns - 1;
     const int32 cursorMaxY = MaxNumLines - 1;
-    int32 vIndex = 0;
+    int32 numGlyphs = 0;
     uint32 rgba = 0xFF00FFFF;
     
     const int32 numChars = str.Length() > MaxNumChars ? MaxNumChars : str.Length();
@@ -312,18 +441,13 @@ debugTextRenderer::convertStringToVertices(const String& str) {
         }
         else {
             // still space in vertex buffer?
-            if ((vIndex < (MaxNumVertices - 6)) && (cursorX <= cursorMaxX)) {
+            if ((numGlyphs < (MaxNumChars - 1)) && (cursorX <= cursorMaxX)) {
                 // renderable character, only consider 7 bit (codes > 127 can be
                 // used to render control-code characters)
                 c &= 0x7F;
                 
-                // write 6 vertices
-                vIndex = this->writeVertex(vIndex, cursorX, cursorY, c, 0, rgba);
-                vIndex = this->writeVertex(vIndex, cursorX+1, cursorY, c+1, 0, rgba);
-                vIndex = this->writeVertex(vIndex, cursorX+1, cursorY+1, c+1, 1, rgba);
-                vIndex = this->writeVertex(vIndex, cursorX, cursorY, c, 0, rgba);
-                vIndex = this->writeVertex(vIndex, cursorX+1, cursorY+1, c+1, 1, rgba);
-                vIndex = this->writeVertex(vIndex, cursorX, cursorY+1, c, 1, rgba);
+                // the 6 vertices are written when the glyph has changed
+                this->glyphs[numGlyphs++] = packGlyph(cursorX, cursorY, c, rgba);
                 
                 // advance horizontal cursor position
                 cursorX++;
@@ -334,7 +458,7 @@ debugTextRenderer::convertStringToVertices(const String& str) {
             }
         }
     }
-    return vIndex;
+    return numGlyphs;
 }
 
 } // namespace _priv
@@ -4,6 +4,19 @@
     @class Oryol::_priv::debugTextRenderer
     @ingroup _priv
     @brief minimalistic 7-bit-ASCII text renderer
+
+    The accumulated text is converted into glyphs (cell position,
+    character and color packed into 64 bits), and the glyph quads
+    are kept in retained Usage::Dynamic meshes. Each frame, the new
+    glyphs are compared against the glyphs of the retained mesh, and
+    only the quads of changed glyph ranges are regenerated (with SIMD
+    where available) and uploaded, so unchanged text costs a scan
+    of the string and a compare, but no vertex writes or uploads.
+
+    There's one retained mesh per frame in flight, since a range
+    update must not touch vertices which the GPU may still read.
+    If the text is drawn more than once per frame, the additional
+    draws stream their vertices into a Usage::Stream mesh.
 */
 #include "Core/Types.h"
 #include "Resource/Id.h"
@@ -11,6 +24,8 @@
 #include "Core/String/StringBuilder.h"
 #include "Core/Threading/RWLock.h"
 #include "Gfx/Core/VertexLayout.h"
+#include "Gfx/Core/GfxConfig.h"
+#include "Core/RunLoop.h"
 #include "glm/vec2.hpp"
 #include "glm/vec4.hpp"
 #include <cstdarg>
@@ -56,15 +71,23 @@ private:
     void setupTextMesh();
     /// setup the text draw state
     void  setupTextDrawState();
-    /// convert the provides string object into vertices, and return number of vertices
-    int32 convertStringToVertices(const String& str);
-    /// write one glyph vertex, returns next vertex index
-    int32 writeVertex(int32 vertexIndex, uint8 x, uint8 y, uint8 u, uint8 v, uint32 rgba);
+    /// convert the provided string object into glyphs, and return number of glyphs
+    int32 convertStringToGlyphs(const String& str);
+    /// write the 6 vertices of each glyph in a range into vertexData
+    void writeGlyphVertices(int32 firstGlyph, int32 numGlyphs);
+    /// update the changed glyph ranges of the current retained mesh
+    void updateRetainedMesh(int32 numGlyphs);
+    /// pack a glyph into 64 bits
+    static uint64 packGlyph(uint8 x, uint8 y, uint8 c, uint32 rgba);
     
     static const int32 MaxNumColumns = 120;
     static const int32 MaxNumLines = 80;
     static const int32 MaxNumChars = MaxNumColumns * MaxNumLines;
     static const int32 MaxNumVertices = MaxNumChars * 6;
+    /// one retained mesh per frame in flight
+    static const int32 NumRetainedMeshes = GfxConfig::MaxInflightFrames;
+    /// changed glyph ranges closer than this are uploaded together
+    static const int32 MaxGlyphGap = 16;
     
     glm::vec2 textScale;
     VertexLayout vertexLayout;
@@ -75,6 +98,19 @@ private:
     StringBuilder stringBuilder;
     bool valid;
     ResourceLabel resourceLabel;
+    RunLoop::Id runLoopId;
+    int32 curRetainedMesh;
+    int32 numDrawsInFrame;
+    
+    /// a mesh with the quads of the glyphs it has been drawn with
+    struct retainedMesh {
+        Id mesh;
+        Id drawState;
+        int32 numGlyphs = 0;
+        uint64 glyphs[MaxNumChars];
+    };
+    retainedMesh retainedMeshes[NumRetainedMeshes];
+    uint64 glyphs[MaxNumChars];
     
     // 6 vertices per character, 2 uint32's per vertex (pos+uv, color)
 //    uint32 vertexData[MaxNumVertices][2];
@@ -85,5 +121,11 @@ private:
     struct Vertex vertexData[MaxNumVertices];
 };
 
+//------------------------------------------------------------------------------
+inline uint64
+debugTextRenderer::packGlyph(uint8 x, uint8 y, uint8 c, uint32 rgba) {
+    return uint64(x) | (uint64(y) << 8) | (uint64(c) << 16) | (uint64(rgba) << 32);
+}
+
 } // namespace _priv
 } // namespace Oryol
@@ -30,8 +30,8 @@ public:
     static const int32 MaxNumUniformLayoutComponents = 16;
     /// maximum number of components in vertex layout
     static const int32 MaxNumVertexLayoutComponents = 16;
-    /// maximum number of in-flight frames for Metal
-    static const int32 MtlMaxInflightFrames = 3;
+    /// max number of frames the CPU may run ahead of the GPU (enforced by all renderers)
+    static const int32 MaxInflightFrames = 3;
 };
 
 } // namespace Oryol
\ No newline at end of file
@@ -3,6 +3,7 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "UniformLayout.h"
+#include "Core/Memory/Memory.h"
 
 namespace Oryol {
 
@@ -10,10 +11,38 @@ namespace Oryol {
 UniformLayout::UniformLayout() :
 TypeHash(0),
 numComps(0),
-byteSize(0) {
+byteSize(0),
+std140ByteSize(0),
+std140SrcOffset(InvalidIndex),
+std140Compatible(true) {
     // empty
 }
 
+//------------------------------------------------------------------------------
+static int32
+std140Alignment(UniformType::Code type) {
+    switch (type) {
+        case UniformType::Vec2:     return 8;
+        case UniformType::Vec3:
+        case UniformType::Vec4:
+        case UniformType::Mat2:
+        case UniformType::Mat3:
+        case UniformType::Mat4:     return 16;
+        default:                    return 4;
+    }
+}
+
+//------------------------------------------------------------------------------
+static int32
+std140Size(UniformType::Code type) {
+    // NOTE: matrix columns are padded to vec4 in std140
+    switch (type) {
+        case UniformType::Mat2:     return 2 * 16;
+        case UniformType::Mat3:     return 3 * 16;
+        default:                    return UniformType::ByteSize(type);
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 UniformLayout::Clear() {
@@ -22,6 +51,9 @@ UniformLayout::Clear() {
     }
     this->numComps = 0;
     this->byteSize = 0;
+    this->std140ByteSize = 0;
+    this->std140SrcOffset = InvalidIndex;
+    this->std140Compatible = true;
 }
 
 //------------------------------------------------------------------------------
@@ -30,6 +62,25 @@ UniformLayout::Add(const Component& comp) {
     o_assert(this->numComps < GfxConfig::MaxNumUniformLayoutComponents);
     this->comps[this->numComps] = comp;
     this->byteOffsets[this->numComps] = this->byteSize;
+    if (UniformType::Texture != comp.Type) {
+        const int32 std140Offset = Memory::RoundUp(this->std140ByteSize, std140Alignment(comp.Type));
+        this->std140Offsets[this->numComps] = std140Offset;
+        this->std140ByteSize = std140Offset + std140Size(comp.Type);
+        if (InvalidIndex == this->std140SrcOffset) {
+            this->std140SrcOffset = this->byteSize;
+        }
+        if ((std140Offset != (this->byteSize - this->std140SrcOffset)) ||
+            (std140Size(comp.Type) != comp.ByteSize())) {
+            this->std140Compatible = false;
+        }
+    }
+    else {
+        this->std140Offsets[this->numComps] = InvalidIndex;
+        if (InvalidIndex != this->std140SrcOffset) {
+            // a texture after non-texture uniforms, C struct data isn't contiguous
+            this->std140Compatible = false;
+        }
+    }
     this->byteSize += comp.ByteSize();
     this->numComps++;
     return *this;
@@ -53,4 +104,36 @@ UniformLayout::ByteSizeWithoutTextures() const {
     return byteSize;
 }
 
+//------------------------------------------------------------------------------
+void
+UniformLayout::ConvertToStd140(const uint8* src, uint8* dst) const {
+    o_assert_dbg(src && dst);
+    if (0 == this->std140ByteSize) {
+        return;
+    }
+    if (this->std140Compatible) {
+        Memory::Copy(src + this->std140SrcOffset, dst, this->std140ByteSize);
+        return;
+    }
+    for (int i = 0; i < this->numComps; i++) {
+        const UniformType::Code type = this->comps[i].Type;
+        if (UniformType::Texture == type) {
+            continue;
+        }
+        const uint8* srcPtr = src + this->byteOffsets[i];
+        uint8* dstPtr = dst + this->std140Offsets[i];
+        if ((UniformType::Mat2 == type) || (UniformType::Mat3 == type)) {
+            // copy matrix columns into vec4-strided std140 columns
+            const int32 numCols = (UniformType::Mat2 == type) ? 2 : 3;
+            const int32 colSize = numCols * sizeof(float32);
+            for (int col = 0; col < numCols; col++) {
+                Memory::Copy(srcPtr + col * colSize, dstPtr + col * 16, colSize);
+            }
+        }
+        else {
+            Memory::Copy(srcPtr, dstPtr, this->comps[i].ByteSize());
+        }
+    }
+}
+
 } // namespace Oryol
@@ -4,6 +4,14 @@
     @class Oryol::UniformLayout
     @ingroup Gfx
     @brief describes the layout of an uniform block
+
+    Besides the packed layout of the C uniform block struct, the
+    UniformLayout also computes the std140 layout of the non-texture
+    uniforms, which is used to write uniform blocks into GL uniform
+    buffers. vec3's are padded to 16 bytes in both layouts (the shader
+    code generator writes explicit padding fields), so that for
+    blocks without mat2 or mat3 uniforms the std140 data is a simple
+    copy of the C struct (minus the leading texture ids).
 */
 #include "Gfx/Core/Enums.h"
 #include "Gfx/Core/GfxConfig.h"
@@ -61,11 +69,24 @@ public:
     /// get byte offset of a component
     int32 ComponentByteOffset(int32 componentIndex) const;
 
+    /// get the byte size of the std140 data (without textures, rounded up to 16)
+    int32 Std140ByteSize() const;
+    /// get std140 byte offset of a component (InvalidIndex for textures)
+    int32 ComponentStd140ByteOffset(int32 componentIndex) const;
+    /// return true if the std140 data is a plain copy of the C struct data
+    bool IsStd140Compatible() const;
+    /// convert C struct data to std140 data (dst must be Std140ByteSize() bytes)
+    void ConvertToStd140(const uint8* src, uint8* dst) const;
+
 private:
     int32 numComps;
     int32 byteSize;
+    int32 std140ByteSize;
+    int32 std140SrcOffset;
+    bool std140Compatible;
     StaticArray<Component, GfxConfig::MaxNumUniformLayoutComponents> comps;
     StaticArray<int32, GfxConfig::MaxNumUniformLayoutComponents> byteOffsets;
+    StaticArray<int32, GfxConfig::MaxNumUniformLayoutComponents> std140Offsets;
 };
 
 //------------------------------------------------------------------------------
@@ -139,4 +160,22 @@ UniformLayout::ComponentByteOffset(int32 componentIndex) const {
     return this->byteOffsets[componentIndex];
 }
 
+//------------------------------------------------------------------------------
+inline int32
+UniformLayout::Std140ByteSize() const {
+    return (this->std140ByteSize + 15) & ~15;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+UniformLayout::ComponentStd140ByteOffset(int32 componentIndex) const {
+    return this->std140Offsets[componentIndex];
+}
+
+//------------------------------------------------------------------------------
+inline bool
+UniformLayout::IsStd140Compatible() const {
+    return this->std140Compatible;
+}
+
 } // namespace Oryol
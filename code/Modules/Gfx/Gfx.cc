@@ -30,7 +30,7 @@ Gfx::Setup(const class GfxSetup& setup) {
     state->displayManager.SetupDisplay(setup, pointers);
     state->renderer.setup(setup, pointers);
     state->resourceContainer.setup(setup, pointers);
-    state->runLoopId = Core::PreRunLoop()->Add([] {
+    state->runLoopId = Core::PreRunLoop()->Add("Gfx", [] {
         state->displayManager.ProcessSystemEvents();
     });
 }
@@ -101,6 +101,7 @@ Gfx::RenderTargetAttrs() {
 //------------------------------------------------------------------------------
 void
 Gfx::ApplyDefaultRenderTarget(const ClearState& clearState) {
+    o_trace_scoped(Gfx_ApplyDefaultRenderTarget);
     o_assert_dbg(IsValid());
     state->renderer.applyRenderTarget(nullptr, clearState);
 }
@@ -108,6 +109,7 @@ Gfx::ApplyDefaultRenderTarget(const ClearState& clearState) {
 //------------------------------------------------------------------------------
 void
 Gfx::ApplyRenderTarget(const Id& id, const ClearState& clearState) {
+    o_trace_scoped(Gfx_ApplyRenderTarget);
     o_assert_dbg(IsValid());
     o_assert_dbg(id.IsValid());
 
@@ -155,6 +157,7 @@ Gfx::PopResourceLabel() {
 //------------------------------------------------------------------------------
 Id
 Gfx::LoadResource(const Ptr<ResourceLoader>& loader) {
+    o_trace_scoped(Gfx_LoadResource);
     o_assert_dbg(IsValid());
     return state->resourceContainer.Load(loader);
 }
@@ -190,6 +193,7 @@ Gfx::QueryResourcePoolInfo(GfxResourceType::Code resType) {
 //------------------------------------------------------------------------------
 void
 Gfx::DestroyResources(ResourceLabel label) {
+    o_trace_scoped(Gfx_DestroyResources);
     o_assert_dbg(IsValid());
     return state->resourceContainer.Destroy(label);
 }
@@ -204,6 +208,7 @@ Gfx::resource() {
 //------------------------------------------------------------------------------
 void
 Gfx::ApplyViewPort(int32 x, int32 y, int32 width, int32 height, bool originTopLeft) {
+    o_trace_scoped(Gfx_ApplyViewPort);
     o_assert_dbg(IsValid());
     state->renderer.applyViewPort(x, y, width, height, originTopLeft);
 }
@@ -211,6 +216,7 @@ Gfx::ApplyViewPort(int32 x, int32 y, int32 width, int32 height, bool originTopLe
 //------------------------------------------------------------------------------
 void
 Gfx::ApplyScissorRect(int32 x, int32 y, int32 width, int32 height, bool originTopLeft) {
+    o_trace_scoped(Gfx_ApplyScissorRect);
     o_assert_dbg(IsValid());
     state->renderer.applyScissorRect(x, y, width, height, originTopLeft);
 }
@@ -250,6 +256,50 @@ Gfx::UpdateIndices(const Id& id, const void* data, int32 numBytes) {
     state->renderer.updateIndices(msh, data, numBytes);
 }
 
+//------------------------------------------------------------------------------
+/**
+    Range updates write into the buffer the GPU reads from without
+    synchronization (D3D11 maps with NO_OVERWRITE, Metal writes the
+    buffer contents directly), the caller must not overwrite a range
+    that was drawn from in the last GfxConfig::MaxInflightFrames frames,
+    for instance by rotating through MaxInflightFrames ranges or meshes.
+    The same applies to Gfx::UpdateIndices().
+*/
+void
+Gfx::UpdateVertices(const Id& id, int32 byteOffset, const void* data, int32 numBytes) {
+    o_trace_scoped(Gfx_UpdateVertices);
+    o_assert_dbg(IsValid());
+    mesh* msh = state->resourceContainer.lookupMesh(id);
+    state->renderer.updateVertices(msh, byteOffset, data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::UpdateIndices(const Id& id, int32 byteOffset, const void* data, int32 numBytes) {
+    o_trace_scoped(Gfx_UpdateIndices);
+    o_assert_dbg(IsValid());
+    mesh* msh = state->resourceContainer.lookupMesh(id);
+    state->renderer.updateIndices(msh, byteOffset, data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+int32
+Gfx::AppendVertices(const Id& id, const void* data, int32 numBytes) {
+    o_trace_scoped(Gfx_AppendVertices);
+    o_assert_dbg(IsValid());
+    mesh* msh = state->resourceContainer.lookupMesh(id);
+    return state->renderer.appendVertices(msh, data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+int32
+Gfx::AppendIndices(const Id& id, const void* data, int32 numBytes) {
+    o_trace_scoped(Gfx_AppendIndices);
+    o_assert_dbg(IsValid());
+    mesh* msh = state->resourceContainer.lookupMesh(id);
+    return state->renderer.appendIndices(msh, data, numBytes);
+}
+
 //------------------------------------------------------------------------------
 void
 Gfx::ReadPixels(void* buf, int32 bufNumBytes) {
@@ -274,6 +324,14 @@ Gfx::Draw(const PrimitiveGroup& primGroup) {
     state->renderer.draw(primGroup);
 }
 
+//------------------------------------------------------------------------------
+void
+Gfx::Draw(const PrimitiveGroup& primGroup, int32 baseVertex) {
+    o_trace_scoped(Gfx_Draw);
+    o_assert_dbg(IsValid());
+    state->renderer.draw(primGroup, baseVertex);
+}
+
 //------------------------------------------------------------------------------
 void
 Gfx::DrawInstanced(int32 primGroupIndex, int32 numInstances) {
@@ -9,6 +9,7 @@
     @brief Gfx module facade
 */
 #include "Core/RunLoop.h"
+#include "Core/Trace.h"
 #include "Gfx/Core/displayMgr.h"
 #include "IO/Stream/Stream.h"
 #include "Gfx/Resource/gfxResourceContainer.h"
@@ -89,10 +90,18 @@ public:
     /// apply a uniform block
     template<class T> static void ApplyUniformBlock(const T& value);
 
-    /// update dynamic vertex data (only complete replace possible at the moment)
+    /// replace vertex data of a Usage::Stream mesh (once per frame)
     static void UpdateVertices(const Id& id, const void* data, int32 numBytes);
-    /// update dynamic index data (only complete replace possible at the moment)
+    /// replace index data of a Usage::Stream mesh (once per frame)
     static void UpdateIndices(const Id& id, const void* data, int32 numBytes);
+    /// update a range of vertex data in a Usage::Dynamic mesh (not synchronized with the GPU, see Gfx.cc)
+    static void UpdateVertices(const Id& id, int32 byteOffset, const void* data, int32 numBytes);
+    /// update a range of index data in a Usage::Dynamic mesh (not synchronized with the GPU, see Gfx.cc)
+    static void UpdateIndices(const Id& id, int32 byteOffset, const void* data, int32 numBytes);
+    /// append vertex data to a Usage::Stream mesh, returns base vertex, or InvalidIndex if full
+    static int32 AppendVertices(const Id& id, const void* data, int32 numBytes);
+    /// append index data to a Usage::Stream mesh, returns base element, or InvalidIndex if full
+    static int32 AppendIndices(const Id& id, const void* data, int32 numBytes);
     /// read current framebuffer pixels into client memory, this means a PIPELINE STALL!!
     static void ReadPixels(void* ptr, int32 numBytes);
     
@@ -100,6 +109,8 @@ public:
     static void Draw(int32 primGroupIndex);
     /// submit a draw call with direct primitive group
     static void Draw(const PrimitiveGroup& primGroup);
+    /// submit a draw call with direct primitive group and base vertex (e.g. from AppendVertices)
+    static void Draw(const PrimitiveGroup& primGroup, int32 baseVertex);
     /// submit a draw call for instanced rendering
     static void DrawInstanced(int32 primGroupIndex, int32 numInstances);
     /// submit a draw call for instanced rendering with direct primitive group
@@ -127,6 +138,7 @@ private:
 //------------------------------------------------------------------------------
 template<class T> inline void
 Gfx::ApplyUniformBlock(const T& value) {
+    o_trace_scoped(Gfx_ApplyUniformBlock);
     o_assert_dbg(IsValid());
     state->renderer.applyUniformBlock(T::_uniformBlockIndex, T::_layoutHash, (const uint8*) &value, sizeof(value));
 }
@@ -134,6 +146,7 @@ Gfx::ApplyUniformBlock(const T& value) {
 //------------------------------------------------------------------------------
 template<class SETUP> inline Id
 Gfx::CreateResource(const SETUP& setup) {
+    o_trace_scoped(Gfx_CreateResource);
     o_assert_dbg(IsValid());
     return state->resourceContainer.Create(setup);
 }
@@ -161,6 +174,7 @@ Gfx::CreateResource(const SetupAndStream<SETUP>& setupAndStream) {
 //------------------------------------------------------------------------------
 template<class SETUP> inline Id
 Gfx::CreateResource(const SETUP& setup, const void* data, int32 size) {
+    o_trace_scoped(Gfx_CreateResource);
     o_assert_dbg(IsValid());
     o_assert_dbg(nullptr != data);
     o_assert_dbg(size > 0);
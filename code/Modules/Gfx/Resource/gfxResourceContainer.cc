@@ -32,7 +32,7 @@ gfxResourceContainer::setup(const GfxSetup& setup, const gfxPointers& ptrs) {
     this->drawStateFactory.Setup(this->pointers);
     this->drawStatePool.Setup(GfxResourceType::DrawState, setup.PoolSize(GfxResourceType::DrawState));
     
-    this->runLoopId = Core::PostRunLoop()->Add([this]() {
+    this->runLoopId = Core::PostRunLoop()->Add("GfxResources", [this]() {
         this->update();
     });
     
@@ -16,10 +16,12 @@ NumVertices(0),
 NumIndices(0),
 IndicesType(IndexType::None),
 FullScreenQuadFlipV(false),
+BoundingRadius(0.0f),
 Locator(Locator::NonShared()),
 DataVertexOffset(0),
 DataIndexOffset(InvalidIndex),
 numPrimGroups(0),
+numLods(0),
 setupFromFile(false),
 setupFromData(false),
 setupEmpty(false),
@@ -131,4 +133,25 @@ MeshSetup::PrimitiveGroup(int32 index) const {
     return this->primGroups[index];
 }
 
+//------------------------------------------------------------------------------
+void
+MeshSetup::AddLod(float32 minScreenSize) {
+    o_assert(this->setupEmpty || this->setupFromData);
+    o_assert(this->numLods < GfxConfig::MaxNumPrimGroups);
+    this->lodMinScreenSizes[this->numLods++] = minScreenSize;
+}
+
+//------------------------------------------------------------------------------
+int32
+MeshSetup::NumLods() const {
+    return this->numLods;
+}
+
+//------------------------------------------------------------------------------
+float32
+MeshSetup::LodMinScreenSize(int32 lodIndex) const {
+    o_assert_range(lodIndex, this->numLods);
+    return this->lodMinScreenSizes[lodIndex];
+}
+
 } // namespace Oryol
\ No newline at end of file
@@ -65,6 +65,15 @@ public:
     int32 NumPrimitiveGroups() const;
     /// get primitive group at index
     const class PrimitiveGroup& PrimitiveGroup(int32 index) const;
+
+    /// add a LOD level, LOD n is rendered with primitive group n (finest first)
+    void AddLod(float32 minScreenSize);
+    /// get number of LOD levels (0 if mesh has no LODs)
+    int32 NumLods() const;
+    /// get min projected screen size (fraction of viewport height) of a LOD level
+    float32 LodMinScreenSize(int32 lodIndex) const;
+    /// bounding sphere radius around origin, used for LOD selection
+    float32 BoundingRadius;
     
     /// resource locator
     class Locator Locator;
@@ -79,6 +88,8 @@ public:
 private:
     int32 numPrimGroups;
     class PrimitiveGroup primGroups[GfxConfig::MaxNumPrimGroups];
+    int32 numLods;
+    float32 lodMinScreenSizes[GfxConfig::MaxNumPrimGroups];
     bool setupFromFile : 1;
     bool setupFromData : 1;
     bool setupEmpty : 1;
@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+//  UniformLayoutTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Core/UniformLayout.h"
+#include "Core/Memory/Memory.h"
+#include <cstring>
+
+using namespace Oryol;
+
+TEST(UniformLayoutTest) {
+    UniformLayout layout;
+    CHECK(layout.Empty());
+    layout.Add("tex", UniformType::Texture, 1, 0)
+        .Add("mvp", UniformType::Mat4, 1, InvalidIndex)
+        .Add("color", UniformType::Vec4, 1, InvalidIndex)
+        .Add("lightDir", UniformType::Vec3, 1, InvalidIndex)
+        .Add("scale", UniformType::Vec2, 1, InvalidIndex)
+        .Add("time", UniformType::Float, 1, InvalidIndex);
+    CHECK(6 == layout.NumComponents());
+    CHECK(layout.ByteSize() == int32(sizeof(Id)) + 64 + 16 + 16 + 8 + 4);
+    CHECK(layout.ByteSizeWithoutTextures() == 64 + 16 + 16 + 8 + 4);
+
+    // largest-first ordering makes the std140 layout a copy of the C layout
+    CHECK(layout.IsStd140Compatible());
+    CHECK(layout.ComponentStd140ByteOffset(0) == InvalidIndex);
+    CHECK(layout.ComponentStd140ByteOffset(1) == 0);
+    CHECK(layout.ComponentStd140ByteOffset(2) == 64);
+    CHECK(layout.ComponentStd140ByteOffset(3) == 80);
+    CHECK(layout.ComponentStd140ByteOffset(4) == 96);
+    CHECK(layout.ComponentStd140ByteOffset(5) == 104);
+    CHECK(layout.Std140ByteSize() == 112);
+
+    uint8 src[256];
+    uint8 dst[256];
+    for (int i = 0; i < int(sizeof(src)); i++) {
+        src[i] = uint8(i);
+    }
+    Memory::Clear(dst, sizeof(dst));
+    layout.ConvertToStd140(src, dst);
+    CHECK(0 == std::memcmp(src + sizeof(Id), dst, layout.ByteSizeWithoutTextures()));
+
+    layout.Clear();
+    CHECK(layout.Empty());
+    CHECK(0 == layout.Std140ByteSize());
+}
+
+TEST(UniformLayoutStd140ConvertTest) {
+    // mat3 columns and a misaligned vec4 need to be moved around
+    UniformLayout layout;
+    layout.Add("normalMatrix", UniformType::Mat3, 1, InvalidIndex)
+        .Add("time", UniformType::Float, 1, InvalidIndex)
+        .Add("color", UniformType::Vec4, 1, InvalidIndex);
+    CHECK(!layout.IsStd140Compatible());
+    CHECK(layout.ByteSize() == 36 + 4 + 16);
+    CHECK(layout.ComponentStd140ByteOffset(0) == 0);
+    CHECK(layout.ComponentStd140ByteOffset(1) == 48);
+    CHECK(layout.ComponentStd140ByteOffset(2) == 64);
+    CHECK(layout.Std140ByteSize() == 80);
+
+    float32 src[9 + 1 + 4];
+    for (int i = 0; i < 14; i++) {
+        src[i] = float32(i + 1);
+    }
+    float32 dst[20];
+    Memory::Clear(dst, sizeof(dst));
+    layout.ConvertToStd140((const uint8*)src, (uint8*)dst);
+    const float32 expected[20] = {
+        1, 2, 3, 0,
+        4, 5, 6, 0,
+        7, 8, 9, 0,
+        10, 0, 0, 0,
+        11, 12, 13, 14
+    };
+    for (int i = 0; i < 20; i++) {
+        CHECK(expected[i] == dst[i]);
+    }
+}
@@ -166,6 +166,16 @@ d3d11DisplayMgr::createDeviceAndSwapChain() {
     o_assert(this->d3d11Device);
     o_assert(this->d3d11DeviceContext);
     o_assert(this->dxgiSwapChain);
+
+    // limit the number of queued frames to GfxConfig::MaxInflightFrames,
+    // dynamic buffer contents written with D3D11_MAP_WRITE_NO_OVERWRITE
+    // rely on this (see Gfx::UpdateVertices())
+    IDXGIDevice1* dxgiDevice = nullptr;
+    hr = this->d3d11Device->QueryInterface(__uuidof(IDXGIDevice1), (void**) &dxgiDevice);
+    if (SUCCEEDED(hr)) {
+        dxgiDevice->SetMaximumFrameLatency(GfxConfig::MaxInflightFrames);
+        dxgiDevice->Release();
+    }
 }
 
 //------------------------------------------------------------------------------
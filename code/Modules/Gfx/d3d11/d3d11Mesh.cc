@@ -13,7 +13,9 @@ d3d11Mesh::d3d11Mesh() :
 d3d11VertexBuffer(nullptr),
 d3d11IndexBuffer(nullptr),
 vbUpdateFrameIndex(-1),
-ibUpdateFrameIndex(-1) {
+ibUpdateFrameIndex(-1),
+vbAppendOffset(InvalidIndex),
+ibAppendOffset(InvalidIndex) {
     // empty
 }
 
@@ -30,6 +32,8 @@ d3d11Mesh::Clear() {
     this->d3d11IndexBuffer = nullptr;
     this->vbUpdateFrameIndex = -1;
     this->ibUpdateFrameIndex = -1;
+    this->vbAppendOffset = InvalidIndex;
+    this->ibAppendOffset = InvalidIndex;
     meshBase::Clear();
 }
 
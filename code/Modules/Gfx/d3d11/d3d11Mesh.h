@@ -25,6 +25,8 @@ public:
     ID3D11Buffer* d3d11IndexBuffer;
     int32 vbUpdateFrameIndex;
     int32 ibUpdateFrameIndex;
+    int32 vbAppendOffset;   // byte offset for next append, InvalidIndex if not in append mode
+    int32 ibAppendOffset;
 };
 
 } // namespace _priv
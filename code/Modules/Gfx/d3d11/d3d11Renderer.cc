@@ -449,6 +449,12 @@ d3d11Renderer::applyUniformBlock(int32 blockIndex, int64 layoutHash, const uint8
 //------------------------------------------------------------------------------
 void
 d3d11Renderer::draw(const PrimitiveGroup& primGroup) {
+    this->draw(primGroup, 0);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::draw(const PrimitiveGroup& primGroup, int32 baseVertex) {
     o_assert_dbg(this->d3d11DeviceContext);
     o_assert2_dbg(this->rtValid, "No render target set!\n");
     if (nullptr == this->curDrawState) {
@@ -461,10 +467,10 @@ d3d11Renderer::draw(const PrimitiveGroup& primGroup) {
     }
     const IndexType::Code indexType = this->curDrawState->meshes[0]->indexBufferAttrs.Type;
     if (indexType != IndexType::None) {
-        this->d3d11DeviceContext->DrawIndexed(primGroup.NumElements, primGroup.BaseElement, 0);
+        this->d3d11DeviceContext->DrawIndexed(primGroup.NumElements, primGroup.BaseElement, baseVertex);
     }
     else {
-        this->d3d11DeviceContext->Draw(primGroup.NumElements, primGroup.BaseElement);        
+        this->d3d11DeviceContext->Draw(primGroup.NumElements, primGroup.BaseElement + baseVertex);
     }
 }
 
@@ -539,6 +545,7 @@ d3d11Renderer::updateVertices(mesh* msh, const void* data, int32 numBytes) {
 
     o_assert2(msh->vbUpdateFrameIndex != this->frameIndex, "Only one data update allowed per buffer and frame!\n");
     msh->vbUpdateFrameIndex = this->frameIndex;
+    msh->vbAppendOffset = InvalidIndex;
 
     D3D11_MAPPED_SUBRESOURCE mapped;
     HRESULT hr = this->d3d11DeviceContext->Map(msh->d3d11VertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
@@ -560,6 +567,7 @@ d3d11Renderer::updateIndices(mesh* msh, const void* data, int32 numBytes) {
 
     o_assert2(msh->ibUpdateFrameIndex != this->frameIndex, "Only one data update allowed per buffer and frame!\n");
     msh->ibUpdateFrameIndex = this->frameIndex;
+    msh->ibAppendOffset = InvalidIndex;
 
     D3D11_MAPPED_SUBRESOURCE mapped;
     HRESULT hr = this->d3d11DeviceContext->Map(msh->d3d11IndexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
@@ -568,6 +576,108 @@ d3d11Renderer::updateIndices(mesh* msh, const void* data, int32 numBytes) {
     this->d3d11DeviceContext->Unmap(msh->d3d11IndexBuffer, 0);
 }
 
+//------------------------------------------------------------------------------
+static void
+mapWrite(ID3D11DeviceContext* ctx, ID3D11Buffer* buf, D3D11_MAP mapType, int32 byteOffset, const void* data, int32 numBytes) {
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = ctx->Map(buf, 0, mapType, 0, &mapped);
+    o_assert_dbg(SUCCEEDED(hr));
+    std::memcpy(((uint8*)mapped.pData) + byteOffset, data, numBytes);
+    ctx->Unmap(buf, 0);
+}
+
+//------------------------------------------------------------------------------
+static int32
+obtainAppendRange(int32& updateFrameIndex, int32& appendOffset, int32 frameIndex, int32 capacity, int32 numBytes, D3D11_MAP& outMapType) {
+    // helper function to sub-allocate a range for an append-update,
+    // the first append in a frame maps with WRITE_DISCARD, so that
+    // the driver hands out a fresh buffer while the previous frame's
+    // data is still in flight, following appends in the same frame
+    // map with WRITE_NO_OVERWRITE into the next free range,
+    // returns the start offset, or InvalidIndex if the buffer is full
+    if (updateFrameIndex != frameIndex) {
+        updateFrameIndex = frameIndex;
+        appendOffset = 0;
+        outMapType = D3D11_MAP_WRITE_DISCARD;
+    }
+    else {
+        o_assert2(InvalidIndex != appendOffset, "Can't mix update and append on a buffer in the same frame!\n");
+        outMapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    }
+    if ((appendOffset + numBytes) > capacity) {
+        return InvalidIndex;
+    }
+    const int32 offset = appendOffset;
+    appendOffset += numBytes;
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::updateVertices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes) {
+    o_assert_dbg(this->d3d11DeviceContext);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(msh->d3d11VertexBuffer);
+    o_assert_dbg((byteOffset >= 0) && (numBytes > 0) && ((byteOffset + numBytes) <= msh->vertexBufferAttrs.ByteSize()));
+    o_assert2_dbg(Usage::Dynamic == msh->vertexBufferAttrs.BufferUsage, "Range updates only allowed on Usage::Dynamic meshes!\n");
+
+    // NOTE: dynamic buffers can't be partially updated with a DISCARD,
+    // the updated range must not be used by draws still in flight
+    mapWrite(this->d3d11DeviceContext, msh->d3d11VertexBuffer, D3D11_MAP_WRITE_NO_OVERWRITE, byteOffset, data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::updateIndices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes) {
+    o_assert_dbg(this->d3d11DeviceContext);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(msh->d3d11IndexBuffer);
+    o_assert_dbg((byteOffset >= 0) && (numBytes > 0) && ((byteOffset + numBytes) <= msh->indexBufferAttrs.ByteSize()));
+    o_assert2_dbg(Usage::Dynamic == msh->indexBufferAttrs.BufferUsage, "Range updates only allowed on Usage::Dynamic meshes!\n");
+
+    mapWrite(this->d3d11DeviceContext, msh->d3d11IndexBuffer, D3D11_MAP_WRITE_NO_OVERWRITE, byteOffset, data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+int32
+d3d11Renderer::appendVertices(mesh* msh, const void* data, int32 numBytes) {
+    o_assert_dbg(this->d3d11DeviceContext);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(msh->d3d11VertexBuffer);
+    o_assert_dbg(Usage::Stream == msh->vertexBufferAttrs.BufferUsage);
+    const int32 vertexSize = msh->vertexBufferAttrs.Layout.ByteSize();
+    o_assert_dbg((numBytes > 0) && ((numBytes % vertexSize) == 0));
+
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    const int32 offset = obtainAppendRange(msh->vbUpdateFrameIndex, msh->vbAppendOffset, this->frameIndex,
+        msh->vertexBufferAttrs.ByteSize(), numBytes, mapType);
+    if (InvalidIndex == offset) {
+        return InvalidIndex;
+    }
+    mapWrite(this->d3d11DeviceContext, msh->d3d11VertexBuffer, mapType, offset, data, numBytes);
+    return offset / vertexSize;
+}
+
+//------------------------------------------------------------------------------
+int32
+d3d11Renderer::appendIndices(mesh* msh, const void* data, int32 numBytes) {
+    o_assert_dbg(this->d3d11DeviceContext);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(msh->d3d11IndexBuffer);
+    o_assert_dbg(Usage::Stream == msh->indexBufferAttrs.BufferUsage);
+    const int32 indexSize = IndexType::ByteSize(msh->indexBufferAttrs.Type);
+    o_assert_dbg((numBytes > 0) && ((numBytes % indexSize) == 0));
+
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    const int32 offset = obtainAppendRange(msh->ibUpdateFrameIndex, msh->ibAppendOffset, this->frameIndex,
+        msh->indexBufferAttrs.ByteSize(), numBytes, mapType);
+    if (InvalidIndex == offset) {
+        return InvalidIndex;
+    }
+    mapWrite(this->d3d11DeviceContext, msh->d3d11IndexBuffer, mapType, offset, data, numBytes);
+    return offset / indexSize;
+}
+
 //------------------------------------------------------------------------------
 void 
 d3d11Renderer::readPixels(void* buf, int32 bufNumBytes) {
@@ -63,6 +63,8 @@ public:
     void draw(int32 primGroupIndex);
     /// submit a draw call with direct primitive group
     void draw(const PrimitiveGroup& primGroup);
+    /// submit a draw call with direct primitive group and base vertex index
+    void draw(const PrimitiveGroup& primGroup, int32 baseVertex);
     /// submit a draw call for instanced rendering with primitive group index in current mesh
     void drawInstanced(int32 primGroupIndex, int32 numInstances);
     /// submit a draw call for instanced rendering with direct primitive group
@@ -71,6 +73,14 @@ public:
     void updateVertices(mesh* msh, const void* data, int32 numBytes);
     /// update index data
     void updateIndices(mesh* msh, const void* data, int32 numBytes);
+    /// update a range of vertex data
+    void updateVertices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes);
+    /// update a range of index data
+    void updateIndices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes);
+    /// append vertex data, return base vertex index or InvalidIndex
+    int32 appendVertices(mesh* msh, const void* data, int32 numBytes);
+    /// append index data, return base element index or InvalidIndex
+    int32 appendIndices(mesh* msh, const void* data, int32 numBytes);
     /// read pixels back from framebuffer, causes a PIPELINE STALL!!!
     void readPixels(void* buf, int32 bufNumBytes);
 
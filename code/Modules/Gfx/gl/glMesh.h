@@ -23,10 +23,11 @@ public:
 
     static const int32 MaxNumSlots = 2;
     struct buffer {
-        buffer() : updateFrameIndex(-1), numSlots(1), activeSlot(0) {
+        buffer() : updateFrameIndex(-1), appendOffset(InvalidIndex), numSlots(1), activeSlot(0) {
             this->glBuffers.Fill(0);
         }
         int32 updateFrameIndex;
+        int32 appendOffset;     // byte offset for next append, InvalidIndex if not in append mode
         uint8 numSlots;
         uint8 activeSlot;
         StaticArray<GLuint, MaxNumSlots> glBuffers;
@@ -87,6 +87,8 @@ rtValid(false),
 frameIndex(0),
 curRenderTarget(nullptr),
 curDrawState(nullptr),
+curBaseVertex(0),
+meshStateDirty(false),
 scissorX(0),
 scissorY(0),
 scissorWidth(0),
@@ -98,7 +100,15 @@ viewPortWidth(0),
 viewPortHeight(0),
 vertexBuffer(0),
 indexBuffer(0),
-program(0) {
+program(0)
+#if ORYOL_GL_USE_UNIFORMBUFFER
+,uniformBuffer(0),
+uniformBufferSize(0),
+uniformBufferOffset(0),
+uniformBufferFrameIndex(-1),
+uniformBufferAlign(256)
+#endif
+{
     for (int32 i = 0; i < MaxTextureSamplers; i++) {
         this->samplers2D[i] = 0;
         this->samplersCube[i] = 0;
@@ -115,7 +125,7 @@ glRenderer::~glRenderer() {
 
 //------------------------------------------------------------------------------
 void
-glRenderer::setup(const GfxSetup& /*setup*/, const gfxPointers& ptrs) {
+glRenderer::setup(const GfxSetup& setup, const gfxPointers& ptrs) {
     o_assert_dbg(!this->valid);
     
     this->valid = true;
@@ -130,6 +140,20 @@ glRenderer::setup(const GfxSetup& /*setup*/, const gfxPointers& ptrs) {
     ::glGenVertexArrays(1, &this->globalVAO);
     ::glBindVertexArray(this->globalVAO);
     #endif
+
+    #if ORYOL_GL_USE_UNIFORMBUFFER
+    // create the global uniform buffer, the actual storage is (re-)allocated
+    // at the start of each frame, so that the driver can hand out fresh
+    // memory while the previous frame's uniform data is still in flight
+    ::glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &this->uniformBufferAlign);
+    ORYOL_GL_CHECK_ERROR();
+    this->uniformBufferSize = setup.GlobalUniformBufferSize;
+    ::glGenBuffers(1, &this->uniformBuffer);
+    ORYOL_GL_CHECK_ERROR();
+    this->invalidateUniformBufferState();
+    #else
+    (void)setup;
+    #endif
     
     this->setupDepthStencilState();
     this->setupBlendState();
@@ -153,6 +177,11 @@ glRenderer::discard() {
     this->globalVAO = 0;
     #endif
 
+    #if ORYOL_GL_USE_UNIFORMBUFFER
+    ::glDeleteBuffers(1, &this->uniformBuffer);
+    this->uniformBuffer = 0;
+    #endif
+
     this->pointers = gfxPointers();
     this->valid = false;
 }
@@ -174,6 +203,9 @@ glRenderer::resetStateCache() {
     this->invalidateMeshState();
     this->invalidateShaderState();
     this->invalidateTextureState();
+    #if ORYOL_GL_USE_UNIFORMBUFFER
+    this->invalidateUniformBufferState();
+    #endif
 }
 
 //------------------------------------------------------------------------------
@@ -358,7 +390,7 @@ glRenderer::applyShader(shader* shd, uint32 mask) {
 
 //------------------------------------------------------------------------------
 void
-glRenderer::applyMeshState(const drawState* ds) {
+glRenderer::applyMeshState(const drawState* ds, int32 baseVertex) {
     o_assert_dbg(this->valid);
     o_assert_dbg(nullptr != ds);
     o_assert_dbg(nullptr != ds->meshes[0]);
@@ -377,13 +409,18 @@ glRenderer::applyMeshState(const drawState* ds) {
         const auto& vb = msh->buffers[mesh::vb];
         const GLuint glVB = vb.glBuffers[vb.activeSlot];
 
+        // the base vertex only offsets per-vertex data in the first mesh slot
+        glVertexAttr baseAttr = attr;
+        if ((0 == attr.vbIndex) && attr.enabled) {
+            baseAttr.offset += baseVertex * attr.stride;
+        }
         bool vbChanged = (glVB != this->glAttrVBs[attrIndex]);
-        bool attrChanged = (attr != curAttr);
+        bool attrChanged = (baseAttr != curAttr);
         if (vbChanged || attrChanged) {
             if (attr.enabled) {
                 this->glAttrVBs[attrIndex] = glVB;
                 this->bindVertexBuffer(glVB);
-                ::glVertexAttribPointer(attr.index, attr.size, attr.type, attr.normalized, attr.stride, (const GLvoid*)(GLintptr)attr.offset);
+                ::glVertexAttribPointer(attr.index, attr.size, attr.type, attr.normalized, attr.stride, (const GLvoid*)(GLintptr)baseAttr.offset);
                 ORYOL_GL_CHECK_ERROR();
                 if (!curAttr.enabled) {
                     ::glEnableVertexAttribArray(attr.index);
@@ -400,7 +437,7 @@ glRenderer::applyMeshState(const drawState* ds) {
                 glExt::VertexAttribDivisor(attr.index, attr.divisor);
                 ORYOL_GL_CHECK_ERROR();
             }
-            curAttr = attr;
+            curAttr = baseAttr;
         }
     }
     #else
@@ -417,7 +454,11 @@ glRenderer::applyMeshState(const drawState* ds) {
             const mesh* msh = ds->meshes[attr.vbIndex];
             const GLuint glVB = msh->glVertexBuffers[msh->activeVertexBufferSlot];
             this->bindVertexBuffer(glVB);
-            ::glVertexAttribPointer(glAttribIndex, attr.size, attr.type, attr.normalized, attr.stride, (const GLvoid*)(GLintptr)attr.offset);
+            GLintptr offset = attr.offset;
+            if (0 == attr.vbIndex) {
+                offset += baseVertex * attr.stride;
+            }
+            ::glVertexAttribPointer(glAttribIndex, attr.size, attr.type, attr.normalized, attr.stride, (const GLvoid*)offset);
             ORYOL_GL_CHECK_ERROR();
             ::glEnableVertexAttribArray(glAttribIndex);
             ORYOL_GL_CHECK_ERROR();
@@ -435,9 +476,24 @@ glRenderer::applyMeshState(const drawState* ds) {
         ORYOL_GL_CHECK_ERROR();
     }
     #endif
+    this->curBaseVertex = baseVertex;
+    this->meshStateDirty = false;
     ORYOL_GL_CHECK_ERROR();
 }
 
+//------------------------------------------------------------------------------
+void
+glRenderer::validateMeshState(int32 baseVertex) {
+    o_assert_dbg(nullptr != this->curDrawState);
+
+    // buffer updates after the draw state was applied may have changed
+    // the GL buffer bindings or rotated a vertex or index buffer of the
+    // current draw state to its next slot, or the base vertex has changed
+    if (this->meshStateDirty || (baseVertex != this->curBaseVertex)) {
+        this->applyMeshState(this->curDrawState, baseVertex);
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 glRenderer::applyDrawState(drawState* ds) {
@@ -470,19 +526,26 @@ glRenderer::applyDrawState(drawState* ds) {
             this->applyRasterizerState(setup.RasterizerState);
         }
         this->applyShader(ds->shd, setup.ShaderSelectionMask);
-        this->applyMeshState(ds);
+        this->applyMeshState(ds, 0);
     }
 }
 
 //------------------------------------------------------------------------------
 void
 glRenderer::draw(const PrimitiveGroup& primGroup) {
+    this->draw(primGroup, 0);
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::draw(const PrimitiveGroup& primGroup, int32 baseVertex) {
     o_assert_dbg(this->valid);
     o_assert2_dbg(this->rtValid, "No render target set!");
     if (nullptr == this->curDrawState) {
         return;
     }
     o_assert_dbg(this->curDrawState->meshes[0]);
+    this->validateMeshState(baseVertex);
     ORYOL_GL_CHECK_ERROR();
     const IndexType::Code indexType = this->curDrawState->meshes[0]->indexBufferAttrs.Type;
     const GLenum glPrimType = glTypes::asGLPrimitiveType(primGroup.PrimType);
@@ -529,6 +592,7 @@ glRenderer::drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
     }
     ORYOL_GL_CHECK_ERROR();
     o_assert_dbg(this->curDrawState->meshes[0]);
+    this->validateMeshState(0);
     const IndexType::Code indexType = this->curDrawState->meshes[0]->indexBufferAttrs.Type;
     const GLenum glPrimType = glTypes::asGLPrimitiveType(primGroup.PrimType);
     if (IndexType::None != indexType) {
@@ -575,10 +639,12 @@ obtainUpdateBuffer(mesh::buffer& buf, int frameIndex) {
     // strictly required on GL, but we want the same restrictions across all 3D APIs
     o_assert2(buf.updateFrameIndex != frameIndex, "Only one data update allowed per buffer and frame!\n");
     buf.updateFrameIndex = frameIndex;
+    buf.appendOffset = InvalidIndex;
 
     // if usage is streaming, rotate slot index to next dynamic vertex buffer
     // to implement double/multi-buffering because the previous buffer
-    // might still be in-flight on the GPU
+    // might still be in-flight on the GPU (the next one might be too,
+    // glBufferSubData() is synchronized by the driver in that case)
     o_assert_dbg(buf.numSlots > 1);
     if (++buf.activeSlot >= buf.numSlots) {
         buf.activeSlot = 0;
@@ -586,6 +652,32 @@ obtainUpdateBuffer(mesh::buffer& buf, int frameIndex) {
     return buf.glBuffers[buf.activeSlot];
 }
 
+//------------------------------------------------------------------------------
+static int32
+obtainAppendRange(mesh::buffer& buf, int frameIndex, int32 capacity, int32 numBytes) {
+    // helper function to sub-allocate a range for an append-update,
+    // the first append in a frame rotates to the next buffer slot and
+    // starts at offset 0, following appends in the same frame go to the
+    // next free range in the same buffer slot, returns the start offset,
+    // or InvalidIndex if the buffer slot is full
+    //
+    // NOTE: there are no fences here (GLES2/WebGL don't have glFenceSync),
+    // the rotated-to slot may still be read by the GPU, glBufferSubData()
+    // is synchronized by the driver, which may stall or copy in that
+    // case, rotating slots only makes this less likely
+    if (buf.updateFrameIndex != frameIndex) {
+        obtainUpdateBuffer(buf, frameIndex);
+        buf.appendOffset = 0;
+    }
+    o_assert2(InvalidIndex != buf.appendOffset, "Can't mix update and append on a buffer in the same frame!\n");
+    if ((buf.appendOffset + numBytes) > capacity) {
+        return InvalidIndex;
+    }
+    const int32 offset = buf.appendOffset;
+    buf.appendOffset += numBytes;
+    return offset;
+}
+
 //------------------------------------------------------------------------------
 void
 glRenderer::updateVertices(mesh* msh, const void* data, int32 numBytes) {
@@ -598,6 +690,7 @@ glRenderer::updateVertices(mesh* msh, const void* data, int32 numBytes) {
     auto& vb = msh->buffers[mesh::vb];
     GLuint glBuffer = obtainUpdateBuffer(vb, this->frameIndex);
     o_assert_dbg(0 != glBuffer);
+    this->meshStateDirty = true;
     this->bindVertexBuffer(glBuffer);
     ::glBufferSubData(GL_ARRAY_BUFFER, 0, numBytes, data);
     ORYOL_GL_CHECK_ERROR();
@@ -617,11 +710,92 @@ glRenderer::updateIndices(mesh* msh, const void* data, int32 numBytes) {
     auto& ib = msh->buffers[mesh::ib];
     GLuint glBuffer = obtainUpdateBuffer(ib, this->frameIndex);
     o_assert_dbg(0 != glBuffer);
+    this->meshStateDirty = true;
     this->bindIndexBuffer(glBuffer);
     ::glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, numBytes, data);
     ORYOL_GL_CHECK_ERROR();
 }
 
+//------------------------------------------------------------------------------
+void
+glRenderer::updateVertices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg((byteOffset >= 0) && (numBytes > 0) && ((byteOffset + numBytes) <= msh->vertexBufferAttrs.ByteSize()));
+    o_assert2_dbg(Usage::Dynamic == msh->vertexBufferAttrs.BufferUsage, "Range updates only allowed on Usage::Dynamic meshes!\n");
+
+    const auto& vb = msh->buffers[mesh::vb];
+    o_assert_dbg(1 == vb.numSlots);
+    this->meshStateDirty = true;
+    this->bindVertexBuffer(vb.glBuffers[0]);
+    ::glBufferSubData(GL_ARRAY_BUFFER, byteOffset, numBytes, data);
+    ORYOL_GL_CHECK_ERROR();
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::updateIndices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg(IndexType::None != msh->indexBufferAttrs.Type);
+    o_assert_dbg((byteOffset >= 0) && (numBytes > 0) && ((byteOffset + numBytes) <= msh->indexBufferAttrs.ByteSize()));
+    o_assert2_dbg(Usage::Dynamic == msh->indexBufferAttrs.BufferUsage, "Range updates only allowed on Usage::Dynamic meshes!\n");
+
+    const auto& ib = msh->buffers[mesh::ib];
+    o_assert_dbg(1 == ib.numSlots);
+    this->meshStateDirty = true;
+    this->bindIndexBuffer(ib.glBuffers[0]);
+    ::glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, byteOffset, numBytes, data);
+    ORYOL_GL_CHECK_ERROR();
+}
+
+//------------------------------------------------------------------------------
+int32
+glRenderer::appendVertices(mesh* msh, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg(Usage::Stream == msh->vertexBufferAttrs.BufferUsage);
+    const int32 vertexSize = msh->vertexBufferAttrs.Layout.ByteSize();
+    o_assert_dbg((numBytes > 0) && ((numBytes % vertexSize) == 0));
+
+    auto& vb = msh->buffers[mesh::vb];
+    const int32 offset = obtainAppendRange(vb, this->frameIndex, msh->vertexBufferAttrs.ByteSize(), numBytes);
+    if (InvalidIndex == offset) {
+        return InvalidIndex;
+    }
+    this->meshStateDirty = true;
+    this->bindVertexBuffer(vb.glBuffers[vb.activeSlot]);
+    ::glBufferSubData(GL_ARRAY_BUFFER, offset, numBytes, data);
+    ORYOL_GL_CHECK_ERROR();
+    return offset / vertexSize;
+}
+
+//------------------------------------------------------------------------------
+int32
+glRenderer::appendIndices(mesh* msh, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg(IndexType::None != msh->indexBufferAttrs.Type);
+    o_assert_dbg(Usage::Stream == msh->indexBufferAttrs.BufferUsage);
+    const int32 indexSize = IndexType::ByteSize(msh->indexBufferAttrs.Type);
+    o_assert_dbg((numBytes > 0) && ((numBytes % indexSize) == 0));
+
+    auto& ib = msh->buffers[mesh::ib];
+    const int32 offset = obtainAppendRange(ib, this->frameIndex, msh->indexBufferAttrs.ByteSize(), numBytes);
+    if (InvalidIndex == offset) {
+        return InvalidIndex;
+    }
+    this->meshStateDirty = true;
+    this->bindIndexBuffer(ib.glBuffers[ib.activeSlot]);
+    ::glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, numBytes, data);
+    ORYOL_GL_CHECK_ERROR();
+    return offset / indexSize;
+}
+
 //------------------------------------------------------------------------------
 void
 glRenderer::readPixels(void* buf, int32 bufNumBytes) {
@@ -666,6 +840,7 @@ glRenderer::invalidateMeshState() {
         this->glAttrs[i] = glVertexAttr();
         this->glAttrVBs[i] = 0;
     }
+    this->meshStateDirty = true;
 }
 
 //------------------------------------------------------------------------------
@@ -1011,10 +1186,23 @@ glRenderer::applyUniformBlock(int32 blockIndex, int64 layoutHash, const uint8* p
     o_assert2(layout.TypeHash == layoutHash, "incompatible uniform block!\n");
     o_assert_dbg(layout.ByteSize() == byteSize);
 
+    #if ORYOL_GL_USE_UNIFORMBUFFER
+    // non-texture uniforms go into the global uniform buffer,
+    // only texture uniforms are handled below
+    if (layout.Std140ByteSize() > 0) {
+        this->applyUniformBuffer(blockIndex, layout, ptr, byteSize);
+    }
+    #endif
+
     // for each uniform in the uniform block:
     const int numComps = layout.NumComponents();
     for (int compIndex = 0; compIndex < numComps; compIndex++) {
         const auto& comp = layout.ComponentAt(compIndex);
+        #if ORYOL_GL_USE_UNIFORMBUFFER
+        if (UniformType::Texture != comp.Type) {
+            continue;
+        }
+        #endif
         const uint8* valuePtr = ptr + layout.ComponentByteOffset(compIndex);
         GLint glLoc = shd->getUniformLocation(blockIndex, compIndex);
         switch (comp.Type) {
@@ -1094,5 +1282,56 @@ glRenderer::applyUniformBlock(int32 blockIndex, int64 layoutHash, const uint8* p
     }
 }
 
+#if ORYOL_GL_USE_UNIFORMBUFFER
+//------------------------------------------------------------------------------
+void
+glRenderer::applyUniformBuffer(int32 blockIndex, const UniformLayout& layout, const uint8* ptr, int32 byteSize) {
+    o_assert_range_dbg(blockIndex, GfxConfig::MaxNumUniformBlocks);
+    o_assert_dbg(byteSize <= MaxUniformBlockByteSize);
+
+    // skip the update if the same data has already been written to
+    // the uniform buffer and bound to this binding point in this frame
+    uniformBlockCache& cache = this->uniformBlockCaches[blockIndex];
+    if ((cache.frameIndex == this->frameIndex) &&
+        (cache.layoutHash == layout.TypeHash) &&
+        (0 == std::memcmp(cache.data, ptr, byteSize))) {
+        return;
+    }
+
+    // first uniform update in this frame? then orphan the buffer storage
+    ::glBindBuffer(GL_UNIFORM_BUFFER, this->uniformBuffer);
+    if (this->uniformBufferFrameIndex != this->frameIndex) {
+        this->uniformBufferFrameIndex = this->frameIndex;
+        this->uniformBufferOffset = 0;
+        ::glBufferData(GL_UNIFORM_BUFFER, this->uniformBufferSize, nullptr, GL_STREAM_DRAW);
+        ORYOL_GL_CHECK_ERROR();
+    }
+
+    // convert to std140 layout, write to the next free range, and bind the range
+    const int32 std140Size = layout.Std140ByteSize();
+    o_assert_dbg(std140Size <= MaxUniformBlockByteSize);
+    o_assert2((this->uniformBufferOffset + std140Size) <= this->uniformBufferSize, "Global uniform buffer exhausted!\n");
+    layout.ConvertToStd140(ptr, this->std140Data);
+    ::glBufferSubData(GL_UNIFORM_BUFFER, this->uniformBufferOffset, std140Size, this->std140Data);
+    ORYOL_GL_CHECK_ERROR();
+    ::glBindBufferRange(GL_UNIFORM_BUFFER, blockIndex, this->uniformBuffer, this->uniformBufferOffset, std140Size);
+    ORYOL_GL_CHECK_ERROR();
+    this->uniformBufferOffset = Memory::RoundUp(this->uniformBufferOffset + std140Size, this->uniformBufferAlign);
+
+    cache.frameIndex = this->frameIndex;
+    cache.layoutHash = layout.TypeHash;
+    Memory::Copy(ptr, cache.data, byteSize);
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::invalidateUniformBufferState() {
+    for (int32 i = 0; i < GfxConfig::MaxNumUniformBlocks; i++) {
+        this->uniformBlockCaches[i].frameIndex = -1;
+        this->uniformBlockCaches[i].layoutHash = 0;
+    }
+}
+#endif
+
 } // namespace _priv
 } // namespace Oryol
@@ -16,8 +16,15 @@
 #include "Gfx/Setup/GfxSetup.h"
 #include "Gfx/gl/gl_decl.h"
 #include "Gfx/gl/glVertexAttr.h"
+#include "Gfx/Core/GfxConfig.h"
+#include "Gfx/Core/UniformLayout.h"
 #include "glm/vec4.hpp"
 
+// the layout of glRenderer depends on this, all modules must agree on it
+#if !defined(ORYOL_GL_USE_UNIFORMBUFFER)
+#error "ORYOL_GL_USE_UNIFORMBUFFER must be defined globally (see fips-include.cmake)"
+#endif
+
 namespace Oryol {
 namespace _priv {
 
@@ -63,6 +70,8 @@ public:
     void draw(int32 primGroupIndex);
     /// submit a draw call with direct primitive group
     void draw(const PrimitiveGroup& primGroup);
+    /// submit a draw call with direct primitive group and base vertex index
+    void draw(const PrimitiveGroup& primGroup, int32 baseVertex);
     /// submit a draw call for instanced rendering with primitive group index in current mesh
     void drawInstanced(int32 primGroupIndex, int32 numInstances);
     /// submit a draw call for instanced rendering with direct primitive group
@@ -71,6 +80,14 @@ public:
     void updateVertices(mesh* msh, const void* data, int32 numBytes);
     /// update index data
     void updateIndices(mesh* msh, const void* data, int32 numBytes);
+    /// update a range of vertex data
+    void updateVertices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes);
+    /// update a range of index data
+    void updateIndices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes);
+    /// append vertex data, return base vertex index or InvalidIndex
+    int32 appendVertices(mesh* msh, const void* data, int32 numBytes);
+    /// append index data, return base element index or InvalidIndex
+    int32 appendIndices(mesh* msh, const void* data, int32 numBytes);
     /// read pixels back from framebuffer, causes a PIPELINE STALL!!!
     void readPixels(void* buf, int32 bufNumBytes);
     
@@ -109,7 +126,15 @@ private:
     /// apply shader to use for rendering
     void applyShader(shader* shd, uint32 selMask);
     /// apply mesh state
-    void applyMeshState(const drawState* ds);
+    void applyMeshState(const drawState* ds, int32 baseVertex);
+    /// re-apply mesh state if buffers have been rotated or base vertex changed
+    void validateMeshState(int32 baseVertex);
+    #if ORYOL_GL_USE_UNIFORMBUFFER
+    /// write uniform block into global uniform buffer and bind it
+    void applyUniformBuffer(int32 blockIndex, const UniformLayout& layout, const uint8* ptr, int32 byteSize);
+    /// invalidate the uniform buffer state cache
+    void invalidateUniformBufferState();
+    #endif
 
     bool valid;
     gfxPointers pointers;
@@ -130,6 +155,8 @@ private:
     // high-level state cache
     texture* curRenderTarget;
     drawState* curDrawState;
+    int32 curBaseVertex;
+    bool meshStateDirty;
 
     // GL state cache
     BlendState blendState;
@@ -157,6 +184,24 @@ private:
     GLuint samplersCube[MaxTextureSamplers];
     glVertexAttr glAttrs[VertexAttr::NumVertexAttrs];
     GLuint glAttrVBs[VertexAttr::NumVertexAttrs];
+
+    #if ORYOL_GL_USE_UNIFORMBUFFER
+    // global uniform buffer, orphaned at the start of each frame, uniform
+    // blocks are appended and bound to their binding point with glBindBufferRange
+    static const int32 MaxUniformBlockByteSize = GfxConfig::MaxNumUniformLayoutComponents * 64;
+    GLuint uniformBuffer;
+    int32 uniformBufferSize;
+    int32 uniformBufferOffset;
+    int32 uniformBufferFrameIndex;
+    int32 uniformBufferAlign;
+    struct uniformBlockCache {
+        int64 layoutHash = 0;
+        int32 frameIndex = -1;
+        uint8 data[MaxUniformBlockByteSize];
+    };
+    uniformBlockCache uniformBlockCaches[GfxConfig::MaxNumUniformBlocks];
+    uint8 std140Data[MaxUniformBlockByteSize];
+    #endif
 };
 
 //------------------------------------------------------------------------------
@@ -133,6 +133,15 @@ glShaderFactory::SetupResource(shader& shd) {
             int32 samplerIndex = 0;
             int32 slotIndex = 0;
             const UniformLayout& layout = setup.UniformBlockLayout(uniformBlockIndex);
+            #if ORYOL_GL_USE_UNIFORMBUFFER
+            // non-texture uniforms live in an std140 uniform block, which is
+            // bound to the binding point with the same index as the uniform block
+            const GLuint glBlockIndex = ::glGetUniformBlockIndex(glProg, setup.UniformBlockName(uniformBlockIndex).AsCStr());
+            if (GL_INVALID_INDEX != glBlockIndex) {
+                ::glUniformBlockBinding(glProg, glBlockIndex, uniformBlockIndex);
+                ORYOL_GL_CHECK_ERROR();
+            }
+            #endif
             const int32 numUniforms = layout.NumComponents();
             for (int uniformIndex = 0; uniformIndex < numUniforms; uniformIndex++) {
                 const UniformLayout::Component& comp = layout.ComponentAt(uniformIndex);
@@ -21,10 +21,11 @@ public:
     /// clear the object (called from meshFactory::DestroyResource())
     void Clear();
 
-    static const int32 NumSlots = GfxConfig::MtlMaxInflightFrames;
+    static const int32 NumSlots = GfxConfig::MaxInflightFrames;
     struct buffer {
         buffer();
         int32 updateFrameIndex;
+        int32 appendOffset;     // byte offset for next append, InvalidIndex if not in append mode
         uint8 numSlots;
         uint8 activeSlot;
         StaticArray<ORYOL_OBJC_TYPED_ID(MTLBuffer), NumSlots> mtlBuffers;
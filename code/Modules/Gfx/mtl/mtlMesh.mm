@@ -11,6 +11,7 @@ namespace _priv {
 //------------------------------------------------------------------------------
 mtlMesh::buffer::buffer() :
 updateFrameIndex(-1),
+appendOffset(InvalidIndex),
 numSlots(1),
 activeSlot(0) {
 
@@ -140,16 +140,18 @@ mtlMeshFactory::createEmptyMesh(mesh& msh) {
     const auto& vbAttrs = msh.vertexBufferAttrs;
     const auto& ibAttrs = msh.indexBufferAttrs;
 
-    // create vertex buffer(s)
+    // create vertex buffer(s), streaming buffers get one slot per
+    // frame in flight, so that a slot is only written after the
+    // inflight-semaphore has signalled that the GPU is done with it
     const int32 vbSize = msh.Setup.NumVertices * msh.Setup.Layout.ByteSize();
-    msh.buffers[mesh::vb].numSlots = Usage::Stream == vbAttrs.BufferUsage ? 2 : 1;
+    msh.buffers[mesh::vb].numSlots = Usage::Stream == vbAttrs.BufferUsage ? mtlMesh::NumSlots : 1;
     for (uint8 slotIndex = 0; slotIndex < msh.buffers[mesh::vb].numSlots; slotIndex++) {
         msh.buffers[mesh::vb].mtlBuffers[slotIndex] = this->createBuffer(nullptr, vbSize, vbAttrs.BufferUsage);
     }
 
     // create optional index buffer(s)
     if (IndexType::None != ibAttrs.Type) {
-        msh.buffers[mesh::ib].numSlots = Usage::Stream == ibAttrs.BufferUsage ? 2 : 1;
+        msh.buffers[mesh::ib].numSlots = Usage::Stream == ibAttrs.BufferUsage ? mtlMesh::NumSlots : 1;
         const int32 ibSize = ibAttrs.NumIndices * IndexType::ByteSize(ibAttrs.Type);
         for (uint8 slotIndex = 0; slotIndex < msh.buffers[mesh::ib].numSlots; slotIndex++) {
             msh.buffers[mesh::ib].mtlBuffers[slotIndex] = this->createBuffer(nullptr, ibSize, ibAttrs.BufferUsage);
@@ -64,6 +64,8 @@ public:
     void draw(int32 primGroupIndex);
     /// submit a draw call with direct primitive group
     void draw(const PrimitiveGroup& primGroup);
+    /// submit a draw call with direct primitive group and base vertex index
+    void draw(const PrimitiveGroup& primGroup, int32 baseVertex);
     /// submit a draw call for instanced rendering with primitive group index in current mesh
     void drawInstanced(int32 primGroupIndex, int32 numInstances);
     /// submit a draw call for instanced rendering with direct primitive group
@@ -72,9 +74,22 @@ public:
     void updateVertices(mesh* msh, const void* data, int32 numBytes);
     /// update index data
     void updateIndices(mesh* msh, const void* data, int32 numBytes);
+    /// update a range of vertex data
+    void updateVertices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes);
+    /// update a range of index data
+    void updateIndices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes);
+    /// append vertex data, return base vertex index or InvalidIndex
+    int32 appendVertices(mesh* msh, const void* data, int32 numBytes);
+    /// append index data, return base element index or InvalidIndex
+    int32 appendIndices(mesh* msh, const void* data, int32 numBytes);
     /// read pixels back from framebuffer, causes a PIPELINE STALL!!!
     void readPixels(void* buf, int32 bufNumBytes);
 
+    /// set vertex buffer of first mesh slot with base vertex offset (if changed)
+    void applyBaseVertex(int32 baseVertex);
+    /// common draw function with instance count and base vertex
+    void drawPrimitives(const PrimitiveGroup& primGroup, int32 numInstances, int32 baseVertex);
+
     bool valid;
     GfxSetup gfxSetup;
     gfxPointers pointers;
@@ -86,6 +101,8 @@ public:
     DisplayAttrs rtAttrs;
     
     drawState* curDrawState;
+    int32 curBaseVertex;
+    bool vertexBufferDirty;
     ORYOL_OBJC_TYPED_ID(MTLDevice) mtlDevice;
     ORYOL_OBJC_TYPED_ID(MTLCommandQueue) commandQueue;
     ORYOL_OBJC_TYPED_ID(MTLCommandBuffer) curCommandBuffer;
@@ -93,7 +110,7 @@ public:
 
     // rotated global uniform buffers
     int32 curUniformBufferOffset;
-    StaticArray<ORYOL_OBJC_TYPED_ID(MTLBuffer), GfxConfig::MtlMaxInflightFrames> uniformBuffers;
+    StaticArray<ORYOL_OBJC_TYPED_ID(MTLBuffer), GfxConfig::MaxInflightFrames> uniformBuffers;
 };
 
 } // namespace _priv
@@ -24,6 +24,8 @@ frameIndex(0),
 curFrameRotateIndex(0),
 rtValid(false),
 curDrawState(nullptr),
+curBaseVertex(0),
+vertexBufferDirty(false),
 mtlDevice(nil),
 commandQueue(nil),
 curCommandBuffer(nil),
@@ -47,14 +49,14 @@ mtlRenderer::setup(const GfxSetup& setup, const gfxPointers& ptrs) {
     this->gfxSetup = setup;
 
     // frame-sync semaphore
-    mtlInflightSemaphore = dispatch_semaphore_create(GfxConfig::MtlMaxInflightFrames);
+    mtlInflightSemaphore = dispatch_semaphore_create(GfxConfig::MaxInflightFrames);
 
     // setup central metal objects
     this->mtlDevice = osxBridge::ptr()->mtlDevice;
     this->commandQueue = [this->mtlDevice newCommandQueue];
 
     // create global rotated uniform buffers
-    for (int i = 0; i < GfxConfig::MtlMaxInflightFrames; i++) {
+    for (int i = 0; i < GfxConfig::MaxInflightFrames; i++) {
         // FIXME: is options:0 right? this is used by the Xcode game sample
         this->uniformBuffers[i] = [this->mtlDevice newBufferWithLength:setup.GlobalUniformBufferSize options:mtlTypes::asBufferResourceOptions(Usage::Stream)];
     }
@@ -67,7 +69,7 @@ void
 mtlRenderer::discard() {
     o_assert_dbg(this->valid);
 
-    for (int i = 0; i < GfxConfig::MtlMaxInflightFrames; i++) {
+    for (int i = 0; i < GfxConfig::MaxInflightFrames; i++) {
         this->uniformBuffers[i] = nil;
     }
     this->commandQueue = nil;
@@ -130,7 +132,7 @@ mtlRenderer::commitFrame() {
     [this->curCommandBuffer commit];
 
     // rotate to next uniform buffer
-    if (++this->curFrameRotateIndex >= GfxConfig::MtlMaxInflightFrames) {
+    if (++this->curFrameRotateIndex >= GfxConfig::MaxInflightFrames) {
         this->curFrameRotateIndex = 0;
     }
     this->frameIndex++;
@@ -343,6 +345,8 @@ mtlRenderer::applyDrawState(drawState* ds) {
             [this->curCommandEncoder setVertexBuffer:nil offset:0 atIndex:vbSlotIndex];
         }
     }
+    this->curBaseVertex = 0;
+    this->vertexBufferDirty = false;
 }
 
 //------------------------------------------------------------------------------
@@ -426,6 +430,32 @@ mtlRenderer::applyUniformBlock(int32 blockIndex, int64 layoutHash, const uint8*
 //------------------------------------------------------------------------------
 void
 mtlRenderer::drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
+    this->drawPrimitives(primGroup, numInstances, 0);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::applyBaseVertex(int32 baseVertex) {
+    o_assert_dbg(this->curDrawState && this->curDrawState->meshes[0]);
+
+    // the vertex buffer of the first mesh slot might have been rotated
+    // by a buffer update after the draw state was applied, or the
+    // base vertex has changed since the last draw, the base vertex is
+    // implemented as vertex buffer offset since baseVertex in draw
+    // calls isn't supported on all GPU families
+    if (this->vertexBufferDirty || (baseVertex != this->curBaseVertex)) {
+        const mesh* msh = this->curDrawState->meshes[0];
+        const auto& vb = msh->buffers[mesh::vb];
+        const NSUInteger offset = baseVertex * msh->vertexBufferAttrs.Layout.ByteSize();
+        [this->curCommandEncoder setVertexBuffer:vb.mtlBuffers[vb.activeSlot] offset:offset atIndex:GfxConfig::MaxNumUniformBlocks];
+        this->curBaseVertex = baseVertex;
+        this->vertexBufferDirty = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::drawPrimitives(const PrimitiveGroup& primGroup, int32 numInstances, int32 baseVertex) {
     o_assert_dbg(this->valid);
     if (nil == this->curCommandEncoder) {
         return;
@@ -434,6 +464,7 @@ mtlRenderer::drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances)
         return;
     }
     o_assert_dbg(this->curDrawState->meshes[0]);
+    this->applyBaseVertex(baseVertex);
     MTLPrimitiveType mtlPrimType = mtlTypes::asPrimitiveType(primGroup.PrimType);
     IndexType::Code indexType = this->curDrawState->meshes[0]->indexBufferAttrs.Type;
     if (IndexType::None != indexType) {
@@ -478,7 +509,13 @@ mtlRenderer::drawInstanced(int32 primGroupIndex, int32 numInstances) {
 //------------------------------------------------------------------------------
 void
 mtlRenderer::draw(const PrimitiveGroup& primGroup) {
-    this->drawInstanced(primGroup, 1);
+    this->drawPrimitives(primGroup, 1, 0);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::draw(const PrimitiveGroup& primGroup, int32 baseVertex) {
+    this->drawPrimitives(primGroup, 1, baseVertex);
 }
 
 //------------------------------------------------------------------------------
@@ -497,6 +534,7 @@ obtainUpdateBuffer(mesh::buffer& buf, int frameIndex) {
     // strictly required on GL, but we want the same restrictions across all 3D APIs
     o_assert2(buf.updateFrameIndex != frameIndex, "Only one data update allowed per buffer and frame!\n");
     buf.updateFrameIndex = frameIndex;
+    buf.appendOffset = InvalidIndex;
 
     // if usage is streaming, rotate slot index to next dynamic vertex buffer
     // to implement double/multi-buffering because the previous buffer
@@ -508,6 +546,38 @@ obtainUpdateBuffer(mesh::buffer& buf, int frameIndex) {
     return buf.mtlBuffers[buf.activeSlot];
 }
 
+//------------------------------------------------------------------------------
+static int32
+obtainAppendRange(mesh::buffer& buf, int frameIndex, int32 capacity, int32 numBytes) {
+    // helper function to sub-allocate a range for an append-update,
+    // the first append in a frame rotates to the next buffer slot (which
+    // is guaranteed to be no longer in flight since there is one slot
+    // per inflight frame) and starts at offset 0, following appends in
+    // the same frame go to the next free range in the same buffer slot,
+    // returns the start offset, or InvalidIndex if the buffer slot is full
+    if (buf.updateFrameIndex != frameIndex) {
+        obtainUpdateBuffer(buf, frameIndex);
+        buf.appendOffset = 0;
+    }
+    o_assert2(InvalidIndex != buf.appendOffset, "Can't mix update and append on a buffer in the same frame!\n");
+    if ((buf.appendOffset + numBytes) > capacity) {
+        return InvalidIndex;
+    }
+    const int32 offset = buf.appendOffset;
+    buf.appendOffset += numBytes;
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+static void
+writeBuffer(id<MTLBuffer> mtlBuffer, int32 byteOffset, const void* data, int32 numBytes) {
+    o_assert_dbg(nil != mtlBuffer);
+    o_assert_dbg((byteOffset + numBytes) <= int([mtlBuffer length]));
+    uint8* dstPtr = ((uint8*)[mtlBuffer contents]) + byteOffset;
+    std::memcpy(dstPtr, data, numBytes);
+    [mtlBuffer didModifyRange:NSMakeRange(byteOffset, numBytes)];
+}
+
 //------------------------------------------------------------------------------
 void
 mtlRenderer::updateVertices(mesh* msh, const void* data, int32 numBytes) {
@@ -519,6 +589,7 @@ mtlRenderer::updateVertices(mesh* msh, const void* data, int32 numBytes) {
 
     auto& vb = msh->buffers[mesh::vb];
     id<MTLBuffer> mtlBuffer = obtainUpdateBuffer(vb, this->frameIndex);
+    this->vertexBufferDirty = true;
     o_assert_dbg(nil != mtlBuffer);
     o_assert_dbg(numBytes <= int([mtlBuffer length]));
     void* dstPtr = [mtlBuffer contents];
@@ -544,6 +615,79 @@ mtlRenderer::updateIndices(mesh* msh, const void* data, int32 numBytes) {
     [mtlBuffer didModifyRange:NSMakeRange(0, numBytes)];
 }
 
+//------------------------------------------------------------------------------
+void
+mtlRenderer::updateVertices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg((byteOffset >= 0) && (numBytes > 0) && ((byteOffset + numBytes) <= msh->vertexBufferAttrs.ByteSize()));
+    o_assert2_dbg(Usage::Dynamic == msh->vertexBufferAttrs.BufferUsage, "Range updates only allowed on Usage::Dynamic meshes!\n");
+
+    // NOTE: dynamic meshes only have a single buffer, the updated
+    // range must not be used by draws still in flight
+    const auto& vb = msh->buffers[mesh::vb];
+    o_assert_dbg(1 == vb.numSlots);
+    writeBuffer(vb.mtlBuffers[0], byteOffset, data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::updateIndices(mesh* msh, int32 byteOffset, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg((byteOffset >= 0) && (numBytes > 0) && ((byteOffset + numBytes) <= msh->indexBufferAttrs.ByteSize()));
+    o_assert2_dbg(Usage::Dynamic == msh->indexBufferAttrs.BufferUsage, "Range updates only allowed on Usage::Dynamic meshes!\n");
+
+    const auto& ib = msh->buffers[mesh::ib];
+    o_assert_dbg(1 == ib.numSlots);
+    writeBuffer(ib.mtlBuffers[0], byteOffset, data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+int32
+mtlRenderer::appendVertices(mesh* msh, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg(Usage::Stream == msh->vertexBufferAttrs.BufferUsage);
+    const int32 vertexSize = msh->vertexBufferAttrs.Layout.ByteSize();
+    o_assert_dbg((numBytes > 0) && ((numBytes % vertexSize) == 0));
+
+    auto& vb = msh->buffers[mesh::vb];
+    const int32 offset = obtainAppendRange(vb, this->frameIndex, msh->vertexBufferAttrs.ByteSize(), numBytes);
+    if (InvalidIndex == offset) {
+        return InvalidIndex;
+    }
+    if (0 == offset) {
+        this->vertexBufferDirty = true;
+    }
+    writeBuffer(vb.mtlBuffers[vb.activeSlot], offset, data, numBytes);
+    return offset / vertexSize;
+}
+
+//------------------------------------------------------------------------------
+int32
+mtlRenderer::appendIndices(mesh* msh, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert_dbg(nullptr != data);
+    o_assert_dbg(IndexType::None != msh->indexBufferAttrs.Type);
+    o_assert_dbg(Usage::Stream == msh->indexBufferAttrs.BufferUsage);
+    const int32 indexSize = IndexType::ByteSize(msh->indexBufferAttrs.Type);
+    o_assert_dbg((numBytes > 0) && ((numBytes % indexSize) == 0));
+
+    // NOTE: the index buffer slot is resolved at draw time
+    auto& ib = msh->buffers[mesh::ib];
+    const int32 offset = obtainAppendRange(ib, this->frameIndex, msh->indexBufferAttrs.ByteSize(), numBytes);
+    if (InvalidIndex == offset) {
+        return InvalidIndex;
+    }
+    writeBuffer(ib.mtlBuffers[ib.activeSlot], offset, data, numBytes);
+    return offset / indexSize;
+}
+
 //------------------------------------------------------------------------------
 void
 mtlRenderer::readPixels(void* buf, int32 bufNumBytes) {
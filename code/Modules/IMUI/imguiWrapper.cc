@@ -4,6 +4,8 @@
 #include "Pre.h"
 #include "imguiWrapper.h"
 #include "Core/Assertion.h"
+#include "Core/Core.h"
+#include "Core/Hash/fasthash.h"
 #include "Input/Input.h"
 #include "IMUIShaders.h"
 #include "glm/mat4x4.hpp"
@@ -52,6 +54,12 @@ imguiWrapper::Setup() {
     this->setupDrawState();
     Gfx::PopResourceLabel();
 
+    // the first render of a frame goes into the next retained mesh
+    this->runLoopId = Core::PostRunLoop()->Add("IMUI", [this]() {
+        this->curRetainedMesh = (this->curRetainedMesh + 1) % NumRetainedMeshes;
+        this->numRendersInFrame = 0;
+    });
+
     this->isValid = true;
 }
 
@@ -61,6 +69,12 @@ imguiWrapper::Discard() {
     o_assert_dbg(this->IsValid());
     ImGui::GetIO().Fonts->TexID = 0;
     ImGui::Shutdown();
+    Core::PostRunLoop()->Remove(this->runLoopId);
+    this->runLoopId = RunLoop::InvalidId;
+    for (auto& rm : this->retainedMeshes) {
+        rm.drawLists.Clear();
+    }
+    this->layout.Clear();
     Gfx::DestroyResources(this->resLabel);
     this->isValid = false;
     self = nullptr;
@@ -112,6 +126,14 @@ imguiWrapper::setupMesh() {
     this->mesh = Gfx::CreateResource(setup);
     o_assert(this->mesh.IsValid());
     o_assert(Gfx::QueryResourceInfo(this->mesh).State == ResourceState::Valid);
+
+    // the retained meshes are only updated where draw lists have changed
+    MeshSetup retainedSetup = MeshSetup::Empty(MaxNumVertices, Usage::Dynamic, IndexType::Index16, MaxNumIndices, Usage::Dynamic);
+    retainedSetup.Layout = setup.Layout;
+    for (auto& rm : this->retainedMeshes) {
+        rm.mesh = Gfx::CreateResource(retainedSetup);
+        o_assert(rm.mesh.IsValid());
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -134,6 +156,10 @@ imguiWrapper::setupDrawState() {
     dss.RasterizerState.CullFaceEnabled = false;
     dss.RasterizerState.SampleCount = Gfx::DisplayAttrs().SampleCount;
     this->drawState = Gfx::CreateResource(dss);
+    for (auto& rm : this->retainedMeshes) {
+        dss.Meshes[0] = rm.mesh;
+        rm.drawState = Gfx::CreateResource(dss);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -187,70 +213,220 @@ imguiWrapper::imguiRenderDrawLists(ImDrawData* draw_data) {
     if (draw_data->CmdListsCount == 0) {
         return;
     }
+    const float height = ImGui::GetIO().DisplaySize.y;
+    if (0 == self->numRendersInFrame++) {
+        self->renderRetained(draw_data, height);
+    }
+    else {
+        self->renderStreamed(draw_data, height);
+    }
+    Gfx::ApplyScissorRect(0, 0, (int32)ImGui::GetIO().DisplaySize.x, (int32)ImGui::GetIO().DisplaySize.y);
+}
 
-    // copy over vertices into single vertex buffer
-    int numVertices = 0;
-    int numIndices = 0;
-    int numCmdLists;
-    for (numCmdLists = 0; numCmdLists < draw_data->CmdListsCount; numCmdLists++) {
+//------------------------------------------------------------------------------
+int
+imguiWrapper::findGap(const Array<drawListInfo>& drawLists, bool vertices, int size, int capacity) {
+    // find the lowest offset where size items fit between the placed draw lists
+    int best = InvalidIndex;
+    for (int i = -1; i < drawLists.Size(); i++) {
+        int start = 0;
+        if (i >= 0) {
+            const drawListInfo& info = drawLists[i];
+            if (InvalidIndex == info.baseVertex) {
+                continue;
+            }
+            start = vertices ? info.baseVertex + info.numVertices : info.baseElement + info.numIndices;
+        }
+        if (((start + size) > capacity) || ((InvalidIndex != best) && (start >= best))) {
+            continue;
+        }
+        bool fits = true;
+        for (const drawListInfo& info : drawLists) {
+            if (InvalidIndex != info.baseVertex) {
+                const int otherStart = vertices ? info.baseVertex : info.baseElement;
+                const int otherEnd = otherStart + (vertices ? info.numVertices : info.numIndices);
+                if ((start < otherEnd) && (otherStart < (start + size))) {
+                    fits = false;
+                    break;
+                }
+            }
+        }
+        if (fits) {
+            best = start;
+        }
+    }
+    return best;
+}
 
-        const ImDrawList* cmd_list = draw_data->CmdLists[numCmdLists];
-        const int cmdListNumVertices = cmd_list->VtxBuffer.size();
-        const int cmdListNumIndices  = cmd_list->IdxBuffer.size();
+//------------------------------------------------------------------------------
+void
+imguiWrapper::upload(const retainedMesh& rm, const ImDrawList* cmdList, const drawListInfo& info) {
+    Gfx::UpdateVertices(rm.mesh, info.baseVertex * sizeof(ImDrawVert), &cmdList->VtxBuffer.front(), info.numVertices * sizeof(ImDrawVert));
+    Gfx::UpdateIndices(rm.mesh, info.baseElement * sizeof(ImDrawIdx), &cmdList->IdxBuffer.front(), info.numIndices * sizeof(ImDrawIdx));
+}
 
-        // overflow check
-        if (((numVertices + cmdListNumVertices) > imguiWrapper::MaxNumVertices) ||
-            ((numIndices + cmdListNumIndices) > imguiWrapper::MaxNumIndices)) {
-            break;
+//------------------------------------------------------------------------------
+void
+imguiWrapper::renderRetained(ImDrawData* drawData, float height) {
+    retainedMesh& rm = this->retainedMeshes[this->curRetainedMesh];
+    Array<drawListInfo>& layout = this->layout;
+    layout.Clear();
+
+    // hash the draw lists, and keep those which this mesh already
+    // holds where they are, the indices are relative to the base vertex
+    // so a draw list can be rendered from anywhere in the mesh
+    const int numDrawLists = drawData->CmdListsCount;
+    for (int cmdListIndex = 0; cmdListIndex < numDrawLists; cmdListIndex++) {
+        const ImDrawList* cmd_list = drawData->CmdLists[cmdListIndex];
+        drawListInfo info;
+        info.numVertices = cmd_list->VtxBuffer.size();
+        info.numIndices = cmd_list->IdxBuffer.size();
+        if ((info.numVertices > 0) && (info.numIndices > 0)) {
+            info.hash = fasthash64(&cmd_list->VtxBuffer.front(), info.numVertices * sizeof(ImDrawVert),
+                fasthash64(&cmd_list->IdxBuffer.front(), info.numIndices * sizeof(ImDrawIdx), 0));
+            for (drawListInfo& prev : rm.drawLists) {
+                if ((InvalidIndex != prev.baseVertex) && (prev.hash == info.hash) &&
+                    (prev.numVertices == info.numVertices) && (prev.numIndices == info.numIndices)) {
+                    info.baseVertex = prev.baseVertex;
+                    info.baseElement = prev.baseElement;
+                    prev.baseVertex = InvalidIndex;
+                    break;
+                }
+            }
         }
-        // copy vertices
-        Memory::Copy((const void*)&cmd_list->VtxBuffer.front(),
-                     &(self->vertexData[numVertices]),
-                     cmdListNumVertices * sizeof(ImDrawVert));
-
-        // need to copy indices one by one and add the current base vertex index :/
-        const ImDrawIdx* srcIndexPtr = &cmd_list->IdxBuffer.front();
-        const uint16 baseVertexIndex = numVertices;
-        for (int i = 0; i < cmdListNumIndices; i++) {
-            self->indexData[numIndices++] = srcIndexPtr[i] + baseVertexIndex;
+        else {
+            info.numVertices = 0;
+            info.numIndices = 0;
         }
-        numVertices += cmdListNumVertices;
+        layout.Add(info);
     }
 
-    // draw command lists
+    // upload the new or changed draw lists into the gaps between the kept
+    // ones, if they don't fit, rebuild the whole mesh
+    bool fits = true;
+    for (int cmdListIndex = 0; cmdListIndex < numDrawLists; cmdListIndex++) {
+        drawListInfo& info = layout[cmdListIndex];
+        if ((InvalidIndex == info.baseVertex) && (info.numVertices > 0)) {
+            const int baseVertex = findGap(layout, true, info.numVertices, MaxNumVertices);
+            const int baseElement = findGap(layout, false, info.numIndices, MaxNumIndices);
+            if ((InvalidIndex == baseVertex) || (InvalidIndex == baseElement)) {
+                fits = false;
+                break;
+            }
+            info.baseVertex = baseVertex;
+            info.baseElement = baseElement;
+            this->upload(rm, drawData->CmdLists[cmdListIndex], info);
+        }
+    }
+    if (!fits) {
+        int baseVertex = 0;
+        int baseElement = 0;
+        bool full = false;
+        for (int cmdListIndex = 0; cmdListIndex < numDrawLists; cmdListIndex++) {
+            drawListInfo& info = layout[cmdListIndex];
+            full |= ((baseVertex + info.numVertices) > MaxNumVertices) || ((baseElement + info.numIndices) > MaxNumIndices);
+            if (full) {
+                // out of space, drop the remaining draw lists
+                info.numVertices = 0;
+                info.numIndices = 0;
+            }
+            info.baseVertex = baseVertex;
+            info.baseElement = baseElement;
+            if (info.numVertices > 0) {
+                this->upload(rm, drawData->CmdLists[cmdListIndex], info);
+            }
+            baseVertex += info.numVertices;
+            baseElement += info.numIndices;
+        }
+    }
+    rm.drawLists = layout;
+
     Shaders::IMUIShader::VSParams vsParams;
     Shaders::IMUIShader::FSParams fsParams;
     const float width  = ImGui::GetIO().DisplaySize.x;
-    const float height = ImGui::GetIO().DisplaySize.y;
     vsParams.Ortho = glm::ortho(0.0f, width, height, 0.0f, -1.0f, 1.0f);
-    fsParams.Texture = self->fontTexture;
-    const int vertexDataSize = numVertices * sizeof(ImDrawVert);
-    const int indexDataSize = numIndices * sizeof(ImDrawIdx);
+    fsParams.Texture = this->fontTexture;
 
-    Gfx::UpdateVertices(self->mesh, self->vertexData, vertexDataSize);
-    Gfx::UpdateIndices(self->mesh, self->indexData, indexDataSize);
-    Gfx::ApplyDrawState(self->drawState);
+    Gfx::ApplyDrawState(rm.drawState);
     Gfx::ApplyUniformBlock(vsParams);
     Gfx::ApplyUniformBlock(fsParams);
-    int elmOffset = 0;
-    for (int cmdListIndex = 0; cmdListIndex < numCmdLists; cmdListIndex++) {
-        const ImDrawList* cmd_list = draw_data->CmdLists[cmdListIndex];
-        const ImDrawCmd* pcmd_end = cmd_list->CmdBuffer.end();
-        for (const ImDrawCmd* pcmd = cmd_list->CmdBuffer.begin(); pcmd != pcmd_end; pcmd++) {
-            if (pcmd->UserCallback) {
-                pcmd->UserCallback(cmd_list, pcmd);
-            }
-            else {
-                Gfx::ApplyScissorRect((int)pcmd->ClipRect.x,
-                                      (int)(height - pcmd->ClipRect.w),
-                                      (int)(pcmd->ClipRect.z - pcmd->ClipRect.x),
-                                      (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-                Gfx::Draw(PrimitiveGroup(PrimitiveType::Triangles, elmOffset, pcmd->ElemCount));
-            }
+    for (int cmdListIndex = 0; cmdListIndex < numDrawLists; cmdListIndex++) {
+        const drawListInfo& info = layout[cmdListIndex];
+        if (info.numVertices > 0) {
+            drawCommands(drawData->CmdLists[cmdListIndex], info.baseVertex, info.baseElement, height);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+imguiWrapper::renderStreamed(ImDrawData* drawData, float height) {
+
+    Shaders::IMUIShader::VSParams vsParams;
+    Shaders::IMUIShader::FSParams fsParams;
+    const float width  = ImGui::GetIO().DisplaySize.x;
+    vsParams.Ortho = glm::ortho(0.0f, width, height, 0.0f, -1.0f, 1.0f);
+    fsParams.Texture = this->fontTexture;
+
+    Gfx::ApplyDrawState(this->drawState);
+    Gfx::ApplyUniformBlock(vsParams);
+    Gfx::ApplyUniformBlock(fsParams);
+    for (int cmdListIndex = 0; cmdListIndex < drawData->CmdListsCount; cmdListIndex++) {
+        const ImDrawList* cmd_list = drawData->CmdLists[cmdListIndex];
+        const int cmdListNumVertices = cmd_list->VtxBuffer.size();
+        const int cmdListNumIndices  = cmd_list->IdxBuffer.size();
+        if ((0 == cmdListNumVertices) || (0 == cmdListNumIndices)) {
+            continue;
+        }
+
+        // append vertices and indices of the command list directly
+        // from imgui's buffers, the indices don't need to be rebased
+        // since the draw calls are issued with a base vertex
+        const int baseVertex = Gfx::AppendVertices(this->mesh, &cmd_list->VtxBuffer.front(), cmdListNumVertices * sizeof(ImDrawVert));
+        if (InvalidIndex == baseVertex) {
+            break;
+        }
+        const int baseElement = Gfx::AppendIndices(this->mesh, &cmd_list->IdxBuffer.front(), cmdListNumIndices * sizeof(ImDrawIdx));
+        if (InvalidIndex == baseElement) {
+            break;
+        }
+        drawCommands(cmd_list, baseVertex, baseElement, height);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+imguiWrapper::drawCommands(const ImDrawList* cmdList, int baseVertex, int baseElement, float height) {
+    int elmOffset = baseElement;
+    const ImDrawCmd* pcmd_end = cmdList->CmdBuffer.end();
+    const ImDrawCmd* pcmd = cmdList->CmdBuffer.begin();
+    while (pcmd != pcmd_end) {
+        if (pcmd->UserCallback) {
+            pcmd->UserCallback(cmdList, pcmd);
             elmOffset += pcmd->ElemCount;
+            pcmd++;
+            continue;
+        }
+        // merge the following commands with the same texture and clip rect,
+        // their indices are contiguous
+        int numElements = pcmd->ElemCount;
+        const ImDrawCmd* next = pcmd + 1;
+        while ((next != pcmd_end) && !next->UserCallback && (next->TextureId == pcmd->TextureId) &&
+               (next->ClipRect.x == pcmd->ClipRect.x) && (next->ClipRect.y == pcmd->ClipRect.y) &&
+               (next->ClipRect.z == pcmd->ClipRect.z) && (next->ClipRect.w == pcmd->ClipRect.w)) {
+            numElements += next->ElemCount;
+            next++;
         }
+        if (numElements > 0) {
+            Gfx::ApplyScissorRect((int)pcmd->ClipRect.x,
+                                  (int)(height - pcmd->ClipRect.w),
+                                  (int)(pcmd->ClipRect.z - pcmd->ClipRect.x),
+                                  (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
+            Gfx::Draw(PrimitiveGroup(PrimitiveType::Triangles, elmOffset, numElements), baseVertex);
+        }
+        elmOffset += numElements;
+        pcmd = next;
     }
-    Gfx::ApplyScissorRect(0, 0, (int32)ImGui::GetIO().DisplaySize.x, (int32)ImGui::GetIO().DisplaySize.y);
 }
 
 } // namespace _priv
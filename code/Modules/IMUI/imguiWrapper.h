@@ -3,13 +3,27 @@
 /**
     @class Oryol::_priv::imguiWrapper
     @brief imgui wrapper class for Oryol
+
+    ImGui's draw lists are rendered from retained Usage::Dynamic meshes,
+    one per frame in flight, since a range update must not touch data
+    which the GPU may still read. Each draw list is hashed, and if the
+    retained mesh already holds a draw list with the same hash, it is
+    drawn from there, so windows which didn't change cost a hash, but
+    no upload. New or changed draw lists are uploaded into the gaps
+    between the kept ones (or the whole mesh is rebuilt if they don't
+    fit). Consecutive draw commands with the same texture and clip rect
+    are merged into one draw call. If ImGui renders more than once per
+    frame, the additional renders append to a Usage::Stream mesh.
 */
 #include "Core/Types.h"
+#include "Core/RunLoop.h"
+#include "Core/Containers/Array.h"
 #include "Input/Core/Mouse.h"
 #include "Input/Core/Key.h"
 #include "Input/InputProtocol.h"
 #include "Messaging/Dispatcher.h"
 #include "Gfx/Gfx.h"
+#include "Gfx/Core/GfxConfig.h"
 #include "Time/Duration.h"
 #include "imgui.h"
 
@@ -36,9 +50,17 @@ private:
     void setupDrawState();
     /// imgui's draw callback
     static void imguiRenderDrawLists(ImDrawData* draw_data);
+    /// render the draw lists from the current retained mesh
+    void renderRetained(ImDrawData* drawData, float height);
+    /// render the draw lists by appending them to the stream mesh
+    void renderStreamed(ImDrawData* drawData, float height);
+    /// issue the draw calls of a draw list, merging commands with same texture and clip rect
+    static void drawCommands(const ImDrawList* cmdList, int baseVertex, int baseElement, float height);
 
     static const int MaxNumVertices = 64 * 1024;
     static const int MaxNumIndices = 128 * 1024;
+    /// one retained mesh per frame in flight
+    static const int NumRetainedMeshes = GfxConfig::MaxInflightFrames;
 
     static imguiWrapper* self;
 
@@ -47,8 +69,31 @@ private:
     Id fontTexture;
     Id mesh;
     Id drawState;
-    ImDrawVert vertexData[MaxNumVertices];
-    ImDrawIdx indexData[MaxNumIndices];
+    RunLoop::Id runLoopId = RunLoop::InvalidId;
+    int curRetainedMesh = 0;
+    int numRendersInFrame = 0;
+
+    /// location and content hash of a draw list in a retained mesh
+    struct drawListInfo {
+        int baseVertex = InvalidIndex;  // InvalidIndex if not placed
+        int numVertices = 0;
+        int baseElement = InvalidIndex;
+        int numIndices = 0;
+        uint64 hash = 0;
+    };
+    /// a mesh with the draw lists it was last rendered with
+    struct retainedMesh {
+        Id mesh;
+        Id drawState;
+        Array<drawListInfo> drawLists;
+    };
+    /// find the lowest vertex or index offset where size items fit between placed draw lists
+    static int findGap(const Array<drawListInfo>& drawLists, bool vertices, int size, int capacity);
+    /// upload a draw list's vertices and indices into a retained mesh
+    static void upload(const retainedMesh& rm, const ImDrawList* cmdList, const drawListInfo& info);
+
+    retainedMesh retainedMeshes[NumRetainedMeshes];
+    Array<drawListInfo> layout;
 };
 
 } // namespace _priv
@@ -26,7 +26,9 @@ void
 IOQueue::Start() {
     o_assert_dbg(!this->isStarted);
     this->isStarted = true;
-    this->runLoopId = Core::PreRunLoop()->Add([this]() { this->update(); });
+    // IO requests are pumped in the IO phase, so look at them afterwards
+    Core::PreRunLoop()->AddPhase("IOQueue", { "IO" });
+    this->runLoopId = Core::PreRunLoop()->Add("IOQueue", [this]() { this->update(); });
 }
 
 //------------------------------------------------------------------------------
@@ -39,6 +41,14 @@ IOQueue::Stop() {
     o_assert(this->isStarted);
     this->isStarted = false;
     Core::PreRunLoop()->Remove(this->runLoopId);
+    for (const auto& curItem : this->items) {
+        IO::ReleaseRequest(curItem.ioRequest);
+    }
+    for (const auto& curItem : this->groupItems) {
+        for (IO::RequestHandle handle : curItem.ioRequests) {
+            IO::ReleaseRequest(handle);
+        }
+    }
     this->items.Clear();
     this->groupItems.Clear();
 }
@@ -60,10 +70,9 @@ void
 IOQueue::Add(const URL& url, SuccessFunc onSuccess, FailFunc onFail) {
     o_assert_dbg(onSuccess);
 
-    // create IO request and push into IO facade
-    Ptr<IOProtocol::Request> ioReq = IOProtocol::Request::Create();
-    ioReq->SetURL(url);
-    IO::Put(ioReq);
+    // create IO request and push into IO facade, the queue only
+    // holds the request handle, not a Ptr to the request
+    IO::RequestHandle ioReq = IO::StartLoadFile(url);
     
     // add to our queue if pending requests
     this->items.Add(item{ ioReq, onSuccess, onFail });
@@ -77,10 +86,7 @@ IOQueue::AddGroup(const Array<URL>& urls, GroupSuccessFunc onSuccess, FailFunc o
     groupItem item;
     item.ioRequests.Reserve(urls.Size());
     for (const URL& url : urls) {
-        Ptr<IOProtocol::Request> ioReq = IOProtocol::Request::Create();
-        ioReq->SetURL(url);
-        IO::Put(ioReq);
-        item.ioRequests.Add(ioReq);
+        item.ioRequests.Add(IO::StartLoadFile(url));
         item.successFunc = onSuccess;
         item.failFunc = onFail;
     }
@@ -97,7 +103,9 @@ IOQueue::update() {
     // check single items
     for (int i = this->items.Size() - 1; i >= 0; --i) {
         const item& curItem = this->items[i];
-        const auto& ioReq = curItem.ioRequest;
+        const IO::RequestHandle handle = curItem.ioRequest;
+        const IOProtocol::Request* ioReq = IO::LookupRequest(handle);
+        o_assert_dbg(nullptr != ioReq);
         if (ioReq->Handled()) {
             // io request has been handled
             if (IOStatus::OK == ioReq->GetStatus()) {
@@ -115,6 +123,7 @@ IOQueue::update() {
                 }
             }
             // remove the handled io request from the queue
+            IO::ReleaseRequest(handle);
             this->items.Erase(i);
         }
     }
@@ -124,7 +133,9 @@ IOQueue::update() {
         const groupItem& curItem = this->groupItems[i];
         bool allHandled = true;
         bool anyFailed = false;
-        for (const auto& ioReq : curItem.ioRequests) {
+        for (IO::RequestHandle handle : curItem.ioRequests) {
+            const IOProtocol::Request* ioReq = IO::LookupRequest(handle);
+            o_assert_dbg(nullptr != ioReq);
             if (ioReq->Handled()) {
                 if (IOStatus::OK != ioReq->GetStatus()) {
                     anyFailed = true;
@@ -146,12 +157,17 @@ IOQueue::update() {
         // if all request in this group have been handled, remove item, and
         // if all were successful, call the successFunc
         if (allHandled) {
+            Array<Ptr<Stream>> result;
             if (!anyFailed) {
-                Array<Ptr<Stream>> result;
                 result.Reserve(curItem.ioRequests.Size());
-                for (const auto& ioReq : curItem.ioRequests) {
-                    result.Add(ioReq->GetStream());
+                for (IO::RequestHandle handle : curItem.ioRequests) {
+                    result.Add(IO::LookupRequest(handle)->GetStream());
                 }
+            }
+            for (IO::RequestHandle handle : curItem.ioRequests) {
+                IO::ReleaseRequest(handle);
+            }
+            if (!anyFailed) {
                 curItem.successFunc(result);
             }
             this->groupItems.Erase(i);
@@ -12,7 +12,7 @@
 */
 #include "Core/Types.h"
 #include "Core/String/StringAtom.h"
-#include "IO/IOProtocol.h"
+#include "IO/IO.h"
 #include "Core/Containers/Array.h"
 #include <functional>
 
@@ -53,13 +53,13 @@ private:
     bool isStarted;
     int32 runLoopId;
     struct item {
-        Ptr<IOProtocol::Request> ioRequest;
+        IO::RequestHandle ioRequest;
         SuccessFunc successFunc;
         FailFunc failFunc;
     };
     Array<item> items;
     struct groupItem {
-        Array<Ptr<IOProtocol::Request>> ioRequests;
+        Array<IO::RequestHandle> ioRequests;
         GroupSuccessFunc successFunc;
         FailFunc failFunc;
     };
@@ -3,7 +3,7 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "URL.h"
-#include "Core/String/StringBuilder.h"
+#include "Core/String/stringOps.h"
 #include "Core/Log.h"
 #include "IO/IO.h"
 
@@ -11,6 +11,23 @@ namespace Oryol {
 
 using namespace _priv;
 
+//------------------------------------------------------------------------------
+/**
+ Find first of delims in the range [startIndex, endIndex), return
+ InvalidIndex if not found.
+*/
+static int32
+findFirstOf(const char* str, int32 startIndex, int32 endIndex, const char* delims) {
+    const int32 index = stringOps::FindFirstOf(str + startIndex, endIndex - startIndex, delims);
+    return (InvalidIndex == index) ? InvalidIndex : startIndex + index;
+}
+
+//------------------------------------------------------------------------------
+static String
+subString(const char* str, int32 startIndex, int32 endIndex) {
+    return (startIndex < endIndex) ? String(str, startIndex, endIndex) : String();
+}
+
 //------------------------------------------------------------------------------
 void
 URL::clearIndices() {
@@ -52,20 +69,19 @@ URL::URL(URL&& rhs) {
 //------------------------------------------------------------------------------
 URL::URL(const char* rhs) :
 valid(false) {
-    this->crack(rhs);
+    this->setup(rhs);
 }
     
 //------------------------------------------------------------------------------
 URL::URL(const StringAtom& rhs) :
 valid(false) {
-    this->crack(rhs.AsString());
+    this->setup(rhs);
 }
     
 //------------------------------------------------------------------------------
 URL::URL(const String& rhs) :
-content(rhs),
 valid(false) {
-    this->crack(rhs);
+    this->setup(rhs.AsCStr());
 }
     
 //------------------------------------------------------------------------------
@@ -94,22 +110,19 @@ URL::operator=(URL&& rhs) {
 //------------------------------------------------------------------------------
 void
 URL::operator=(const char* rhs) {
-    this->content = rhs;
-    this->crack(rhs);
+    this->setup(rhs);
 }
     
 //------------------------------------------------------------------------------
 void
 URL::operator=(const StringAtom& rhs) {
-    this->content = rhs;
-    this->crack(rhs.AsString());
+    this->setup(rhs);
 }
     
 //------------------------------------------------------------------------------
 void
 URL::operator=(const String& rhs) {
-    this->content = rhs;
-    this->crack(rhs);
+    this->setup(rhs.AsCStr());
 }
     
 //------------------------------------------------------------------------------
@@ -148,45 +161,80 @@ URL::Empty() const {
     return !this->content.IsValid();
 }
 
+//------------------------------------------------------------------------------
+bool
+URL::resolveAssigns(const char* str) {
+    if ((nullptr == str) || !IO::IsValid()) {
+        return false;
+    }
+    char buf[ResolveBufferSize];
+    const int32 len = IO::ResolveAssigns(str, buf, ResolveBufferSize);
+    if (InvalidIndex == len) {
+        return false;
+    }
+    else if (len < ResolveBufferSize) {
+        this->content = buf;
+    }
+    else {
+        // very long result, take the slow path
+        this->content = IO::ResolveAssigns(String(str));
+    }
+    return true;
+}
+
 //------------------------------------------------------------------------------
 void
-URL::crack(String urlString) {
+URL::setup(const char* str) {
+    if (!this->resolveAssigns(str)) {
+        this->content = str;
+    }
+    this->crack();
+}
+
+//------------------------------------------------------------------------------
+void
+URL::setup(const StringAtom& str) {
+    // if there's nothing to resolve, the StringAtom is simply copied
+    if (!this->resolveAssigns(str.AsCStr())) {
+        this->content = str;
+    }
+    this->crack();
+}
+
+//------------------------------------------------------------------------------
+void
+URL::crack() {
 
-    this->content.Clear();
     this->clearIndices();
     this->valid = false;
     
-    if (IO::IsValid()) {
-        urlString = IO::ResolveAssigns(urlString);
-    }
-    if (urlString.IsValid()) {
+    if (this->content.IsValid()) {
     
-        StringBuilder builder;
-        builder.Set(urlString);
-        this->content = urlString;
+        const char* str = this->content.AsCStr();
+        const int32 len = this->content.Length();
         
-        // extract scheme
+        // extract scheme, the "://" must start within the first 8 characters
         this->indices[schemeStart] = 0;
-        this->indices[schemeEnd] = builder.FindSubString(0, 8, "://");
-        if (EndOfString == this->indices[schemeEnd]) {
-            o_warn("URL::crack(): '%s' is not a valid URL!\n", this->content.AsCStr());
+        this->indices[schemeEnd] = stringOps::FindSubString(str, len < 10 ? len : 10, "://", 3);
+        if (InvalidIndex == this->indices[schemeEnd]) {
+            o_warn("URL::crack(): '%s' is not a valid URL!\n", str);
             this->clearIndices();
             return;
         }
         
         // extract host fields
         int32 leftStartIndex = this->indices[schemeEnd] + 3;
-        int32 leftEndIndex = builder.FindFirstOf(leftStartIndex, EndOfString, "/");
-        if (EndOfString == leftEndIndex) {
-            leftEndIndex = builder.Length();
+        int32 leftEndIndex = findFirstOf(str, leftStartIndex, len, "/");
+        if (InvalidIndex == leftEndIndex) {
+            leftEndIndex = len;
         }
         if (leftStartIndex != leftEndIndex) {
             // extract user and password
-            int32 userAndPwdEndIndex = builder.FindFirstOf(leftStartIndex, leftEndIndex, "@");
-            if (EndOfString != userAndPwdEndIndex) {
+            int32 userAndPwdEndIndex = findFirstOf(str, leftStartIndex, leftEndIndex, "@");
+            if (InvalidIndex != userAndPwdEndIndex) {
                 // only user, or user:pwd?
-                int32 userEndIndex = builder.FindFirstOf(leftStartIndex, userAndPwdEndIndex, ":");
-                if (EndOfString != userEndIndex) {
+                int32 userEndIndex = findFirstOf(str, leftStartIndex, userAndPwdEndIndex, ":");
+                if (InvalidIndex != userEndIndex) {
                     // user and password
                     this->indices[userStart] = leftStartIndex;
                     this->indices[userEnd]   = userEndIndex;
@@ -202,8 +250,8 @@ URL::crack(String urlString) {
             }
             
             // extract host and port
-            int32 hostEndIndex = builder.FindFirstOf(leftStartIndex, leftEndIndex, ":");
-            if (EndOfString != hostEndIndex) {
+            int32 hostEndIndex = findFirstOf(str, leftStartIndex, leftEndIndex, ":");
+            if (InvalidIndex != hostEndIndex) {
                 // host and port
                 this->indices[hostStart] = leftStartIndex;
                 this->indices[hostEnd]   = hostEndIndex;
@@ -218,14 +266,14 @@ URL::crack(String urlString) {
         }
         
         // is there any path component?
-        if (leftEndIndex != builder.Length()) {
+        if (leftEndIndex != len) {
             // extract right-hand-side (path, fragment, query)
             int32 rightStartIndex = leftEndIndex + 1;
-            int32 rightEndIndex = builder.Length();
+            int32 rightEndIndex = len;
             
             int32 pathStartIndex = rightStartIndex;
-            int32 pathEndIndex = builder.FindFirstOf(rightStartIndex, rightEndIndex, "#?");
-            if (EndOfString == pathEndIndex) {
+            int32 pathEndIndex = findFirstOf(str, rightStartIndex, rightEndIndex, "#?");
+            if (InvalidIndex == pathEndIndex) {
                 pathEndIndex = rightEndIndex;
             }
             if (pathStartIndex != pathEndIndex) {
@@ -234,10 +282,10 @@ URL::crack(String urlString) {
             }
 
             // extract query
-            if ((pathEndIndex != rightEndIndex) && (builder.At(pathEndIndex) == '?')) {
+            if ((pathEndIndex != rightEndIndex) && (str[pathEndIndex] == '?')) {
                 int32 queryStartIndex = pathEndIndex + 1;
-                int32 queryEndIndex = builder.FindFirstOf(queryStartIndex, rightEndIndex, "#");
-                if (EndOfString == queryEndIndex) {
+                int32 queryEndIndex = findFirstOf(str, queryStartIndex, rightEndIndex, "#");
+                if (InvalidIndex == queryEndIndex) {
                     queryEndIndex = rightEndIndex;
                 }
                 if (queryStartIndex != queryEndIndex) {
@@ -248,10 +296,10 @@ URL::crack(String urlString) {
             }
             
             // extract fragment
-            if ((pathEndIndex != rightEndIndex) && (builder.At(pathEndIndex) == '#')) {
+            if ((pathEndIndex != rightEndIndex) && (str[pathEndIndex] == '#')) {
                 int32 fragStartIndex = pathEndIndex + 1;
-                int32 fragEndIndex = builder.FindFirstOf(fragStartIndex, rightEndIndex, "?");
-                if (EndOfString == fragEndIndex) {
+                int32 fragEndIndex = findFirstOf(str, fragStartIndex, rightEndIndex, "?");
+                if (InvalidIndex == fragEndIndex) {
                     fragEndIndex = rightEndIndex;
                 }
                 if (fragStartIndex != fragEndIndex) {
@@ -425,27 +473,27 @@ Map<String, String>
 URL::Query() const {
     if (this->HasQuery()) {
         Map<String, String> query;
-        StringBuilder builder;
-        builder.Set(this->content.AsCStr(), this->indices[queryStart], this->indices[queryEnd]);
-        int32 kvpStartIndex = 0;
+        const char* str = this->content.AsCStr();
+        const int32 queryEndIndex = this->indices[queryEnd];
+        int32 kvpStartIndex = this->indices[queryStart];
         int32 kvpEndIndex = 0;
         do {
-            kvpEndIndex = builder.FindFirstOf(kvpStartIndex, EndOfString, "&");
-            int32 keyEndIndex = builder.FindFirstOf(kvpStartIndex, kvpEndIndex, "=");
-            if (EndOfString != keyEndIndex) {
+            kvpEndIndex = findFirstOf(str, kvpStartIndex, queryEndIndex, "&");
+            if (InvalidIndex == kvpEndIndex) {
+                kvpEndIndex = queryEndIndex;
+            }
+            int32 keyEndIndex = findFirstOf(str, kvpStartIndex, kvpEndIndex, "=");
+            if (InvalidIndex != keyEndIndex) {
                 // key and value
-                String key(builder.GetSubString(kvpStartIndex, keyEndIndex));
-                String value(builder.GetSubString(keyEndIndex + 1, kvpEndIndex));
-                query.Add(key, value);
+                query.Add(subString(str, kvpStartIndex, keyEndIndex), subString(str, keyEndIndex + 1, kvpEndIndex));
             }
             else {
                 // only key
-                String key(builder.GetSubString(kvpStartIndex, kvpEndIndex));
-                query.Add(key, String());
+                query.Add(subString(str, kvpStartIndex, kvpEndIndex), String());
             }
             kvpStartIndex = kvpEndIndex + 1;
         }
-        while (EndOfString != kvpEndIndex);
+        while (kvpEndIndex != queryEndIndex);
         return query;
     }
     else {
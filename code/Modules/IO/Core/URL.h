@@ -6,11 +6,13 @@
     @brief Oryol's URL class
     
     All resource paths in Oryol are expressed as URLs. 
-    On creation and assignment, the URL will be
-    parsed and indices to its parts will be stored internally, this
-    is quite fast. The actual URL string will be stored as a StringAtom.
-    Expensive String construction only happens when actually getting
-    the URL parts. 
+    On creation and assignment, assigns are resolved into a stack
+    buffer, and the URL is parsed in place, only the indices
+    of its parts are stored internally. The actual URL string
+    will be stored as a StringAtom, so creating an URL which has been
+    seen before doesn't allocate. String construction only happens
+    when actually getting the URL parts (and short parts are stored
+    in the String object itself).
     
     @see URLBuilder
 */
@@ -100,8 +102,14 @@ public:
     String PathToEnd() const;
     
 private:
-    /// crack URL, populates string indices
-    void crack(String urlString);
+    /// resolve assigns and setup content from a C string
+    void setup(const char* str);
+    /// resolve assigns and setup content from a StringAtom
+    void setup(const StringAtom& str);
+    /// resolve assigns into content, return false if nothing to resolve
+    bool resolveAssigns(const char* str);
+    /// crack URL content, populates string indices
+    void crack();
     /// clear string indices
     void clearIndices();
     /// copy string indices
@@ -127,6 +135,8 @@ private:
         
         numIndices,
     };
+    /// size of the stack buffer for resolving assigns
+    static const int32 ResolveBufferSize = 1024;
     
     StringAtom content;
     int16 indices[numIndices];
@@ -4,6 +4,8 @@
 #include "Pre.h"
 #include "assignRegistry.h"
 #include "Core/String/StringBuilder.h"
+#include "Core/Memory/Memory.h"
+#include <cstring>
 
 namespace Oryol {
 namespace _priv {
@@ -33,6 +35,7 @@ assignRegistry::SetAssign(const String& assign, const String& path) {
     else {
         this->assigns.Add(assign, path);
     }
+    this->updateResolved();
     this->rwLock.UnlockWrite();
 }
 
@@ -61,32 +64,94 @@ assignRegistry::LookupAssign(const String& assign) const {
 }
 
 //------------------------------------------------------------------------------
-String
-assignRegistry::ResolveAssigns(const String& str) const {
-
-    this->rwLock.LockRead();
-    
+void
+assignRegistry::updateResolved() {
+    this->resolved.Clear();
     StringBuilder builder;
-    builder.Set(str);
-    
-    // while there are assigns to replace...
-    int32 index;
-    while ((index = builder.FindFirstOf(0, EndOfString, ":")) != EndOfString) {
-        // ignore DOS drive letters
-        if (index > 1) {
-            String assignString = builder.GetSubString(0, index + 1);
-
-            // lookup the assign, ignore unknown assigns, may be URL schemes
-            if (this->assigns.Contains(assignString)) {
+    for (const auto& kvp : this->assigns) {
+        builder.Set(kvp.Value());
+        
+        // while there are assigns to replace... (the iteration count
+        // is limited to not hang on circular assigns)
+        int32 index;
+        int32 numIter = 0;
+        while ((index = builder.FindFirstOf(0, EndOfString, ":")) != EndOfString) {
+            // ignore DOS drive letters
+            if ((index > 1) && (numIter++ < this->assigns.Size())) {
+                String assignString = builder.GetSubString(0, index + 1);
                 
-                // replace assign string
-                builder.SubstituteFirst(assignString, this->assigns[assignString]);
+                // lookup the assign, ignore unknown assigns, may be URL schemes
+                if (this->assigns.Contains(assignString)) {
+                    
+                    // replace assign string
+                    builder.SubstituteFirst(assignString, this->assigns[assignString]);
+                }
+                else break;
             }
             else break;
         }
-        else break;
+        this->resolved.Add(kvp.Key(), builder.GetString());
+    }
+}
+
+//------------------------------------------------------------------------------
+const String*
+assignRegistry::findResolved(const char* str, int32& outAssignLength) const {
+    const char* colon = std::strchr(str, ':');
+    
+    // ignore DOS drive letters
+    if (colon && ((colon - str) > 1)) {
+        // assign names fit into a String without allocation
+        const String assign(str, 0, int32(colon - str) + 1);
+        const int32 index = this->resolved.FindIndex(assign);
+        if (InvalidIndex != index) {
+            outAssignLength = assign.Length();
+            return &this->resolved.ValueAtIndex(index);
+        }
+    }
+    // not an assign, may be an URL scheme
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+String
+assignRegistry::ResolveAssigns(const String& str) const {
+    String result = str;
+    this->rwLock.LockRead();
+    int32 assignLength = 0;
+    const String* path = this->findResolved(str.AsCStr(), assignLength);
+    if (path) {
+        StringBuilder builder(*path);
+        builder.Append(str.AsCStr() + assignLength);
+        result = builder.GetString();
+    }
+    this->rwLock.UnlockRead();
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Resolve assigns into a caller-provided buffer without allocating. Returns
+ InvalidIndex if str doesn't start with an assign (dst is untouched), 
+ otherwise the length of the resolved string. If the length is >= dstSize,
+ nothing has been written and the caller must use the String version.
+*/
+int32
+assignRegistry::ResolveAssigns(const char* str, char* dst, int32 dstSize) const {
+    o_assert_dbg(str && dst);
+    int32 result = InvalidIndex;
+    this->rwLock.LockRead();
+    int32 assignLength = 0;
+    const String* path = this->findResolved(str, assignLength);
+    if (path) {
+        const int32 pathLength = path->Length();
+        const int32 restLength = int32(std::strlen(str + assignLength));
+        result = pathLength + restLength;
+        if (result < dstSize) {
+            Memory::Copy(path->AsCStr(), dst, pathLength);
+            Memory::Copy(str + assignLength, dst + pathLength, restLength + 1);
+        }
     }
-    String result = builder.GetString();
     this->rwLock.UnlockRead();
     return result;
 }
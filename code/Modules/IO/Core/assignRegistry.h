@@ -7,6 +7,10 @@
  
     Central registry for assign definitions. Assigns are
     path aliases (google for AmigaOS assign).
+
+    The fully resolved path of each assign is cached, and the cache
+    is rebuilt in SetAssign(). Resolving a string is one
+    lookup and a copy, no matter how deeply the assigns are nested.
 */
 #include "Core/Containers/Map.h"
 #include "Core/String/String.h"
@@ -30,13 +34,20 @@ public:
     String LookupAssign(const String& assign) const;
     /// resolve assigns in the provided string
     String ResolveAssigns(const String& str) const;
+    /// resolve assigns into a buffer, return resolved length (may be >= dstSize), or InvalidIndex if nothing to resolve
+    int32 ResolveAssigns(const char* str, char* dst, int32 dstSize) const;
     
 private:
     /// setup the standard assigns
     void setStandardAssigns();
+    /// rebuild the resolved-assigns cache (call with write lock)
+    void updateResolved();
+    /// find resolved path of the assign at start of str (call with read lock)
+    const String* findResolved(const char* str, int32& outAssignLength) const;
     
     mutable RWLock rwLock;
     Map<String, String> assigns;
+    Map<String, String> resolved;
 };
     
 } // namespace _priv
@@ -4,6 +4,7 @@
 #include "Pre.h"
 #include "ioLane.h"
 #include "Messaging/Dispatcher.h"
+#include "Core/Trace.h"
 
 // FIXME: access to IO.h from down here is a bit hacky :/
 #include "IO/IO.h"
@@ -28,6 +29,9 @@ ioLane::~ioLane() {
 void
 ioLane::onThreadEnter() {
     ThreadedQueue::onThreadEnter();
+    #if ORYOL_HAS_THREADS
+    Profiler::SetThreadName("ioLane");
+    #endif
 
     // setup a Dispatcher to route messages to safely route messages
     // to this object's callback methods
@@ -51,6 +55,7 @@ ioLane::onThreadLeave() {
 //------------------------------------------------------------------------------
 void
 ioLane::onTick() {
+    o_trace_scoped(ioLane_Tick);
     ThreadedQueue::onTick();
     
     // also tick our file systems
@@ -62,19 +67,22 @@ ioLane::onTick() {
 //------------------------------------------------------------------------------
 Ptr<FileSystem>
 ioLane::fileSystemForURL(const URL& url) {
-    StringAtom scheme = url.Scheme();
-    if (this->fileSystems.Contains(scheme)) {
-        return this->fileSystems[scheme];
-    }
-    else {
-        o_warn("ioLane::fileSystemForURL: no filesystem registered for URL scheme '%s'!\n", scheme.AsCStr());
-        return Ptr<FileSystem>();
+    // only a handful of filesystems are registered, comparing the
+    // scheme directly is cheaper than creating a StringAtom per request
+    const String scheme = url.Scheme();
+    for (const auto& kvp : this->fileSystems) {
+        if (scheme == kvp.Key().AsCStr()) {
+            return kvp.Value();
+        }
     }
+    o_warn("ioLane::fileSystemForURL: no filesystem registered for URL scheme '%s'!\n", scheme.AsCStr());
+    return Ptr<FileSystem>();
 }
 
 //------------------------------------------------------------------------------
 void
 ioLane::onRequest(const Ptr<IOProtocol::Request>& msg) {
+    o_trace_scoped(ioLane_Request);
     if (msg->Cancelled()) {
         // message has been cancelled, don't waste time with it
         msg->SetStatus(IOStatus::Cancelled);
@@ -31,22 +31,22 @@ ioRequestRouter::~ioRequestRouter() {
 //------------------------------------------------------------------------------
 bool
 ioRequestRouter::Put(const Ptr<Message>& msg) {
+    // NOTE: test the message type with IsA<>() instead of DynamicCast<>(),
+    // a temporary Ptr would touch the refcount which is shared with the IO lanes
+
     // is it a notify message for all lanes?
-    Ptr<IOProtocol::notifyLanes> notifyMsg = msg->DynamicCast<IOProtocol::notifyLanes>();
-    if (notifyMsg.isValid()) {
+    if (msg->IsA<IOProtocol::notifyLanes>()) {
         for (const auto& lane : this->ioLanes) {
             lane->Put(msg);
         }
         return true;
     }
-    else {
-        Ptr<IOProtocol::Request> req = msg->DynamicCast<IOProtocol::Request>();
-        if (req.isValid()) {
-            const int32 laneIndex = req->GetLane() % this->numLanes;
-            req->SetActualLane(laneIndex);
-            this->ioLanes[laneIndex]->Put(msg);
-            return true;
-        }
+    else if (msg->IsA<IOProtocol::Request>()) {
+        IOProtocol::Request* req = (IOProtocol::Request*) msg.get();
+        const int32 laneIndex = req->GetLane() % this->numLanes;
+        req->SetActualLane(laneIndex);
+        this->ioLanes[laneIndex]->Put(msg);
+        return true;
     }
     // fallthrough: unrecognized message
     o_warn("ioRequestRouter::Put(): unrecognized message received!\n");
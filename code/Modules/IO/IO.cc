@@ -31,7 +31,8 @@ IO::Setup(const IOSetup& setup) {
         RegisterFileSystem(fs.Key(), fs.Value());
     }
     
-    state->runLoopId = Core::PreRunLoop()->Add([] { doWork(); });
+    // doWork() must be called from the thread which created the IO lanes
+    state->runLoopId = Core::PreRunLoop()->Add("IO", [] { doWork(); });
 }
 
 //------------------------------------------------------------------------------
@@ -87,6 +88,13 @@ IO::ResolveAssigns(const String& str) {
     return state->assignReg.ResolveAssigns(str);
 }
 
+//------------------------------------------------------------------------------
+int32
+IO::ResolveAssigns(const char* str, char* dst, int32 dstSize) {
+    o_assert_dbg(IsValid());
+    return state->assignReg.ResolveAssigns(str, dst, dstSize);
+}
+
 //------------------------------------------------------------------------------
 void
 IO::RegisterFileSystem(const StringAtom& scheme, std::function<Ptr<FileSystem>()> fsCreator) {
@@ -140,6 +148,45 @@ IO::Put(const Ptr<IOProtocol::Request>& ioReq) {
     state->requestRouter->Put(ioReq);
 }
 
+//------------------------------------------------------------------------------
+/**
+ The handle-based variant of LoadFile(). The IO module holds the only
+ reference to the request outside the IO lane, callers only copy the
+ 32-bit handle around, which avoids the atomic refcount traffic
+ of Ptr<> copies on the calling thread.
+*/
+IO::RequestHandle
+IO::StartLoadFile(const URL& url, int32 ioLane) {
+    o_assert_dbg(IsValid());
+    const RequestHandle handle = state->requests.Create(IOProtocol::Request::Create());
+    const Ptr<IOProtocol::Request>& ioReq = *state->requests.Lookup(handle);
+    ioReq->SetURL(url);
+    ioReq->SetLane(ioLane);
+    state->requestRouter->Put(ioReq);
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+IOProtocol::Request*
+IO::LookupRequest(RequestHandle handle) {
+    o_assert_dbg(IsValid());
+    Ptr<IOProtocol::Request>* ioReq = state->requests.Lookup(handle);
+    return ioReq ? ioReq->get() : nullptr;
+}
+
+//------------------------------------------------------------------------------
+void
+IO::ReleaseRequest(RequestHandle handle) {
+    o_assert_dbg(IsValid());
+    Ptr<IOProtocol::Request>* ioReq = state->requests.Lookup(handle);
+    o_assert(nullptr != ioReq);
+    if (!(*ioReq)->Handled()) {
+        // the IO lane will skip the request
+        (*ioReq)->SetCancelled();
+    }
+    state->requests.Destroy(handle);
+}
+
 //------------------------------------------------------------------------------
 schemeRegistry*
 IO::getSchemeRegistry() {
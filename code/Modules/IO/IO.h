@@ -11,6 +11,7 @@
 #include "Core/RefCounted.h"
 #include "Core/String/String.h"
 #include "Core/String/StringAtom.h"
+#include "Core/Memory/HandlePool.h"
 #include "IO/Core/IOSetup.h"
 #include "IO/IOProtocol.h"
 #include "IO/FS/ioRequestRouter.h"
@@ -37,6 +38,8 @@ public:
     static String LookupAssign(const String& assign);
     /// resolve assigns in the provided string
     static String ResolveAssigns(const String& str);
+    /// resolve assigns into a buffer without allocating (see assignRegistry)
+    static int32 ResolveAssigns(const char* str, char* dst, int32 dstSize);
     
     /// associate URL scheme with filesystem
     static void RegisterFileSystem(const StringAtom& scheme, std::function<Ptr<FileSystem>()> fsCreator);
@@ -49,6 +52,15 @@ public:
     static Ptr<IOProtocol::Request> LoadFile(const URL& url, int32 ioLane=0);
     /// push a generic asynchronous IO request
     static void Put(const Ptr<IOProtocol::Request>& ioReq);
+
+    /// handle to an IO request which is owned by the IO module
+    typedef HandlePool<Ptr<IOProtocol::Request>>::Handle RequestHandle;
+    /// start async loading of file from URL, return a handle instead of a shared request
+    static RequestHandle StartLoadFile(const URL& url, int32 ioLane=0);
+    /// lookup request by handle, return nullptr if the handle has been released
+    static IOProtocol::Request* LookupRequest(RequestHandle handle);
+    /// release a request handle, cancels the request if not handled yet
+    static void ReleaseRequest(RequestHandle handle);
     
 private:
     friend class _priv::ioLane;
@@ -64,6 +76,7 @@ private:
         _priv::schemeRegistry schemeReg;
         int32 runLoopId = 0;
         Ptr<_priv::ioRequestRouter> requestRouter;
+        HandlePool<Ptr<IOProtocol::Request>> requests;
     };
     static _state* state;
 };
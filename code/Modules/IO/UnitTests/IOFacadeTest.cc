@@ -69,6 +69,19 @@ TEST(IOFacadeTest) {
     CHECK(reader->Read(str));
     stream->Close();
     CHECK(str == msg->GetURL().Get());
+
+    // the same through a request handle
+    IO::RequestHandle handle = IO::StartLoadFile(url);
+    const IOProtocol::Request* req = IO::LookupRequest(handle);
+    CHECK(nullptr != req);
+    while (!req->Handled()) {
+        Core::PreRunLoop()->Run();
+    }
+    CHECK(numRequestsHandled == 2);
+    CHECK(req->GetStatus() == IOStatus::OK);
+    CHECK(req->GetStream().isValid());
+    IO::ReleaseRequest(handle);
+    CHECK(nullptr == IO::LookupRequest(handle));
     
     // FIXME: dynamically add/remove/replace filesystems, ...
     
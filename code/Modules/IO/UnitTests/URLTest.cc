@@ -97,4 +97,22 @@ TEST(URLTest) {
     CHECK(query["key1"] == "val1");
     CHECK(url3.Fragment() == "frag");
     CHECK(url3.PathToEnd() == "bla.txt?key0=val0&key1=val1#frag");
+    
+    // query with empty values, and an URL constructed from a StringAtom
+    URL url4(StringAtom("file:///bla/blub.txt?key0=&key1"));
+    CHECK(url4.IsValid());
+    CHECK(!url4.HasHost());
+    CHECK(url4.Path() == "bla/blub.txt");
+    query = url4.Query();
+    CHECK(query.Size() == 2);
+    CHECK(query["key0"].Empty());
+    CHECK(query["key1"].Empty());
+    
+    // copying doesn't parse again
+    URL url5 = url4;
+    CHECK(url5 == url4);
+    CHECK(url5.Path() == "bla/blub.txt");
+    URL url6 = std::move(url5);
+    CHECK(url6.Get() == url4.Get());
+    CHECK(!url5.IsValid());
 }
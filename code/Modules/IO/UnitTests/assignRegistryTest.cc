@@ -6,6 +6,7 @@
 #include "UnitTest++/src/UnitTest++.h"
 #include "IO/Core/assignRegistry.h"
 #include "Core/Ptr.h"
+#include <cstring>
 
 using namespace Oryol;
 using namespace Oryol::_priv;
@@ -32,4 +33,22 @@ TEST(assignRegistryTest) {
     reg.SetAssign("home:", "http://www.flohofwoe.net/");
     res = reg.ResolveAssigns("blub:");
     CHECK(res == "http://www.flohofwoe.net/blub/");
+    
+    // resolve into a buffer
+    char buf[64];
+    CHECK(InvalidIndex == reg.ResolveAssigns("http://www.bla.org/", buf, sizeof(buf)));
+    CHECK(InvalidIndex == reg.ResolveAssigns("c:/bla/", buf, sizeof(buf)));
+    CHECK(InvalidIndex == reg.ResolveAssigns("blob:bla.txt", buf, sizeof(buf)));
+    const int32 len = reg.ResolveAssigns("blub:bla.txt", buf, sizeof(buf));
+    CHECK(len == 37);
+    CHECK(std::strcmp(buf, "http://www.flohofwoe.net/blub/bla.txt") == 0);
+    CHECK(len == reg.ResolveAssigns("blub:bla.txt", buf, 10));
+    CHECK(reg.ResolveAssigns("blub:bla.txt") == "http://www.flohofwoe.net/blub/bla.txt");
+    CHECK(reg.ResolveAssigns("http://www.bla.org/") == "http://www.bla.org/");
+    
+    // circular assigns must not hang
+    reg.SetAssign("loop0:", "loop1:");
+    reg.SetAssign("loop1:", "loop0:");
+    res = reg.ResolveAssigns("loop0:bla");
+    CHECK(res.Back() == 'a');
 }
@@ -10,6 +10,11 @@
 
 namespace Oryol {
     
+namespace _priv {
+class inputRecorder;
+class replayInputMgr;
+}
+
 class Gamepad {
 public:
     /// constructor
@@ -67,6 +72,9 @@ public:
     void reset();
     
 private:
+    friend class _priv::inputRecorder;
+    friend class _priv::replayInputMgr;
+
     uint32 down;
     uint32 up;
     uint32 pressed;
@@ -6,6 +6,7 @@
     @brief configure the Input module
 */
 #include "Core/Types.h"
+#include "Core/String/String.h"
 
 namespace Oryol {
 
@@ -23,6 +24,10 @@ public:
     bool AccelerometerEnabled = true;
     /// gyrometer enabled
     bool GyrometerEnabled = true;
+    /// if set, record the per-frame input into this file
+    String RecordPath;
+    /// if set, replay a recorded input file instead of the platform input (works headless)
+    String ReplayPath;
 };
     
 } // namespace Oryol
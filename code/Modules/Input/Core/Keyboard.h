@@ -11,6 +11,11 @@
 
 namespace Oryol {
 
+namespace _priv {
+class inputRecorder;
+class replayInputMgr;
+}
+
 class Keyboard {
 public:
     /// constructor
@@ -50,6 +55,9 @@ public:
     void clearCapturedText();
 
 private:
+    friend class _priv::inputRecorder;
+    friend class _priv::replayInputMgr;
+
     std::bitset<Key::NumKeys> down;
     std::bitset<Key::NumKeys> up;
     std::bitset<Key::NumKeys> pressed;
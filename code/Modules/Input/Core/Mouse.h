@@ -10,6 +10,11 @@
 
 namespace Oryol {
     
+namespace _priv {
+class inputRecorder;
+class replayInputMgr;
+}
+
 class Mouse {
 public:
     /// constructor
@@ -50,6 +55,9 @@ public:
     void reset();
     
 private:
+    friend class _priv::inputRecorder;
+    friend class _priv::replayInputMgr;
+
     enum flags {
         btnDown = (1<<0),
         btnUp = (1<<1),
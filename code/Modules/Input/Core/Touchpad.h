@@ -10,6 +10,11 @@
 
 namespace Oryol {
     
+namespace _priv {
+class inputRecorder;
+class replayInputMgr;
+}
+
 class Touchpad {
 public:
     /// constructor
@@ -53,6 +58,9 @@ public:
     void reset();
 
 private:
+    friend class _priv::inputRecorder;
+    friend class _priv::replayInputMgr;
+
     static const int32 MaxNumTouches = 2;
     glm::vec2 pos[MaxNumTouches];
     glm::vec2 mov[MaxNumTouches];
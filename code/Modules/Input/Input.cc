@@ -14,14 +14,25 @@ void
 Input::Setup(const InputSetup& setup) {
     o_assert_dbg(!IsValid());
     state = Memory::New<_state>();
-    state->inputManager.setup(setup);
+    if (setup.ReplayPath.Empty()) {
+        state->inputManager.setup(setup);
+    }
+    else {
+        state->replaying = true;
+        state->replayManager.setup(setup);
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 Input::Discard() {
     o_assert_dbg(IsValid());
-    state->inputManager.discard();
+    if (state->replaying) {
+        state->replayManager.discard();
+    }
+    else {
+        state->inputManager.discard();
+    }
     Memory::Delete(state);
     state = nullptr;
 }
@@ -32,81 +43,111 @@ Input::IsValid() {
     return nullptr != state;
 }
 
+//------------------------------------------------------------------------------
+_priv::inputMgrBase&
+Input::inputManager() {
+    if (state->replaying) {
+        return state->replayManager;
+    }
+    else {
+        return state->inputManager;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+Input::IsReplaying() {
+    o_assert_dbg(IsValid());
+    return state->replaying;
+}
+
+//------------------------------------------------------------------------------
+bool
+Input::ReplayFinished() {
+    o_assert_dbg(IsValid());
+    return state->replaying && state->replayManager.isFinished();
+}
+
 //------------------------------------------------------------------------------
 void
 Input::AttachInputHandler(const Ptr<Port>& handler) {
     o_assert_dbg(IsValid());
-    state->inputManager.attachInputHandler(handler);
+    inputManager().attachInputHandler(handler);
 }
 
 //------------------------------------------------------------------------------
 void
 Input::DetachInputHandler(const Ptr<Port>& handler) {
     o_assert_dbg(IsValid());
-    state->inputManager.detachInputHandler(handler);
+    inputManager().detachInputHandler(handler);
 }
 
 //------------------------------------------------------------------------------
 void
 Input::SetCursorMode(CursorMode::Code mode) {
     o_assert_dbg(IsValid());
-    state->inputManager.setCursorMode(mode);
+    if (state->replaying) {
+        state->replayManager.setCursorMode(mode);
+    }
+    else {
+        state->inputManager.setCursorMode(mode);
+    }
 }
 
 //------------------------------------------------------------------------------
 CursorMode::Code
 Input::GetCursorMode() {
     o_assert_dbg(IsValid());
-    return state->inputManager.getCursorMode();
+    return inputManager().getCursorMode();
 }
 
 //------------------------------------------------------------------------------
 void
 Input::BeginCaptureText() {
     o_assert_dbg(IsValid());
-    state->inputManager.beginCaptureText();
+    inputManager().beginCaptureText();
 }
 
 //------------------------------------------------------------------------------
 void
 Input::EndCaptureText() {
     o_assert_dbg(IsValid());
-    return state->inputManager.endCaptureText();
+    return inputManager().endCaptureText();
 }
 
 //------------------------------------------------------------------------------
 const class Keyboard&
 Input::Keyboard() {
     o_assert_dbg(IsValid());
-    return state->inputManager.Keyboard();
+    return inputManager().Keyboard();
 }
 
 //------------------------------------------------------------------------------
 const class Mouse&
 Input::Mouse() {
     o_assert_dbg(IsValid());
-    return state->inputManager.Mouse();
+    return inputManager().Mouse();
 }
 
 //------------------------------------------------------------------------------
 const class Gamepad&
 Input::Gamepad(int32 index) {
     o_assert_dbg(IsValid());
-    return state->inputManager.Gamepad(index);
+    return inputManager().Gamepad(index);
 }
 
 //------------------------------------------------------------------------------
 const class Touchpad&
 Input::Touchpad() {
     o_assert_dbg(IsValid());
-    return state->inputManager.Touchpad();
+    return inputManager().Touchpad();
 }
 
 //------------------------------------------------------------------------------
 const class Sensors&
 Input::Sensors() {
     o_assert_dbg(IsValid());
-    return state->inputManager.Sensors();
+    return inputManager().Sensors();
 }
 
 } // namespace Input
@@ -11,8 +11,14 @@
     Provides access to connected input devices,
     like keyboard, mouse and game pads. On mobile platforms it also allows
     to query touch gestures.
+
+    The per-frame input can be recorded into a file (InputSetup::RecordPath)
+    and replayed frame by frame later (InputSetup::ReplayPath), replaying
+    doesn't need a window, so interactive workloads can be reproduced
+    exactly, for instance to compare frame times between builds.
 */
 #include "Input/Core/inputMgr.h"
+#include "Input/replay/replayInputMgr.h"
 
 namespace Oryol {
     
@@ -49,10 +55,20 @@ public:
     static void BeginCaptureText();
     /// end text capturing
     static void EndCaptureText();
+
+    /// return true if replaying an input recording
+    static bool IsReplaying();
+    /// return true if all frames of the input recording have been replayed
+    static bool ReplayFinished();
     
 private:
+    /// get the active input manager
+    static _priv::inputMgrBase& inputManager();
+
     struct _state {
         _priv::inputMgr inputManager;
+        _priv::replayInputMgr replayManager;
+        bool replaying = false;
     };
     static _state* state;
 };
@@ -28,12 +28,18 @@ inputMgrBase::setup(const InputSetup& setup) {
     this->valid = true;
     this->inputSetup = setup;
     this->cursorMode = CursorMode::Normal;
+    if (!setup.RecordPath.Empty()) {
+        this->recorder.start(setup.RecordPath.AsCStr());
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 inputMgrBase::discard() {
     o_assert_dbg(this->isValid());
+    if (this->recorder.isRecording()) {
+        this->recorder.stop();
+    }
     this->valid = false;
 }
 
@@ -62,6 +68,9 @@ inputMgrBase::detachInputHandler(const Ptr<Port>& handler) {
 //------------------------------------------------------------------------------
 void
 inputMgrBase::notifyHandlers(const Ptr<Message>& msg) {
+    if (this->recorder.isRecording()) {
+        this->recorder.recordMessage(msg);
+    }
     for (const auto& handler : this->handlers) {
         handler->Put(msg);
     }
@@ -70,6 +79,15 @@ inputMgrBase::notifyHandlers(const Ptr<Message>& msg) {
 //------------------------------------------------------------------------------
 void
 inputMgrBase::reset() {
+    if (this->recorder.isRecording()) {
+        this->recorder.recordFrame(*this);
+    }
+    this->resetDevices();
+}
+
+//------------------------------------------------------------------------------
+void
+inputMgrBase::resetDevices() {
     if (this->keyboard.Attached) {
         this->keyboard.reset();
     }
@@ -16,6 +16,7 @@
 #include "Input/touch/tapDetector.h"
 #include "Input/touch/panDetector.h"
 #include "Input/touch/pinchDetector.h"
+#include "Input/replay/inputRecorder.h"
 #include "Messaging/Port.h"
 
 namespace Oryol {
@@ -23,6 +24,9 @@ namespace _priv {
     
 class inputMgrBase {
 public:
+    /// max number of gamepads
+    static const int32 MaxNumGamepads = 4;
+
     /// constructor
     inputMgrBase();
     /// destructor
@@ -34,7 +38,7 @@ public:
     void discard();
     /// return true if the input manager has been setup
     bool isValid() const;
-    /// reset input devices (usually called by RunLoop at end of frame)
+    /// record the frame and reset input devices (usually called by RunLoop at end of frame)
     void reset();
     /// get the input setup object
     const InputSetup& getInputSetup() const;
@@ -71,8 +75,9 @@ public:
 protected:
     /// distribute input event to attached event handlers
     void notifyHandlers(const Ptr<Message>& msg);
+    /// reset the per-frame state of the input devices
+    void resetDevices();
 
-    static const int32 MaxNumGamepads = 4;
     bool valid;
     InputSetup inputSetup;
     class Keyboard keyboard;
@@ -86,6 +91,7 @@ protected:
     class pinchDetector pinchDetector;        
     CursorMode::Code cursorMode;
     Array<Ptr<Port>> handlers;
+    inputRecorder recorder;
 };
 
 //------------------------------------------------------------------------------
@@ -32,7 +32,7 @@ emscInputMgr::setup(const InputSetup& setup) {
     this->touchpad.Attached = true;
     this->sensors.Attached = true;
     this->setupCallbacks();
-    this->runLoopId = Core::PostRunLoop()->Add([this]() { this->reset(); });
+    this->runLoopId = Core::PostRunLoop()->Add("Input", [this]() { this->reset(); }, RunLoop::Affinity::AnyThread);
 }
 
 //------------------------------------------------------------------------------
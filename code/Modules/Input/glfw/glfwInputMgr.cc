@@ -48,7 +48,8 @@ glfwInputMgr::setup(const InputSetup& setup) {
     this->setCursorMode(CursorMode::Normal);
     
     // attach our reset callback to the global runloop
-    this->runLoopId = Core::PostRunLoop()->Add([this]() { this->reset(); });    
+    // reset() polls GLFW joysticks, so it must run on the main thread
+    this->runLoopId = Core::PostRunLoop()->Add("Input", [this]() { this->reset(); });    
 }
 
 //------------------------------------------------------------------------------
@@ -109,10 +110,12 @@ glfwInputMgr::setCursorMode(CursorMode::Code newMode) {
 //------------------------------------------------------------------------------
 void
 glfwInputMgr::reset() {
+    // poll joysticks after the frame has been recorded, the new
+    // attached state is seen by the next frame
+    inputMgrBase::reset();
     for (int32 i = 0; i < MaxNumGamepads; i++) {
         this->gamepads[i].Attached = glfwJoystickPresent(i) != 0;
     }
-    inputMgrBase::reset();
 }
     
 //------------------------------------------------------------------------------
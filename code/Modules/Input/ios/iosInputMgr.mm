@@ -104,7 +104,7 @@ iosInputMgr::setup(const InputSetup& setup) {
     [glkView setTouchDelegate:this->inputDelegate];
     
     // add reset callback to post-runloop
-    this->resetRunLoopId = Core::PostRunLoop()->Add([this]() { this->reset(); });
+    this->resetRunLoopId = Core::PostRunLoop()->Add("Input", [this]() { this->reset(); }, RunLoop::Affinity::AnyThread);
 }
 
 //------------------------------------------------------------------------------
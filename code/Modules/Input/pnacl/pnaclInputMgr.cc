@@ -34,7 +34,7 @@ pnaclInputMgr::setup(const InputSetup& setup) {
     pnaclInstance::Instance()->enableInput([this] (const pp::InputEvent& e) {
         return this->handleEvent(e);
     });
-    this->runLoopId = Core::PostRunLoop()->Add([this]() { this->reset(); });
+    this->runLoopId = Core::PostRunLoop()->Add("Input", [this]() { this->reset(); }, RunLoop::Affinity::AnyThread);
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+//  inputRecorder.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "inputRecorder.h"
+#include "Input/base/inputMgrBase.h"
+#include "Input/InputProtocol.h"
+#include "Core/Assertion.h"
+#include "Core/Log.h"
+#include <cstring>
+
+namespace Oryol {
+namespace _priv {
+
+static_assert(Key::NumKeys <= 256, "inputRecorder: key codes must fit into a byte!");
+static_assert(inputRecorder::NumTags <= 256, "inputRecorder: tags must fit into a byte!");
+
+//------------------------------------------------------------------------------
+inputRecorder::inputRecorder() :
+fp(nullptr),
+frameCount(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inputRecorder::~inputRecorder() {
+    o_assert_dbg(!this->isRecording());
+}
+
+//------------------------------------------------------------------------------
+bool
+inputRecorder::start(const char* path) {
+    o_assert_dbg(path);
+    o_assert_dbg(!this->isRecording());
+    static_assert(NumStateBlocks == inputMgrBase::MaxNumGamepads + 4, "inputRecorder: NumStateBlocks mismatch!");
+
+    this->fp = std::fopen(path, "wb");
+    if (nullptr == this->fp) {
+        o_warn("inputRecorder: failed to open '%s'\n", path);
+        return false;
+    }
+    const uint32 header[3] = { Magic, Version, 0 };
+    std::fwrite(header, sizeof(header), 1, this->fp);
+    this->frameCount = 0;
+    this->frame.Clear();
+    for (auto& state : this->prevState) {
+        state.Clear();
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+inputRecorder::stop() {
+    o_assert_dbg(this->isRecording());
+
+    // patch the number of frames into the header
+    const uint32 num = uint32(this->frameCount);
+    std::fseek(this->fp, 2 * sizeof(uint32), SEEK_SET);
+    std::fwrite(&num, sizeof(num), 1, this->fp);
+    std::fclose(this->fp);
+    this->fp = nullptr;
+    Log::Info("inputRecorder: recorded %d frames\n", this->frameCount);
+}
+
+//------------------------------------------------------------------------------
+void
+inputRecorder::recordMessage(const Ptr<Message>& msg) {
+    o_assert_dbg(this->isRecording());
+    if (!msg->IsMemberOf(InputProtocol::GetProtocolId())) {
+        return;
+    }
+    switch (msg->MessageId()) {
+        case InputProtocol::MessageId::MouseMoveId:
+            {
+                Ptr<InputProtocol::MouseMove> m(msg);
+                put<uint8>(this->frame, MouseMoveEvent);
+                put(this->frame, m->GetMovement().x);
+                put(this->frame, m->GetMovement().y);
+                put(this->frame, m->GetPosition().x);
+                put(this->frame, m->GetPosition().y);
+            }
+            break;
+        case InputProtocol::MessageId::MouseButtonId:
+            {
+                Ptr<InputProtocol::MouseButton> m(msg);
+                put<uint8>(this->frame, MouseButtonEvent);
+                put<uint8>(this->frame, m->GetMouseButton());
+                put<uint8>(this->frame, (m->GetDown() ? Down : 0) | (m->GetUp() ? Up : 0));
+            }
+            break;
+        case InputProtocol::MessageId::MouseScrollId:
+            {
+                Ptr<InputProtocol::MouseScroll> m(msg);
+                put<uint8>(this->frame, MouseScrollEvent);
+                put(this->frame, m->GetScroll().x);
+                put(this->frame, m->GetScroll().y);
+            }
+            break;
+        case InputProtocol::MessageId::KeyId:
+            {
+                Ptr<InputProtocol::Key> m(msg);
+                put<uint8>(this->frame, KeyEvent);
+                put<uint8>(this->frame, m->GetKey());
+                put<uint8>(this->frame, (m->GetDown() ? Down : 0) | (m->GetUp() ? Up : 0) | (m->GetRepeat() ? Repeat : 0));
+            }
+            break;
+        case InputProtocol::MessageId::WCharId:
+            {
+                Ptr<InputProtocol::WChar> m(msg);
+                put<uint8>(this->frame, WCharEvent);
+                put<uint32>(this->frame, m->GetWChar());
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+inputRecorder::encodeState(const inputMgrBase& mgr, int32 block) {
+    Array<uint8>& dst = this->curState;
+    dst.Clear();
+    if (0 == block) {
+        const Keyboard& kbd = mgr.Keyboard();
+        put<uint8>(dst, KeyboardState);
+        put<uint8>(dst, kbd.Attached);
+        int32 numKeys = 0;
+        for (int32 key = 0; key < Key::NumKeys; key++) {
+            if (kbd.down[key] || kbd.up[key] || kbd.pressed[key] || kbd.repeat[key]) {
+                numKeys++;
+            }
+        }
+        put<uint8>(dst, numKeys);
+        for (int32 key = 0; key < Key::NumKeys; key++) {
+            const uint8 f = (kbd.down[key] ? Down : 0) | (kbd.up[key] ? Up : 0) |
+                            (kbd.pressed[key] ? Pressed : 0) | (kbd.repeat[key] ? Repeat : 0);
+            if (0 != f) {
+                put<uint8>(dst, key);
+                put<uint8>(dst, f);
+            }
+        }
+        put<uint8>(dst, kbd.charIndex);
+        for (int32 i = 0; i < kbd.charIndex; i++) {
+            put<uint32>(dst, kbd.chars[i]);
+        }
+    }
+    else if (1 == block) {
+        const Mouse& mouse = mgr.Mouse();
+        put<uint8>(dst, MouseState);
+        put<uint8>(dst, mouse.Attached);
+        for (int32 i = 0; i < Mouse::NumButtons; i++) {
+            put<uint8>(dst, mouse.buttonState[i]);
+        }
+        put(dst, mouse.Position.x);
+        put(dst, mouse.Position.y);
+        put(dst, mouse.Movement.x);
+        put(dst, mouse.Movement.y);
+        put(dst, mouse.Scroll.x);
+        put(dst, mouse.Scroll.y);
+    }
+    else if (block < 2 + inputMgrBase::MaxNumGamepads) {
+        const int32 index = block - 2;
+        const Gamepad& pad = mgr.Gamepad(index);
+        put<uint8>(dst, GamepadState);
+        put<uint8>(dst, index);
+        put<uint8>(dst, pad.Attached);
+        put(dst, pad.down);
+        put(dst, pad.up);
+        put(dst, pad.pressed);
+        for (const auto& val : pad.values) {
+            put(dst, val.x);
+            put(dst, val.y);
+        }
+    }
+    else if (6 == block) {
+        const Touchpad& touch = mgr.Touchpad();
+        put<uint8>(dst, TouchpadState);
+        put<uint8>(dst, touch.Attached);
+        put<uint8>(dst, (touch.Tapped ? (1<<0) : 0) |
+                        (touch.DoubleTapped ? (1<<1) : 0) |
+                        (touch.PanningStarted ? (1<<2) : 0) |
+                        (touch.Panning ? (1<<3) : 0) |
+                        (touch.PanningEnded ? (1<<4) : 0) |
+                        (touch.PinchingStarted ? (1<<5) : 0) |
+                        (touch.Pinching ? (1<<6) : 0) |
+                        (touch.PinchingEnded ? (1<<7) : 0));
+        for (int32 i = 0; i < Touchpad::MaxNumTouches; i++) {
+            put(dst, touch.pos[i].x);
+            put(dst, touch.pos[i].y);
+            put(dst, touch.mov[i].x);
+            put(dst, touch.mov[i].y);
+            put(dst, touch.startPos[i].x);
+            put(dst, touch.startPos[i].y);
+        }
+    }
+    else {
+        const Sensors& sensors = mgr.Sensors();
+        put<uint8>(dst, SensorsState);
+        put<uint8>(dst, sensors.Attached);
+        put(dst, sensors.Acceleration.x);
+        put(dst, sensors.Acceleration.y);
+        put(dst, sensors.Acceleration.z);
+        put(dst, sensors.Yaw);
+        put(dst, sensors.Pitch);
+        put(dst, sensors.Roll);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+inputRecorder::recordFrame(const inputMgrBase& mgr) {
+    o_assert_dbg(this->isRecording());
+
+    // only write the devices which have changed since the last frame
+    for (int32 block = 0; block < NumStateBlocks; block++) {
+        this->encodeState(mgr, block);
+        Array<uint8>& prev = this->prevState[block];
+        if ((prev.Size() != this->curState.Size()) ||
+            (0 != std::memcmp(prev.begin(), this->curState.begin(), this->curState.Size()))) {
+            for (uint8 b : this->curState) {
+                this->frame.Add(b);
+            }
+            prev = this->curState;
+        }
+    }
+    put<uint8>(this->frame, EndFrame);
+    std::fwrite(this->frame.begin(), this->frame.Size(), 1, this->fp);
+    this->frame.Clear();
+    this->frameCount++;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,124 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::inputRecorder
+    @ingroup _priv
+    @brief record per-frame input state and events into a binary file
+
+    The recorder is owned by inputMgrBase and started when
+    InputSetup::RecordPath is set. Input events are recorded as they are
+    sent to the input handlers, and the state of the input devices is
+    recorded at the end of each frame (right before the devices are
+    reset), so a replayInputMgr can feed back exactly what the
+    application saw in each frame.
+
+    File layout (native byte order):
+
+        uint32 Magic, uint32 Version, uint32 numFrames
+        frames: a sequence of tagged records, ended by an EndFrame tag
+
+    The events of a frame come first, in the order they were sent,
+    followed by the state of each device whose state has changed since
+    the previous frame. A frame without input is a single byte.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Messaging/Message.h"
+#include <cstdio>
+
+namespace Oryol {
+namespace _priv {
+
+class inputMgrBase;
+
+class inputRecorder {
+public:
+    /// file magic number
+    static const uint32 Magic = 'OIRC';
+    /// file format version
+    static const uint32 Version = 1;
+    /// byte size of the file header
+    static const int32 HeaderSize = 3 * sizeof(uint32);
+
+    /// record tags
+    enum tag : uint8 {
+        EndFrame = 0,
+        KeyboardState,
+        MouseState,
+        GamepadState,
+        TouchpadState,
+        SensorsState,
+        MouseMoveEvent,
+        MouseButtonEvent,
+        MouseScrollEvent,
+        KeyEvent,
+        WCharEvent,
+
+        NumTags,
+    };
+    /// key and button state flags
+    enum flags : uint8 {
+        Down = (1<<0),
+        Up = (1<<1),
+        Pressed = (1<<2),
+        Repeat = (1<<3),
+    };
+
+    /// constructor
+    inputRecorder();
+    /// destructor
+    ~inputRecorder();
+
+    /// open the recording file, return false on failure
+    bool start(const char* path);
+    /// finish the recording file
+    void stop();
+    /// return true if recording
+    bool isRecording() const;
+
+    /// record an input event
+    void recordMessage(const Ptr<Message>& msg);
+    /// record the device state at the end of a frame
+    void recordFrame(const inputMgrBase& mgr);
+    /// get number of recorded frames
+    int32 numFrames() const;
+
+private:
+    /// encode a device's state into curState
+    void encodeState(const inputMgrBase& mgr, int32 block);
+    /// append a value to a byte array
+    template<class TYPE> static void put(Array<uint8>& dst, const TYPE& val);
+
+    /// keyboard, mouse, 4 gamepads, touchpad, sensors
+    static const int32 NumStateBlocks = 8;
+
+    FILE* fp;
+    int32 frameCount;
+    Array<uint8> frame;
+    Array<uint8> curState;
+    Array<uint8> prevState[NumStateBlocks];
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE> inline void
+inputRecorder::put(Array<uint8>& dst, const TYPE& val) {
+    const uint8* src = (const uint8*) &val;
+    for (int32 i = 0; i < int32(sizeof(TYPE)); i++) {
+        dst.Add(src[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline bool
+inputRecorder::isRecording() const {
+    return nullptr != this->fp;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+inputRecorder::numFrames() const {
+    return this->frameCount;
+}
+
+} // namespace _priv
+} // namespace Oryol
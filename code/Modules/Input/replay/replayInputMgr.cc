@@ -0,0 +1,296 @@
+//------------------------------------------------------------------------------
+//  replayInputMgr.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "replayInputMgr.h"
+#include "Core/Core.h"
+#include "Core/Log.h"
+#include "Core/Memory/Memory.h"
+#include "Input/InputProtocol.h"
+#include <cstdio>
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+replayInputMgr::replayInputMgr() :
+data(nullptr),
+size(0),
+pos(0),
+frameCount(0),
+curFrame(0),
+preRunLoopId(RunLoop::InvalidId),
+postRunLoopId(RunLoop::InvalidId) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+replayInputMgr::~replayInputMgr() {
+    o_assert_dbg(nullptr == this->data);
+}
+
+//------------------------------------------------------------------------------
+void
+replayInputMgr::setup(const InputSetup& setup) {
+    o_assert_dbg(!setup.ReplayPath.Empty());
+
+    inputMgrBase::setup(setup);
+    if (!this->load(setup.ReplayPath.AsCStr())) {
+        o_warn("replayInputMgr: failed to load input recording '%s'\n", setup.ReplayPath.AsCStr());
+    }
+
+    // feed the next frame before the app's frame callback, and record
+    // the frame at the end, so that a replay can be recorded again
+    this->preRunLoopId = Core::PreRunLoop()->Add("Input", [this]() { this->replayFrame(); });
+    this->postRunLoopId = Core::PostRunLoop()->Add("Input", [this]() {
+        if (this->recorder.isRecording()) {
+            this->recorder.recordFrame(*this);
+        }
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+replayInputMgr::discard() {
+    Core::PreRunLoop()->Remove(this->preRunLoopId);
+    Core::PostRunLoop()->Remove(this->postRunLoopId);
+    this->preRunLoopId = RunLoop::InvalidId;
+    this->postRunLoopId = RunLoop::InvalidId;
+    if (this->data) {
+        Memory::Free(this->data);
+        this->data = nullptr;
+    }
+    this->size = 0;
+    this->pos = 0;
+    this->frameCount = 0;
+    this->curFrame = 0;
+    inputMgrBase::discard();
+}
+
+//------------------------------------------------------------------------------
+bool
+replayInputMgr::load(const char* path) {
+    o_assert_dbg(nullptr == this->data);
+
+    FILE* fp = std::fopen(path, "rb");
+    if (nullptr == fp) {
+        return false;
+    }
+    std::fseek(fp, 0, SEEK_END);
+    const int32 fileSize = int32(std::ftell(fp));
+    std::fseek(fp, 0, SEEK_SET);
+    if (fileSize < inputRecorder::HeaderSize) {
+        std::fclose(fp);
+        return false;
+    }
+    this->data = (uint8*) Memory::Alloc(fileSize);
+    this->size = fileSize;
+    const bool success = 1 == std::fread(this->data, fileSize, 1, fp);
+    std::fclose(fp);
+
+    if (success && (inputRecorder::Magic == this->get<uint32>()) && (inputRecorder::Version == this->get<uint32>())) {
+        this->frameCount = int32(this->get<uint32>());
+        Log::Info("replayInputMgr: replaying %d frames from '%s'\n", this->frameCount, path);
+        return true;
+    }
+    Memory::Free(this->data);
+    this->data = nullptr;
+    this->size = 0;
+    this->pos = 0;
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+replayInputMgr::replayFrame() {
+    if (this->isFinished()) {
+        // no more input, but clear the per-frame state of the last frame
+        this->resetDevices();
+        return;
+    }
+    for (uint8 tag = this->get<uint8>(); inputRecorder::EndFrame != tag; tag = this->get<uint8>()) {
+        if (tag < inputRecorder::MouseMoveEvent) {
+            this->decodeState(tag);
+        }
+        else {
+            this->decodeEvent(tag);
+        }
+    }
+    this->curFrame++;
+}
+
+//------------------------------------------------------------------------------
+void
+replayInputMgr::decodeState(uint8 tag) {
+    switch (tag) {
+        case inputRecorder::KeyboardState:
+            {
+                class Keyboard& kbd = this->keyboard;
+                kbd.Attached = 0 != this->get<uint8>();
+                kbd.down.reset();
+                kbd.up.reset();
+                kbd.pressed.reset();
+                kbd.repeat.reset();
+                const int32 numKeys = this->get<uint8>();
+                for (int32 i = 0; i < numKeys; i++) {
+                    const int32 key = this->get<uint8>();
+                    const uint8 f = this->get<uint8>();
+                    o_assert2(key < Key::NumKeys, "replayInputMgr: invalid key code!\n");
+                    kbd.down[key] = 0 != (f & inputRecorder::Down);
+                    kbd.up[key] = 0 != (f & inputRecorder::Up);
+                    kbd.pressed[key] = 0 != (f & inputRecorder::Pressed);
+                    kbd.repeat[key] = 0 != (f & inputRecorder::Repeat);
+                }
+                const int32 numChars = this->get<uint8>();
+                o_assert2(numChars <= Keyboard::MaxNumChars, "replayInputMgr: too many characters!\n");
+                for (int32 i = 0; i < numChars; i++) {
+                    kbd.chars[i] = wchar_t(this->get<uint32>());
+                }
+                kbd.chars[numChars] = 0;
+                kbd.charIndex = numChars;
+            }
+            break;
+
+        case inputRecorder::MouseState:
+            {
+                class Mouse& mouse = this->mouse;
+                mouse.Attached = 0 != this->get<uint8>();
+                for (int32 i = 0; i < Mouse::NumButtons; i++) {
+                    mouse.buttonState[i] = this->get<uint8>();
+                }
+                mouse.Position.x = this->get<float32>();
+                mouse.Position.y = this->get<float32>();
+                mouse.Movement.x = this->get<float32>();
+                mouse.Movement.y = this->get<float32>();
+                mouse.Scroll.x = this->get<float32>();
+                mouse.Scroll.y = this->get<float32>();
+            }
+            break;
+
+        case inputRecorder::GamepadState:
+            {
+                const int32 index = this->get<uint8>();
+                o_assert2(index < MaxNumGamepads, "replayInputMgr: invalid gamepad index!\n");
+                class Gamepad& pad = this->gamepads[index];
+                pad.Attached = 0 != this->get<uint8>();
+                pad.down = this->get<uint32>();
+                pad.up = this->get<uint32>();
+                pad.pressed = this->get<uint32>();
+                for (auto& val : pad.values) {
+                    val.x = this->get<float32>();
+                    val.y = this->get<float32>();
+                }
+            }
+            break;
+
+        case inputRecorder::TouchpadState:
+            {
+                class Touchpad& touch = this->touchpad;
+                touch.Attached = 0 != this->get<uint8>();
+                const uint8 f = this->get<uint8>();
+                touch.Tapped = 0 != (f & (1<<0));
+                touch.DoubleTapped = 0 != (f & (1<<1));
+                touch.PanningStarted = 0 != (f & (1<<2));
+                touch.Panning = 0 != (f & (1<<3));
+                touch.PanningEnded = 0 != (f & (1<<4));
+                touch.PinchingStarted = 0 != (f & (1<<5));
+                touch.Pinching = 0 != (f & (1<<6));
+                touch.PinchingEnded = 0 != (f & (1<<7));
+                for (int32 i = 0; i < Touchpad::MaxNumTouches; i++) {
+                    touch.pos[i].x = this->get<float32>();
+                    touch.pos[i].y = this->get<float32>();
+                    touch.mov[i].x = this->get<float32>();
+                    touch.mov[i].y = this->get<float32>();
+                    touch.startPos[i].x = this->get<float32>();
+                    touch.startPos[i].y = this->get<float32>();
+                }
+            }
+            break;
+
+        case inputRecorder::SensorsState:
+            {
+                class Sensors& sensors = this->sensors;
+                sensors.Attached = 0 != this->get<uint8>();
+                sensors.Acceleration.x = this->get<float32>();
+                sensors.Acceleration.y = this->get<float32>();
+                sensors.Acceleration.z = this->get<float32>();
+                sensors.Yaw = this->get<float32>();
+                sensors.Pitch = this->get<float32>();
+                sensors.Roll = this->get<float32>();
+            }
+            break;
+
+        default:
+            o_error("replayInputMgr: invalid record tag '%d'!\n", tag);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+replayInputMgr::decodeEvent(uint8 tag) {
+    switch (tag) {
+        case inputRecorder::MouseMoveEvent:
+            {
+                auto msg = InputProtocol::MouseMove::Create();
+                glm::vec2 mov, pos;
+                mov.x = this->get<float32>();
+                mov.y = this->get<float32>();
+                pos.x = this->get<float32>();
+                pos.y = this->get<float32>();
+                msg->SetMovement(mov);
+                msg->SetPosition(pos);
+                this->notifyHandlers(msg);
+            }
+            break;
+
+        case inputRecorder::MouseButtonEvent:
+            {
+                auto msg = InputProtocol::MouseButton::Create();
+                msg->SetMouseButton((Mouse::Button) this->get<uint8>());
+                const uint8 f = this->get<uint8>();
+                msg->SetDown(0 != (f & inputRecorder::Down));
+                msg->SetUp(0 != (f & inputRecorder::Up));
+                this->notifyHandlers(msg);
+            }
+            break;
+
+        case inputRecorder::MouseScrollEvent:
+            {
+                auto msg = InputProtocol::MouseScroll::Create();
+                glm::vec2 scroll;
+                scroll.x = this->get<float32>();
+                scroll.y = this->get<float32>();
+                msg->SetScroll(scroll);
+                this->notifyHandlers(msg);
+            }
+            break;
+
+        case inputRecorder::KeyEvent:
+            {
+                auto msg = InputProtocol::Key::Create();
+                msg->SetKey((Key::Code) this->get<uint8>());
+                const uint8 f = this->get<uint8>();
+                msg->SetDown(0 != (f & inputRecorder::Down));
+                msg->SetUp(0 != (f & inputRecorder::Up));
+                msg->SetRepeat(0 != (f & inputRecorder::Repeat));
+                this->notifyHandlers(msg);
+            }
+            break;
+
+        case inputRecorder::WCharEvent:
+            {
+                auto msg = InputProtocol::WChar::Create();
+                msg->SetWChar(wchar_t(this->get<uint32>()));
+                this->notifyHandlers(msg);
+            }
+            break;
+
+        default:
+            o_error("replayInputMgr: invalid record tag '%d'!\n", tag);
+            break;
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,94 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::replayInputMgr
+    @ingroup _priv
+    @brief input manager which replays an input recording
+
+    Used instead of the platform's input manager when
+    InputSetup::ReplayPath is set. The recording (see inputRecorder)
+    is loaded at setup, and at the start of each frame the next
+    recorded frame is fed back: the recorded events are sent to the
+    input handlers, and the devices get the state they had in the
+    recorded frame. The replay manager doesn't need a window or the
+    Gfx module, so recordings can be replayed headless. When all
+    frames have been replayed, the devices stay attached but
+    don't report any new input.
+*/
+#include "Input/base/inputMgrBase.h"
+#include "Core/RunLoop.h"
+#include <cstring>
+
+namespace Oryol {
+namespace _priv {
+
+class replayInputMgr : public inputMgrBase {
+public:
+    /// constructor
+    replayInputMgr();
+    /// destructor
+    ~replayInputMgr();
+
+    /// setup the replay input manager
+    void setup(const InputSetup& setup);
+    /// discard the replay input manager
+    void discard();
+
+    /// get number of frames in the recording
+    int32 numFrames() const;
+    /// get number of replayed frames
+    int32 numReplayedFrames() const;
+    /// return true when all frames have been replayed
+    bool isFinished() const;
+
+private:
+    /// load the recording file, return false on failure
+    bool load(const char* path);
+    /// feed back the next recorded frame
+    void replayFrame();
+    /// decode a device state record
+    void decodeState(uint8 tag);
+    /// decode an event record and send it to the input handlers
+    void decodeEvent(uint8 tag);
+    /// read a value from the recording
+    template<class TYPE> TYPE get();
+
+    uint8* data;
+    int32 size;
+    int32 pos;
+    int32 frameCount;
+    int32 curFrame;
+    RunLoop::Id preRunLoopId;
+    RunLoop::Id postRunLoopId;
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE> inline TYPE
+replayInputMgr::get() {
+    o_assert2((this->pos + int32(sizeof(TYPE))) <= this->size, "replayInputMgr: truncated input recording!\n");
+    TYPE val;
+    std::memcpy(&val, this->data + this->pos, sizeof(TYPE));
+    this->pos += sizeof(TYPE);
+    return val;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+replayInputMgr::numFrames() const {
+    return this->frameCount;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+replayInputMgr::numReplayedFrames() const {
+    return this->curFrame;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+replayInputMgr::isFinished() const {
+    return this->curFrame >= this->frameCount;
+}
+
+} // namespace _priv
+} // namespace Oryol
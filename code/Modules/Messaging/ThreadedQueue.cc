@@ -4,6 +4,7 @@
 #include "Pre.h"
 #include "ThreadedQueue.h"
 #include "Core/Core.h"
+#include "Core/Trace.h"
 
 namespace Oryol {
     
@@ -120,8 +121,10 @@ ThreadedQueue::DoWork() {
         // FIXME: we could do without all those queue transfers here!
         this->moveTransferToReadQueue();
         while (!this->readQueue.Empty()) {
+            o_trace_scoped(ThreadedQueue_Message);
             this->onMessage(std::move(this->readQueue.Dequeue()));
         }
+        o_trace_scoped(ThreadedQueue_Tick);
         this->onTick();
     #endif
 }
@@ -211,8 +214,10 @@ ThreadedQueue::threadFunc(ThreadedQueue* self) {
         
         // now process the messages, this happens without locking
         while (!self->readQueue.Empty()) {
+            o_trace_scoped(ThreadedQueue_Message);
             self->onMessage(std::move(self->readQueue.Dequeue()));
         }
+        o_trace_scoped(ThreadedQueue_Tick);
         self->onTick();
     }
     
@@ -229,6 +234,9 @@ ThreadedQueue::threadFunc(ThreadedQueue* self) {
 void
 ThreadedQueue::onThreadEnter() {
     Core::EnterThread();
+    #if ORYOL_HAS_THREADS
+    Profiler::SetThreadName("ThreadedQueue");
+    #endif
 }
 
 //------------------------------------------------------------------------------
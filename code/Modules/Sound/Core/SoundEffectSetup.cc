@@ -19,4 +19,17 @@ SoundEffectSetup::FromSampleFunc(int numVoices, float32 dur, int32 freq, SampleF
     return setup;
 }
 
+//------------------------------------------------------------------------------
+SoundEffectSetup
+SoundEffectSetup::FromSampleRangeFunc(int numVoices, float32 dur, int32 freq, SampleRangeFuncT sampleRangeFunc) {
+    o_assert_dbg(dur > 0.0f);
+    o_assert_dbg(freq > 0);
+    SoundEffectSetup setup;
+    setup.Duration = dur;
+    setup.BufferFrequency = freq;
+    setup.SampleRangeFunc = sampleRangeFunc;
+    setup.NumVoices = numVoices;
+    return setup;
+}
+
 } // namespace Oryol
\ No newline at end of file
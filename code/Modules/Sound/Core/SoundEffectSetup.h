@@ -18,9 +18,19 @@ public:
     /// @param ptr  sample pointer
     /// @param num  number of samples
     typedef std::function<void(float32 dt, int16* sampleBuffer, int32 numSamples)> SampleFuncT;
+    /// optional callback function to setup a range of sound effect samples,
+    /// may be called in parallel for different ranges (prefer this over
+    /// SampleFunc for long effects created with Sound::CreateResourceAsync())
+    /// @param dt           time from one sample to next in seconds
+    /// @param ptr          pointer to first sample of the range
+    /// @param firstSample  index of first sample of the range
+    /// @param num          number of samples in the range
+    typedef std::function<void(float32 dt, int16* sampleBuffer, int32 firstSample, int32 numSamples)> SampleRangeFuncT;
 
     /// create with number of samples and SampleFunc
     static SoundEffectSetup FromSampleFunc(int32 numVoices, float32 duration, int32 bufferFreq, SampleFuncT sampleFunc);
+    /// create with number of samples and SampleRangeFunc
+    static SoundEffectSetup FromSampleRangeFunc(int32 numVoices, float32 duration, int32 bufferFreq, SampleRangeFuncT sampleRangeFunc);
 
     /// resource locator
     class Locator Locator = Locator::NonShared();
@@ -30,10 +40,14 @@ public:
     float32 Duration;
     /// optional callback function to setup sample buffer
     SampleFuncT SampleFunc;
+    /// optional callback function to setup sample buffer in independent chunks (overrides SampleFunc)
+    SampleRangeFuncT SampleRangeFunc;
     /// max number of parallel voices for this sound effect
     static const int32 MaxNumVoices = 16;
     /// number of parallel voices this sound can play
     int32 NumVoices = MaxNumVoices;
+    /// voices of effects with higher priority are mixed first, and steal voices from lower priorities
+    int32 Priority = 0;
 };
 
 } // namespace Oryol
\ No newline at end of file
@@ -17,6 +17,20 @@ public:
     int32 ResourceLabelStackCapacity = 256;
     /// initial resource registry capacity
     int32 ResourceRegistryCapacity = 256;
+    /// max number of sound effect voices playing at the same time (mixed or virtual)
+    int32 MaxNumVoices = 64;
+    /// max number of voices actually mixed, the weaker voices are virtual
+    int32 MaxNumMixedVoices = 24;
+    /// sample rate of the mixed output
+    int32 SampleRate = 44100;
+    /// mix on a separate audio thread (if the platform has threads)
+    bool UseAudioThread = true;
+    /// number of output buffers queued on the audio device
+    int32 NumStreamBuffers = 4;
+    /// number of samples per output buffer
+    int32 StreamBufferNumSamples = 512;
+    /// don't open an audio device, mix sound effects with Sound::RenderOffline()
+    bool Offline = false;
 };
 
 } // namespace Oryol
\ No newline at end of file
@@ -10,7 +10,9 @@ namespace _priv {
 //------------------------------------------------------------------------------
 void
 soundEffectBase::Clear() {
-    // FIXME
+    // the samples are freed by the factory
+    this->samples = nullptr;
+    this->numSamples = 0;
     resourceBase::Clear();
 }
 
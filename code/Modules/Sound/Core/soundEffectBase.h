@@ -15,6 +15,11 @@ class soundEffectBase : public resourceBase<SoundEffectSetup> {
 public:
     /// clear the object
     void Clear();
+
+    /// the samples in CPU memory, played by the soundMixer
+    int16* samples = nullptr;
+    /// number of samples
+    int32 numSamples = 0;
 };
 
 } // namespace _priv
@@ -3,6 +3,7 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "soundEffectFactoryBase.h"
+#include "Core/Memory/Memory.h"
 
 namespace Oryol {
 namespace _priv {
@@ -39,9 +40,18 @@ soundEffectFactoryBase::isValid() const {
 }
 
 //------------------------------------------------------------------------------
+/**
+ The samples are kept in CPU memory for the software mixer.
+*/
 ResourceState::Code
-soundEffectFactoryBase::setupResource(soundEffect& /*effect*/) {
-    return ResourceState::Valid;
+soundEffectFactoryBase::setupResource(soundEffect& effect) {
+    o_assert_dbg(this->isValid());
+    o_assert_dbg(nullptr == effect.samples);
+
+    const int32 num = numSamples(effect.Setup);
+    int16* samples = (int16*) Memory::Alloc(num * sizeof(int16));
+    generateSamples(effect.Setup, samples, 0, num);
+    return this->setupWithSamples(effect, samples, num);
 }
 
 //------------------------------------------------------------------------------
@@ -50,11 +60,56 @@ soundEffectFactoryBase::setupResource(soundEffect& /*effect*/, const void* /*dat
     return ResourceState::Valid;
 }
 
+//------------------------------------------------------------------------------
+ResourceState::Code
+soundEffectFactoryBase::setupWithSamples(soundEffect& effect, int16* samples, int32 numSamples) {
+    o_assert_dbg(this->isValid());
+    o_assert_dbg(nullptr == effect.samples);
+    o_assert_dbg(nullptr != samples);
+    effect.samples = samples;
+    effect.numSamples = numSamples;
+    return ResourceState::Valid;
+}
+
 //------------------------------------------------------------------------------
 void
 soundEffectFactoryBase::destroyResource(soundEffect& effect) {
+    if (effect.samples) {
+        Memory::Free(effect.samples);
+    }
     effect.Clear();
 }
 
+//------------------------------------------------------------------------------
+int32
+soundEffectFactoryBase::numSamples(const SoundEffectSetup& setup) {
+    const int32 num = int32(setup.Duration * setup.BufferFrequency);
+    o_assert_dbg(num > 0);
+    return num;
+}
+
+//------------------------------------------------------------------------------
+/**
+ A SampleRangeFunc can generate any range of samples, a SampleFunc
+ keeps state from one sample to the next and can only generate
+ the whole buffer at once. Without callback the buffer is cleared
+ to silence.
+*/
+void
+soundEffectFactoryBase::generateSamples(const SoundEffectSetup& setup, int16* samples, int32 firstSample, int32 num) {
+    o_assert_dbg(nullptr != samples);
+    const float32 dt = 1.0f / setup.BufferFrequency;
+    if (setup.SampleRangeFunc) {
+        setup.SampleRangeFunc(dt, samples + firstSample, firstSample, num);
+    }
+    else if (setup.SampleFunc) {
+        o_assert_dbg((0 == firstSample) && (numSamples(setup) == num));
+        setup.SampleFunc(dt, samples, num);
+    }
+    else {
+        Memory::Clear(samples + firstSample, num * sizeof(int16));
+    }
+}
+
 } // namespace _priv
 } // namespace Oryol
\ No newline at end of file
@@ -30,9 +30,16 @@ public:
     ResourceState::Code setupResource(soundEffect& effect);
     /// setup with 'raw' data
     ResourceState::Code setupResource(soundEffect& effect, const void* data, int32 size);
+    /// setup with samples generated by generateSamples(), takes ownership of samples
+    ResourceState::Code setupWithSamples(soundEffect& effect, int16* samples, int32 numSamples);
     /// destroy a resource
     void destroyResource(soundEffect& effect);
 
+    /// get number of samples of a sound effect
+    static int32 numSamples(const SoundEffectSetup& setup);
+    /// generate a range of samples with the setup's sample callback (thread-safe)
+    static void generateSamples(const SoundEffectSetup& setup, int16* samples, int32 firstSample, int32 numSamples);
+
 protected:
     bool valid;
 };
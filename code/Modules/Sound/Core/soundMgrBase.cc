@@ -3,7 +3,10 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "soundMgrBase.h"
-#include "Sound/Core/soundEffectPool.h"
+#include "Sound/Core/soundEffect.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
 
 namespace Oryol {
 namespace _priv {
@@ -11,33 +14,45 @@ namespace _priv {
 //------------------------------------------------------------------------------
 soundMgrBase::soundMgrBase() :
 valid(false),
-effectPool(nullptr) {
+offline(false),
+useThread(false),
+voiceIdCounter(soundMixer::InvalidVoiceId),
+appliedVoiceId(soundMixer::InvalidVoiceId),
+numSubmitted(0),
+numApplied(0) {
     // empty
 }
 
 //------------------------------------------------------------------------------
 soundMgrBase::~soundMgrBase() {
     o_assert_dbg(!this->valid);
-    o_assert_dbg(nullptr == this->effectPool);
 }
 
 //------------------------------------------------------------------------------
 void
-soundMgrBase::setup(const SoundSetup& setup, soundEffectPool* sndEffectPool) {
+soundMgrBase::setup(const SoundSetup& setup) {
     o_assert_dbg(!this->valid);
-    o_assert_dbg(nullptr == this->effectPool);
-    o_assert_dbg(nullptr != sndEffectPool);
 
     this->valid = true;
-    this->effectPool = sndEffectPool;
+    this->offline = setup.Offline;
+    this->voiceIdCounter = soundMixer::InvalidVoiceId;
+    this->appliedVoiceId = soundMixer::InvalidVoiceId;
+    this->numSubmitted = 0;
+    this->numApplied = 0;
+    this->mixer.setup(setup.SampleRate, setup.MaxNumVoices, setup.MaxNumMixedVoices);
 }
 
 //------------------------------------------------------------------------------
 void
 soundMgrBase::discard() {
     o_assert_dbg(this->valid);
+    o_assert_dbg(!this->useThread);
+    command cmd;
+    while (this->cmdQueue.Pop(cmd)) {
+        // drop commands which never made it to the audio thread
+    }
+    this->mixer.discard();
     this->valid = false;
-    this->effectPool = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -48,9 +63,177 @@ soundMgrBase::isValid() const {
 
 //------------------------------------------------------------------------------
 void
-soundMgrBase::play(soundEffect* /*effect*/, int32 /*loopCount*/, int32 freqShift) {
-    // empty
+soundMgrBase::update() {
+    // the base class has no audio device to feed
+}
+
+//------------------------------------------------------------------------------
+uint32
+soundMgrBase::play(soundEffect* effect, int32 loopCount, int32 /*freqShift*/, float32 volume) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != effect);
+    if (nullptr == effect->samples) {
+        return soundMixer::InvalidVoiceId;
+    }
+    uint32 voiceId = ++this->voiceIdCounter;
+    if (soundMixer::InvalidVoiceId == voiceId) {
+        // the counter wrapped around
+        voiceId = ++this->voiceIdCounter;
+    }
+    command cmd;
+    cmd.code = command::Play;
+    cmd.voiceId = voiceId;
+    cmd.effect = effect;
+    cmd.loopCount = loopCount;
+    cmd.volume = volume;
+    this->submit(cmd);
+    return voiceId;
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::stop(uint32 voiceId) {
+    o_assert_dbg(this->valid);
+    command cmd;
+    cmd.code = command::Stop;
+    cmd.voiceId = voiceId;
+    this->submit(cmd);
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::updateVoiceVolume(uint32 voiceId, float32 volume) {
+    o_assert_dbg(this->valid);
+    command cmd;
+    cmd.code = command::UpdateVolume;
+    cmd.voiceId = voiceId;
+    cmd.volume = volume;
+    this->submit(cmd);
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::stopEffect(const Id& effect) {
+    o_assert_dbg(this->valid);
+    command cmd;
+    cmd.code = command::StopEffect;
+    cmd.effectId = effect;
+    this->submit(cmd);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The mixer keeps pointers to the samples of the playing effects, so
+ after stopEffect() the samples may only be freed once flush() has
+ returned. Without an audio thread the commands have already been
+ applied.
+*/
+void
+soundMgrBase::flush() {
+    #if ORYOL_HAS_THREADS
+    while (this->useThread && (this->numApplied.load(std::memory_order_acquire) != this->numSubmitted)) {
+        this->wakeup.Signal();
+        std::this_thread::yield();
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+ A voice which has been handed out by play() but hasn't been started
+ by the audio thread yet counts as playing.
+*/
+bool
+soundMgrBase::isPlaying(uint32 voiceId) const {
+    o_assert_dbg(this->valid);
+    if (soundMixer::InvalidVoiceId == voiceId) {
+        return false;
+    }
+    if (int32(voiceId - this->appliedVoiceId.load(std::memory_order_acquire)) > 0) {
+        return true;
+    }
+    return this->mixer.isPlaying(voiceId);
+}
+
+//------------------------------------------------------------------------------
+int32
+soundMgrBase::numVoices() const {
+    o_assert_dbg(this->valid);
+    return this->mixer.numVoices();
+}
+
+//------------------------------------------------------------------------------
+int32
+soundMgrBase::numMixedVoices() const {
+    o_assert_dbg(this->valid);
+    return this->mixer.numMixedVoices();
+}
+
+//------------------------------------------------------------------------------
+/**
+ The queue only runs full if the audio thread is stalled, the main
+ thread then waits instead of dropping the command, a dropped
+ StopEffect would leave the mixer with dangling samples.
+*/
+void
+soundMgrBase::submit(const command& cmd) {
+    #if ORYOL_HAS_THREADS
+    if (this->useThread) {
+        while (!this->cmdQueue.Push(cmd)) {
+            this->wakeup.Signal();
+            std::this_thread::yield();
+        }
+        this->numSubmitted++;
+        return;
+    }
+    #endif
+    this->apply(cmd);
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::apply(const command& cmd) {
+    switch (cmd.code) {
+        case command::Play:
+            this->mixer.play(cmd.voiceId, cmd.effect, cmd.loopCount, cmd.volume);
+            this->appliedVoiceId.store(cmd.voiceId, std::memory_order_release);
+            break;
+        case command::Stop:
+            this->mixer.stop(cmd.voiceId);
+            break;
+        case command::UpdateVolume:
+            this->mixer.setVolume(cmd.voiceId, cmd.volume);
+            break;
+        case command::StopEffect:
+            this->mixer.stopEffect(cmd.effectId);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::applyCommands() {
+    command cmd;
+    while (this->cmdQueue.Pop(cmd)) {
+        this->apply(cmd);
+        this->numApplied.fetch_add(1, std::memory_order_release);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::render(int16* samples, int32 numSamples) {
+    this->mixer.render(samples, numSamples);
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::renderOffline(int16* samples, int32 numSamples) {
+    o_assert_dbg(this->valid);
+    o_assert(this->offline);
+    o_assert_dbg(samples && (numSamples >= 0));
+    this->render(samples, numSamples);
 }
 
 } // namespace _priv
-} // namespace Oryol
\ No newline at end of file
+} // namespace Oryol
@@ -4,13 +4,30 @@
     @class Oryol::_priv::soundMgrBase
     @ingroup _priv
     @brief sound manager base class
+
+    Sound effects are played by the software mixer (see soundMixer)
+    into a single mono output. The base class is also the offline
+    backend: with SoundSetup::Offline (or on platforms without an
+    audio device backend) the output is pulled with renderOffline(),
+    the platform backends stream it to the audio device.
+
+    If a platform backend mixes on an audio thread, the mixer belongs
+    to that thread: play(), stop() and updateVoiceVolume() push
+    commands into a lock-free queue which the audio thread applies
+    before it mixes the next buffer. Voice ids are handed out on the
+    main thread, so play() can return the id right away.
 */
 #include "Sound/Core/SoundSetup.h"
+#include "Sound/Core/soundMixer.h"
+#include "Core/Threading/SPSCQueue.h"
+#if ORYOL_HAS_THREADS
+#include "Core/Threading/Event.h"
+#endif
+#include <atomic>
 
 namespace Oryol {
 namespace _priv {
 
-class soundEffectPool;
 class soundEffect;
 
 class soundMgrBase {
@@ -21,19 +38,73 @@ public:
     ~soundMgrBase();
 
     /// setup the sound manager
-    void setup(const SoundSetup& setup, soundEffectPool* sndEffectPool);
+    void setup(const SoundSetup& setup);
     /// discard the sound manager
     void discard();
     /// return true if sound manager has been setup
     bool isValid() const;
+    /// per-frame update
+    void update();
 
-    /// play a sound effect
-    void play(soundEffect* effect, int32 loopCount, int32 freqShift);
+    /// play a sound effect, return voice id
+    uint32 play(soundEffect* effect, int32 loopCount, int32 freqShift, float32 volume);
+    /// stop a playing voice
+    void stop(uint32 voiceId);
+    /// set the volume of a playing voice
+    void updateVoiceVolume(uint32 voiceId, float32 volume);
+    /// stop all voices of an effect, the effect can be destroyed after flush()
+    void stopEffect(const Id& effect);
+    /// wait until the mixer has applied all commands
+    void flush();
+    /// return true if a voice is playing (or about to start)
+    bool isPlaying(uint32 voiceId) const;
+    /// get number of playing voices
+    int32 numVoices() const;
+    /// get number of voices mixed in the last block
+    int32 numMixedVoices() const;
+    /// mix the playing sound effects into the next numSamples samples (offline only)
+    void renderOffline(int16* samples, int32 numSamples);
 
 protected:
+    /// a mixer command on its way to the audio thread
+    struct command {
+        enum Code {
+            Play,
+            Stop,
+            UpdateVolume,
+            StopEffect,
+        };
+        Code code = Play;
+        uint32 voiceId = 0;
+        const soundEffect* effect = nullptr;
+        Id effectId;
+        int32 loopCount = 0;
+        float32 volume = 0.0f;
+    };
+    /// push a command to the queue, or apply it directly if there is no audio thread
+    void submit(const command& cmd);
+    /// apply a command to the mixer
+    void apply(const command& cmd);
+    /// apply the commands queued by submit() (audio thread)
+    void applyCommands();
+    /// mix the next numSamples samples
+    void render(int16* samples, int32 numSamples);
+
+    static const int32 MaxQueuedCommands = 256;
+
     bool valid;
-    soundEffectPool* effectPool;
+    bool offline;
+    bool useThread;
+    soundMixer mixer;
+    uint32 voiceIdCounter;                  // last voice id handed out by play()
+    std::atomic<uint32> appliedVoiceId;     // last voice id started by the mixer
+    uint32 numSubmitted;                    // number of commands pushed to the queue
+    std::atomic<uint32> numApplied;         // number of commands applied by the audio thread
+    SPSCQueue<command, MaxQueuedCommands> cmdQueue;
+    #if ORYOL_HAS_THREADS
+    Event wakeup;                           // wakes up the audio thread
+    #endif
 };
 
 } // namespace _priv
-} // namespace Oryol
\ No newline at end of file
+} // namespace Oryol
@@ -0,0 +1,356 @@
+//------------------------------------------------------------------------------
+//  soundMixer.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "soundMixer.h"
+#include "Sound/Core/soundEffect.h"
+#include "Core/Memory/Memory.h"
+#include "Core/sampleOps.h"
+#include <algorithm>
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+soundMixer::soundMixer() :
+valid(false),
+sampleRate(0),
+maxNumVoices(0),
+maxNumMixedVoices(0),
+numPlaying(0),
+numMixed(0),
+voiceSamples(nullptr),
+voiceVolumes(nullptr) {
+    for (auto& id : this->voiceIds) {
+        id = InvalidVoiceId;
+    }
+}
+
+//------------------------------------------------------------------------------
+soundMixer::~soundMixer() {
+    o_assert_dbg(!this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+soundMixer::setup(int32 sampleRate_, int32 maxNumVoices_, int32 maxNumMixedVoices_) {
+    o_assert_dbg(!this->valid);
+    o_assert_dbg(sampleRate_ > 0);
+    o_assert((maxNumVoices_ > 0) && (maxNumVoices_ <= MaxNumVoices));
+    o_assert((maxNumMixedVoices_ > 0) && (maxNumMixedVoices_ <= maxNumVoices_));
+
+    this->valid = true;
+    this->sampleRate = sampleRate_;
+    this->maxNumVoices = maxNumVoices_;
+    this->maxNumMixedVoices = maxNumMixedVoices_;
+    this->numPlaying = 0;
+    this->numMixed = 0;
+    this->voiceSamples = (int16*) Memory::Alloc(maxNumMixedVoices_ * VoiceStride * sizeof(int16));
+    this->voiceVolumes = (int16*) Memory::Alloc(maxNumMixedVoices_ * sizeof(int16));
+    for (int32 i = 0; i < MaxNumVoices; i++) {
+        this->voices[i] = voice();
+        this->voiceIds[i] = InvalidVoiceId;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMixer::discard() {
+    o_assert_dbg(this->valid);
+    this->valid = false;
+    Memory::Free(this->voiceSamples);
+    this->voiceSamples = nullptr;
+    Memory::Free(this->voiceVolumes);
+    this->voiceVolumes = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+soundMixer::isValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+bool
+soundMixer::stronger(const voice& a, const voice& b) {
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+    else if (a.volume != b.volume) {
+        return a.volume > b.volume;
+    }
+    else {
+        // the newer voice wins
+        return int32(a.id - b.id) > 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+soundMixer::voice*
+soundMixer::lookup(uint32 voiceId) const {
+    o_assert_dbg(this->valid);
+    if (InvalidVoiceId != voiceId) {
+        for (int32 i = 0; i < this->maxNumVoices; i++) {
+            if (this->voices[i].id == voiceId) {
+                return const_cast<voice*>(&this->voices[i]);
+            }
+        }
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+void
+soundMixer::freeVoice(voice& v) {
+    o_assert_dbg(InvalidVoiceId != v.id);
+    v.id = InvalidVoiceId;
+    v.effect.Invalidate();
+    v.samples = nullptr;
+    this->voiceIds[&v - this->voices].store(InvalidVoiceId, std::memory_order_release);
+    this->numPlaying.fetch_sub(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The freqShift isn't supported yet, a loopCount below 1 plays the
+ effect once. The voiceId must be newer than the ids of all playing
+ voices. The voice keeps a pointer to the effect's samples, so the
+ effect must be stopped with stopEffect() before it is destroyed.
+*/
+bool
+soundMixer::play(uint32 voiceId, const soundEffect* effect, int32 loopCount, float32 volume) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(InvalidVoiceId != voiceId);
+    o_assert_dbg(nullptr != effect);
+    if (nullptr == effect->samples) {
+        return false;
+    }
+
+    voice newVoice;
+    newVoice.id = voiceId;
+    newVoice.effect = effect->Id;
+    newVoice.priority = effect->Setup.Priority;
+    newVoice.volume = sampleOps::ToVolume(volume);
+    newVoice.samples = effect->samples;
+    newVoice.numSamples = effect->numSamples;
+    newVoice.step = uint32((int64(effect->Setup.BufferFrequency) << 16) / this->sampleRate);
+    newVoice.loopsLeft = loopCount > 1 ? loopCount : 1;
+
+    // find the voice slot: restart the oldest voice of the effect if all
+    // its voices are busy, otherwise grab a free slot, otherwise steal
+    // the weakest voice if the new voice is stronger
+    voice* freeSlot = nullptr;
+    voice* oldestOfEffect = nullptr;
+    voice* weakest = nullptr;
+    int32 numEffectVoices = 0;
+    for (int32 i = 0; i < this->maxNumVoices; i++) {
+        voice& v = this->voices[i];
+        if (InvalidVoiceId == v.id) {
+            if (nullptr == freeSlot) {
+                freeSlot = &v;
+            }
+            continue;
+        }
+        if (v.effect == newVoice.effect) {
+            numEffectVoices++;
+            if ((nullptr == oldestOfEffect) || (int32(v.id - oldestOfEffect->id) < 0)) {
+                oldestOfEffect = &v;
+            }
+        }
+        if ((nullptr == weakest) || stronger(*weakest, v)) {
+            weakest = &v;
+        }
+    }
+    voice* slot = nullptr;
+    if (numEffectVoices >= effect->Setup.NumVoices) {
+        slot = oldestOfEffect;
+    }
+    else if (nullptr != freeSlot) {
+        slot = freeSlot;
+        this->numPlaying.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if ((nullptr != weakest) && stronger(newVoice, *weakest)) {
+        slot = weakest;
+    }
+    else {
+        // all voices busy with stronger sounds, drop the new sound
+        return false;
+    }
+    *slot = newVoice;
+    this->voiceIds[slot - this->voices].store(voiceId, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+soundMixer::stop(uint32 voiceId) {
+    voice* v = this->lookup(voiceId);
+    if (v) {
+        this->freeVoice(*v);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMixer::stopEffect(const Id& effect) {
+    o_assert_dbg(this->valid);
+    for (int32 i = 0; i < this->maxNumVoices; i++) {
+        voice& v = this->voices[i];
+        if ((InvalidVoiceId != v.id) && (v.effect == effect)) {
+            this->freeVoice(v);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMixer::setVolume(uint32 voiceId, float32 volume) {
+    voice* v = this->lookup(voiceId);
+    if (v) {
+        v->volume = sampleOps::ToVolume(volume);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+soundMixer::isPlaying(uint32 voiceId) const {
+    if (InvalidVoiceId != voiceId) {
+        for (int32 i = 0; i < this->maxNumVoices; i++) {
+            if (this->voiceIds[i].load(std::memory_order_acquire) == voiceId) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+int32
+soundMixer::numVoices() const {
+    return this->numPlaying.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+int32
+soundMixer::numMixedVoices() const {
+    return this->numMixed.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+/**
+ Effects at the output sample rate are copied, everything else is
+ linearly interpolated. The rest of dst is filled with silence when
+ the voice finishes.
+*/
+bool
+soundMixer::resample(voice& v, int16* dst, int32 numSamples) {
+    const int16* src = v.samples;
+    const int32 numSrcSamples = v.numSamples;
+    int32 i = 0;
+    while (i < numSamples) {
+        if ((0x10000 == v.step) && (0 == v.frac)) {
+            int32 num = numSrcSamples - v.pos;
+            if (num > (numSamples - i)) {
+                num = numSamples - i;
+            }
+            Memory::Copy(src + v.pos, dst + i, num * sizeof(int16));
+            v.pos += num;
+            i += num;
+        }
+        else {
+            for (; (i < numSamples) && (v.pos < numSrcSamples); i++) {
+                const int32 s0 = src[v.pos];
+                const int32 s1 = (v.pos + 1) < numSrcSamples ? src[v.pos + 1] : s0;
+                dst[i] = int16(s0 + (((s1 - s0) * int32(v.frac >> 1)) >> 15));
+                v.frac += v.step;
+                v.pos += int32(v.frac >> 16);
+                v.frac &= 0xFFFF;
+            }
+        }
+        while (v.pos >= numSrcSamples) {
+            if (--v.loopsLeft <= 0) {
+                Memory::Clear(dst + i, (numSamples - i) * sizeof(int16));
+                return false;
+            }
+            v.pos -= numSrcSamples;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+soundMixer::skip(voice& v, int32 numSamples) {
+    const int32 numSrcSamples = v.numSamples;
+    const uint64 advance = uint64(v.frac) + uint64(v.step) * uint64(numSamples);
+    v.pos += int32(advance >> 16);
+    v.frac = uint32(advance & 0xFFFF);
+    while (v.pos >= numSrcSamples) {
+        if (--v.loopsLeft <= 0) {
+            return false;
+        }
+        v.pos -= numSrcSamples;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+ The voices are picked again for each block, so a virtual voice
+ becomes audible within one block when it gets strong enough.
+*/
+void
+soundMixer::render(int16* dst, int32 numSamples) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(dst && (numSamples >= 0));
+
+    int32 candidates[MaxNumVoices];
+    bool mixed[MaxNumVoices];
+    while (numSamples > 0) {
+        const int32 num = numSamples < BlockSize ? numSamples : BlockSize;
+
+        // pick the strongest audible voices
+        int32 numCandidates = 0;
+        for (int32 i = 0; i < this->maxNumVoices; i++) {
+            mixed[i] = false;
+            if ((InvalidVoiceId != this->voices[i].id) && (this->voices[i].volume > 0)) {
+                candidates[numCandidates++] = i;
+            }
+        }
+        if (numCandidates > this->maxNumMixedVoices) {
+            std::nth_element(candidates, candidates + this->maxNumMixedVoices, candidates + numCandidates,
+                [this](int32 a, int32 b) {
+                    return stronger(this->voices[a], this->voices[b]);
+                });
+            numCandidates = this->maxNumMixedVoices;
+        }
+
+        // resample the mixed voices
+        int32 numMixedVoices = 0;
+        for (int32 i = 0; i < numCandidates; i++) {
+            voice& v = this->voices[candidates[i]];
+            mixed[candidates[i]] = true;
+            int16* samples = this->voiceSamples + numMixedVoices * VoiceStride;
+            this->voiceVolumes[numMixedVoices++] = v.volume;
+            if (!resample(v, samples, num)) {
+                this->freeVoice(v);
+            }
+        }
+        this->numMixed.store(numMixedVoices, std::memory_order_relaxed);
+
+        // move the virtual voices along
+        for (int32 i = 0; i < this->maxNumVoices; i++) {
+            voice& v = this->voices[i];
+            if (!mixed[i] && (InvalidVoiceId != v.id) && !skip(v, num)) {
+                this->freeVoice(v);
+            }
+        }
+
+        sampleOps::Mix(dst, this->voiceSamples, VoiceStride, this->voiceVolumes, numMixedVoices, num);
+        dst += num;
+        numSamples -= num;
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,126 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::soundMixer
+    @ingroup _priv
+    @brief software mixer with voice virtualization
+
+    Each play() starts a voice, up to SoundSetup::MaxNumVoices voices
+    can play at the same time. When all voices are busy, the weakest
+    voice (lowest SoundEffectSetup::Priority, then lowest volume, then
+    the oldest) is stolen if the new voice is stronger, otherwise the
+    new voice is dropped. An effect never plays on more voices than its
+    SoundEffectSetup::NumVoices, the oldest voice of the effect is
+    restarted instead.
+
+    Only the SoundSetup::MaxNumMixedVoices strongest voices are mixed,
+    the other voices are virtual: their play position moves on, but
+    their samples are not touched, so they come back at the right
+    position when stronger voices stop. Silent voices are always
+    virtual. This keeps the mixing cost bounded no matter how many
+    sounds are triggered.
+
+    The mixed voices are resampled to the output sample rate with
+    linear interpolation into a per-voice buffer, and summed with
+    their volumes by sampleOps::Mix() (SSE2/NEON), the same kernel
+    the Synth module uses.
+
+    Voice ids are handed out by the caller in play order and are never
+    reused (until they wrap around), so the id of a finished voice
+    doesn't find the voice which reuses its slot.
+
+    The mixer is only touched by one thread (the audio thread if there
+    is one), only isPlaying(), numVoices() and numMixedVoices() may be
+    called from other threads.
+*/
+#include "Core/Types.h"
+#include "Resource/Id.h"
+#include <atomic>
+
+namespace Oryol {
+namespace _priv {
+
+class soundEffect;
+
+class soundMixer {
+public:
+    /// max number of voices (mixed and virtual)
+    static const int32 MaxNumVoices = 256;
+    /// number of samples mixed per block
+    static const int32 BlockSize = 256;
+    /// the invalid voice id
+    static const uint32 InvalidVoiceId = 0;
+
+    /// constructor
+    soundMixer();
+    /// destructor
+    ~soundMixer();
+
+    /// setup the mixer
+    void setup(int32 sampleRate, int32 maxNumVoices, int32 maxNumMixedVoices);
+    /// discard the mixer
+    void discard();
+    /// return true if the mixer has been setup
+    bool isValid() const;
+
+    /// start playing an effect on a new voice, return false if dropped
+    bool play(uint32 voiceId, const soundEffect* effect, int32 loopCount, float32 volume);
+    /// stop a voice
+    void stop(uint32 voiceId);
+    /// stop all voices playing an effect
+    void stopEffect(const Id& effect);
+    /// set the volume of a voice (0.0f .. 2.0f)
+    void setVolume(uint32 voiceId, float32 volume);
+    /// mix the next numSamples samples of all playing voices
+    void render(int16* dst, int32 numSamples);
+
+    /// return true if the voice is still playing (any thread)
+    bool isPlaying(uint32 voiceId) const;
+    /// get number of playing voices, mixed and virtual (any thread)
+    int32 numVoices() const;
+    /// get number of voices mixed in the last block (any thread)
+    int32 numMixedVoices() const;
+
+private:
+    /// a playing effect
+    struct voice {
+        uint32 id = InvalidVoiceId;     // InvalidVoiceId if the slot is free
+        Id effect;
+        int32 priority = 0;
+        int16 volume = 0;
+        const int16* samples = nullptr; // the effect's samples
+        int32 numSamples = 0;
+        int32 pos = 0;                  // current sample index
+        uint32 frac = 0;                // fractional sample position (16 bits)
+        uint32 step = 0;                // 16.16 fixed point step per output sample
+        int32 loopsLeft = 0;
+    };
+    /// return true if voice a should be kept over voice b
+    static bool stronger(const voice& a, const voice& b);
+    /// lookup a playing voice by id, or nullptr
+    voice* lookup(uint32 voiceId) const;
+    /// resample a voice into dst, return false when the voice has finished
+    static bool resample(voice& v, int16* dst, int32 numSamples);
+    /// advance a virtual voice, return false when the voice has finished
+    static bool skip(voice& v, int32 numSamples);
+    /// free a voice slot
+    void freeVoice(voice& v);
+
+    /// distance of the per-voice sample buffers, padded by a cache line so
+    /// that the buffers don't all map to the same cache sets
+    static const int32 VoiceStride = BlockSize + 32;
+
+    bool valid;
+    int32 sampleRate;
+    int32 maxNumVoices;
+    int32 maxNumMixedVoices;
+    std::atomic<int32> numPlaying;
+    std::atomic<int32> numMixed;
+    int16* voiceSamples;    // maxNumMixedVoices * VoiceStride
+    int16* voiceVolumes;    // maxNumMixedVoices
+    voice voices[MaxNumVoices];
+    std::atomic<uint32> voiceIds[MaxNumVoices];  // copy of the voice ids for isPlaying()
+};
+
+} // namespace _priv
+} // namespace Oryol
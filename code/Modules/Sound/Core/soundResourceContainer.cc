@@ -3,17 +3,28 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "soundResourceContainer.h"
+#include "Sound/Core/soundMgr.h"
+#include "Core/Core.h"
+#include "Core/Threading/WorkerPool.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
 
 namespace Oryol {
 namespace _priv {
 
 //------------------------------------------------------------------------------
 void
-soundResourceContainer::setup(const SoundSetup& setup) {
+soundResourceContainer::setup(const SoundSetup& setup, soundMgr* mgr) {
     o_assert_dbg(!this->isValid());
+    o_assert_dbg(nullptr != mgr);
 
+    this->sndMgr = mgr;
     this->effectFactory.setup(setup);
     this->effectPool.Setup(0, setup.SoundEffectPoolSize);
+    this->runLoopId = Core::PostRunLoop()->Add("SoundResources", [this]() {
+        this->update();
+    });
     resourceContainerBase::setup(setup.ResourceLabelStackCapacity, setup.ResourceRegistryCapacity);
 }
 
@@ -22,9 +33,24 @@ void
 soundResourceContainer::discard() {
     o_assert_dbg(this->isValid());
 
+    // worker jobs may still be running on pending effects, the effects
+    // have all been destroyed already, so just wait for the jobs and
+    // throw away the samples
+    Core::PostRunLoop()->Remove(this->runLoopId);
+    this->runLoopId = RunLoop::InvalidId;
+    while (!this->pendingEffects.Empty()) {
+        this->update();
+        if (!this->pendingEffects.Empty() && !WorkerPool::RunOwn(this)) {
+            #if ORYOL_HAS_THREADS
+            std::this_thread::yield();
+            #endif
+        }
+    }
+
     resourceContainerBase::discard();
     this->effectPool.Discard();
     this->effectFactory.discard();
+    this->sndMgr = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -69,12 +95,115 @@ soundResourceContainer::Create(const SoundEffectSetup& setup, const void* data,
     return resId;
 }
 
+//------------------------------------------------------------------------------
+/**
+ The effect is in Pending state until its samples have been generated
+ and update() has set it up, it can't be played before. Effects with
+ a SampleFunc are generated by a single job, effects with a
+ SampleRangeFunc are split into ChunkNumSamples jobs. The jobs are
+ pushed with Low priority, so they only run on the worker threads
+ (or in discard()). Without worker threads the samples are generated
+ right away.
+*/
+Id
+soundResourceContainer::CreateAsync(const SoundEffectSetup& setup) {
+    o_assert_dbg(this->isValid());
+
+    Id resId = this->registry.Lookup(setup.Locator);
+    if (resId.IsValid()) {
+        return resId;
+    }
+    resId = this->effectPool.AllocId();
+    this->registry.Add(setup.Locator, resId, this->peekLabel());
+    this->effectPool.Assign(resId, setup, ResourceState::Pending);
+
+    asyncEffect* effect = Memory::New<asyncEffect>();
+    effect->resId = resId;
+    effect->setup = setup;
+    effect->numSamples = soundEffectFactoryBase::numSamples(setup);
+    effect->samples = (int16*) Memory::Alloc(effect->numSamples * sizeof(int16));
+    if (setup.SampleRangeFunc) {
+        effect->numChunks = (effect->numSamples + ChunkNumSamples - 1) / ChunkNumSamples;
+    }
+    else {
+        effect->numChunks = 1;
+    }
+    this->pendingEffects.Add(effect);
+    const bool useWorkers = WorkerPool::IsValid() && (WorkerPool::NumWorkers() > 0);
+    for (int32 i = 0; i < effect->numChunks; i++) {
+        if (useWorkers) {
+            WorkerPool::Push(generateJob, effect, this, WorkerPool::Priority::Low);
+        }
+        else {
+            generateJob(effect);
+        }
+    }
+    return resId;
+}
+
+//------------------------------------------------------------------------------
+void
+soundResourceContainer::generateJob(void* userData) {
+    asyncEffect* effect = (asyncEffect*) userData;
+    const int32 chunkIndex = effect->nextChunk.fetch_add(1, std::memory_order_relaxed);
+    o_assert_dbg(chunkIndex < effect->numChunks);
+    int32 firstSample = 0;
+    int32 num = effect->numSamples;
+    if (effect->numChunks > 1) {
+        firstSample = chunkIndex * ChunkNumSamples;
+        num = (firstSample + ChunkNumSamples) < effect->numSamples ? ChunkNumSamples : (effect->numSamples - firstSample);
+    }
+    soundEffectFactoryBase::generateSamples(effect->setup, effect->samples, firstSample, num);
+    effect->numChunksDone.fetch_add(1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+void
+soundResourceContainer::initAsync(asyncEffect* effect) {
+    // the effect may have been destroyed while its samples were generated
+    if (ResourceState::Pending == this->effectPool.QueryState(effect->resId)) {
+        soundEffect* res = this->effectPool.Get(effect->resId);
+        o_assert_dbg(nullptr != res);
+        const ResourceState::Code newState = this->effectFactory.setupWithSamples(*res, effect->samples, effect->numSamples);
+        o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
+        this->effectPool.UpdateState(effect->resId, newState);
+    }
+    else {
+        Memory::Free(effect->samples);
+    }
+    effect->samples = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void
+soundResourceContainer::update() {
+    o_assert_dbg(this->isValid());
+
+    this->effectPool.Update();
+    for (int32 i = this->pendingEffects.Size() - 1; i >= 0; i--) {
+        asyncEffect* effect = this->pendingEffects[i];
+        if (effect->numChunksDone.load(std::memory_order_acquire) == effect->numChunks) {
+            this->initAsync(effect);
+            Memory::Delete(effect);
+            this->pendingEffects.EraseSwap(i);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 soundResourceContainer::Destroy(ResourceLabel label) {
     o_assert_dbg(this->isValid());
 
     Array<Id> ids = this->registry.Remove(label);
+
+    // the mixer must be done with the samples before they are freed
+    for (const Id& id : ids) {
+        if (ResourceState::Valid == this->effectPool.QueryState(id)) {
+            this->sndMgr->stopEffect(id);
+        }
+    }
+    this->sndMgr->flush();
     for (const Id& id : ids) {
         if (ResourceState::Valid == this->effectPool.QueryState(id)) {
             soundEffect* effect = this->effectPool.Lookup(id);
@@ -93,5 +222,12 @@ soundResourceContainer::lookupSoundEffect(const Id& resId) {
     return this->effectPool.Lookup(resId);
 }
 
+//------------------------------------------------------------------------------
+ResourceInfo
+soundResourceContainer::QueryResourceInfo(const Id& resId) const {
+    o_assert_dbg(this->isValid());
+    return this->effectPool.QueryResourceInfo(resId);
+}
+
 } // namespace _priv
 } // namespace Oryol
@@ -4,21 +4,37 @@
     @class Oryol::_priv::soundResourceContainer
     @ingroup _priv
     @brief resource container for Sound module
+
+    Sound effects created with createAsync() start in the Pending
+    state while their samples are generated by Low priority WorkerPool
+    jobs, so only the worker threads pick them up, never a thread which
+    helps out while it waits for frame-critical jobs. Effects with a
+    SampleRangeFunc are split into ChunkNumSamples jobs, so a worker is
+    never blocked for long. A SampleFunc has to fill the whole buffer
+    in one call and can't be split. The effects are set up and switch
+    to Valid (or are thrown away if they have been destroyed in the
+    meantime) in the per-frame update() on the main thread.
 */
 #include "Resource/Core/resourceContainerBase.h"
+#include "Resource/ResourceInfo.h"
+#include "Core/RunLoop.h"
+#include "Core/Containers/Array.h"
 #include "Sound/Core/SoundSetup.h"
 #include "Sound/Core/SoundEffectSetup.h"
 #include "IO/Stream/Stream.h"
 #include "Sound/Core/soundEffectPool.h"
 #include "Sound/Core/soundEffectFactory.h"
+#include <atomic>
 
 namespace Oryol {
 namespace _priv {
 
+class soundMgr;
+
 class soundResourceContainer : public resourceContainerBase {
 public:
     /// setup the resource container
-    void setup(const SoundSetup& setup);
+    void setup(const SoundSetup& setup, soundMgr* sndMgr);
     /// discard the resource container
     void discard();
 
@@ -26,14 +42,44 @@ public:
     Id Create(const SoundEffectSetup& setup);
     /// create sound effect resource with raw data
     Id Create(const SoundEffectSetup& setup, const void* data, int32 size);
+    /// create sound effect resource, samples are generated on worker threads
+    Id CreateAsync(const SoundEffectSetup& setup);
     /// destroy resources by label
     void Destroy(ResourceLabel label);
 
     /// lookup soundEffect, return 0 if not exists or valid
     soundEffect* lookupSoundEffect(const Id& resId);
+    /// query resource info (fast)
+    ResourceInfo QueryResourceInfo(const Id& resId) const;
+
+    /// per-frame update, finishes async sound effects
+    void update();
+
+    /// number of samples generated by one async job
+    static const int32 ChunkNumSamples = 8 * 1024;
 
     _priv::soundEffectPool effectPool;
     _priv::soundEffectFactory effectFactory;
+
+private:
+    /// an async sound effect, shared with the worker jobs
+    struct asyncEffect {
+        Id resId;
+        SoundEffectSetup setup;
+        int16* samples = nullptr;
+        int32 numSamples = 0;
+        int32 numChunks = 0;
+        std::atomic<int32> nextChunk{0};
+        std::atomic<int32> numChunksDone{0};
+    };
+    /// WorkerPool job function, generates the next chunk of samples
+    static void generateJob(void* userData);
+    /// setup the sound effect of a finished async effect
+    void initAsync(asyncEffect* effect);
+
+    soundMgr* sndMgr = nullptr;
+    RunLoop::Id runLoopId = RunLoop::InvalidId;
+    Array<asyncEffect*> pendingEffects;
 };
 
 } // namespace _pric
@@ -3,6 +3,7 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "Sound.h"
+#include "Core/Core.h"
 
 namespace Oryol {
 
@@ -17,8 +18,11 @@ Sound::Setup(const SoundSetup& setup) {
 
     state = Memory::New<_state>();
     state->soundSetup = setup;
-    state->soundMgr.setup(setup, &state->resourceContainer.effectPool);
-    state->resourceContainer.setup(setup);
+    state->soundMgr.setup(setup);
+    state->resourceContainer.setup(setup, &state->soundMgr);
+    state->runLoopId = Core::PostRunLoop()->Add("Sound", [] {
+        state->soundMgr.update();
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -26,6 +30,7 @@ void
 Sound::Discard() {
     o_assert_dbg(IsValid());
 
+    Core::PostRunLoop()->Remove(state->runLoopId);
     state->resourceContainer.Destroy(ResourceLabel::All);
     state->soundMgr.discard();
     state->resourceContainer.discard();
@@ -75,6 +80,13 @@ Sound::CreateResource(const SoundEffectSetup& setup, const void* data, int32 siz
     return state->resourceContainer.Create(setup, data, size);
 }
 
+//------------------------------------------------------------------------------
+Id
+Sound::CreateResourceAsync(const SoundEffectSetup& setup) {
+    o_assert_dbg(IsValid());
+    return state->resourceContainer.CreateAsync(setup);
+}
+
 //------------------------------------------------------------------------------
 void
 Sound::DestroyResources(ResourceLabel label) {
@@ -83,13 +95,63 @@ Sound::DestroyResources(ResourceLabel label) {
 }
 
 //------------------------------------------------------------------------------
-void
-Sound::Play(Id resId, int32 loopCount, int32 freqShift) {
+ResourceInfo
+Sound::QueryResourceInfo(const Id& id) {
+    o_assert_dbg(IsValid());
+    return state->resourceContainer.QueryResourceInfo(id);
+}
+
+//------------------------------------------------------------------------------
+Sound::VoiceId
+Sound::Play(Id resId, int32 loopCount, int32 freqShift, float32 volume) {
     o_assert_dbg(IsValid());
     soundEffect* sndEffect = state->resourceContainer.lookupSoundEffect(resId);
     if (sndEffect) {
-        state->soundMgr.play(sndEffect, loopCount, freqShift);
+        return state->soundMgr.play(sndEffect, loopCount, freqShift, volume);
     }
+    return InvalidVoiceId;
+}
+
+//------------------------------------------------------------------------------
+void
+Sound::StopVoice(VoiceId voice) {
+    o_assert_dbg(IsValid());
+    state->soundMgr.stop(voice);
+}
+
+//------------------------------------------------------------------------------
+void
+Sound::UpdateVoiceVolume(VoiceId voice, float32 volume) {
+    o_assert_dbg(IsValid());
+    state->soundMgr.updateVoiceVolume(voice, volume);
+}
+
+//------------------------------------------------------------------------------
+bool
+Sound::IsVoicePlaying(VoiceId voice) {
+    o_assert_dbg(IsValid());
+    return state->soundMgr.isPlaying(voice);
+}
+
+//------------------------------------------------------------------------------
+int32
+Sound::NumVoices() {
+    o_assert_dbg(IsValid());
+    return state->soundMgr.numVoices();
+}
+
+//------------------------------------------------------------------------------
+int32
+Sound::NumMixedVoices() {
+    o_assert_dbg(IsValid());
+    return state->soundMgr.numMixedVoices();
+}
+
+//------------------------------------------------------------------------------
+void
+Sound::RenderOffline(int16* samples, int32 numSamples) {
+    o_assert_dbg(IsValid());
+    state->soundMgr.renderOffline(samples, numSamples);
 }
 
 } // namespace Oryol
@@ -7,6 +7,11 @@
     @class Oryol::Sound
     @ingroup Sound
     @brief audio module for generated sound effects and short samples
+
+    Sound effects are played by a software mixer with a global voice
+    budget (see SoundSetup::MaxNumVoices and MaxNumMixedVoices), the
+    mixed output is streamed to the audio device from an audio thread
+    (see SoundSetup::UseAudioThread).
 */
 #include "Core/Types.h"
 #include "Sound/Core/soundResourceContainer.h"
@@ -14,11 +19,17 @@
 #include "Sound/Core/soundMgr.h"
 #include "Sound/Core/soundResourceContainer.h"
 #include "Resource/Core/SetupAndStream.h"
+#include "Core/RunLoop.h"
 
 namespace Oryol {
 
 class Sound {
 public:
+    /// id of a playing voice
+    typedef uint32 VoiceId;
+    /// the invalid voice id
+    static const VoiceId InvalidVoiceId = _priv::soundMixer::InvalidVoiceId;
+
     /// setup the Sound module
     static void Setup(const SoundSetup& setup);
     /// discard the Sound module
@@ -40,19 +51,36 @@ public:
     static Id CreateResource(const SoundEffectSetup& setup, const Ptr<Stream>& stream);
     /// create a sound effect resource with raw data
     static Id CreateResource(const SoundEffectSetup& setup, const void* data, int32 size);
+    /// create a sound effect resource, samples are generated on worker threads
+    static Id CreateResourceAsync(const SoundEffectSetup& setup);
     /// lookup a resource id by Locator
     static Id LookupResource(const Locator& locator);
     /// destroy one or several sound resources by matching label
     static void DestroyResources(ResourceLabel label);
+    /// query resource info (fast)
+    static ResourceInfo QueryResourceInfo(const Id& id);
 
-    /// play a sound effect
-    static void Play(Id snd, int32 loopCount=1, int32 freqShift=0);
+    /// play a sound effect, the voice may be dropped by the voice limit (see IsVoicePlaying)
+    static VoiceId Play(Id snd, int32 loopCount=1, int32 freqShift=0, float32 volume=1.0f);
+    /// stop a playing voice
+    static void StopVoice(VoiceId voice);
+    /// update the volume of a playing voice (0.0f .. 2.0f)
+    static void UpdateVoiceVolume(VoiceId voice, float32 volume);
+    /// test if a voice is still playing (mixed or virtual)
+    static bool IsVoicePlaying(VoiceId voice);
+    /// get number of playing voices (mixed and virtual)
+    static int32 NumVoices();
+    /// get number of voices mixed in the last mixed block
+    static int32 NumMixedVoices();
+    /// mix the next numSamples mono samples of playing effects (SoundSetup::Offline only)
+    static void RenderOffline(int16* samples, int32 numSamples);
 
 private:
     struct _state {
         SoundSetup soundSetup;
         _priv::soundMgr soundMgr;
         _priv::soundResourceContainer resourceContainer;
+        RunLoop::Id runLoopId = RunLoop::InvalidId;
     };
     static _state* state;
 };
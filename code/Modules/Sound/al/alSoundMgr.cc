@@ -5,6 +5,7 @@
 #include "alSoundMgr.h"
 #include "Sound/al/sound_al.h"
 #include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
 #include "Core/String/StringBuilder.h"
 
 namespace Oryol {
@@ -13,24 +14,40 @@ namespace _priv {
 //------------------------------------------------------------------------------
 alSoundMgr::alSoundMgr() :
 alcDevice(nullptr),
-alcContext(nullptr) {
-    // empty
+alcContext(nullptr),
+sampleRate(0),
+source(0),
+numBuffers(0),
+bufferNumSamples(0),
+buffers(nullptr),
+samples(nullptr) {
+    #if ORYOL_HAS_THREADS
+    this->threadStopRequested = false;
+    #endif
 }
 
 //------------------------------------------------------------------------------
 alSoundMgr::~alSoundMgr() {
     o_assert_dbg(nullptr == this->alcDevice);
     o_assert_dbg(nullptr == this->alcContext);
+    o_assert_dbg(0 == this->source);
+    o_assert_dbg(nullptr == this->buffers);
 }
 
 //------------------------------------------------------------------------------
 void
-alSoundMgr::setup(const SoundSetup& setup, soundEffectPool* sndEffectPool) {
+alSoundMgr::setup(const SoundSetup& setup) {
     o_assert_dbg(!this->isValid());
     o_assert_dbg(nullptr == this->alcDevice);
     o_assert_dbg(nullptr == this->alcContext);
+    o_assert(setup.NumStreamBuffers >= 2);
+    o_assert(setup.StreamBufferNumSamples > 0);
 
-    soundMgrBase::setup(setup, sndEffectPool);
+    soundMgrBase::setup(setup);
+    if (setup.Offline) {
+        // headless, sound effects are mixed by renderOffline()
+        return;
+    }
 
     // setup OpenAL context and make it current
     this->alcDevice = alcOpenDevice(NULL);
@@ -49,7 +66,29 @@ alSoundMgr::setup(const SoundSetup& setup, soundEffectPool* sndEffectPool) {
     }
     this->printALInfo();
 
-    this->valid = true;
+    // setup the stream source and queue the first (silent) buffers,
+    // playback starts in fillBuffers()
+    this->sampleRate = setup.SampleRate;
+    this->numBuffers = setup.NumStreamBuffers;
+    this->bufferNumSamples = setup.StreamBufferNumSamples;
+    this->buffers = (ALuint*) Memory::Alloc(this->numBuffers * sizeof(ALuint));
+    this->samples = (int16*) Memory::Alloc(this->bufferNumSamples * sizeof(int16));
+    alGenSources(1, &this->source);
+    ORYOL_SOUND_AL_CHECK_ERROR();
+    alGenBuffers(this->numBuffers, this->buffers);
+    ORYOL_SOUND_AL_CHECK_ERROR();
+    for (int32 i = 0; i < this->numBuffers; i++) {
+        this->queueBuffer(this->buffers[i]);
+    }
+
+    // from here on only the audio thread touches the mixer and the source
+    #if ORYOL_HAS_THREADS
+    if (setup.UseAudioThread) {
+        this->useThread = true;
+        this->threadStopRequested = false;
+        this->thread = std::thread(threadFunc, this);
+    }
+    #endif
 }
 
 //------------------------------------------------------------------------------
@@ -57,6 +96,26 @@ void
 alSoundMgr::discard() {
     o_assert_dbg(this->isValid());
 
+    #if ORYOL_HAS_THREADS
+    if (this->useThread) {
+        this->threadStopRequested = true;
+        this->wakeup.Signal();
+        this->thread.join();
+        this->useThread = false;
+    }
+    #endif
+    if (0 != this->source) {
+        alDeleteSources(1, &this->source);
+        ORYOL_SOUND_AL_CHECK_ERROR();
+        this->source = 0;
+        alDeleteBuffers(this->numBuffers, this->buffers);
+        ORYOL_SOUND_AL_CHECK_ERROR();
+        Memory::Free(this->buffers);
+        this->buffers = nullptr;
+        Memory::Free(this->samples);
+        this->samples = nullptr;
+        this->queuedBuffers.Clear();
+    }
     if (nullptr != this->alcContext) {
         alcDestroyContext(this->alcContext);
         this->alcContext = nullptr;
@@ -103,21 +162,66 @@ alSoundMgr::printALInfo() {
 
 //------------------------------------------------------------------------------
 void
-alSoundMgr::play(soundEffect* effect, int32 loopCount, int32 freqShift) {
+alSoundMgr::queueBuffer(ALuint buf) {
+    this->render(this->samples, this->bufferNumSamples);
+    alBufferData(buf, AL_FORMAT_MONO16, this->samples, this->bufferNumSamples * sizeof(int16), this->sampleRate);
+    ORYOL_SOUND_AL_CHECK_ERROR();
+    alSourceQueueBuffers(this->source, 1, &buf);
+    ORYOL_SOUND_AL_CHECK_ERROR();
+    this->queuedBuffers.Enqueue(buf);
+}
+
+//------------------------------------------------------------------------------
+void
+alSoundMgr::update() {
     o_assert_dbg(this->isValid());
-    o_assert_dbg(nullptr != effect);
-    o_assert_dbg(effect->State == ResourceState::Valid);
-    o_assert_dbg(effect->nextSourceIndex < effect->numSources);
+    if ((0 != this->source) && !this->useThread) {
+        this->fillBuffers();
+    }
+}
 
-    // get next source, round-robin
-    ALuint src = effect->alSources[effect->nextSourceIndex++];
-    if (effect->nextSourceIndex == effect->numSources) {
-        effect->nextSourceIndex = 0;
+//------------------------------------------------------------------------------
+void
+alSoundMgr::fillBuffers() {
+    // refill the buffers which have been played
+    ALint numProcessed = 0;
+    alGetSourcei(this->source, AL_BUFFERS_PROCESSED, &numProcessed);
+    ORYOL_SOUND_AL_CHECK_ERROR();
+    for (int32 i = 0; i < numProcessed; i++) {
+        ALuint buf = this->queuedBuffers.Dequeue();
+        alSourceUnqueueBuffers(this->source, 1, &buf);
+        ORYOL_SOUND_AL_CHECK_ERROR();
+        this->queueBuffer(buf);
     }
-    o_assert_dbg(0 != src);
-    alSourcePlay(src);
+
+    // start playback if the source isn't playing (either it never
+    // was, or it has stopped because it was starved)
+    ALint srcState = 0;
+    alGetSourcei(this->source, AL_SOURCE_STATE, &srcState);
     ORYOL_SOUND_AL_CHECK_ERROR();
+    if (AL_PLAYING != srcState) {
+        alSourcePlay(this->source);
+        ORYOL_SOUND_AL_CHECK_ERROR();
+    }
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_HAS_THREADS
+void
+alSoundMgr::threadFunc(alSoundMgr* self) {
+    // check the source twice per buffer, and right away when
+    // the main thread is waiting in flush()
+    int32 pollMs = (self->bufferNumSamples * 1000) / (self->sampleRate * 2);
+    if (pollMs < 1) {
+        pollMs = 1;
+    }
+    while (!self->threadStopRequested) {
+        self->applyCommands();
+        self->fillBuffers();
+        self->wakeup.TimedWait(pollMs);
+    }
 }
+#endif
 
 } // namespace _priv
 } // namespace Oryol
\ No newline at end of file
@@ -4,10 +4,33 @@
     @class Oryol::_priv::alSoundMgr
     @ingroup _priv
     @brief OpenAL implementation of soundMgr
+
+    The mixed output is streamed through a single OpenAL source, which
+    cycles through SoundSetup::NumStreamBuffers buffers of
+    SoundSetup::StreamBufferNumSamples samples. The buffers which have
+    finished playing are mixed again and requeued.
+
+    With SoundSetup::UseAudioThread (the default if the platform has
+    threads) an audio thread owns the mixer and the OpenAL source, it
+    applies the queued play/stop/volume commands and refills the
+    buffers a few times per buffer, so frame-time hitches on the main
+    thread don't starve the source. Without the audio thread this
+    happens once per frame in update(): if a frame takes longer than
+    the queued buffers (4 x 512 samples is about 46ms at 44.1kHz) the
+    source runs dry and the output stutters.
+
+    A new sound starts when the next buffer is mixed, so it is delayed
+    by up to NumStreamBuffers * StreamBufferNumSamples samples, fewer
+    or smaller buffers lower the latency but make the output easier
+    to starve.
 */
 #include "Sound/Core/soundMgrBase.h"
 #include "Sound/Core/soundEffect.h"
 #include "Sound/al/sound_al.h"
+#include "Core/Containers/Queue.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
 
 namespace Oryol {
 namespace _priv {
@@ -20,19 +43,37 @@ public:
     ~alSoundMgr();
 
     /// setup the sound manager
-    void setup(const SoundSetup& setup, soundEffectPool* sndEffectPool);
+    void setup(const SoundSetup& setup);
     /// discard the sound manager
     void discard();
-
-    /// play a sound effect
-    void play(soundEffect* effect, int32 loopCount, int32 freqShift);
+    /// per-frame update, feeds the output stream if there is no audio thread
+    void update();
 
 private:
     /// print info about OpenAL implementation
     void printALInfo();
+    /// mix the next buffer and queue it on the stream source
+    void queueBuffer(ALuint buf);
+    /// requeue the played buffers, and restart the source if it has stopped
+    void fillBuffers();
+    #if ORYOL_HAS_THREADS
+    /// the audio thread entry function
+    static void threadFunc(alSoundMgr* self);
+    #endif
 
     ALCdevice* alcDevice;
-    ALCcontext* alcContext;    
+    ALCcontext* alcContext;
+    int32 sampleRate;
+    ALuint source;
+    int32 numBuffers;
+    int32 bufferNumSamples;
+    ALuint* buffers;        // numBuffers
+    Queue<ALuint> queuedBuffers;
+    int16* samples;         // bufferNumSamples
+    #if ORYOL_HAS_THREADS
+    std::thread thread;
+    std::atomic<bool> threadStopRequested;
+    #endif
 };
 
 } // namespace _priv
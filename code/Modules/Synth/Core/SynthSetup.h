@@ -15,10 +15,18 @@ public:
     bool UseGPUSynthesizer = false;
     /// initial volume
     float32 InitialVolume = 0.05f;
-    /// number of voices
+    /// number of voices (max synth::MaxNumVoices)
     int32 NumVoices = 4;
+    /// number of op tracks per voice (max synth::MaxNumTracks)
+    int32 NumTracks = 4;
     /// number of samples in waveforms (default: 32)
     int32 WaveFormNumSamples = 32;
+    /// synthesize on a separate audio thread (CPU synthesizer only)
+    bool UseAudioThread = true;
+    /// number of buffers queued for playback ahead of the playing buffer
+    int32 NumLookAheadBuffers = 2;
+    /// don't open an audio device, pull samples with Synth::RenderOffline()
+    bool Offline = false;
 };
     
 } // namespace Oryol
\ No newline at end of file
@@ -4,13 +4,116 @@
 #include "Pre.h"
 #include "Core/Assertion.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Threading/Parallel.h"
 #include "cpuSynthesizer.h"
 #include <cmath>
 #include <cstdlib>
+#if ORYOL_SIMD_SSE
+#include <emmintrin.h>
+#elif ORYOL_SIMD_NEON
+#include <arm_neon.h>
+#endif
 
 namespace Oryol {
 namespace _priv {
 
+namespace {
+
+#if ORYOL_SIMD_SSE
+/// 32-bit multiply keeping the low 32 bits (SSE2 has no pmulld)
+inline __m128i
+mullo32(__m128i a, __m128i b) {
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/// select a where mask is set, otherwise b
+inline __m128i
+select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+#endif
+
+/// accum = (accum * s) >> 15
+void
+modulate(int32* accum, const int32* s, int32 num) {
+    int32 i = 0;
+    #if ORYOL_SIMD_SSE
+    for (; (i + 4) <= num; i += 4) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(accum + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(s + i));
+        _mm_storeu_si128((__m128i*)(accum + i), _mm_srai_epi32(mullo32(a, b), 15));
+    }
+    #elif ORYOL_SIMD_NEON
+    for (; (i + 4) <= num; i += 4) {
+        vst1q_s32(accum + i, vshrq_n_s32(vmulq_s32(vld1q_s32(accum + i), vld1q_s32(s + i)), 15));
+    }
+    #endif
+    for (; i < num; i++) {
+        accum[i] = (accum[i] * s[i]) >> 15;
+    }
+}
+
+/// accum = clamp(accum + s, MinSampleVal, MaxSampleVal)
+void
+addSaturate(int32* accum, const int32* s, int32 num) {
+    int32 i = 0;
+    #if ORYOL_SIMD_SSE
+    const __m128i minVal = _mm_set1_epi32(synth::MinSampleVal);
+    const __m128i maxVal = _mm_set1_epi32(synth::MaxSampleVal);
+    for (; (i + 4) <= num; i += 4) {
+        __m128i sum = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(accum + i)), _mm_loadu_si128((const __m128i*)(s + i)));
+        sum = select(_mm_cmplt_epi32(sum, minVal), minVal, sum);
+        sum = select(_mm_cmpgt_epi32(sum, maxVal), maxVal, sum);
+        _mm_storeu_si128((__m128i*)(accum + i), sum);
+    }
+    #elif ORYOL_SIMD_NEON
+    const int32x4_t minVal = vdupq_n_s32(synth::MinSampleVal);
+    const int32x4_t maxVal = vdupq_n_s32(synth::MaxSampleVal);
+    for (; (i + 4) <= num; i += 4) {
+        const int32x4_t sum = vaddq_s32(vld1q_s32(accum + i), vld1q_s32(s + i));
+        vst1q_s32(accum + i, vminq_s32(vmaxq_s32(sum, minVal), maxVal));
+    }
+    #endif
+    for (; i < num; i++) {
+        int32 sum = accum[i] + s[i];
+        if (sum < synth::MinSampleVal) sum = synth::MinSampleVal;
+        else if (sum > synth::MaxSampleVal) sum = synth::MaxSampleVal;
+        accum[i] = sum;
+    }
+}
+
+/// convert accumulated values to 16-bit samples (truncates like a cast to int16)
+void
+store(int16* dst, const int32* accum, int32 num) {
+    int32 i = 0;
+    #if ORYOL_SIMD_SSE
+    for (; (i + 8) <= num; i += 8) {
+        // sign-extend the low 16 bits, so that the saturating pack doesn't saturate
+        const __m128i a0 = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i*)(accum + i)), 16), 16);
+        const __m128i a1 = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i*)(accum + i + 4)), 16), 16);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(a0, a1));
+    }
+    #elif ORYOL_SIMD_NEON
+    for (; (i + 8) <= num; i += 8) {
+        vst1q_s16(dst + i, vcombine_s16(vmovn_s32(vld1q_s32(accum + i)), vmovn_s32(vld1q_s32(accum + i + 4))));
+    }
+    #endif
+    for (; i < num; i++) {
+        dst[i] = int16(accum[i]);
+    }
+}
+
+/// wave counter increment per tick for a frequency
+inline uint32
+freqStep(uint32 freq, int32 numWaveSamples) {
+    return ((freq * numWaveSamples) << 12) / synth::SampleRate;
+}
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 void
 cpuSynthesizer::Setup(const SynthSetup& /*setupParams*/) {
@@ -21,73 +124,142 @@ cpuSynthesizer::Setup(const SynthSetup& /*setupParams*/) {
 //------------------------------------------------------------------------------
 void
 cpuSynthesizer::Synthesize(const opBundle& bundle) {
-    for (int32 voiceIndex = 0; voiceIndex < synth::NumVoices; voiceIndex++) {
+    o_assert_dbg((bundle.NumVoices > 0) && (bundle.NumVoices <= synth::MaxNumVoices));
+    o_assert_dbg((bundle.NumTracks > 0) && (bundle.NumTracks <= synth::MaxNumTracks));
+    // each voice only touches its own freqCounters and sample buffer
+    Parallel::For(0, bundle.NumVoices, VoiceGrainSize, [this, &bundle](int32 voiceIndex) {
         this->synthesizeVoice(voiceIndex, bundle);
-    }
+    });
 }
 
 //------------------------------------------------------------------------------
+/**
+ Splits the buffer's tick range into spans where the op of each
+ track is constant. The gathered ops of a track are sorted by start
+ tick and don't overlap, so a cursor per track is enough to find
+ the next span. Spans are capped at MaxSpanTicks, this only
+ splits the work and doesn't change the output.
+*/
 void
 cpuSynthesizer::synthesizeVoice(int32 voiceIndex, const opBundle& bundle) {
     o_assert_dbg(synth::BufferSize == bundle.BufferNumBytes);
-    o_assert_range_dbg(voiceIndex, synth::NumVoices);
+    o_assert_range_dbg(voiceIndex, bundle.NumVoices);
     
     // the sample tick range covered by the buffer
     int16* samplePtr = (int16*) bundle.Buffer[voiceIndex];
-    
-    // for each sample...
-    for (int32 curTick = bundle.StartTick[voiceIndex]; curTick < bundle.EndTick[voiceIndex]; curTick++) {
-        int32 accum = 0;
-        for (int trackIndex = 0; trackIndex < synth::NumTracks; trackIndex++) {
-            const SynthOp* op = bundle.Op(voiceIndex, trackIndex, curTick);
-            if (op) {
-                o_assert_dbg(op);
-                int32 s = this->sample(voiceIndex, trackIndex, accum, op);
-                switch (op->Op) {
-                    case SynthOp::Modulate:
-                        accum = (accum * s) >> 15;
-                        break;
-                    case SynthOp::Add:
-                        accum = accum + s;
-                        if (accum < synth::MinSampleVal) accum = synth::MinSampleVal;
-                        else if (accum > synth::MaxSampleVal) accum = synth::MaxSampleVal;
-                        break;
-                    case SynthOp::Replace:
-                    case SynthOp::ModFreq:
-                        accum = s;
-                        break;
-                    default:
-                        break;
+    const int32 endTick = bundle.EndTick[voiceIndex];
+    o_assert_dbg((endTick - bundle.StartTick[voiceIndex]) <= synth::BufferNumSamples);
+
+    int32 accum[MaxSpanTicks];
+    int32 samples[MaxSpanTicks];
+    const int32 numTracks = bundle.NumTracks;
+    const SynthOp* cursor[synth::MaxNumTracks];
+    const SynthOp* ops[synth::MaxNumTracks];
+    for (int32 trackIndex = 0; trackIndex < numTracks; trackIndex++) {
+        cursor[trackIndex] = bundle.Begin[voiceIndex][trackIndex];
+    }
+    int32 curTick = bundle.StartTick[voiceIndex];
+    while (curTick < endTick) {
+        // find the current op of each track, and the tick where
+        // the first track changes its op
+        int32 spanEndTick = (endTick - curTick) > MaxSpanTicks ? (curTick + MaxSpanTicks) : endTick;
+        for (int32 trackIndex = 0; trackIndex < numTracks; trackIndex++) {
+            const SynthOp* end = bundle.End[voiceIndex][trackIndex];
+            const SynthOp*& op = cursor[trackIndex];
+            while ((op < end) && (op->endTick <= curTick)) {
+                op++;
+            }
+            ops[trackIndex] = nullptr;
+            if (op < end) {
+                if (op->startTick <= curTick) {
+                    ops[trackIndex] = op;
+                    if (op->endTick < spanEndTick) {
+                        spanEndTick = op->endTick;
+                    }
+                }
+                else if (op->startTick < spanEndTick) {
+                    spanEndTick = op->startTick;
                 }
             }
         }
-        *samplePtr++ = int16(accum);
+        const int32 numTicks = spanEndTick - curTick;
+        this->synthesizeSpan(voiceIndex, ops, numTracks, numTicks, accum, samples);
+        store(samplePtr, accum, numTicks);
+        samplePtr += numTicks;
+        curTick = spanEndTick;
     }
 }
 
 //------------------------------------------------------------------------------
-int32
-cpuSynthesizer::sample(int32 voiceIndex, int32 trackIndex, int32 accum, const SynthOp* op) {
-    
+void
+cpuSynthesizer::synthesizeSpan(int32 voiceIndex, const SynthOp* const* ops, int32 numTracks, int32 numTicks, int32* accum, int32* samples) {
+    Memory::Clear(accum, numTicks * sizeof(int32));
+    for (int32 trackIndex = 0; trackIndex < numTracks; trackIndex++) {
+        const SynthOp* op = ops[trackIndex];
+        if (nullptr == op) {
+            continue;
+        }
+        if (SynthOp::Nop == op->Op) {
+            // a Nop doesn't change the output, but its oscillator keeps running
+            if (SynthOp::Const != op->Wave) {
+                this->freqCounters[voiceIndex][trackIndex] += freqStep(op->Freq, NumWaveSamples) * uint32(numTicks);
+            }
+            continue;
+        }
+        this->sampleSpan(voiceIndex, trackIndex, op, numTicks, accum, samples);
+        switch (op->Op) {
+            case SynthOp::Modulate:
+                modulate(accum, samples, numTicks);
+                break;
+            case SynthOp::Add:
+                addSaturate(accum, samples, numTicks);
+                break;
+            case SynthOp::Replace:
+            case SynthOp::ModFreq:
+                Memory::Copy(samples, accum, numTicks * sizeof(int32));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+cpuSynthesizer::sampleSpan(int32 voiceIndex, int32 trackIndex, const SynthOp* op, int32 numTicks, const int32* accum, int32* samples) {
+    int32* dst = samples;
+
     // non-sample waves
     if (SynthOp::Const == op->Wave) {
-        return op->Amp + op->Bias;
+        const int32 s = op->Amp + op->Bias;
+        for (int32 i = 0; i < numTicks; i++) {
+            dst[i] = s;
+        }
+        return;
+    }
+
+    // sample a canned wave
+    const int32* wave = this->waves[op->Wave];
+    const int32 amp = op->Amp;
+    const int32 bias = op->Bias;
+    uint32 counter = this->freqCounters[voiceIndex][trackIndex];
+    if (SynthOp::ModFreq == op->Op) {
+        // the frequency is modulated by the accumulated value of each tick
+        const uint32 f = op->Freq;
+        const int32* src = accum;
+        for (int32 i = 0; i < numTicks; i++) {
+            counter += freqStep((f * uint32(src[i] + (1<<15))) >> 16, NumWaveSamples);
+            dst[i] = ((wave[(counter >> 12) % NumWaveSamples] * amp) >> 15) + bias;
+        }
     }
     else {
-        // update the frequency counter
-        uint32 f = op->Freq;
-        if (op->Op == SynthOp::ModFreq) {
-            accum += (1<<15);
-            f = (f * accum) >> 16;
+        const uint32 step = freqStep(op->Freq, NumWaveSamples);
+        for (int32 i = 0; i < numTicks; i++) {
+            counter += step;
+            dst[i] = ((wave[(counter >> 12) % NumWaveSamples] * amp) >> 15) + bias;
         }
-        uint32 t = (((f * NumWaveSamples) << 12) / synth::SampleRate);
-        this->freqCounters[voiceIndex][trackIndex] += t;
-    
-        // sample a canned wave
-        uint32 tick = (this->freqCounters[voiceIndex][trackIndex] >> 12) % NumWaveSamples;
-        int32 s = ((this->waves[op->Wave][tick] * op->Amp) >> 15) + op->Bias;
-        return s;
     }
+    this->freqCounters[voiceIndex][trackIndex] = counter;
 }
 
 //------------------------------------------------------------------------------
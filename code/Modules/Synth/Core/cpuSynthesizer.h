@@ -8,6 +8,18 @@
     The cpuSynthesize class takes an opBundle object and fills sample
     buffers with samples (one for each voice). Samples are synthesized
     on the CPU.
+
+    The ops of a voice are rendered in spans, a span is a range of ticks
+    where the op of each track doesn't change. Each track of a span
+    is rendered into a temporary sample buffer, and combined with the
+    accumulated samples in a single pass per track.
+
+    The voices are independent from each other and are rendered
+    in parallel with Parallel::For(), the temporary buffers live
+    on the stack of the rendering thread. The audio thread only
+    waits for voice jobs which a worker has already started, it
+    renders the others itself and never runs unrelated WorkerPool
+    jobs.
 */
 #include "Synth/Core/SynthSetup.h"
 #include "Synth/Core/opBundle.h"
@@ -27,12 +39,18 @@ private:
     void setupWaves();
     /// synthesize a single voice
     void synthesizeVoice(int32 voiceIndex, const opBundle& bundle);
-    /// generate a single voice-track sample
-    int32 sample(int32 voiceIndex, int32 trackIndex, int32 accum, const SynthOp* op);
+    /// synthesize a span of ticks where the op of each track is constant into accum
+    void synthesizeSpan(int32 voiceIndex, const SynthOp* const* ops, int32 numTracks, int32 numTicks, int32* accum, int32* samples);
+    /// generate the samples of one voice-track over a span into the samples buffer
+    void sampleSpan(int32 voiceIndex, int32 trackIndex, const SynthOp* op, int32 numTicks, const int32* accum, int32* samples);
     
     static const int32 NumWaveSamples = 32;
+    /// max number of ticks in a span (size of the temporary buffers)
+    static const int32 MaxSpanTicks = 256;
+    /// number of voices rendered by one WorkerPool job
+    static const int32 VoiceGrainSize = 2;
     int32 waves[SynthOp::NumWaves][NumWaveSamples];
-    uint32 freqCounters[synth::NumVoices][synth::NumTracks];
+    uint32 freqCounters[synth::MaxNumVoices][synth::MaxNumTracks];
 };
     
 } // namespace _priv
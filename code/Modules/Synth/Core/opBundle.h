@@ -16,47 +16,38 @@ class opBundle {
 public:
     /// constructor
     opBundle() :
+        NumVoices(0),
+        NumTracks(0),
         BufferNumBytes(0) {
         
         // this is a workaround for VS2013 missing array initializers :/
-        for (int voice = 0; voice < synth::NumVoices; voice++) {
+        for (int voice = 0; voice < synth::MaxNumVoices; voice++) {
             this->StartTick[voice] = 0;
             this->EndTick[voice] = 0;
             this->Buffer[voice] = nullptr;
-            for (int track = 0; track < synth::NumTracks; track++) {
+            for (int track = 0; track < synth::MaxNumTracks; track++) {
                 this->Begin[voice][track] = nullptr;
                 this->End[voice][track] = nullptr;
             }
         }
     };
 
+    /// number of voices in the bundle
+    int32 NumVoices;
+    /// number of tracks per voice
+    int32 NumTracks;
     /// sample buffer start tick
-    int32 StartTick[synth::NumVoices];
+    int32 StartTick[synth::MaxNumVoices];
     /// sample buffer end tick
-    int32 EndTick[synth::NumVoices];
+    int32 EndTick[synth::MaxNumVoices];
     /// pointers to start op
-    SynthOp* Begin[synth::NumVoices][synth::NumTracks];
+    SynthOp* Begin[synth::MaxNumVoices][synth::MaxNumTracks];
     /// one-past-end-pointers to end op
-    SynthOp* End[synth::NumVoices][synth::NumTracks];
+    SynthOp* End[synth::MaxNumVoices][synth::MaxNumTracks];
     /// sample buffer pointers
-    void* Buffer[synth::NumVoices];
+    void* Buffer[synth::MaxNumVoices];
     /// sample buffer size in bytes
     int32 BufferNumBytes;
-    
-    /// return op at voice, track and tick
-    SynthOp* Op(int32 voiceIndex, int32 trackIndex, int32 tick) const {
-        o_assert_range_dbg(voiceIndex, synth::NumVoices);
-        o_assert_range_dbg(trackIndex, synth::NumTracks);
-        SynthOp* begin = Begin[voiceIndex][trackIndex];
-        const SynthOp* end = End[voiceIndex][trackIndex];
-        for (SynthOp* op = begin; op < end; op++) {
-            if ((tick >= op->startTick) && (tick < op->endTick)) {
-                return op;
-            }
-        }
-        // can't happen
-        return nullptr;
-    };
 };
     
 } // namespace _priv
@@ -24,10 +24,10 @@ public:
     static const int32 BufferNumSamples = 2 * 1024;
     /// byte size of one streaming buffer
     static const int32 BufferSize = SampleSize * BufferNumSamples;
-    /// number of voices
-    static const int32 NumVoices = 1;
-    /// number of tracks per voice
-    static const int32 NumTracks = 4;
+    /// max number of voices (SynthSetup::NumVoices)
+    static const int32 MaxNumVoices = 64;
+    /// max number of tracks per voice (SynthSetup::NumTracks)
+    static const int32 MaxNumTracks = 8;
     /// max sample value (16 bit signed)
     static const int32 MaxSampleVal = (1<<15) - 1;
     /// min sample value (16 bit signed)
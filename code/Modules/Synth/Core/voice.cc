@@ -12,7 +12,8 @@ namespace _priv {
 //------------------------------------------------------------------------------
 voice::voice() :
 isValid(false),
-voiceIndex(InvalidIndex) {
+voiceIndex(InvalidIndex),
+numTracks(0) {
     // empty
 }
 
@@ -25,9 +26,11 @@ voice::~voice() {
 void
 voice::Setup(int32 vcIndex, const SynthSetup& setupAttrs) {
     o_assert_dbg(!this->isValid);
-    o_assert_range_dbg(vcIndex, synth::NumVoices);
+    o_assert_range_dbg(vcIndex, synth::MaxNumVoices);
+    o_assert_dbg((setupAttrs.NumTracks > 0) && (setupAttrs.NumTracks <= synth::MaxNumTracks));
     
     this->voiceIndex = vcIndex;
+    this->numTracks = setupAttrs.NumTracks;
     this->isValid = true;
 }
 
@@ -45,7 +48,7 @@ voice::Discard() {
 void
 voice::AddOp(int32 track, const SynthOp& op) {
     o_assert_dbg(this->isValid);
-    o_assert_range_dbg(track, synth::NumTracks);
+    o_assert_range_dbg(track, this->numTracks);
     this->tracks[track].AddOp(op);
 }
 
@@ -53,7 +56,7 @@ voice::AddOp(int32 track, const SynthOp& op) {
 void
 voice::GatherOps(int32 startTick, int32 endTick, opBundle& inOutBundle) {
     o_assert_dbg(this->isValid);
-    for (int trackIndex = 0; trackIndex < synth::NumTracks; trackIndex++) {
+    for (int trackIndex = 0; trackIndex < this->numTracks; trackIndex++) {
         this->tracks[trackIndex].GatherOps(startTick, endTick,
             inOutBundle.Begin[this->voiceIndex][trackIndex],
             inOutBundle.End[this->voiceIndex][trackIndex]);
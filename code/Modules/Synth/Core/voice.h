@@ -37,7 +37,8 @@ public:
 private:
     bool isValid;
     int32 voiceIndex;
-    voiceTrack tracks[synth::NumTracks];
+    int32 numTracks;
+    voiceTrack tracks[synth::MaxNumTracks];
 };
 
 //------------------------------------------------------------------------------
@@ -52,4 +52,25 @@ Synth::AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset) {
     state->soundManager.AddOp(voice, track, op, timeOffset);
 }
 
+//------------------------------------------------------------------------------
+void
+Synth::UpdateVoiceVolume(int32 voice, float32 vol) {
+    o_assert_dbg(IsValid());
+    state->soundManager.UpdateVoiceVolume(voice, vol);
+}
+
+//------------------------------------------------------------------------------
+int32
+Synth::NumBufferUnderruns() {
+    o_assert_dbg(IsValid());
+    return state->soundManager.NumBufferUnderruns();
+}
+
+//------------------------------------------------------------------------------
+void
+Synth::RenderOffline(int16* samples, int32 numSamples) {
+    o_assert_dbg(IsValid());
+    state->soundManager.RenderOffline(samples, numSamples);
+}
+
 } // namespace Oryol
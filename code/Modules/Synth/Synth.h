@@ -27,6 +27,12 @@ public:
     static void Update();
     /// add a sound synthesis Op
     static void AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset = 0);
+    /// update the volume of a voice (0.0f .. 2.0f, default is 1.0f)
+    static void UpdateVoiceVolume(int32 voice, float32 vol);
+    /// get number of audio buffer underruns since setup
+    static int32 NumBufferUnderruns();
+    /// render the next numSamples mono samples (SynthSetup::Offline only)
+    static void RenderOffline(int16* samples, int32 numSamples);
     
 private:
     struct _state {
@@ -10,6 +10,9 @@ namespace _priv {
 //------------------------------------------------------------------------------
 alBufferStreamer::alBufferStreamer() :
 isValid(false),
+playbackStarted(false),
+numLookAheadBuffers(2),
+numUnderruns(0),
 source(0) {
     this->allBuffers.Reserve(MaxNumBuffers);
     this->queuedBuffers.Reserve(MaxNumBuffers);
@@ -26,9 +29,12 @@ void
 alBufferStreamer::Setup(const SynthSetup& setupAttrs) {
     o_assert_dbg(!this->isValid);
     
-    this->isValid = true;
+    o_assert_dbg((setupAttrs.NumLookAheadBuffers > 0) && (setupAttrs.NumLookAheadBuffers < MaxNumBuffers));
     
-    // FIXME: actually use attrs from SynthSetup!
+    this->isValid = true;
+    this->playbackStarted = false;
+    this->numLookAheadBuffers = setupAttrs.NumLookAheadBuffers;
+    this->numUnderruns = 0;
     
     // generate buffers, initially fill buffer with 0
     int16 silence[synth::BufferNumSamples] = { 0 };
@@ -104,14 +110,8 @@ alBufferStreamer::Update() {
         this->freeBuffers.Enqueue(buf);
     }
     
-    // check if new data is needed (processed + 1 playing + 1 waiting)
-    // FIXME: or: processed + 1 playing?)
-    if ((buffersProcessed + 2) >= buffersQueued) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    // check if new data is needed (1 playing + look-ahead waiting)
+    return (buffersQueued - buffersProcessed) <= this->numLookAheadBuffers;
 }
 
 //------------------------------------------------------------------------------
@@ -134,12 +134,22 @@ alBufferStreamer::Enqueue(const void* ptr, int32 numBytes) {
     alGetSourcei(this->source, AL_SOURCE_STATE, &srcState);
     ORYOL_AL_CHECK_ERROR();
     if (AL_PLAYING != srcState) {
+        if (this->playbackStarted) {
+            this->numUnderruns++;
+        }
+        this->playbackStarted = true;
         alSourcePlay(this->source);
         ORYOL_AL_CHECK_ERROR();
         Log::Dbg("alBufferStreamer: starting playback\n");
     }
 }
 
+//------------------------------------------------------------------------------
+int32
+alBufferStreamer::NumUnderruns() const {
+    return this->numUnderruns.load(std::memory_order_relaxed);
+}
+
     
 } // namespace _priv
 } // namespace Oryol
@@ -26,6 +26,7 @@
 #include "Synth/Core/SynthSetup.h"
 #include "Synth/al/al.h"
 #include "Synth/Core/synth.h"
+#include <atomic>
 
 namespace Oryol {
 namespace _priv {
@@ -50,11 +51,16 @@ public:
     bool Update();
     /// enqueue new data into the streamer
     void Enqueue(const void* ptr, int32 numBytes);
+    /// get number of buffer underruns (can be called from any thread)
+    int32 NumUnderruns() const;
     
 private:
     static const int32 MaxNumBuffers = 8;
 
     bool isValid;
+    bool playbackStarted;
+    int32 numLookAheadBuffers;
+    std::atomic<int32> numUnderruns;
     ALuint source;
     Array<ALuint> allBuffers;
     Queue<ALuint> queuedBuffers;
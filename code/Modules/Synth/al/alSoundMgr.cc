@@ -14,7 +14,9 @@ namespace _priv {
 alSoundMgr::alSoundMgr() :
 alcDevice(nullptr),
 alcContext(nullptr) {
-    // empty
+    #if ORYOL_HAS_THREADS
+    this->threadStopRequested = false;
+    #endif
 }
 
 //------------------------------------------------------------------------------
@@ -31,6 +33,10 @@ alSoundMgr::Setup(const SynthSetup& setupAttrs) {
     o_assert_dbg(nullptr == this->alcContext);
 
     soundMgrBase::Setup(setupAttrs);
+    if (setupAttrs.Offline) {
+        // headless, samples are pulled with RenderOffline()
+        return;
+    }
     
     // setup an OpenAL context and make it current
     this->alcDevice = alcOpenDevice(NULL);
@@ -51,6 +57,15 @@ alSoundMgr::Setup(const SynthSetup& setupAttrs) {
     
     // setup the buffer streamer
     this->streamer.Setup(setupAttrs);
+
+    // start the audio thread, the GPU synthesizer must run on the main thread
+    #if ORYOL_HAS_THREADS
+    if (setupAttrs.UseAudioThread && !setupAttrs.UseGPUSynthesizer) {
+        this->useThread = true;
+        this->threadStopRequested = false;
+        this->thread = std::thread(threadFunc, this);
+    }
+    #endif
 }
 
 //------------------------------------------------------------------------------
@@ -58,7 +73,17 @@ void
 alSoundMgr::Discard() {
     o_assert_dbg(this->isValid);
     
-    this->streamer.Discard();
+    #if ORYOL_HAS_THREADS
+    if (this->useThread) {
+        this->threadStopRequested = true;
+        this->wakeup.Signal();
+        this->thread.join();
+        this->useThread = false;
+    }
+    #endif
+    if (this->streamer.IsValid()) {
+        this->streamer.Discard();
+    }
     if (nullptr != this->alcContext) {
         alcDestroyContext(this->alcContext);
         this->alcContext = nullptr;
@@ -107,41 +132,49 @@ alSoundMgr::PrintALInfo() {
 //------------------------------------------------------------------------------
 void
 alSoundMgr::UpdateVolume(float32 vol) {
-    this->streamer.UpdateVolume(vol);
+    if (this->streamer.IsValid()) {
+        this->streamer.UpdateVolume(vol);
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 alSoundMgr::Update() {
+    if (!this->useThread && this->streamer.IsValid()) {
+        this->fillStreamer();
+    }
     soundMgrBase::Update();
-    if (this->streamer.Update()) {
-    
-        // need to 'render' new buffers
-        static int16 samples[synth::NumVoices][synth::BufferNumSamples];
-        const int32 startTick = this->curTick;
-        const int32 endTick   = startTick + synth::BufferNumSamples;
-        opBundle bundle;
-        for (int voiceIndex = 0; voiceIndex < synth::NumVoices; voiceIndex++) {
-            bundle.StartTick[voiceIndex] = startTick;
-            bundle.EndTick[voiceIndex] = endTick;
-            bundle.Buffer[voiceIndex] = samples[voiceIndex];
-            bundle.BufferNumBytes = synth::BufferSize;
-            this->voices[voiceIndex].GatherOps(startTick, endTick, bundle);
-        }
-        
-        // select between cpuSynth and gpuSynth here!
-        if (this->useGpuSynth) {
-            this->gpuSynth.Synthesize(bundle);
-        }
-        else {
-            this->cpuSynth.Synthesize(bundle);
-        }
-        this->curTick += synth::BufferNumSamples;
-        
-        // FIXME: only one voice handled at the moment!
-        this->streamer.Enqueue(samples[0], sizeof(samples[0]));
+}
+
+//------------------------------------------------------------------------------
+int32
+alSoundMgr::NumBufferUnderruns() const {
+    return this->streamer.NumUnderruns();
+}
+
+//------------------------------------------------------------------------------
+void
+alSoundMgr::fillStreamer() {
+    while (this->streamer.Update()) {
+        this->render(this->samples);
+        this->streamer.Enqueue(this->samples, sizeof(this->samples));
+    }
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_HAS_THREADS
+void
+alSoundMgr::threadFunc(alSoundMgr* self) {
+    // one buffer holds about 46ms of samples, check the
+    // streamer a few times per buffer
+    const int32 pollMs = (synth::BufferNumSamples * 1000) / (synth::SampleRate * 4);
+    while (!self->threadStopRequested) {
+        self->applyOps();
+        self->fillStreamer();
+        self->wakeup.TimedWait(pollMs);
     }
 }
+#endif
 
 } // namespace _priv
 } // namespace Oryol
@@ -4,10 +4,20 @@
     @class Oryol::_priv::alSoundMgr
     @ingroup _priv
     @brief OpenAL sound system wrapper
+
+    If SynthSetup::UseAudioThread is set (and the CPU synthesizer is
+    used), an audio thread owns the buffer streamer: it keeps
+    SynthSetup::NumLookAheadBuffers rendered buffers queued for playback
+    and picks up new ops from the op queue, so that frame-time spikes
+    on the main thread don't starve the OpenAL source.
 */
 #include "Synth/base/soundMgrBase.h"
 #include "Synth/al/al.h"
 #include "Synth/al/alBufferStreamer.h"
+#if ORYOL_HAS_THREADS
+#include "Core/Threading/Event.h"
+#include <thread>
+#endif
 
 namespace Oryol {
 namespace _priv {
@@ -27,14 +37,28 @@ public:
     void UpdateVolume(float32 vol);
     /// update the sound system
     void Update();
+    /// get number of buffer underruns since setup
+    int32 NumBufferUnderruns() const;
     
 private:
     /// print AL implementation info
     void PrintALInfo();
+    /// render and enqueue buffers until the streamer has enough data
+    void fillStreamer();
+    #if ORYOL_HAS_THREADS
+    /// the audio thread entry function
+    static void threadFunc(alSoundMgr* self);
+    #endif
     
     ALCdevice* alcDevice;
     ALCcontext* alcContext;
     alBufferStreamer streamer;
+    int16 samples[synth::BufferNumSamples];
+    #if ORYOL_HAS_THREADS
+    std::thread thread;
+    std::atomic<bool> threadStopRequested;
+    Event wakeup;
+    #endif
 };
     
 } // namespace _priv
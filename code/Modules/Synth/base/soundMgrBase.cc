@@ -4,6 +4,9 @@
 #include "Pre.h"
 #include "soundMgrBase.h"
 #include "Core/Assertion.h"
+#include "Core/Log.h"
+#include "Core/Memory/Memory.h"
+#include "Core/sampleOps.h"
 #include "Time/Clock.h"
 
 namespace Oryol {
@@ -13,7 +16,12 @@ namespace _priv {
 soundMgrBase::soundMgrBase() :
 isValid(false),
 useGpuSynth(false),
-curTick(0) {
+useThread(false),
+curTick(0),
+renderTick(0),
+numVoices(0),
+voiceSamples(nullptr),
+offlinePos(synth::BufferNumSamples) {
     // empty
 }
 
@@ -26,35 +34,63 @@ soundMgrBase::~soundMgrBase() {
 void
 soundMgrBase::Setup(const SynthSetup& setupParams) {
     o_assert(!this->isValid);
+    o_assert((setupParams.NumVoices > 0) && (setupParams.NumVoices <= synth::MaxNumVoices));
+    o_assert((setupParams.NumTracks > 0) && (setupParams.NumTracks <= synth::MaxNumTracks));
     this->isValid = true;
     this->useGpuSynth = setupParams.UseGPUSynthesizer;
     this->setup = setupParams;
     this->curTick = 0;
-    for (int i = 0; i < synth::NumVoices; i++) {
+    this->renderTick = 0;
+    this->offlinePos = synth::BufferNumSamples;
+    this->numVoices = setupParams.NumVoices;
+    for (int i = 0; i < this->numVoices; i++) {
         this->voices[i].Setup(i, setupParams);
+        this->voiceVolumes[i] = sampleOps::VolumeOne;
+    }
+    const int32 voiceSamplesSize = this->numVoices * synth::BufferSize;
+    this->voiceSamples = (int16*) Memory::Alloc(voiceSamplesSize);
+    Memory::Clear(this->voiceSamples, voiceSamplesSize);
+    this->bundle = opBundle();
+    this->bundle.NumVoices = this->numVoices;
+    this->bundle.NumTracks = setupParams.NumTracks;
+    this->bundle.BufferNumBytes = synth::BufferSize;
+    for (int i = 0; i < this->numVoices; i++) {
+        this->bundle.Buffer[i] = this->voiceSamples + i * synth::BufferNumSamples;
     }
     
     // add an initial NOP operation to first track of each voice,
     // this will generate all 0.0 samples instead of 1.0s
     SynthOp nop;
-    for (int i = 0; i < synth::NumVoices; i++) {
+    for (int i = 0; i < this->numVoices; i++) {
         this->AddOp(i, 0, nop, 0);
     }
     
     this->cpuSynth.Setup(setupParams);
-    this->gpuSynth.Setup(setupParams);
+    if (this->useGpuSynth) {
+        this->gpuSynth.Setup(setupParams);
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 soundMgrBase::Discard() {
     o_assert(this->isValid);
+    o_assert(!this->useThread);
     this->isValid = false;
     this->setup = SynthSetup();
-    for (voice& voice : this->voices) {
-        voice.Discard();
+    opItem item;
+    while (this->opQueue.Pop(item)) {
+        // drop ops which never made it to the render thread
+    }
+    for (int i = 0; i < this->numVoices; i++) {
+        this->voices[i].Discard();
+    }
+    this->numVoices = 0;
+    Memory::Free(this->voiceSamples);
+    this->voiceSamples = nullptr;
+    if (this->gpuSynth.IsValid()) {
+        this->gpuSynth.Discard();
     }
-    this->gpuSynth.Discard();
 }
 
 //------------------------------------------------------------------------------
@@ -73,16 +109,131 @@ soundMgrBase::UpdateVolume(float32 /*vol*/) {
 void
 soundMgrBase::Update() {
     o_assert_dbg(this->isValid);
+    // ops added during this frame are timed relative to the first
+    // sample which hasn't been rendered yet
+    this->curTick = this->renderTick.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+int32
+soundMgrBase::NumBufferUnderruns() const {
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Offline rendering is pulled by the caller as fast as it wants, the
+ samples are rendered a buffer at a time and handed out from the
+ last rendered buffer, so numSamples can be anything. Ops added with
+ AddOp() are timed relative to the first sample which hasn't been
+ rendered at the last Update().
+*/
+void
+soundMgrBase::RenderOffline(int16* samples, int32 numSamples) {
+    o_assert_dbg(this->isValid);
+    o_assert(this->setup.Offline);
+    o_assert_dbg(samples && (numSamples >= 0));
+    while (numSamples > 0) {
+        if (this->offlinePos == synth::BufferNumSamples) {
+            this->render(this->offlineSamples);
+            this->offlinePos = 0;
+        }
+        int32 num = synth::BufferNumSamples - this->offlinePos;
+        if (num > numSamples) {
+            num = numSamples;
+        }
+        Memory::Copy(this->offlineSamples + this->offlinePos, samples, num * sizeof(int16));
+        this->offlinePos += num;
+        samples += num;
+        numSamples -= num;
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 soundMgrBase::AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset) {
-    o_assert_range_dbg(voice, synth::NumVoices);
+    o_assert_range_dbg(voice, this->numVoices);
+
+    opItem item;
+    item.code = opItem::AddOp;
+    item.voice = voice;
+    item.track = track;
+    item.op = op;
+    item.op.startTick = this->curTick + timeOffset;
+    this->submit(item);
+}
 
-    SynthOp addOp = op;
-    addOp.startTick = this->curTick + timeOffset;
-    this->voices[voice].AddOp(track, addOp);
+//------------------------------------------------------------------------------
+void
+soundMgrBase::UpdateVoiceVolume(int32 voice, float32 vol) {
+    o_assert_range_dbg(voice, this->numVoices);
+
+    opItem item;
+    item.code = opItem::UpdateVolume;
+    item.voice = voice;
+    item.volume = sampleOps::ToVolume(vol);
+    this->submit(item);
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::submit(const opItem& item) {
+    if (this->useThread) {
+        if (!this->opQueue.Push(item)) {
+            o_warn("soundMgrBase::submit(): op queue full, op dropped!\n");
+        }
+    }
+    else {
+        this->apply(item);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::apply(const opItem& item) {
+    if (opItem::AddOp == item.code) {
+        this->voices[item.voice].AddOp(item.track, item.op);
+    }
+    else {
+        this->voiceVolumes[item.voice] = item.volume;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::applyOps() {
+    opItem item;
+    while (this->opQueue.Pop(item)) {
+        this->apply(item);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ Renders synth::BufferNumSamples samples per voice, and mixes the
+ voices into the samples array (synth::BufferNumSamples). This is
+ called on the audio thread if one is running, otherwise on the
+ main thread.
+*/
+void
+soundMgrBase::render(int16* samples) {
+    const int32 startTick = this->renderTick.load(std::memory_order_relaxed);
+    const int32 endTick = startTick + synth::BufferNumSamples;
+    for (int voiceIndex = 0; voiceIndex < this->numVoices; voiceIndex++) {
+        this->bundle.StartTick[voiceIndex] = startTick;
+        this->bundle.EndTick[voiceIndex] = endTick;
+        this->voices[voiceIndex].GatherOps(startTick, endTick, this->bundle);
+    }
+
+    // select between cpuSynth and gpuSynth here!
+    if (this->useGpuSynth) {
+        this->gpuSynth.Synthesize(this->bundle);
+    }
+    else {
+        this->cpuSynth.Synthesize(this->bundle);
+    }
+    sampleOps::Mix(samples, this->voiceSamples, synth::BufferNumSamples, this->voiceVolumes, this->numVoices, synth::BufferNumSamples);
+    this->renderTick.store(endTick, std::memory_order_release);
 }
 
 } // namespace _priv
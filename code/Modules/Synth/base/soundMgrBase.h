@@ -8,8 +8,11 @@
 #include "Synth/Core/SynthSetup.h"
 #include "Synth/Core/SynthOp.h"
 #include "Synth/Core/voice.h"
+#include "Synth/Core/opBundle.h"
 #include "Synth/Core/cpuSynthesizer.h"
 #include "Synth/Core/gpuSynthesizer.h"
+#include "Core/Threading/SPSCQueue.h"
+#include <atomic>
 
 namespace Oryol {
 namespace _priv {
@@ -35,13 +38,51 @@ public:
     
     /// add an op to a voice track
     void AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset);
+    /// update the volume of a voice (0.0f .. 2.0f)
+    void UpdateVoiceVolume(int32 voice, float32 vol);
+    /// get number of buffer underruns since setup
+    int32 NumBufferUnderruns() const;
+    /// render the next numSamples samples into samples (offline mode only)
+    void RenderOffline(int16* samples, int32 numSamples);
     
 protected:
+    /// add the ops which have been queued by AddOp() to their voices (render thread)
+    void applyOps();
+    /// synthesize the next buffer of all voices and mix them into samples, advances the render tick
+    void render(int16* samples);
+
+    /// an op or volume update on its way to the render thread
+    struct opItem {
+        enum Code {
+            AddOp,
+            UpdateVolume,
+        };
+        Code code = AddOp;
+        int32 voice = 0;
+        int32 track = 0;
+        int16 volume = 0;
+        SynthOp op;
+    };
+    /// push an item to the op queue, or apply it directly if there is no render thread
+    void submit(const opItem& item);
+    /// apply an item to its voice (render thread)
+    void apply(const opItem& item);
+    static const int32 MaxQueuedOps = 1024;
+
     bool isValid;
     SynthSetup setup;
     bool useGpuSynth;
-    int32 curTick;
-    voice voices[synth::NumVoices];
+    bool useThread;
+    int32 curTick;                      // tick of the next unrendered sample at the start of the frame
+    std::atomic<int32> renderTick;      // tick of the next unrendered sample
+    SPSCQueue<opItem, MaxQueuedOps> opQueue;
+    int32 numVoices;
+    voice voices[synth::MaxNumVoices];
+    int16 voiceVolumes[synth::MaxNumVoices];
+    int16* voiceSamples;                // numVoices * synth::BufferNumSamples
+    opBundle bundle;
+    int16 offlineSamples[synth::BufferNumSamples];
+    int32 offlinePos;                   // next unread sample in offlineSamples
     cpuSynthesizer cpuSynth;
     gpuSynthesizer gpuSynth;
 };
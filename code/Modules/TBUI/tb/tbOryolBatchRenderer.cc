@@ -29,7 +29,12 @@ u0(0.0f), v0(0.0f), u1(0.0f), v1(0.0f),
 batchId(0),
 inFlushBatch(false),
 curBatchIndex(0),
-curVertexIndex(0) {
+curVertexIndex(0),
+atlasPixels(nullptr),
+atlasNextShelfY(0),
+numAtlasSlots(0),
+atlasDirty(false),
+atlasLabel(ResourceLabel::Invalid) {
     // empty
 }
 
@@ -59,6 +64,14 @@ tbOryolBatchRenderer::Discard() {
     o_assert_dbg(this->isValid);
     
     this->deleteTextures();
+    if (this->atlasTex.IsValid()) {
+        Gfx::DestroyResources(this->atlasLabel);
+        this->atlasTex.Invalidate();
+    }
+    if (this->atlasPixels) {
+        Memory::Free(this->atlasPixels);
+        this->atlasPixels = nullptr;
+    }
     Gfx::DestroyResources(this->resLabel);
     this->isValid = false;
 }
@@ -149,6 +162,7 @@ tbOryolBatchRenderer::BeginPaint(int renderTargetWidth, int renderTargetHeight)
     this->curBatchIndex = 0;
     this->screenRect.Set(0, 0, renderTargetWidth, renderTargetHeight);
     this->clipRect = this->screenRect;
+    this->initBatch();
 }
 
 //------------------------------------------------------------------------------
@@ -248,6 +262,11 @@ tbOryolBatchRenderer::DrawBitmapColored(const TBRect& dstRect, const TBRect& src
 //------------------------------------------------------------------------------
 void
 tbOryolBatchRenderer::DrawBitmapTile(const TBRect& dstRect, TBBitmap* bitmap) {
+    auto* oryolBitmap = (tbOryolBitmap*) bitmap;
+    if (oryolBitmap && oryolBitmap->inAtlas) {
+        // tiling needs texture wrapping, which doesn't work with an atlas slot
+        oryolBitmap->moveOutOfAtlas();
+    }
     this->addQuad(dstRect.Offset(this->translationX, this->translationY),
                     TBRect(0, 0, dstRect.w, dstRect.h),
                     VER_COL_OPACITY(this->ui8Opacity), bitmap, nullptr);
@@ -287,7 +306,7 @@ tbOryolBatchRenderer::FlushBitmap(TBBitmap* bitmap) {
     if (this->curBatchIndex < MaxNumBatches) {
         const Batch& curBatch = this->batches[this->curBatchIndex];
         auto* oryolBitmap = (tbOryolBitmap*) bitmap;
-        if (oryolBitmap && (oryolBitmap->texture == curBatch.texture)) {
+        if (oryolBitmap && ((oryolBitmap->inAtlas ? this->atlasTex : oryolBitmap->texture) == curBatch.texture)) {
             this->flushBatch();
         }
     }
@@ -323,19 +342,31 @@ tbOryolBatchRenderer::addQuad(const TBRect& dstRect, const TBRect& srcRect, uint
     Batch* curBatch = &(this->batches[this->curBatchIndex]);
     auto* oryolBitmap = (tbOryolBitmap*) bitmap;
     if (oryolBitmap) {
-        if (curBatch->texture != oryolBitmap->texture) {
+        const Id texture = this->bitmapTexture(bitmap);
+        if (curBatch->texture != texture) {
             curBatch = this->flushBatch();
             if (!curBatch) {
                 return;
             }
-            curBatch->texture = oryolBitmap->texture;
+            curBatch->texture = texture;
+        }
+        if (oryolBitmap->inAtlas) {
+            const float texSize = (float) AtlasSize;
+            const int x = oryolBitmap->atlasSlot.x + srcRect.x;
+            const int y = oryolBitmap->atlasSlot.y + srcRect.y;
+            this->u0 = x / texSize;
+            this->v0 = y / texSize;
+            this->u1 = (x + srcRect.w) / texSize;
+            this->v1 = (y + srcRect.h) / texSize;
+        }
+        else {
+            int bitmapWidth = bitmap->Width();
+            int bitmapHeight = bitmap->Height();
+            this->u0 = (float) srcRect.x / bitmapWidth;
+            this->v0 = (float) srcRect.y / bitmapHeight;
+            this->u1 = (float) (srcRect.x + srcRect.w) / bitmapWidth;
+            this->v1 = (float) (srcRect.y + srcRect.h) / bitmapHeight;
         }
-        int bitmapWidth = bitmap->Width();
-        int bitmapHeight = bitmap->Height();
-        this->u0 = (float) srcRect.x / bitmapWidth;
-        this->v0 = (float) srcRect.y / bitmapHeight;
-        this->u1 = (float) (srcRect.x + srcRect.w) / bitmapWidth;
-        this->v1 = (float) (srcRect.y + srcRect.h) / bitmapHeight;
     }
     else {
         // bitmap-less, use white texture
@@ -351,6 +382,9 @@ tbOryolBatchRenderer::addQuad(const TBRect& dstRect, const TBRect& srcRect, uint
     if (fragment) {
         fragment->m_batch_id = curBatch->batchId;
     }
+    if (!dstRect.IsEmpty()) {
+        curBatch->bounds = curBatch->bounds.Union(dstRect);
+    }
     
     Vertex* v = &(this->vertexData[this->curVertexIndex]);
     this->curVertexIndex += 6;
@@ -418,6 +452,7 @@ tbOryolBatchRenderer::flushBatch() {
     this->inFlushBatch = false;
         
     curBatch->numVertices = numVerts;
+    curBatch->bounds = curBatch->bounds.Clip(this->clipRect);
     curBatch->clipRect.x = this->clipRect.x;
     curBatch->clipRect.y = this->screenRect.h - (this->clipRect.y + this->clipRect.h);
     curBatch->clipRect.w = this->clipRect.w;
@@ -427,26 +462,95 @@ tbOryolBatchRenderer::flushBatch() {
     this->batchId++;
     
     if (this->curBatchIndex < MaxNumBatches) {
-        // initialize the new batch
-        curBatch = &this->batches[this->curBatchIndex];
-        curBatch->startIndex = this->curVertexIndex;
-        curBatch->numVertices = 0;
-        curBatch->texture.Invalidate();        
-        curBatch->fragment = nullptr;
-        curBatch->batchId = this->batchId;
-        return &(this->batches[this->curBatchIndex]);
+        return this->initBatch();
     }
     else {
         return nullptr;
     }
 }
 
+//------------------------------------------------------------------------------
+tbOryolBatchRenderer::Batch*
+tbOryolBatchRenderer::initBatch() {
+    o_assert_dbg(this->curBatchIndex < MaxNumBatches);
+    Batch* curBatch = &(this->batches[this->curBatchIndex]);
+    curBatch->startIndex = this->curVertexIndex;
+    curBatch->numVertices = 0;
+    curBatch->texture.Invalidate();
+    curBatch->fragment = nullptr;
+    curBatch->batchId = this->batchId;
+    curBatch->bounds = TBRect();
+    curBatch->nextInGroup = -1;
+    return curBatch;
+}
+
+//------------------------------------------------------------------------------
+int
+tbOryolBatchRenderer::mergeBatches() {
+
+    // Each batch is either appended to an earlier draw with the same texture
+    // and clip rect, or starts a new draw. Appending moves the batch in front
+    // of all later draws, which is only allowed if it doesn't overlap any of
+    // them. Batches are only ever moved back in paint order, never forward,
+    // so the batches within a draw stay in paint order.
+    int numDraws = 0;
+    for (int batchIndex = 0; batchIndex < this->curBatchIndex; batchIndex++) {
+        Batch& batch = this->batches[batchIndex];
+        batch.nextInGroup = -1;
+        if (batch.bounds.IsEmpty()) {
+            // completely clipped away
+            continue;
+        }
+        int mergeIndex = InvalidIndex;
+        const int minDrawIndex = numDraws > MaxMergeDistance ? numDraws - MaxMergeDistance : 0;
+        for (int drawIndex = numDraws - 1; drawIndex >= minDrawIndex; drawIndex--) {
+            const MergedDraw& draw = this->mergedDraws[drawIndex];
+            const Batch& first = this->batches[draw.firstBatch];
+            if ((first.texture == batch.texture) && first.clipRect.Equals(batch.clipRect)) {
+                mergeIndex = drawIndex;
+                break;
+            }
+            if (draw.bounds.Intersects(batch.bounds)) {
+                break;
+            }
+        }
+        if (InvalidIndex != mergeIndex) {
+            MergedDraw& draw = this->mergedDraws[mergeIndex];
+            this->batches[draw.lastBatch].nextInGroup = batchIndex;
+            draw.lastBatch = batchIndex;
+            draw.numVertices += batch.numVertices;
+            draw.bounds = draw.bounds.Union(batch.bounds);
+        }
+        else {
+            MergedDraw& draw = this->mergedDraws[numDraws++];
+            draw.firstBatch = batchIndex;
+            draw.lastBatch = batchIndex;
+            draw.numVertices = batch.numVertices;
+            draw.bounds = batch.bounds;
+        }
+    }
+
+    // copy the vertices into draw order, so each draw is a contiguous range
+    uint16 vertexIndex = 0;
+    for (int drawIndex = 0; drawIndex < numDraws; drawIndex++) {
+        MergedDraw& draw = this->mergedDraws[drawIndex];
+        draw.startIndex = vertexIndex;
+        for (int batchIndex = draw.firstBatch; batchIndex >= 0; batchIndex = this->batches[batchIndex].nextInGroup) {
+            const Batch& batch = this->batches[batchIndex];
+            Memory::Copy(&this->vertexData[batch.startIndex], &this->mergedVertexData[vertexIndex], batch.numVertices * sizeof(Vertex));
+            vertexIndex += batch.numVertices;
+        }
+    }
+    return numDraws;
+}
+
 //------------------------------------------------------------------------------
 void
 tbOryolBatchRenderer::drawBatches() {
 
     // NOTE: curBatchIndex is always one-past-end
-    if (this->curBatchIndex > 1) {
+    const int numDraws = this->mergeBatches();
+    if (numDraws > 0) {
 
         Shaders::TBUIShader::VSParams vsParams;
         Shaders::TBUIShader::FSParams fsParams;
@@ -454,23 +558,157 @@ tbOryolBatchRenderer::drawBatches() {
         vsParams.Ortho = glm::ortho(0.0f, float(this->screenRect.w),
             (float)this->screenRect.h, 0.0f,
             -1.0f, 1.0f);
-        const int vertexDataSize = this->curVertexIndex * this->vertexLayout.ByteSize();
+        const MergedDraw& lastDraw = this->mergedDraws[numDraws - 1];
+        const int numVertices = lastDraw.startIndex + lastDraw.numVertices;
+        const int vertexDataSize = numVertices * this->vertexLayout.ByteSize();
         
         this->tbClipRect = this->screenRect;
-        Gfx::UpdateVertices(this->mesh, this->vertexData, vertexDataSize);
+        const int32 baseVertex = Gfx::AppendVertices(this->mesh, this->mergedVertexData, vertexDataSize);
+        if (InvalidIndex == baseVertex) {
+            return;
+        }
         Gfx::ApplyDrawState(this->drawState);
         Gfx::ApplyUniformBlock(vsParams);
-        for (int batchIndex = 0; batchIndex < this->curBatchIndex; batchIndex++) {
-            const Batch& batch = this->batches[batchIndex];
+        for (int drawIndex = 0; drawIndex < numDraws; drawIndex++) {
+            const MergedDraw& draw = this->mergedDraws[drawIndex];
+            const Batch& batch = this->batches[draw.firstBatch];
             Gfx::ApplyScissorRect(batch.clipRect.x, batch.clipRect.y, batch.clipRect.w, batch.clipRect.h);
             fsParams.Texture = batch.texture.IsValid() ? batch.texture : this->whiteTexture;
             Gfx::ApplyUniformBlock(fsParams);
-            Gfx::Draw(PrimitiveGroup(PrimitiveType::Triangles, batch.startIndex, batch.numVertices));
+            Gfx::Draw(PrimitiveGroup(PrimitiveType::Triangles, draw.startIndex, draw.numVertices), baseVertex);
         }
         Gfx::ApplyScissorRect(this->screenRect.x, this->screenRect.y, this->screenRect.w, this->screenRect.h);
     }
 }
 
+//------------------------------------------------------------------------------
+bool
+tbOryolBatchRenderer::allocAtlasSlot(int width, int height, TBRect& outSlot) {
+    if ((width > MaxAtlasBitmapSize) || (height > MaxAtlasBitmapSize)) {
+        return false;
+    }
+    const int slotWidth = width + AtlasPadding;
+    const int slotHeight = height + AtlasPadding;
+
+    // first try the smallest freed slot which fits
+    int freeIndex = InvalidIndex;
+    for (int i = 0; i < this->atlasFreeSlots.Size(); i++) {
+        const TBRect& slot = this->atlasFreeSlots[i];
+        if ((slot.w >= slotWidth) && (slot.h >= slotHeight)) {
+            if ((InvalidIndex == freeIndex) || ((slot.w * slot.h) < (this->atlasFreeSlots[freeIndex].w * this->atlasFreeSlots[freeIndex].h))) {
+                freeIndex = i;
+            }
+        }
+    }
+    if (InvalidIndex != freeIndex) {
+        outSlot = this->atlasFreeSlots[freeIndex];
+        this->atlasFreeSlots.EraseSwap(freeIndex);
+        this->numAtlasSlots++;
+        return true;
+    }
+
+    // otherwise find the lowest shelf with enough room left, and start
+    // a new shelf if there is none or it would waste too much space
+    AtlasShelf* shelf = nullptr;
+    for (AtlasShelf& cur : this->atlasShelves) {
+        if ((cur.height >= slotHeight) && ((AtlasSize - cur.width) >= slotWidth)) {
+            if ((nullptr == shelf) || (cur.height < shelf->height)) {
+                shelf = &cur;
+            }
+        }
+    }
+    if (((nullptr == shelf) || (shelf->height > 2 * slotHeight)) && ((this->atlasNextShelfY + slotHeight) <= AtlasSize)) {
+        AtlasShelf newShelf;
+        newShelf.y = this->atlasNextShelfY;
+        newShelf.height = slotHeight;
+        this->atlasShelves.Add(newShelf);
+        this->atlasNextShelfY += slotHeight;
+        shelf = &this->atlasShelves.Back();
+    }
+    if (nullptr == shelf) {
+        return false;
+    }
+    outSlot.Set(shelf->width, shelf->y, slotWidth, slotHeight);
+    shelf->width += slotWidth;
+    this->numAtlasSlots++;
+
+    if (nullptr == this->atlasPixels) {
+        const int byteSize = AtlasSize * AtlasSize * sizeof(tb::uint32);
+        this->atlasPixels = (tb::uint32*) Memory::Alloc(byteSize);
+        Memory::Clear(this->atlasPixels, byteSize);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+tbOryolBatchRenderer::freeAtlasSlot(const TBRect& slot) {
+    o_assert_dbg(this->numAtlasSlots > 0);
+    if (0 == --this->numAtlasSlots) {
+        // atlas is empty, start packing from scratch
+        this->atlasShelves.Clear();
+        this->atlasFreeSlots.Clear();
+        this->atlasNextShelfY = 0;
+    }
+    else {
+        this->atlasFreeSlots.Add(slot);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+tbOryolBatchRenderer::writeAtlasPixels(const TBRect& slot, int width, int height, const tb::uint32* data) {
+    o_assert_dbg(this->atlasPixels && data);
+    o_assert_dbg((width < slot.w) && (height < slot.h));
+    for (int y = 0; y < height; y++) {
+        Memory::Copy(data + y * width, this->atlasPixels + (slot.y + y) * AtlasSize + slot.x, width * sizeof(tb::uint32));
+    }
+    this->atlasDirty = true;
+}
+
+//------------------------------------------------------------------------------
+void
+tbOryolBatchRenderer::readAtlasPixels(const TBRect& slot, int width, int height, tb::uint32* data) const {
+    o_assert_dbg(this->atlasPixels && data);
+    o_assert_dbg((width < slot.w) && (height < slot.h));
+    for (int y = 0; y < height; y++) {
+        Memory::Copy(this->atlasPixels + (slot.y + y) * AtlasSize + slot.x, data + y * width, width * sizeof(tb::uint32));
+    }
+}
+
+//------------------------------------------------------------------------------
+Id
+tbOryolBatchRenderer::atlasTexture() {
+    o_assert_dbg(this->atlasPixels);
+    if (this->atlasDirty || !this->atlasTex.IsValid()) {
+        // textures can't be updated, so the atlas texture is re-created,
+        // batches recorded before still use the old texture
+        if (this->atlasTex.IsValid()) {
+            this->deferDeleteTexture(this->atlasLabel);
+            this->atlasTex.Invalidate();
+        }
+        const int byteSize = AtlasSize * AtlasSize * sizeof(tb::uint32);
+        this->atlasLabel = Gfx::PushResourceLabel();
+        auto texSetup = TextureSetup::FromPixelData(AtlasSize, AtlasSize, 1, TextureType::Texture2D, PixelFormat::RGBA8);
+        texSetup.WrapU = TextureWrapMode::ClampToEdge;
+        texSetup.WrapV = TextureWrapMode::ClampToEdge;
+        texSetup.MinFilter = TextureFilterMode::Nearest;
+        texSetup.MagFilter = TextureFilterMode::Nearest;
+        texSetup.ImageSizes[0][0] = byteSize;
+        this->atlasTex = Gfx::CreateResource(texSetup, this->atlasPixels, byteSize);
+        Gfx::PopResourceLabel();
+        this->atlasDirty = false;
+    }
+    return this->atlasTex;
+}
+
+//------------------------------------------------------------------------------
+Id
+tbOryolBatchRenderer::bitmapTexture(TBBitmap* bitmap) {
+    auto* oryolBitmap = (tbOryolBitmap*) bitmap;
+    return oryolBitmap->inAtlas ? this->atlasTexture() : oryolBitmap->texture;
+}
+
 //------------------------------------------------------------------------------
 tb::TBBitmap *
 tbOryolBatchRenderer::CreateBitmap(int width, int height, uint32 *data)
@@ -3,6 +3,19 @@
 /**
     @class Oryol::_priv::tbOryolBatchRenderer
     @brief properly optimized turbobadger ui renderer for oryol
+
+    Quads are collected into batches which are split whenever the
+    texture or clip rect changes. Before drawing, a merge pass moves
+    each batch back to the latest earlier batch with the same texture
+    and clip rect, as long as it doesn't overlap any batch in between,
+    so that painting order is preserved where it matters. The merged
+    batches are copied into contiguous vertex ranges and rendered with
+    one draw call each.
+
+    Small bitmaps (up to MaxAtlasBitmapSize) are packed into a shared
+    atlas texture, so that quads from different small bitmaps end up
+    in the same batch. The atlas keeps a CPU copy of its pixels and
+    the texture is re-created when bitmaps have been added or changed.
 */
 #include "Core/Types.h"
 #include "Gfx/Gfx.h"
@@ -57,12 +70,19 @@ public:
     /// create a new bitmap object
     virtual tb::TBBitmap *CreateBitmap(int width, int height, tb::uint32 *data);
     
+    /// atlas texture width and height
+    static const int AtlasSize = 512;
+    /// max width and height of bitmaps which are put into the atlas
+    static const int MaxAtlasBitmapSize = 128;
+
     struct Batch {
         uint16 startIndex = 0;
         uint16 numVertices = 0;
         Id texture;
         uint32 batchId = 0;
         tb::TBRect clipRect;
+        tb::TBRect bounds;          // clipped screen area covered by the batch
+        int16 nextInGroup = -1;     // next batch merged into the same draw
         tb::TBBitmapFragment* fragment = nullptr;
     };
     /// add a single quad
@@ -79,9 +99,26 @@ public:
     void deleteTextures();
     /// flush current batch (adds curBatch to batches array)
     Batch* flushBatch();
+    /// initialize the current batch
+    Batch* initBatch();
+    /// merge batches with same texture and clip rect, return number of draws
+    int mergeBatches();
     /// draw this frame's patches
     void drawBatches();
 
+    /// allocate an atlas slot, return false if the atlas is full
+    bool allocAtlasSlot(int width, int height, tb::TBRect& outSlot);
+    /// free an atlas slot
+    void freeAtlasSlot(const tb::TBRect& slot);
+    /// copy bitmap pixels into an atlas slot
+    void writeAtlasPixels(const tb::TBRect& slot, int width, int height, const tb::uint32* data);
+    /// copy bitmap pixels out of an atlas slot
+    void readAtlasPixels(const tb::TBRect& slot, int width, int height, tb::uint32* data) const;
+    /// get the atlas texture, re-created if the atlas has changed
+    Id atlasTexture();
+    /// get the texture to render a bitmap with
+    Id bitmapTexture(tb::TBBitmap* bitmap);
+
 private:
     bool isValid;
     
@@ -97,6 +134,10 @@ private:
     
     static const int MaxNumVertices = 64 * 1024;
     static const int MaxNumBatches = 1024;
+    /// how many draws the merge pass looks back for a matching batch
+    static const int MaxMergeDistance = 64;
+    /// gap between atlas slots
+    static const int AtlasPadding = 1;
     
     ResourceLabel resLabel;
     VertexLayout vertexLayout;
@@ -113,6 +154,31 @@ private:
         float32 u, v;
         uint32 c;
     } vertexData[MaxNumVertices];
+
+    /// a merged draw, batches are chained through Batch::nextInGroup
+    struct MergedDraw {
+        int16 firstBatch;
+        int16 lastBatch;
+        uint16 startIndex;
+        uint16 numVertices;
+        tb::TBRect bounds;
+    } mergedDraws[MaxNumBatches];
+    Vertex mergedVertexData[MaxNumVertices];
+
+    /// a row of atlas slots
+    struct AtlasShelf {
+        int y = 0;
+        int height = 0;
+        int width = 0;
+    };
+    tb::uint32* atlasPixels;
+    Array<AtlasShelf> atlasShelves;
+    Array<tb::TBRect> atlasFreeSlots;
+    int atlasNextShelfY;
+    int numAtlasSlots;
+    bool atlasDirty;
+    ResourceLabel atlasLabel;
+    Id atlasTex;
 };
 
 } // namespace _priv
@@ -5,6 +5,7 @@
 #include "tbOryolBitmap.h"
 #include "tbOryolBatchRenderer.h"
 #include "tb_bitmap_fragment.h"
+#include "Core/Memory/Memory.h"
 
 namespace Oryol {
 namespace _priv {
@@ -14,7 +15,8 @@ tbOryolBitmap::tbOryolBitmap(tbOryolBatchRenderer* rnd) :
 renderer(rnd),
 width(0),
 height(0),
-label(ResourceLabel::Invalid) {
+label(ResourceLabel::Invalid),
+inAtlas(false) {
     // empty
 }
 
@@ -23,6 +25,9 @@ tbOryolBitmap::~tbOryolBitmap() {
     if (this->texture.IsValid()) {
         this->destroyTexture();
     }
+    if (this->inAtlas) {
+        this->renderer->freeAtlasSlot(this->atlasSlot);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -32,16 +37,27 @@ tbOryolBitmap::Init(int w, int h, tb::uint32* data) {
     o_assert_dbg(tb::TBGetNearestPowerOfTwo(h) == h);
     this->width = w;
     this->height = h;
-    this->createTexture(data);
+    if (this->renderer->allocAtlasSlot(w, h, this->atlasSlot)) {
+        this->inAtlas = true;
+        this->renderer->writeAtlasPixels(this->atlasSlot, w, h, data);
+    }
+    else {
+        this->createTexture(data);
+    }
     return true;
 }
 
 //------------------------------------------------------------------------------
 void
 tbOryolBitmap::SetData(uint32* data) {
-    o_assert_dbg(this->texture.IsValid());
-    this->destroyTexture();
-    this->createTexture(data);
+    if (this->inAtlas) {
+        this->renderer->writeAtlasPixels(this->atlasSlot, this->width, this->height, data);
+    }
+    else {
+        o_assert_dbg(this->texture.IsValid());
+        this->destroyTexture();
+        this->createTexture(data);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -72,5 +88,19 @@ tbOryolBitmap::destroyTexture() {
     this->label = ResourceLabel::Invalid;
 }
 
+//------------------------------------------------------------------------------
+void
+tbOryolBitmap::moveOutOfAtlas() {
+    o_assert_dbg(this->inAtlas);
+    
+    const int byteSize = this->width * this->height * sizeof(tb::uint32);
+    tb::uint32* pixels = (tb::uint32*) Memory::Alloc(byteSize);
+    this->renderer->readAtlasPixels(this->atlasSlot, this->width, this->height, pixels);
+    this->renderer->freeAtlasSlot(this->atlasSlot);
+    this->inAtlas = false;
+    this->createTexture(pixels);
+    Memory::Free(pixels);
+}
+
 } // namespace _priv
 } // namespace Oryol
\ No newline at end of file
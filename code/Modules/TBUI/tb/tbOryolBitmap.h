@@ -3,6 +3,10 @@
 /**
     @class tbOryolBitmap
     @brief Oryol wrapper for TBBitmap
+
+    Small bitmaps live in a slot of the batch renderer's atlas texture
+    and don't have a texture of their own. A bitmap which is drawn
+    tiled is moved out of the atlas, since tiling needs texture wrapping.
 */
 #include "Core/Types.h"
 #include "tb_renderer.h"
@@ -34,6 +38,8 @@ public:
     void destroyTexture();
     /// create texture
     void createTexture(tb::uint32* data);
+    /// move the bitmap out of the atlas into its own texture
+    void moveOutOfAtlas();
     
     tbOryolBatchRenderer *renderer;
     int32 width;
@@ -41,6 +47,8 @@ public:
     
     ResourceLabel label;
     Id texture;
+    bool inAtlas;
+    tb::TBRect atlasSlot;
 };
 
 } // namespace _priv
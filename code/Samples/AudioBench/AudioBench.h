@@ -0,0 +1,45 @@
+#pragma once
+//------------------------------------------------------------------------------
+//  AudioBench.h
+//  Shared helpers of the SynthBench and SoundBench headless benchmarks.
+//  Synth and Sound can't be linked into the same executable (both have
+//  a _priv::soundMgr), so each gets its own benchmark app.
+//------------------------------------------------------------------------------
+#include "Core/Log.h"
+#include "Core/Containers/Array.h"
+#include "Core/String/String.h"
+#include "Core/String/StringBuilder.h"
+#include "Time/Duration.h"
+#include "Assets/Sound/WAVWriter.h"
+
+namespace Oryol {
+namespace AudioBench {
+
+const int32 SampleRate = 44100;
+// samples rendered between two 'frames', the app-side work happens in between
+const int32 FrameNumSamples = SampleRate / 60;
+
+//------------------------------------------------------------------------------
+inline void
+report(const char* name, int32 numSamples, Duration dur) {
+    const float64 sec = dur.AsSeconds();
+    Log::Info("%s: %d samples in %.2f ms, %.1f Msamples/s, %.1fx realtime\n",
+        name, numSamples, dur.AsMilliSeconds(),
+        (numSamples / sec) / 1000000.0, (numSamples / float64(SampleRate)) / sec);
+}
+
+//------------------------------------------------------------------------------
+inline void
+writeWAV(const String& prefix, const char* name, const Array<int16>& samples) {
+    if (prefix.Empty() || samples.Empty()) {
+        return;
+    }
+    StringBuilder path;
+    path.Format(1024, "%s%s.wav", prefix.AsCStr(), name);
+    if (WAVWriter::WriteFile(path.AsCStr(), &samples[0], samples.Size(), SampleRate)) {
+        Log::Info("wrote '%s'\n", path.AsCStr());
+    }
+}
+
+} // namespace AudioBench
+} // namespace Oryol
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+//  SoundBench.cc
+//  Mix sound effects through the offline Sound backend as fast as possible
+//  and print the throughput, runs without an audio device:
+//
+//  SoundBench [-seconds 60] [-effects 32] [-voices 64] [-mixed 24] [-async] [-wav prefix]
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Core/Core.h"
+#include "Core/Args.h"
+#include "Core/RunLoop.h"
+#include "Time/Clock.h"
+#include "Sound/Sound.h"
+#include "Assets/Sound/SoundGen.h"
+#include "AudioBench.h"
+
+using namespace Oryol;
+using namespace Oryol::AudioBench;
+
+namespace {
+
+//------------------------------------------------------------------------------
+void
+benchSound(int32 numEffects, int32 seconds, const SoundSetup& soundSetup, bool async, bool capture, Array<int16>& outSamples) {
+    SoundSetup setup = soundSetup;
+    setup.Offline = true;
+    setup.SampleRate = SampleRate;
+    Sound::Setup(setup);
+
+    // short effects at 22kHz, so that the mixer resamples, played
+    // a few times per second each, with -async the samples are
+    // generated on the worker threads
+    Array<Id> effects;
+    TimePoint loadStart = Clock::Now();
+    for (int32 i = 0; i < numEffects; i++) {
+        const float32 freq = 110.0f + 40.0f * i;
+        const int32 wave = i % SoundGen::NamcoVoice::NumWaveForms;
+        SoundEffectSetup effectSetup = SoundEffectSetup::FromSampleFunc(4, 0.5f, 22050,
+            [freq, wave](float32 dt, int16* samples, int32 numSamples) {
+                SoundGen::NamcoVoice voice(dt, SoundGen::NamcoVoice::WaveForm(wave));
+                voice.Frequency = freq;
+                for (int32 s = 0; s < numSamples; s++) {
+                    voice.Volume = 0.05f * (1.0f - float32(s) / numSamples);
+                    samples[s] = SoundGen::Sample::Int16(voice.Step());
+                }
+            });
+        effects.Add(async ? Sound::CreateResourceAsync(effectSetup) : Sound::CreateResource(effectSetup));
+    }
+    for (const Id& id : effects) {
+        while (ResourceState::Pending == Sound::QueryResourceInfo(id).State) {
+            Core::PostRunLoop()->Run();
+        }
+    }
+    Log::Info("created %d effects in %.2f ms\n", numEffects, Clock::Since(loadStart).AsMilliSeconds());
+
+    int16 samples[FrameNumSamples];
+    const int32 numFrames = seconds * 60;
+    Duration dur;
+    int64 sumVoices = 0;
+    int64 sumMixedVoices = 0;
+    for (int32 frame = 0; frame < numFrames; frame++) {
+        for (int32 i = (frame % 8); i < numEffects; i += 8) {
+            Sound::Play(effects[i]);
+        }
+        TimePoint start = Clock::Now();
+        Sound::RenderOffline(samples, FrameNumSamples);
+        dur += Clock::Since(start);
+        sumVoices += Sound::NumVoices();
+        sumMixedVoices += Sound::NumMixedVoices();
+        if (capture) {
+            outSamples.Reserve(FrameNumSamples);
+            for (int32 i = 0; i < FrameNumSamples; i++) {
+                outSamples.Add(samples[i]);
+            }
+        }
+    }
+    Sound::Discard();
+
+    StringBuilder name;
+    name.Format(128, "Sound (%d effects, %.1f voices, %.1f mixed)", numEffects,
+        float64(sumVoices) / numFrames, float64(sumMixedVoices) / numFrames);
+    report(name.AsCStr(), numFrames * FrameNumSamples, dur);
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int
+main(int argc, const char** argv) {
+    Core::Setup();
+    Args args(argc, argv);
+    const int32 seconds = args.GetInt("-seconds", 60);
+    const int32 numEffects = args.GetInt("-effects", 32);
+    SoundSetup setup;
+    setup.MaxNumVoices = args.GetInt("-voices", setup.MaxNumVoices);
+    setup.MaxNumMixedVoices = args.GetInt("-mixed", setup.MaxNumMixedVoices);
+    const bool async = args.HasArg("-async");
+    const String wavPrefix = args.GetString("-wav");
+
+    Array<int16> samples;
+    benchSound(numEffects, seconds, setup, async, !wavPrefix.Empty(), samples);
+    writeWAV(wavPrefix, "sound", samples);
+
+    Core::Discard();
+    return 0;
+}
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+//  SynthBench.cc
+//  Render Synth voices through the offline backend as fast as possible
+//  and print the throughput, runs without an audio device:
+//
+//  SynthBench [-seconds 60] [-voices 32] [-wav prefix]
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Core/Core.h"
+#include "Core/Args.h"
+#include "Time/Clock.h"
+#include "Synth/Synth.h"
+#include "AudioBench.h"
+
+using namespace Oryol;
+using namespace Oryol::AudioBench;
+
+namespace {
+
+//------------------------------------------------------------------------------
+void
+benchSynth(int32 numVoices, int32 seconds, bool capture, Array<int16>& outSamples) {
+    SynthSetup setup;
+    setup.Offline = true;
+    setup.NumVoices = numVoices;
+    Synth::Setup(setup);
+
+    // a frequency-modulated tone with a volume LFO per voice,
+    // the tone changes a few times per second to create op spans
+    SynthOp freqOp;
+    freqOp.Op = SynthOp::Replace;
+    freqOp.Wave = SynthOp::Sine;
+    freqOp.Amp = 1<<14;
+    freqOp.Bias = 1<<13;
+    SynthOp sndOp;
+    sndOp.Op = SynthOp::ModFreq;
+    sndOp.Wave = SynthOp::Custom0;
+    sndOp.Amp = 1<<12;
+    SynthOp volOp;
+    volOp.Op = SynthOp::Modulate;
+    volOp.Wave = SynthOp::Triangle;
+    volOp.Amp = 1<<14;
+    volOp.Bias = 1<<14;
+    for (int32 voice = 0; voice < numVoices; voice++) {
+        freqOp.Freq = 2 + voice;
+        volOp.Freq = 1 + (voice & 3);
+        Synth::AddOp(voice, 0, freqOp);
+        Synth::AddOp(voice, 2, volOp);
+        Synth::UpdateVoiceVolume(voice, 4.0f / numVoices);
+    }
+
+    int16 samples[FrameNumSamples];
+    const int32 numFrames = seconds * 60;
+    Duration dur;
+    for (int32 frame = 0; frame < numFrames; frame++) {
+        Synth::Update();
+        if (0 == (frame % 10)) {
+            for (int32 voice = 0; voice < numVoices; voice++) {
+                sndOp.Freq = 110 + ((frame * 7 + voice * 31) % 880);
+                sndOp.Wave = SynthOp::WaveT(SynthOp::Custom0 + ((frame / 10 + voice) & 7));
+                Synth::AddOp(voice, 1, sndOp, voice * 16);
+            }
+        }
+        TimePoint start = Clock::Now();
+        Synth::RenderOffline(samples, FrameNumSamples);
+        dur += Clock::Since(start);
+        if (capture) {
+            outSamples.Reserve(FrameNumSamples);
+            for (int32 i = 0; i < FrameNumSamples; i++) {
+                outSamples.Add(samples[i]);
+            }
+        }
+    }
+    Synth::Discard();
+
+    StringBuilder name;
+    name.Format(64, "Synth (%d voices)", numVoices);
+    report(name.AsCStr(), numFrames * FrameNumSamples, dur);
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int
+main(int argc, const char** argv) {
+    Core::Setup();
+    Args args(argc, argv);
+    const int32 seconds = args.GetInt("-seconds", 60);
+    const int32 numVoices = args.GetInt("-voices", 32);
+    const String wavPrefix = args.GetString("-wav");
+
+    Array<int16> samples;
+    benchSynth(numVoices, seconds, !wavPrefix.Empty(), samples);
+    writeWAV(wavPrefix, "synth", samples);
+
+    Core::Discard();
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include "Dbg/Dbg.h"
 #include "Input/Input.h"
 #include "Time/Clock.h"
+#include "Core/Threading/Parallel.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/random.hpp"
@@ -123,7 +124,7 @@ DrawCallPerfApp::emitParticles() {
 void
 DrawCallPerfApp::updateParticles() {
     const float32 frameTime = 1.0f / 60.0f;
-    for (int32 i = 0; i < this->curNumParticles; i++) {
+    Parallel::For(0, this->curNumParticles, 4096, [this, frameTime](int32 i) {
         auto& curParticle = this->particles[i];
         curParticle.vec.y -= 1.0f * frameTime;
         curParticle.pos += curParticle.vec * frameTime;
@@ -132,7 +133,7 @@ DrawCallPerfApp::updateParticles() {
             curParticle.vec.y = -curParticle.vec.y;
             curParticle.vec *= 0.8f;
         }
-    }
+    });
 }
 
 //------------------------------------------------------------------------------
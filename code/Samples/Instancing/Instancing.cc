@@ -8,6 +8,7 @@
 #include "Dbg/Dbg.h"
 #include "Input/Input.h"
 #include "Time/Clock.h"
+#include "Core/Containers/SoaArray.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/random.hpp"
@@ -34,12 +35,11 @@ private:
     Shaders::Main::VSParams vsParams;
     bool updateEnabled = true;
     int32 frameCount = 0;
-    int32 curNumParticles = 0;
     TimePoint lastFrameTimePoint;
     static const int32 MaxNumParticles = 1024 * 1024;
     const int32 NumParticlesEmittedPerFrame = 100;
-    glm::vec4 positions[MaxNumParticles];
-    glm::vec4 vectors[MaxNumParticles];
+    /// particle positions (stream 0) and velocity vectors (stream 1)
+    SoaArray<glm::vec4, glm::vec4> particles;
 };
 OryolMain(InstancingApp);
 
@@ -59,7 +59,7 @@ InstancingApp::OnRunning() {
         updTime = Clock::Since(updStart);
 
         TimePoint bufStart = Clock::Now();
-        Gfx::UpdateVertices(this->instanceMesh, this->positions, this->curNumParticles * sizeof(glm::vec4));
+        Gfx::UpdateVertices(this->instanceMesh, this->particles.Stream<0>().Data(), this->particles.Size() * sizeof(glm::vec4));
         bufTime = Clock::Since(bufStart);
     }
     
@@ -68,7 +68,7 @@ InstancingApp::OnRunning() {
     Gfx::ApplyDefaultRenderTarget();
     Gfx::ApplyDrawState(this->drawState);
     Gfx::ApplyUniformBlock(this->vsParams);
-    Gfx::DrawInstanced(0, this->curNumParticles);
+    Gfx::DrawInstanced(0, this->particles.Size());
     drawTime = Clock::Since(drawStart);
     
     Dbg::DrawTextBuffer();
@@ -83,7 +83,7 @@ InstancingApp::OnRunning() {
     Duration frameTime = Clock::LapTime(this->lastFrameTimePoint);
     Dbg::PrintF("\n %d instances\n\r upd=%.3fms\n\r bufUpd=%.3fms\n\r draw=%.3fms\n\r frame=%.3fms\n\r"
                 " LMB/Tap: toggle particle updates",
-                this->curNumParticles,
+                this->particles.Size(),
                 updTime.AsMilliSeconds(),
                 bufTime.AsMilliSeconds(),
                 drawTime.AsMilliSeconds(),
@@ -105,12 +105,10 @@ InstancingApp::updateCamera() {
 void
 InstancingApp::emitParticles() {
     for (int32 i = 0; i < NumParticlesEmittedPerFrame; i++) {
-        if (this->curNumParticles < MaxNumParticles) {
-            this->positions[this->curNumParticles] = glm::vec4(0.0f, 0.0f, 0.0f, 0.0f);
+        if (this->particles.Size() < MaxNumParticles) {
             glm::vec3 rnd = glm::ballRand(0.5f);
             rnd.y += 2.0f;
-            this->vectors[this->curNumParticles] = glm::vec4(rnd, 0.0f);
-            this->curNumParticles++;
+            this->particles.Add(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f), glm::vec4(rnd, 0.0f));
         }
     }
 }
@@ -119,9 +117,11 @@ InstancingApp::emitParticles() {
 void
 InstancingApp::updateParticles() {
     const float32 frameTime = 1.0f / 60.0f;
-    for (int32 i = 0; i < this->curNumParticles; i++) {
-        auto& pos = this->positions[i];
-        auto& vec = this->vectors[i];
+    Slice<glm::vec4> positions = this->particles.Stream<0>();
+    Slice<glm::vec4> vectors = this->particles.Stream<1>();
+    for (int32 i = 0; i < positions.Size(); i++) {
+        auto& pos = positions[i];
+        auto& vec = vectors[i];
         vec.y -= 1.0f * frameTime;
         pos += vec * frameTime;
         if (pos.y < -2.0f) {
@@ -151,6 +151,7 @@ InstancingApp::OnInit() {
     instanceMeshSetup.StepFunction = VertexStepFunction::PerInstance;
     instanceMeshSetup.StepRate = 1;
     this->instanceMesh = Gfx::CreateResource(instanceMeshSetup);
+    this->particles.Reserve(MaxNumParticles);
     
     // setup static draw state
     const glm::mat4 rot90 = glm::rotate(glm::mat4(), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
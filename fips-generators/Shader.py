@@ -749,24 +749,30 @@ class GLSLGenerator :
     #---------------------------------------------------------------------------
     def genUniformBlocks(self, shd, slVersion, lines) :
         for uBlock in shd.uniformBlocks :
-            '''
             if glslVersionNumber[slVersion] >= 150 :
-                # on GLSL 1.50 and above, write actual uniform blocks
-                lines.append(Line('layout(std140) uniform {} {{'.format(uBlock.name), uBlock.filePath, uBlock.lineNumber))
+                # on GLSL 1.50 and above, write textures as normal uniforms
+                # and the rest into an std140 uniform block, vec3's are padded
+                # to 16 bytes to match the C struct layout
+                hasBlockUniforms = False
                 for type in uBlock.uniformsByType :
                     for uniform in uBlock.uniformsByType[type] :
-                        lines.append(Line('  {} {};'.format(uniform.type, uniform.name), uniform.filePath, uniform.lineNumber))
-                lines.append(Line('};', uBlock.filePath, uBlock.lineNumber))
+                        if type in ['sampler2D', 'samplerCube'] :
+                            lines.append(Line('uniform {} {};'.format(uniform.type, uniform.name), uniform.filePath, uniform.lineNumber))
+                        else :
+                            hasBlockUniforms = True
+                if hasBlockUniforms :
+                    lines.append(Line('layout(std140) uniform {} {{'.format(uBlock.name), uBlock.filePath, uBlock.lineNumber))
+                    for type in uBlock.uniformsByType :
+                        if type not in ['sampler2D', 'samplerCube'] :
+                            for uniform in uBlock.uniformsByType[type] :
+                                lines.append(Line('  {} {};'.format(uniform.type, uniform.name), uniform.filePath, uniform.lineNumber))
+                                if type == 'vec3' :
+                                    lines.append(Line('  float _pad_{};'.format(uniform.name)))
+                    lines.append(Line('};', uBlock.filePath, uBlock.lineNumber))
             else :
-                # on old-school GLSL, pack the uniform block members into arrays by type
                 for type in uBlock.uniformsByType :
-                    name = '{}_{}'.format(uBlock.name, type)
-                    size = len(uBlock.uniformsByType[type])
-                    lines.append(Line('uniform {} {}[{}];'.format(type, name, size), uBlock.filePath, uBlock.lineNumber)) 
-            '''
-            for type in uBlock.uniformsByType :
-                for uniform in uBlock.uniformsByType[type] :
-                    lines.append(Line('uniform {} {};'.format(uniform.type, uniform.name), uniform.filePath, uniform.lineNumber))
+                    for uniform in uBlock.uniformsByType[type] :
+                        lines.append(Line('uniform {} {};'.format(uniform.type, uniform.name), uniform.filePath, uniform.lineNumber))
         return lines 
 
     #---------------------------------------------------------------------------
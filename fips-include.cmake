@@ -116,6 +116,16 @@ if (ORYOL_OPENGL)
     if (ORYOL_OPENGL_CORE_PROFILE)
         add_definitions(-DORYOL_OPENGL_CORE_PROFILE=1)
     endif()
+    # On the GL core profile, shaders are generated as GLSL 1.50 with
+    # std140 uniform blocks, uniform blocks are then written into a
+    # global uniform buffer instead of one glUniform call per uniform.
+    # This changes the layout of glRenderer, which is visible to all
+    # modules through Gfx.h, so it must be defined globally.
+    if (ORYOL_OPENGL_CORE_PROFILE)
+        add_definitions(-DORYOL_GL_USE_UNIFORMBUFFER=1)
+    else()
+        add_definitions(-DORYOL_GL_USE_UNIFORMBUFFER=0)
+    endif()
 endif()
 
 # D3D11 defines